@@ -233,8 +233,8 @@ namespace QuantLib {
         }
         if (fixingDate == today) {
             // might have been fixed
-            Rate pastFixing =
-                IndexManager::instance().getHistory((underlying_->index())->name())[fixingDate];
+            Rate pastFixing = IndexManager::instance().fixing(
+                                   underlying_->index()->name(), fixingDate);
             if (pastFixing != Null<Real>()) {
                 return underlyingRate + callCsi_ * callPayoff() + putCsi_  * putPayoff();
             } else
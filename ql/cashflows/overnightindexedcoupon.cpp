@@ -35,6 +35,10 @@ namespace QuantLib {
 
         class OvernightIndexedCouponPricer : public FloatingRateCouponPricer {
           public:
+            OvernightIndexedCouponPricer()
+            : coupon_(0), cachedCoupon_(0), handle_(Null<Size>()),
+              cachedRevision_(0), cachedFixings_(0),
+              cachedCompoundFactor_(1.0) {}
             void initialize(const FloatingRateCoupon& coupon) {
                 coupon_ = dynamic_cast<const OvernightIndexedCoupon*>(&coupon);
                 QL_ENSURE(coupon_, "wrong coupon type");
@@ -47,30 +51,59 @@ namespace QuantLib {
                 const vector<Date>& fixingDates = coupon_->fixingDates();
                 const vector<Time>& dt = coupon_->dt();
 
-                Size n = dt.size(),
-                     i = 0;
+                Size n = dt.size();
 
-                Real compoundFactor = 1.0;
-
-                // already fixed part
+                // already fixed part; the compound factor of the past
+                // fixings is kept and only extended as the evaluation
+                // date moves forward, until one of its fixings changes
                 Date today = Settings::instance().evaluationDate();
+                const IndexManager& manager = IndexManager::instance();
+                if (coupon_ != cachedCoupon_) {
+                    cachedCoupon_ = coupon_;
+                    handle_ = manager.handle(index->name());
+                    cachedRevision_ = manager.revision(handle_);
+                    cachedFixings_ = 0;
+                    cachedCompoundFactor_ = 1.0;
+                }
+                Size handle = handle_;
+                Size revision = manager.revision(handle);
+                if (revision != cachedRevision_) {
+                    // fixings added after the cached ones don't matter
+                    Date changed =
+                        manager.firstChangedDate(handle, cachedRevision_);
+                    if (cachedFixings_ > 0 && changed != Date()
+                        && changed <= fixingDates[cachedFixings_-1]) {
+                        cachedFixings_ = 0;
+                        cachedCompoundFactor_ = 1.0;
+                    }
+                    cachedRevision_ = revision;
+                }
+                if (cachedFixings_ > 0
+                    && fixingDates[cachedFixings_-1] >= today) {
+                    cachedFixings_ = 0;
+                    cachedCompoundFactor_ = 1.0;
+                }
+
+                Size i = cachedFixings_;
+                Real compoundFactor = cachedCompoundFactor_;
                 while (i<n && fixingDates[i]<today) {
                     // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                    Rate pastFixing = manager.fixing(handle, fixingDates[i]);
                     QL_REQUIRE(pastFixing != Null<Real>(),
                                "Missing " << index->name() <<
                                " fixing for " << fixingDates[i]);
                     compoundFactor *= (1.0 + pastFixing*dt[i]);
                     ++i;
                 }
+                cachedFixings_ = i;
+                cachedCompoundFactor_ = compoundFactor;
 
                 // today is a border case
                 if (i<n && fixingDates[i] == today) {
                     // might have been fixed
                     try {
-                        Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
+                        Rate pastFixing =
+                            manager.fixing(handle, fixingDates[i]);
                         if (pastFixing != Null<Real>()) {
                             compoundFactor *= (1.0 + pastFixing*dt[i]);
                             ++i;
@@ -109,6 +142,10 @@ namespace QuantLib {
             Rate floorletRate(Rate) const { QL_FAIL("floorletRate not available"); }
           protected:
             const OvernightIndexedCoupon* coupon_;
+          private:
+            mutable const OvernightIndexedCoupon* cachedCoupon_;
+            mutable Size handle_, cachedRevision_, cachedFixings_;
+            mutable Real cachedCompoundFactor_;
         };
     }
 
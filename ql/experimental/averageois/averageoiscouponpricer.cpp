@@ -48,10 +48,11 @@ namespace QuantLib {
 
         // already fixed part
         Date today = Settings::instance().evaluationDate();
+        const IndexManager& manager = IndexManager::instance();
+        Size handle = manager.handle(index->name());
         while (i < n && fixingDates[i] < today) {
             // rate must have been fixed
-            Rate pastFixing = IndexManager::instance().getHistory(
-                index->name())[fixingDates[i]];
+            Rate pastFixing = manager.fixing(handle, fixingDates[i]);
             QL_REQUIRE(pastFixing != Null<Real>(),
                 "Missing " << index->name() <<
                 " fixing for " << fixingDates[i]);
@@ -63,8 +64,7 @@ namespace QuantLib {
         if (i < n && fixingDates[i] == today) {
             // might have been fixed
             try {
-                Rate pastFixing = IndexManager::instance().getHistory(
-                    index->name())[fixingDates[i]];
+                Rate pastFixing = manager.fixing(handle, fixingDates[i]);
                 if (pastFixing != Null<Real>()) {
                     accumulatedRate += pastFixing*dt[i];
                     ++i;
@@ -52,11 +52,11 @@ namespace QuantLib {
             today = calendar_.adjust(today, businessDayConvention_);
             // for valuations inside the reference period, index quotes
             // must have been populated in the history
-            const TimeSeries<Real>& history = IndexManager::instance()
-                .getHistory(overnightIndex_->name());
+            const IndexManager& manager = IndexManager::instance();
+            Size handle = manager.handle(overnightIndex_->name());
             Date d1 = valueDate_;
             while (d1 < today) {
-                Real r = history[d1];
+                Real r = manager.fixing(handle, d1);
                 QL_REQUIRE(r!=Null<Real>(), "missing rate on "<<
                     d1<<" for index "<<overnightIndex_->name());
                 Date d2 = calendar_.advance(d1, 1, Days);
@@ -482,31 +482,48 @@ namespace QuantLib {
                 const ext::shared_ptr<FdmScheme> fdmScheme(
                     fdmSchemeFactory(fdmSchemeDesc, hestonFwdOp));
 
-                for (Size j=0; j < x.size(); ++j) {
-                    Array pSlice(vGrid);
-                    for (Size k=0; k < vGrid; ++k)
-                        pSlice[k] = pn[j + k*xGrid];
-
-                    const Real pInt = (trafoType == FdmSquareRootFwdOp::Power)
-                       ? DiscreteSimpsonIntegral()(v, Pow(v, alpha-1)*pSlice)
-                       : DiscreteSimpsonIntegral()(v, pSlice);
-
-                    const Real vpInt = (trafoType == FdmSquareRootFwdOp::Log)
-                      ? DiscreteSimpsonIntegral()(v, Exp(v)*pSlice)
-                      : (trafoType == FdmSquareRootFwdOp::Power)
-                      ? DiscreteSimpsonIntegral()(v, Pow(v, alpha)*pSlice)
-                      : DiscreteSimpsonIntegral()(v, v*pSlice);
-
-                    const Real scale = pInt/vpInt;
-                    const Volatility localVol = localVol_->localVol(t, x[j]);
-
-                    const Real l = (scale >= 0.0)
-                      ? localVol*std::sqrt(scale) : 1.0;
-
-                    (*L)[j][i] = std::min(50.0, std::max(0.001, l));
-
-                    leverageFct->setInterpolation(Linear());
+                // the first lookup initializes lazy or moving local
+                // volatility surfaces outside of the parallel loop
+                localVol_->localVol(t, x.front());
+
+                std::vector<std::string> failures(x.size());
+                #pragma omp parallel for
+                for (long j=0; j < (long)x.size(); ++j) {
+                    try {
+                        Array pSlice(vGrid);
+                        for (Size k=0; k < vGrid; ++k)
+                            pSlice[k] = pn[j + k*xGrid];
+
+                        const Real pInt =
+                            (trafoType == FdmSquareRootFwdOp::Power)
+                          ? DiscreteSimpsonIntegral()(v, Pow(v, alpha-1)*pSlice)
+                          : DiscreteSimpsonIntegral()(v, pSlice);
+
+                        const Real vpInt =
+                            (trafoType == FdmSquareRootFwdOp::Log)
+                          ? DiscreteSimpsonIntegral()(v, Exp(v)*pSlice)
+                          : (trafoType == FdmSquareRootFwdOp::Power)
+                          ? DiscreteSimpsonIntegral()(v, Pow(v, alpha)*pSlice)
+                          : DiscreteSimpsonIntegral()(v, v*pSlice);
+
+                        const Real scale = pInt/vpInt;
+                        const Volatility localVol =
+                            localVol_->localVol(t, x[j]);
+
+                        const Real l = (scale >= 0.0)
+                          ? localVol*std::sqrt(scale) : 1.0;
+
+                        (*L)[j][i] = std::min(50.0, std::max(0.001, l));
+                    } catch (std::exception& e) {
+                        failures[j] = e.what();
+                    } catch (...) {
+                        failures[j] = "unknown error";
+                    }
                 }
+                for (Size j=0; j < x.size(); ++j)
+                    QL_REQUIRE(failures[j].empty(), failures[j]);
+
+                leverageFct->setInterpolation(Linear());
 
                 Real sLowerBound = x.front();
                 // try {
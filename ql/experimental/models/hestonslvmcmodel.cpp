@@ -36,6 +36,29 @@
 #endif
 
 namespace QuantLib {
+
+    namespace {
+        typedef boost::multi_array<Real, 3> path_type;
+
+        // x0 and dw are work arrays reused across paths
+        void evolvePath(const ext::shared_ptr<HestonSLVProcess>& slvProcess,
+                        const path_type& paths,
+                        std::vector<std::pair<Real, Real> >& pairs,
+                        Size i, Size n, Time t, Time dt,
+                        Array& x0, Array& dw) {
+            x0[0] = pairs[i].first;
+            x0[1] = pairs[i].second;
+
+            dw[0] = paths[i][n-1][0];
+            dw[1] = paths[i][n-1][1];
+
+            x0 = slvProcess->evolve(t, x0, dt, dw);
+
+            pairs[i].first = x0[0];
+            pairs[i].second = x0[1];
+        }
+    }
+
     HestonSLVMCModel::HestonSLVMCModel(
         const Handle<LocalVolTermStructure>& localVol,
         const Handle<HestonModel>& hestonModel,
@@ -134,7 +157,6 @@ namespace QuantLib {
 
         const Size timeSteps = timeGrid_->size()-1;
 
-        typedef boost::multi_array<Real, 3> path_type;
         path_type paths(boost::extents[calibrationPaths_][timeSteps][2]);
 
         const ext::shared_ptr<BrownianGenerator> brownianGenerator =
@@ -154,40 +176,70 @@ namespace QuantLib {
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
 
+            // the first path initializes lazy or moving term structures
+            // outside of the parallel loops
             Array x0(2), dw(2);
-
-            for (Size i=0; i < calibrationPaths_; ++i) {
-                x0[0] = pairs[i].first;
-                x0[1] = pairs[i].second;
-
-                dw[0] = paths[i][n-1][0];
-                dw[1] = paths[i][n-1][1];
-
-                x0 = slvProcess->evolve(t, x0, dt, dw);
-
-                pairs[i].first = x0[0];
-                pairs[i].second = x0[1];
+            evolvePath(slvProcess, paths, pairs, 0, n, t, dt, x0, dw);
+
+            // only the first failure is kept
+            bool failed = false;
+            std::string failure;
+            #pragma omp parallel
+            {
+                Array x(2), w(2);
+                #pragma omp for
+                for (long i=1; i < (long)calibrationPaths_; ++i) {
+                    try {
+                        evolvePath(slvProcess, paths, pairs, i, n, t, dt,
+                                   x, w);
+                    } catch (std::exception& e) {
+                        #pragma omp critical(ql_slv_mc_calibration)
+                        if (!failed) {
+                            failed = true;
+                            failure = e.what();
+                        }
+                    } catch (...) {
+                        #pragma omp critical(ql_slv_mc_calibration)
+                        if (!failed) {
+                            failed = true;
+                            failure = "unknown error";
+                        }
+                    }
+                }
             }
+            QL_REQUIRE(!failed, failure);
 
             std::sort(pairs.begin(), pairs.end());
 
-            Size s = 0u, e = 0u;
-            for (Size i=0; i < nBins_; ++i) {
-                const Size inc = k + (i < m);
-                e = s + inc;
-
-                Real sum=0.0;
-                for (Size j=s; j < e; ++j) {
-                    sum+=pairs[j].second;
+            // likewise for the local volatility surface
+            localVol_->localVol(t, pairs.front().first, true);
+
+            std::vector<std::string> binFailures(nBins_);
+            #pragma omp parallel for
+            for (long i=0; i < (long)nBins_; ++i) {
+                try {
+                    const Size s = i*k + std::min(Size(i), m);
+                    const Size inc = k + (Size(i) < m);
+                    const Size e = s + inc;
+
+                    Real sum=0.0;
+                    for (Size j=s; j < e; ++j) {
+                        sum+=pairs[j].second;
+                    }
+                    sum/=inc;
+
+                    vStrikes[n]->at(i) =
+                        0.5*(pairs[e-1].first + pairs[s].first);
+                    (*L)[i][n] = std::sqrt(square<Real>()(
+                         localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
+                } catch (std::exception& e) {
+                    binFailures[i] = e.what();
+                } catch (...) {
+                    binFailures[i] = "unknown error";
                 }
-                sum/=inc;
-
-                vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
-                (*L)[i][n] = std::sqrt(square<Real>()(
-                     localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
-
-                s = e;
             }
+            for (Size i=0; i < nBins_; ++i)
+                QL_REQUIRE(binFailures[i].empty(), binFailures[i]);
 
             leverageFunction_->setInterpolation<Linear>();
         }
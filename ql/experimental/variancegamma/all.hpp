@@ -5,6 +5,7 @@
 #include <ql/experimental/variancegamma/fftengine.hpp>
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/experimental/variancegamma/fftvariancegammaengine.hpp>
+#include <ql/experimental/variancegamma/variancegammacharacteristicfunction.hpp>
 #include <ql/experimental/variancegamma/variancegammamodel.hpp>
 #include <ql/experimental/variancegamma/variancegammaprocess.hpp>
 
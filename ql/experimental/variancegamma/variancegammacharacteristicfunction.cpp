@@ -0,0 +1,44 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/variancegammacharacteristicfunction.hpp>
+
+namespace QuantLib {
+
+    VarianceGammaCharacteristicFunction::VarianceGammaCharacteristicFunction(
+                             const ext::shared_ptr<VarianceGammaModel>& model)
+    : model_(model) {
+        QL_REQUIRE(model_, "null Variance Gamma model given");
+        registerWith(model_);
+    }
+
+    std::complex<Real> VarianceGammaCharacteristicFunction::operator()(
+                                   const std::complex<Real>& u, Time t) const {
+        const Real sigma = model_->sigma();
+        const Real nu    = model_->nu();
+        const Real theta = model_->theta();
+
+        const std::complex<Real> i1(0.0, 1.0);
+        const Real omega =
+            std::log(1.0 - theta*nu - sigma*sigma*nu/2.0)/nu;
+
+        return std::exp(i1*u*omega*t)
+            * std::pow(1.0 - i1*theta*nu*u + sigma*sigma*nu*u*u/2.0,
+                       -t/nu);
+    }
+
+}
@@ -0,0 +1,45 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file variancegammacharacteristicfunction.hpp
+    \brief characteristic function of the Variance Gamma model
+*/
+
+#ifndef quantlib_variance_gamma_characteristic_function_hpp
+#define quantlib_variance_gamma_characteristic_function_hpp
+
+#include <ql/experimental/variancegamma/variancegammamodel.hpp>
+#include <ql/pricingengines/vanilla/carrmadanfftengine.hpp>
+
+namespace QuantLib {
+
+    //! characteristic function of the Variance Gamma model
+    /*! To be used with the CarrMadanFFTEngine. */
+    class VarianceGammaCharacteristicFunction
+        : public ForwardCharacteristicFunction {
+      public:
+        explicit VarianceGammaCharacteristicFunction(
+                             const ext::shared_ptr<VarianceGammaModel>& model);
+        std::complex<Real> operator()(const std::complex<Real>& u,
+                                      Time t) const;
+      private:
+        ext::shared_ptr<VarianceGammaModel> model_;
+    };
+
+}
+
+#endif
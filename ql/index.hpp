@@ -91,43 +91,34 @@ namespace QuantLib {
                         ValueIterator vBegin,
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
-            std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
-            bool noInvalidFixing = true, noDuplicatedFixing = true;
-            Date invalidDate, duplicatedDate;
-            Real nullValue = Null<Real>();
+            IndexManager& manager = IndexManager::instance();
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            bool noInvalidFixing = true;
+            Date invalidDate;
             Real invalidValue = Null<Real>();
-            Real duplicatedValue = Null<Real>();
             while (dBegin != dEnd) {
-                bool validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
-                bool missingFixing = forceOverwrite || currentValue == nullValue;
-                if (validFixing) {
-                    if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
-                    else if (close(currentValue,*(vBegin))) {
-                        ++dBegin;
-                        ++vBegin;
-                    } else {
-                        noDuplicatedFixing = false;
-                        duplicatedDate = *(dBegin++);
-                        duplicatedValue = *(vBegin++);
-                    }
+                if (isValidFixingDate(*dBegin)) {
+                    dates.push_back(*(dBegin++));
+                    values.push_back(*(vBegin++));
                 } else {
                     noInvalidFixing = false;
                     invalidDate = *(dBegin++);
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            Size handle = manager.handle(name());
+            std::vector<Size> duplicated =
+                manager.addFixings(handle, dates, values, forceOverwrite);
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
                        ", " << invalidValue);
-            QL_REQUIRE(noDuplicatedFixing,
+            QL_REQUIRE(duplicated.empty(),
                        "At least one duplicated fixing provided: " <<
-                       duplicatedDate << ", " << duplicatedValue <<
-                       " while " << h[duplicatedDate] <<
+                       dates[duplicated.back()] << ", " <<
+                       values[duplicated.back()] << " while " <<
+                       manager.fixing(handle, dates[duplicated.back()]) <<
                        " value is already present");
         }
         //! clears all stored historical fixings
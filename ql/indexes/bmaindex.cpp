@@ -48,6 +48,10 @@ namespace QuantLib {
                         fixingCalendar,
                         ActualActual(ActualActual::ISDA)),
       termStructure_(h) {
+        // the fixings are stored under the plain family name
+        name_ = "BMA";
+        handle_ = IndexManager::instance().handle(name_);
+        registerWith(IndexManager::instance().notifier(handle_));
         registerWith (h);
     }
 
@@ -48,7 +48,6 @@ namespace QuantLib {
         //@{
         /*! BMA is fixed weekly on Wednesdays.
         */
-        std::string name() const { return "BMA"; }
         bool isValidFixingDate(const Date& fixingDate) const;
         //@}
         //! \name Inspectors
@@ -27,45 +27,312 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <ql/math/comparison.hpp>
+#include <algorithm>
+
 using boost::algorithm::to_upper_copy;
 using std::string;
 
 namespace QuantLib {
 
+    namespace {
+
+        class date_position_less {
+          public:
+            explicit date_position_less(const std::vector<Date>& dates)
+            : dates_(dates) {}
+            bool operator()(Size i, Size j) const {
+                return dates_[i] < dates_[j];
+            }
+          private:
+            const std::vector<Date>& dates_;
+        };
+
+        const TimeSeries<Real>& emptyHistory() {
+            static const TimeSeries<Real> empty;
+            return empty;
+        }
+
+        // number of changes tracked for each index
+        const Size loggedChanges = 256;
+
+    }
+
+    IndexManager::Entry& IndexManager::entry(Size handle) const {
+        QL_REQUIRE(handle < entries_.size(),
+                   "invalid index handle (" << handle << ")");
+        return entries_[handle];
+    }
+
+    Size IndexManager::find(const string& name) const {
+        std::map<string, Size>::const_iterator i =
+            handles_.find(to_upper_copy(name));
+        return i != handles_.end() ? i->second : Null<Size>();
+    }
+
+    Size IndexManager::handle(const string& name) const {
+        string tag = to_upper_copy(name);
+        std::map<string, Size>::const_iterator i = handles_.find(tag);
+        if (i != handles_.end())
+            return i->second;
+
+        Entry e;
+        e.name = tag;
+        e.stored = false;
+        e.revision = 0;
+        e.notifier = ext::make_shared<Observable>();
+        e.firstLoggedRevision = 0;
+        entries_.push_back(e);
+        handles_[tag] = entries_.size()-1;
+        return entries_.size()-1;
+    }
+
+    void IndexManager::record(Entry& e, const Date& firstChangedDate) {
+        ++e.revision;
+        e.changes.push_back(firstChangedDate);
+        if (e.changes.size() > 2*loggedChanges) {
+            e.changes.erase(e.changes.begin(),
+                            e.changes.begin() + loggedChanges);
+            e.firstLoggedRevision += loggedChanges;
+        }
+    }
+
+    void IndexManager::refreshView(const Entry& e) {
+        // references to the view might be held, so it is rebuilt
+        // in place and only if it was ever requested
+        if (e.timeSeries)
+            *e.timeSeries = TimeSeries<Real>(e.dates.begin(), e.dates.end(),
+                                             e.values.begin());
+    }
+
+    void IndexManager::update(Entry& e, const Date& firstChangedDate) {
+        e.stored = true;
+        record(e, firstChangedDate);
+        refreshView(e);
+        e.notifier->notifyObservers();
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        Size h = find(name);
+        return h != Null<Size>() && entries_[h].stored;
+    }
+
+    bool IndexManager::hasHistory(Size handle) const {
+        return entry(handle).stored;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        Size h = find(name);
+        if (h == Null<Size>())
+            return emptyHistory();
+
+        const Entry& e = entries_[h];
+        if (!e.timeSeries) {
+            e.timeSeries = ext::make_shared<TimeSeries<Real> >();
+            refreshView(e);
+        }
+        return *e.timeSeries;
     }
 
     void IndexManager::setHistory(const string& name,
                                   const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+        setHistory(handle(name), history.dates(), history.values());
+    }
+
+    void IndexManager::setHistory(Size handle,
+                                  const std::vector<Date>& dates,
+                                  const std::vector<Real>& values) {
+        std::vector<Date> newDates(dates);
+        std::vector<Real> newValues(values);
+        swapHistory(handle, newDates, newValues);
+    }
+
+    void IndexManager::swapHistory(Size handle,
+                                   std::vector<Date>& dates,
+                                   std::vector<Real>& values) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "size mismatch between dates (" << dates.size()
+                   << ") and values (" << values.size() << ")");
+        for (Size i=1; i<dates.size(); ++i)
+            QL_REQUIRE(dates[i-1] < dates[i],
+                       "fixing dates not sorted or duplicated: "
+                       << dates[i-1] << ", " << dates[i]);
+
+        Entry& e = entry(handle);
+
+        // the earliest date whose fixing differs
+        Size k = 0;
+        while (k < dates.size() && k < e.dates.size()
+               && dates[k] == e.dates[k] && values[k] == e.values[k])
+            ++k;
+        Date changed;
+        if (k < dates.size() && k < e.dates.size())
+            changed = std::min(dates[k], e.dates[k]);
+        else if (k < dates.size())
+            changed = dates[k];
+        else if (k < e.dates.size())
+            changed = e.dates[k];
+
+        e.dates.swap(dates);
+        e.values.swap(values);
+        update(e, changed);
+    }
+
+    std::vector<Size> IndexManager::addFixings(
+                                         Size handle,
+                                         const std::vector<Date>& dates,
+                                         const std::vector<Real>& values,
+                                         bool forceOverwrite) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "size mismatch between dates (" << dates.size()
+                   << ") and values (" << values.size() << ")");
+        Entry& e = entry(handle);
+        std::vector<Size> conflicts;
+
+        std::vector<Size> order(dates.size());
+        for (Size i=0; i<order.size(); ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         date_position_less(dates));
+
+        // when all new dates follow the stored ones, the stored arrays
+        // are extended in place; otherwise the two are merged
+        std::vector<Date> newDates;
+        std::vector<Real> newValues;
+        if (e.dates.empty() || order.empty()
+            || e.dates.back() < dates[order.front()]) {
+            newDates.swap(e.dates);
+            newValues.swap(e.values);
+        } else {
+            newDates.reserve(e.dates.size() + dates.size());
+            newValues.reserve(e.dates.size() + dates.size());
+        }
+
+        // the new dates are visited in increasing order, so the
+        // first change found is the earliest one
+        const Real nullValue = Null<Real>();
+        Date changed;
+        Size j = 0;
+        for (Size k=0; k<order.size(); ++k) {
+            const Date& d = dates[order[k]];
+            const Real v = values[order[k]];
+            while (j < e.dates.size() && !(d < e.dates[j])) {
+                newDates.push_back(e.dates[j]);
+                newValues.push_back(e.values[j]);
+                ++j;
+            }
+            if (newDates.empty() || newDates.back() < d) {
+                newDates.push_back(d);
+                newValues.push_back(v);
+                if (changed == Date())
+                    changed = d;
+            } else {
+                Real& current = newValues.back();
+                if (forceOverwrite || current == nullValue) {
+                    if (current != v && changed == Date())
+                        changed = d;
+                    current = v;
+                } else if (!close(current, v)) {
+                    conflicts.push_back(order[k]);
+                }
+            }
+        }
+        newDates.insert(newDates.end(), e.dates.begin()+j, e.dates.end());
+        newValues.insert(newValues.end(), e.values.begin()+j, e.values.end());
+        e.dates.swap(newDates);
+        e.values.swap(newValues);
+
+        update(e, changed);
+        std::sort(conflicts.begin(), conflicts.end());
+        return conflicts;
+    }
+
+    Real IndexManager::fixing(const string& name, const Date& date) const {
+        Size h = find(name);
+        return h != Null<Size>() ? fixing(h, date) : Null<Real>();
+    }
+
+    Real IndexManager::fixing(Size handle, const Date& date) const {
+        const Entry& e = entry(handle);
+        std::vector<Date>::const_iterator i =
+            std::lower_bound(e.dates.begin(), e.dates.end(), date);
+        if (i != e.dates.end() && *i == date)
+            return e.values[i - e.dates.begin()];
+        else
+            return Null<Real>();
+    }
+
+    const std::vector<Date>& IndexManager::fixingDates(Size handle) const {
+        return entry(handle).dates;
+    }
+
+    const std::vector<Real>& IndexManager::fixingValues(Size handle) const {
+        return entry(handle).values;
     }
 
     ext::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return entry(handle(name)).notifier;
+    }
+
+    ext::shared_ptr<Observable> IndexManager::notifier(Size handle) const {
+        return entry(handle).notifier;
+    }
+
+    Size IndexManager::revision(Size handle) const {
+        return entry(handle).revision;
+    }
+
+    Date IndexManager::firstChangedDate(Size handle,
+                                        Size sinceRevision) const {
+        const Entry& e = entry(handle);
+        QL_REQUIRE(sinceRevision <= e.revision,
+                   "revision " << sinceRevision << " not reached yet");
+        if (sinceRevision < e.firstLoggedRevision)
+            return Date::minDate();
+
+        Date result;
+        for (Size k = sinceRevision - e.firstLoggedRevision;
+             k < e.changes.size(); ++k) {
+            const Date& d = e.changes[k];
+            if (d != Date() && (result == Date() || d < result))
+                result = d;
+        }
+        return result;
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
-        temp.reserve(data_.size());
-        for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+        temp.reserve(handles_.size());
+        for (std::map<string, Size>::const_iterator i=handles_.begin();
+             i!=handles_.end(); ++i)
+            if (entries_[i->second].stored)
+                temp.push_back(i->first);
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        Size h = find(name);
+        if (h != Null<Size>()) {
+            Entry& e = entries_[h];
+            record(e, e.dates.empty() ? Date() : e.dates.front());
+            std::vector<Date>().swap(e.dates);
+            std::vector<Real>().swap(e.values);
+            e.stored = false;
+            refreshView(e);
+        }
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        for (Size h=0; h<entries_.size(); ++h) {
+            Entry& e = entries_[h];
+            record(e, e.dates.empty() ? Date() : e.dates.front());
+            std::vector<Date>().swap(e.dates);
+            std::vector<Real>().swap(e.values);
+            e.stored = false;
+            refreshView(e);
+        }
     }
 
 }
@@ -27,35 +27,124 @@
 #include <ql/timeseries.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <deque>
 
 
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! Fixings are stored per index as sorted arrays of dates and
+        values, so that lookups are binary searches and histories can
+        be loaded or extended in bulk.  Index names are interned; the
+        handle returned by handle() stays valid for the lifetime of
+        the repository and allows repeated lookups without comparing
+        strings.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
         IndexManager() {}
       public:
+        //! \name Name-based interface
+        //@{
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
         //! returns the (possibly empty) history of the index fixings
+        /*! \note the returned time series is built from the stored
+                  arrays when first requested, and is then kept in
+                  sync with them; therefore, once it was requested,
+                  each change to the fixings of the index rebuilds
+                  it.  fixing() should be preferred for single
+                  lookups.
+        */
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
         //! observer notifying of changes in the index fixings
         ext::shared_ptr<Observable> notifier(const std::string& name) const;
+        //! returns the stored fixing, or Null<Real>() if missing
+        Real fixing(const std::string& name, const Date& date) const;
         //! returns all names of the indexes for which fixings were stored
         std::vector<std::string> histories() const;
         //! clears the historical fixings of the index
         void clearHistory(const std::string& name);
         //! clears all stored fixings
         void clearHistories();
+        //@}
+        //! \name Handle-based interface
+        //@{
+        //! returns the handle of the index, registering it if needed
+        Size handle(const std::string& name) const;
+        bool hasHistory(Size handle) const;
+        //! returns the stored fixing, or Null<Real>() if missing
+        Real fixing(Size handle, const Date& date) const;
+        //! sorted fixing dates
+        const std::vector<Date>& fixingDates(Size handle) const;
+        //! fixing values corresponding to fixingDates()
+        const std::vector<Real>& fixingValues(Size handle) const;
+        ext::shared_ptr<Observable> notifier(Size handle) const;
+        //! number of changes to the fixings of the index
+        /*! This allows cached results depending on the fixings to
+            be checked for validity without observing the notifier.
+        */
+        Size revision(Size handle) const;
+        //! earliest date whose fixing changed after the given revision
+        /*! This allows cached results depending on the fixings up to
+            a given date to be kept when later fixings are added.  A
+            null date is returned if no fixing changed.  Only the
+            latest changes are tracked; Date::minDate() is returned
+            for revisions older than those.
+        */
+        Date firstChangedDate(Size handle, Size sinceRevision) const;
+        //! replaces the history of the index
+        /*! the dates must be strictly increasing. */
+        void setHistory(Size handle,
+                        const std::vector<Date>& dates,
+                        const std::vector<Real>& values);
+        //! replaces the history of the index without copying it
+        /*! The given arrays are swapped with the stored ones and
+            therefore hold the previous history on return.  The
+            dates must be strictly increasing.
+        */
+        void swapHistory(Size handle,
+                         std::vector<Date>& dates,
+                         std::vector<Real>& values);
+        //! merges the given fixings into the history of the index
+        /*! The dates need not be sorted.  An existing fixing is
+            replaced if forceOverwrite is true or if it is null;
+            otherwise, the new value is discarded and, unless it is
+            close to the stored one, its position in the input is
+            returned.  Observers are notified in any case.
+        */
+        std::vector<Size> addFixings(Size handle,
+                                     const std::vector<Date>& dates,
+                                     const std::vector<Real>& values,
+                                     bool forceOverwrite = false);
+        //@}
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
-        mutable history_map data_;
+        struct Entry {
+            std::string name;
+            bool stored;
+            Size revision;
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            ext::shared_ptr<Observable> notifier;
+            mutable ext::shared_ptr<TimeSeries<Real> > timeSeries;
+            // earliest changed date of the latest revisions; the
+            // first one is for revision firstLoggedRevision+1
+            std::vector<Date> changes;
+            Size firstLoggedRevision;
+        };
+        Entry& entry(Size handle) const;
+        Size find(const std::string& name) const;
+        void record(Entry&, const Date& firstChangedDate);
+        void update(Entry&, const Date& firstChangedDate);
+        static void refreshView(const Entry&);
+        // a deque keeps references to the entries valid while adding
+        mutable std::deque<Entry> entries_;
+        mutable std::map<std::string, Size> handles_;
     };
 
 }
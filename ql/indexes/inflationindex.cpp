@@ -35,11 +35,16 @@ namespace QuantLib {
       frequency_(frequency), availabilityLag_(availabilityLag),
       currency_(currency) {
         name_ = region_.name() + " " + familyName_;
+        handle_ = IndexManager::instance().handle(name_);
         registerWith(Settings::instance().evaluationDate());
-        registerWith(IndexManager::instance().notifier(name()));
+        registerWith(IndexManager::instance().notifier(handle_));
     }
 
 
+    Real InflationIndex::storedFixing(const Date& fixingDate) const {
+        return IndexManager::instance().fixing(handle_, fixingDate);
+    }
+
     Calendar InflationIndex::fixingCalendar() const {
         static NullCalendar c;
         return c;
@@ -81,8 +86,7 @@ namespace QuantLib {
                                     bool /*forecastTodaysFixing*/) const {
         if (!needsForecast(aFixingDate)) {
             std::pair<Date,Date> lim = inflationPeriod(aFixingDate, frequency_);
-            const TimeSeries<Real>& ts = timeSeries();
-            Real pastFixing = ts[lim.first];
+            Real pastFixing = storedFixing(lim.first);
             QL_REQUIRE(pastFixing != Null<Real>(),
                        "Missing " << name() << " fixing for " << lim.first);
             Real theFixing = pastFixing;
@@ -92,7 +96,7 @@ namespace QuantLib {
                     // we don't actually need the next fixing
                     theFixing = pastFixing;
                 } else {
-                    Real pastFixing2 = ts[lim.second+1];
+                    Real pastFixing2 = storedFixing(lim.second+1);
                     QL_REQUIRE(pastFixing2 != Null<Real>(),
                                "Missing " << name() << " fixing for " << lim.second+1);
 
@@ -145,7 +149,7 @@ namespace QuantLib {
             // we're not sure, but the fixing might be there so we
             // check.  Todo: check which fixings are not possible, to
             // avoid using fixings in the future
-            Real f = timeSeries()[latestNeededDate];
+            Real f = storedFixing(latestNeededDate);
             return (f == Null<Real>());
         }
     }
@@ -228,7 +232,6 @@ namespace QuantLib {
 
         // four cases with ratio() and interpolated()
 
-        const TimeSeries<Real>& ts = timeSeries();
         if (ratio()) {
 
             if(interpolated()){ // IS ratio, IS interpolated
@@ -243,20 +246,19 @@ namespace QuantLib {
                 Real dlBef = fixMinus1Y - limBef.first;
                 // get the four relevant fixings
                 // recall that they are stored flat for every day
-                Rate limFirstFix = ts[lim.first];
+                Rate limFirstFix = storedFixing(lim.first);
                 QL_REQUIRE(limFirstFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << lim.first );
-                Rate limSecondFix = ts[lim.second+1];
+                Rate limSecondFix = storedFixing(lim.second+1);
                 QL_REQUIRE(limSecondFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << lim.second+1 );
-                Rate limBefFirstFix = ts[limBef.first];
+                Rate limBefFirstFix = storedFixing(limBef.first);
                 QL_REQUIRE(limBefFirstFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << limBef.first );
-                Rate limBefSecondFix =
-                IndexManager::instance().getHistory(name())[limBef.second+1];
+                Rate limBefSecondFix = storedFixing(limBef.second+1);
                 QL_REQUIRE(limBefSecondFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << limBef.second+1 );
@@ -268,12 +270,12 @@ namespace QuantLib {
                 return wasYES;
 
             } else {    // IS ratio, NOT interpolated
-                Rate pastFixing = ts[fixingDate];
+                Rate pastFixing = storedFixing(fixingDate);
                 QL_REQUIRE(pastFixing != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << fixingDate);
                 Date previousDate = fixingDate - 1*Years;
-                Rate previousFixing = ts[previousDate];
+                Rate previousFixing = storedFixing(previousDate);
                 QL_REQUIRE(previousFixing != Null<Rate>(),
                            "Missing " << name() << " fixing for "
                            << previousDate );
@@ -288,11 +290,11 @@ namespace QuantLib {
                 std::pair<Date,Date> lim = inflationPeriod(fixingDate, frequency_);
                 Real dp= lim.second + 1 - lim.first;
                 Real dl = fixingDate-lim.first;
-                Rate limFirstFix = ts[lim.first];
+                Rate limFirstFix = storedFixing(lim.first);
                 QL_REQUIRE(limFirstFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << lim.first );
-                Rate limSecondFix = ts[lim.second+1];
+                Rate limSecondFix = storedFixing(lim.second+1);
                 QL_REQUIRE(limSecondFix != Null<Rate>(),
                             "Missing " << name() << " fixing for "
                             << lim.second+1 );
@@ -303,7 +305,7 @@ namespace QuantLib {
             } else { // NOT ratio, NOT interpolated
                     // so just flat
 
-                Rate pastFixing = ts[fixingDate];
+                Rate pastFixing = storedFixing(fixingDate);
                 QL_REQUIRE(pastFixing != Null<Rate>(),
                            "Missing " << name() << " fixing for "
                            << fixingDate);
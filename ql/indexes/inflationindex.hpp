@@ -128,8 +128,11 @@ namespace QuantLib {
         Frequency frequency_;
         Period availabilityLag_;
         Currency currency_;
+        //! stored fixing for the given date, or Null<Real>() if missing
+        Real storedFixing(const Date& fixingDate) const;
       private:
         std::string name_;
+        Size handle_;
     };
 
 
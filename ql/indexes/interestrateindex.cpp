@@ -53,9 +53,10 @@ namespace QuantLib {
         }
         out << " " << dayCounter_.name();
         name_ = out.str();
+        handle_ = IndexManager::instance().handle(name_);
 
         registerWith(Settings::instance().evaluationDate());
-        registerWith(IndexManager::instance().notifier(name()));
+        registerWith(IndexManager::instance().notifier(handle_));
     }
 
     Rate InterestRateIndex::fixing(const Date& fixingDate,
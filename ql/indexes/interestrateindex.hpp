@@ -89,6 +89,8 @@ namespace QuantLib {
         Currency currency_;
         DayCounter dayCounter_;
         std::string name_;
+        //! handle of name_ in the IndexManager
+        Size handle_;
       private:
         Calendar fixingCalendar_;
     };
@@ -127,7 +129,7 @@ namespace QuantLib {
     inline Rate InterestRateIndex::pastFixing(const Date& fixingDate) const {
         QL_REQUIRE(isValidFixingDate(fixingDate),
                    fixingDate << " is not a valid fixing date");
-        return timeSeries()[fixingDate];
+        return IndexManager::instance().fixing(handle_, fixingDate);
     }
 
 }
@@ -82,6 +82,7 @@ namespace QuantLib {
                                       weights_.end(),
                                       a.begin(), 0.0);
         }
+        const Array& weights() const { return weights_; }
       private:
         Array weights_;
     };
@@ -23,6 +23,7 @@
 #include <ql/instruments/impliedvolatility.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/exercise.hpp>
 #include <boost/scoped_ptr.hpp>
 
@@ -44,6 +45,33 @@ namespace QuantLib {
 
         QL_REQUIRE(!isExpired(), "option expired");
 
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff_);
+        if (exercise_->type() == Exercise::European && payoff) {
+            // no need to reprice the option: the Black formula is
+            // inverted directly, with the same inputs that the
+            // analytic engine would use
+            const Date maturity = exercise_->lastDate();
+            const DiscountFactor riskFreeDiscount =
+                process->riskFreeRate()->discount(maturity);
+            const DiscountFactor dividendDiscount =
+                process->dividendYield()->discount(maturity);
+            const Real forward = process->stateVariable()->value()
+                * dividendDiscount / riskFreeDiscount;
+            const Time t =
+                process->blackVolatility()->timeFromReference(maturity);
+            QL_REQUIRE(t > 0.0, "null time to maturity");
+
+            const Volatility vol = blackFormulaImpliedStdDevHouseholder(
+                      payoff, forward, targetValue, riskFreeDiscount)
+                / std::sqrt(t);
+            QL_REQUIRE(vol >= minVol && vol <= maxVol,
+                       "implied volatility (" << vol
+                       << ") outside the allowed range ["
+                       << minVol << ", " << maxVol << "]");
+            return vol;
+        }
+
         ext::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
 
         ext::shared_ptr<GeneralizedBlackScholesProcess> newProcess =
@@ -47,6 +47,13 @@ namespace QuantLib {
                      with any other methods (such as jump-diffusion
                      models.)
 
+            \note for European options with a plain-vanilla payoff,
+                  the Black formula is inverted directly (see
+                  blackFormulaImpliedStdDevHouseholder) and the
+                  result is accurate to machine precision; the
+                  accuracy and maxEvaluations parameters are
+                  only used for other options.
+
             \warning options with a gamma that changes sign (e.g.,
                      binary options) have values that are <b>not</b>
                      monotonic in the volatility. In these cases, the
@@ -4,6 +4,10 @@
 #include <ql/math/matrixutilities/basisincompleteordered.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/csrbicgstab.hpp>
+#include <ql/math/matrixutilities/csrgmres.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/matrixutilities/csrpreconditioner.hpp>
 #include <ql/math/matrixutilities/factorreduction.hpp>
 #include <ql/math/matrixutilities/getcovariance.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
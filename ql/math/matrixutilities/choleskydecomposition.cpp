@@ -63,4 +63,31 @@ namespace QuantLib {
         return result;
     }
 
+    const Disposable<Array> CholeskySolveFor(const Matrix& L,
+                                             const Array& b) {
+        const Size n = b.size();
+
+        QL_REQUIRE(L.rows() == n && L.columns() == n,
+                   "size of input vector (" << n << ") does not match "
+                   "the size of the Cholesky factor ("
+                   << L.rows() << "x" << L.columns() << ")");
+
+        Array x(n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(L[i][i] > 0.0, "singular Cholesky factor");
+            Real sum = b[i];
+            for (Size k=0; k<i; ++k)
+                sum -= L[i][k]*x[k];
+            x[i] = sum/L[i][i];
+        }
+        for (Integer i=Integer(n)-1; i>=0; --i) {
+            Real sum = x[i];
+            for (Size k=i+1; k<n; ++k)
+                sum -= L[k][i]*x[k];
+            x[i] = sum/L[i][i];
+        }
+
+        return x;
+    }
+
 }
@@ -25,6 +25,7 @@
 #define quantlib_cholesky_decomposition_hpp
 
 #include <ql/math/matrix.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
 
@@ -32,6 +33,11 @@ namespace QuantLib {
     const Disposable<Matrix> CholeskyDecomposition(const Matrix& m,
                                                    bool flexible = false);
 
+    //! solves L L^T x = b given the lower triangular Cholesky factor L
+    /*! \relates Matrix */
+    const Disposable<Array> CholeskySolveFor(const Matrix& L,
+                                             const Array& b);
+
 }
 
 
@@ -0,0 +1,136 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrbicgstab.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+        Real dot(const Array& a, const Array& b) {
+            Real sum = 0.0;
+            for (Size i=0; i < a.size(); ++i)
+                sum += a[i]*b[i];
+            return sum;
+        }
+    }
+
+    CSRBiCGstab::CSRBiCGstab(
+                    const CSRMatrix& A, Size maxIter, Real relTol,
+                    const ext::shared_ptr<CSRPreconditioner>& preconditioner)
+    : A_(A), M_(preconditioner), maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(A_.rows() == A_.columns(),
+                   "BiCGstab requires a square matrix");
+    }
+
+    BiCGStabResult CSRBiCGstab::solve(const Array& b, const Array& x0) const {
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        Real error;
+        const Size iterations = solveImpl(b, x, error);
+
+        BiCGStabResult result = { iterations, error, x };
+        return result;
+    }
+
+    Size CSRBiCGstab::solveInPlace(const Array& b, Array& x) const {
+        Real error;
+        return solveImpl(b, x, error);
+    }
+
+    void CSRBiCGstab::precondition(const Array& r, Array& z) const {
+        if (M_)
+            M_->apply(r, z);
+        else
+            std::copy(r.begin(), r.end(), z.begin());
+    }
+
+    Size CSRBiCGstab::solveImpl(const Array& b, Array& x, Real& error) const {
+        const Size n = A_.rows();
+        QL_REQUIRE(b.size() == n && x.size() == n,
+                   "inconsistent vector sizes");
+
+        const Real bnorm2 = std::sqrt(dot(b, b));
+        if (bnorm2 == 0.0) {
+            std::fill(x.begin(), x.end(), 0.0);
+            error = 0.0;
+            return 0;
+        }
+
+        if (r_.size() != n) {
+            r_ = rTld_ = p_ = pTld_ = v_ = s_ = sTld_ = t_ = Array(n);
+        }
+
+        A_.apply(x, t_);
+        for (Size k=0; k < n; ++k)
+            r_[k] = b[k] - t_[k];
+        std::copy(r_.begin(), r_.end(), rTld_.begin());
+
+        Real omega = 1.0;
+        Real rho, rhoTld=1.0;
+        Real alpha = 0.0, beta;
+        error = std::sqrt(dot(r_, r_))/bnorm2;
+
+        Size i;
+        for (i=0; i < maxIter_ && error >= relTol_; ++i) {
+            rho = dot(rTld_, r_);
+            if (rho == 0.0 || omega == 0.0)
+                break;
+
+            if (i) {
+                beta = (rho/rhoTld)*(alpha/omega);
+                for (Size k=0; k < n; ++k)
+                    p_[k] = r_[k] + beta*(p_[k] - omega*v_[k]);
+            }
+            else {
+                std::copy(r_.begin(), r_.end(), p_.begin());
+            }
+
+            precondition(p_, pTld_);
+            A_.apply(pTld_, v_);
+
+            alpha = rho/dot(rTld_, v_);
+            for (Size k=0; k < n; ++k)
+                s_[k] = r_[k] - alpha*v_[k];
+
+            const Real snorm2 = std::sqrt(dot(s_, s_));
+            if (snorm2 < relTol_*bnorm2) {
+                for (Size k=0; k < n; ++k)
+                    x[k] += alpha*pTld_[k];
+                error = snorm2/bnorm2;
+                ++i;
+                break;
+            }
+
+            precondition(s_, sTld_);
+            A_.apply(sTld_, t_);
+            omega = dot(t_, s_)/dot(t_, t_);
+            for (Size k=0; k < n; ++k) {
+                x[k] += alpha*pTld_[k] + omega*sTld_[k];
+                r_[k] = s_[k] - omega*t_[k];
+            }
+            error = std::sqrt(dot(r_, r_))/bnorm2;
+            rhoTld = rho;
+        }
+
+        // converging on the last allowed iteration is fine
+        QL_REQUIRE(error < relTol_, "could not converge");
+
+        return i;
+    }
+
+}
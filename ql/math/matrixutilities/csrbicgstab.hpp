@@ -0,0 +1,64 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrbicgstab.hpp
+    \brief bi-conjugated gradient stabilized algorithm for CSR matrices
+*/
+
+#ifndef quantlib_csr_bicgstab_hpp
+#define quantlib_csr_bicgstab_hpp
+
+#include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrpreconditioner.hpp>
+
+namespace QuantLib {
+
+    //! BiCGstab for sparse matrices in CSR storage
+    /*! Same algorithm as BiCGstab, but the matrix and the
+        preconditioner are applied in place and the work vectors are
+        allocated once and reused by subsequent solves.  solveInPlace()
+        performs no allocation once the work vectors exist.
+
+        \warning the work vectors make concurrent calls to solve() on
+                 the same instance unsafe; use one solver per thread.
+    */
+    class CSRBiCGstab {
+      public:
+        CSRBiCGstab(const CSRMatrix& A, Size maxIter, Real relTol,
+                    const ext::shared_ptr<CSRPreconditioner>& preconditioner
+                        = ext::shared_ptr<CSRPreconditioner>());
+
+        BiCGStabResult solve(const Array& b, const Array& x0 = Array()) const;
+        /*! x holds the initial guess on input and the solution on
+            output; returns the number of iterations.
+        */
+        Size solveInPlace(const Array& b, Array& x) const;
+
+      private:
+        Size solveImpl(const Array& b, Array& x, Real& error) const;
+        void precondition(const Array& r, Array& z) const;
+
+        const CSRMatrix A_;
+        const ext::shared_ptr<CSRPreconditioner> M_;
+        const Size maxIter_;
+        const Real relTol_;
+        mutable Array r_, rTld_, p_, pTld_, v_, s_, sTld_, t_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,179 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrgmres.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+        Real dot(const Array& a, const Array& b) {
+            Real sum = 0.0;
+            for (Size i=0; i < a.size(); ++i)
+                sum += a[i]*b[i];
+            return sum;
+        }
+    }
+
+    CSRGMRES::CSRGMRES(
+                    const CSRMatrix& A, Size maxIter, Real relTol,
+                    const ext::shared_ptr<CSRPreconditioner>& preconditioner)
+    : A_(A), M_(preconditioner), maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(A_.rows() == A_.columns(),
+                   "GMRES requires a square matrix");
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater then zero");
+    }
+
+    GMRESResult CSRGMRES::solve(const Array& b, const Array& x0) const {
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+        std::list<Real> errors;
+        Real error;
+        solveImpl(b, x, error, &errors);
+
+        GMRESResult result = { errors, x };
+        return result;
+    }
+
+    Size CSRGMRES::solveInPlace(const Array& b, Array& x) const {
+        Real error;
+        return solveImpl(b, x, error, 0);
+    }
+
+    void CSRGMRES::precondition(const Array& r, Array& z) const {
+        if (M_)
+            M_->apply(r, z);
+        else
+            std::copy(r.begin(), r.end(), z.begin());
+    }
+
+    Size CSRGMRES::solveImpl(const Array& b, Array& x, Real& error,
+                             std::list<Real>* errors) const {
+        const Size n = A_.rows();
+        QL_REQUIRE(b.size() == n && x.size() == n,
+                   "inconsistent vector sizes");
+
+        const Real bn = std::sqrt(dot(b, b));
+        if (bn == 0.0) {
+            std::fill(x.begin(), x.end(), 0.0);
+            error = 0.0;
+            if (errors)
+                errors->push_back(error);
+            return 0;
+        }
+
+        if (w_.size() != n) {
+            v_.assign(maxIter_+1, Array(n));
+            h_ = Matrix(maxIter_+1, maxIter_);
+            c_ = s_ = y_ = Array(maxIter_);
+            z_ = Array(maxIter_+1);
+            w_ = tmp_ = Array(n);
+        }
+
+        A_.apply(x, w_);
+        for (Size k=0; k < n; ++k)
+            w_[k] = b[k] - w_[k];
+
+        const Real g = std::sqrt(dot(w_, w_));
+        error = g/bn;
+        if (errors)
+            errors->push_back(error);
+
+        Size m = 0;
+        if (error >= relTol_) {
+            for (Size k=0; k < n; ++k)
+                v_[0][k] = w_[k]/g;
+            std::fill(z_.begin(), z_.end(), 0.0);
+            z_[0] = g;
+
+            for (Size j=0; j < maxIter_ && error >= relTol_; ++j) {
+                precondition(v_[j], tmp_);
+                A_.apply(tmp_, w_);
+
+                // modified Gram-Schmidt
+                for (Size i=0; i <= j; ++i) {
+                    const Real hij = dot(w_, v_[i]);
+                    h_[i][j] = hij;
+                    const Array& vi = v_[i];
+                    for (Size k=0; k < n; ++k)
+                        w_[k] -= hij*vi[k];
+                }
+                h_[j+1][j] = std::sqrt(dot(w_, w_));
+
+                // the Krylov subspace is invariant if the new vector
+                // vanishes; the solution lies in the current basis
+                const bool breakdown = h_[j+1][j] < QL_EPSILON*QL_EPSILON;
+                if (!breakdown) {
+                    for (Size k=0; k < n; ++k)
+                        v_[j+1][k] = w_[k]/h_[j+1][j];
+                }
+
+                for (Size i=0; i < j; ++i) {
+                    const Real h0 = c_[i]*h_[i][j] + s_[i]*h_[i+1][j];
+                    const Real h1 =-s_[i]*h_[i][j] + c_[i]*h_[i+1][j];
+
+                    h_[i][j]   = h0;
+                    h_[i+1][j] = h1;
+                }
+
+                const Real nu = std::sqrt(h_[j][j]*h_[j][j]
+                                          + h_[j+1][j]*h_[j+1][j]);
+
+                c_[j] = h_[j][j]/nu;
+                s_[j] = h_[j+1][j]/nu;
+
+                h_[j][j]   = nu;
+                h_[j+1][j] = 0.0;
+
+                z_[j+1] = -s_[j]*z_[j];
+                z_[j] = c_[j]*z_[j];
+
+                error = std::fabs(z_[j+1]/bn);
+                if (errors)
+                    errors->push_back(error);
+                m = j+1;
+
+                if (breakdown)
+                    break;
+            }
+
+            // back substitution for the coefficients of the basis...
+            for (Integer i=Integer(m)-1; i >= 0; --i) {
+                Real sum = z_[i];
+                for (Size l=i+1; l < m; ++l)
+                    sum -= h_[i][l]*y_[l];
+                y_[i] = sum/h_[i][i];
+            }
+
+            // ...and update of the solution, x += M^{-1} V y
+            std::fill(w_.begin(), w_.end(), 0.0);
+            for (Size i=0; i < m; ++i) {
+                const Array& vi = v_[i];
+                for (Size k=0; k < n; ++k)
+                    w_[k] += y_[i]*vi[k];
+            }
+            precondition(w_, tmp_);
+            for (Size k=0; k < n; ++k)
+                x[k] += tmp_[k];
+        }
+
+        QL_REQUIRE(error < relTol_, "could not converge");
+
+        return m;
+    }
+
+}
@@ -0,0 +1,70 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrgmres.hpp
+    \brief GMRES for sparse matrices in CSR storage
+*/
+
+#ifndef quantlib_csr_gmres_hpp
+#define quantlib_csr_gmres_hpp
+
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/csrpreconditioner.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! GMRES for sparse matrices in CSR storage
+    /*! Same algorithm as GMRES without restarts, i.e., with right
+        preconditioning, but the matrix and the preconditioner are
+        applied in place.  The Krylov basis, the Hessenberg matrix
+        and the other work vectors are allocated once and reused by
+        subsequent solves; solveInPlace() performs no allocation once
+        they exist.  The basis needs storage for maxIter+1 vectors.
+
+        \warning the work vectors make concurrent calls to solve() on
+                 the same instance unsafe; use one solver per thread.
+    */
+    class CSRGMRES {
+      public:
+        CSRGMRES(const CSRMatrix& A, Size maxIter, Real relTol,
+                 const ext::shared_ptr<CSRPreconditioner>& preconditioner
+                     = ext::shared_ptr<CSRPreconditioner>());
+
+        GMRESResult solve(const Array& b, const Array& x0 = Array()) const;
+        /*! x holds the initial guess on input and the solution on
+            output; returns the number of iterations.
+        */
+        Size solveInPlace(const Array& b, Array& x) const;
+
+      private:
+        Size solveImpl(const Array& b, Array& x, Real& error,
+                       std::list<Real>* errors) const;
+        void precondition(const Array& r, Array& z) const;
+
+        const CSRMatrix A_;
+        const ext::shared_ptr<CSRPreconditioner> M_;
+        const Size maxIter_;
+        const Real relTol_;
+        mutable std::vector<Array> v_;
+        mutable Matrix h_;
+        mutable Array c_, s_, z_, y_, w_, tmp_;
+    };
+
+}
+
+#endif
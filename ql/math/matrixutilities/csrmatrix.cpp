@@ -0,0 +1,191 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+        struct column_less {
+            bool operator()(const std::pair<Size, Real>& a,
+                            const std::pair<Size, Real>& b) const {
+                return a.first < b.first;
+            }
+        };
+    }
+
+    CSRMatrix::CSRMatrix()
+    : rows_(0), columns_(0), rowOffsets_(1, 0) {}
+
+    CSRMatrix::CSRMatrix(Size rows, Size columns,
+                         const std::vector<Size>& rowOffsets,
+                         const std::vector<Size>& columnIndices,
+                         const std::vector<Real>& values)
+    : rows_(rows), columns_(columns), rowOffsets_(rows+1, 0) {
+
+        QL_REQUIRE(rowOffsets.size() == rows+1,
+                   "wrong number of row offsets (" << rowOffsets.size()
+                   << ", " << rows+1 << " required)");
+        QL_REQUIRE(rowOffsets.front() == 0
+                   && rowOffsets.back() == columnIndices.size()
+                   && columnIndices.size() == values.size(),
+                   "inconsistent sparse matrix data");
+
+        columnIndices_.reserve(columnIndices.size());
+        values_.reserve(values.size());
+
+        std::vector<std::pair<Size, Real> > row;
+        for (Size i=0; i < rows; ++i) {
+            QL_REQUIRE(rowOffsets[i] <= rowOffsets[i+1],
+                       "decreasing row offsets");
+
+            row.clear();
+            for (Size k=rowOffsets[i]; k < rowOffsets[i+1]; ++k) {
+                QL_REQUIRE(columnIndices[k] < columns,
+                           "column index (" << columnIndices[k]
+                           << ") out of range");
+                row.push_back(std::make_pair(columnIndices[k], values[k]));
+            }
+            std::stable_sort(row.begin(), row.end(), column_less());
+
+            for (Size k=0; k < row.size(); ++k) {
+                if (k > 0 && row[k].first == row[k-1].first)
+                    values_.back() += row[k].second;
+                else {
+                    columnIndices_.push_back(row[k].first);
+                    values_.push_back(row[k].second);
+                }
+            }
+            rowOffsets_[i+1] = values_.size();
+        }
+
+        setDiagonalPositions();
+    }
+
+    CSRMatrix::CSRMatrix(const Matrix& m)
+    : rows_(m.rows()), columns_(m.columns()), rowOffsets_(m.rows()+1, 0) {
+        for (Size i=0; i < rows_; ++i) {
+            for (Size j=0; j < columns_; ++j) {
+                if (m[i][j] != 0.0) {
+                    columnIndices_.push_back(j);
+                    values_.push_back(m[i][j]);
+                }
+            }
+            rowOffsets_[i+1] = values_.size();
+        }
+
+        setDiagonalPositions();
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    CSRMatrix::CSRMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowOffsets_(m.size1()+1, 0) {
+        columnIndices_.reserve(m.nnz());
+        values_.reserve(m.nnz());
+
+        // the iterators visit the stored entries row by row
+        // in increasing column order
+        for (SparseMatrix::const_iterator1 i1 = m.begin1();
+             i1 != m.end1(); ++i1) {
+            for (SparseMatrix::const_iterator2 i2 = i1.begin();
+                 i2 != i1.end(); ++i2) {
+                columnIndices_.push_back(i2.index2());
+                values_.push_back(*i2);
+            }
+            rowOffsets_[i1.index1()+1] = values_.size();
+        }
+        // rows without stored entries are skipped by the iterators
+        for (Size i=1; i <= rows_; ++i)
+            rowOffsets_[i] = std::max(rowOffsets_[i], rowOffsets_[i-1]);
+
+        setDiagonalPositions();
+    }
+#endif
+
+    void CSRMatrix::setDiagonalPositions() {
+        diagonalPositions_.assign(rows_, Null<Size>());
+        for (Size i=0; i < std::min(rows_, columns_); ++i) {
+            const std::vector<Size>::const_iterator begin =
+                columnIndices_.begin() + rowOffsets_[i];
+            const std::vector<Size>::const_iterator end =
+                columnIndices_.begin() + rowOffsets_[i+1];
+            const std::vector<Size>::const_iterator iter =
+                std::lower_bound(begin, end, i);
+            if (iter != end && *iter == i)
+                diagonalPositions_[i] = iter - columnIndices_.begin();
+        }
+    }
+
+    Real CSRMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "index (" << i << ", " << j << ") out of range");
+
+        const std::vector<Size>::const_iterator begin =
+            columnIndices_.begin() + rowOffsets_[i];
+        const std::vector<Size>::const_iterator end =
+            columnIndices_.begin() + rowOffsets_[i+1];
+        const std::vector<Size>::const_iterator iter =
+            std::lower_bound(begin, end, j);
+
+        return (iter != end && *iter == j)
+            ? values_[iter - columnIndices_.begin()] : 0.0;
+    }
+
+    Disposable<Array> CSRMatrix::diagonal() const {
+        Array d(std::min(rows_, columns_), 0.0);
+        for (Size i=0; i < d.size(); ++i)
+            if (diagonalPositions_[i] != Null<Size>())
+                d[i] = values_[diagonalPositions_[i]];
+
+        return d;
+    }
+
+    void CSRMatrix::apply(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "vector size (" << x.size()
+                   << ") does not match the number of columns ("
+                   << columns_ << ")");
+        QL_REQUIRE(y.size() == rows_,
+                   "result size (" << y.size()
+                   << ") does not match the number of rows ("
+                   << rows_ << ")");
+        QL_REQUIRE(&x != &y, "result and argument must be different");
+
+        const Size* offsets = &rowOffsets_[0];
+        const Size* indices = columnIndices_.empty() ? 0 : &columnIndices_[0];
+        const Real* values = values_.empty() ? 0 : &values_[0];
+
+        #pragma omp parallel for if(rows_ >= 4096)
+        for (long i=0; i < (long)rows_; ++i) {
+            Real sum = 0.0;
+            for (Size k=offsets[i]; k < offsets[i+1]; ++k)
+                sum += values[k]*x[indices[k]];
+            y[i] = sum;
+        }
+    }
+
+    Disposable<Array> CSRMatrix::apply(const Array& x) const {
+        Array y(rows_);
+        apply(x, y);
+
+        return y;
+    }
+
+}
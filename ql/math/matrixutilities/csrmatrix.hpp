@@ -0,0 +1,122 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed sparse row storage
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed sparse row (CSR) storage
+    /*! The non-zero entries of row \f$ i \f$ are stored in
+        values()[k] with column index columnIndices()[k] for
+        \f$ rowOffsets()[i] \le k < rowOffsets()[i+1] \f$.  Column
+        indices are sorted within each row.
+
+        Unlike SparseMatrix, the storage is a set of plain vectors;
+        matrix-vector products write into a given array and do not
+        allocate.  Rows are processed in parallel for large matrices
+        if OpenMP is enabled.
+    */
+    class CSRMatrix {
+      public:
+        CSRMatrix();
+        /*! the column indices of each row are sorted and entries
+            with the same indices are summed.
+        */
+        CSRMatrix(Size rows, Size columns,
+                  const std::vector<Size>& rowOffsets,
+                  const std::vector<Size>& columnIndices,
+                  const std::vector<Real>& values);
+        //! non-zero entries of a dense matrix
+        explicit CSRMatrix(const Matrix& m);
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        explicit CSRMatrix(const SparseMatrix& m);
+#endif
+
+        //! \name Inspectors
+        //@{
+        Size rows() const;
+        Size columns() const;
+        Size nonZeros() const;
+        const std::vector<Size>& rowOffsets() const;
+        const std::vector<Size>& columnIndices() const;
+        const std::vector<Real>& values() const;
+        //! position of the diagonal entry of each row, or Null<Size>()
+        const std::vector<Size>& diagonalPositions() const;
+        //! entry (i,j), zero if not stored
+        Real operator()(Size i, Size j) const;
+        Disposable<Array> diagonal() const;
+        //@}
+
+        //! \name Matrix-vector products
+        //@{
+        //! y = A x; y must not be x
+        void apply(const Array& x, Array& y) const;
+        Disposable<Array> apply(const Array& x) const;
+        //@}
+
+      private:
+        void setDiagonalPositions();
+
+        Size rows_, columns_;
+        std::vector<Size> rowOffsets_, columnIndices_;
+        std::vector<Real> values_;
+        std::vector<Size> diagonalPositions_;
+    };
+
+
+    // inline definitions
+
+    inline Size CSRMatrix::rows() const {
+        return rows_;
+    }
+
+    inline Size CSRMatrix::columns() const {
+        return columns_;
+    }
+
+    inline Size CSRMatrix::nonZeros() const {
+        return values_.size();
+    }
+
+    inline const std::vector<Size>& CSRMatrix::rowOffsets() const {
+        return rowOffsets_;
+    }
+
+    inline const std::vector<Size>& CSRMatrix::columnIndices() const {
+        return columnIndices_;
+    }
+
+    inline const std::vector<Real>& CSRMatrix::values() const {
+        return values_;
+    }
+
+    inline const std::vector<Size>& CSRMatrix::diagonalPositions() const {
+        return diagonalPositions_;
+    }
+
+}
+
+#endif
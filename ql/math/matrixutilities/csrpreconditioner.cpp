@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrpreconditioner.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    Disposable<Array> CSRPreconditioner::apply(const Array& r) const {
+        Array z(r.size());
+        apply(r, z);
+
+        return z;
+    }
+
+
+    CSRJacobiPreconditioner::CSRJacobiPreconditioner(const CSRMatrix& A)
+    : inverseDiagonal_(A.diagonal()) {
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "Jacobi preconditioner requires a square matrix");
+
+        for (Size i=0; i < inverseDiagonal_.size(); ++i) {
+            QL_REQUIRE(inverseDiagonal_[i] != 0.0,
+                       "zero diagonal entry in row " << i);
+            inverseDiagonal_[i] = 1.0/inverseDiagonal_[i];
+        }
+    }
+
+    void CSRJacobiPreconditioner::apply(const Array& r, Array& z) const {
+        QL_REQUIRE(r.size() == inverseDiagonal_.size()
+                   && z.size() == inverseDiagonal_.size(),
+                   "inconsistent vector sizes");
+
+        for (Size i=0; i < r.size(); ++i)
+            z[i] = inverseDiagonal_[i]*r[i];
+    }
+
+
+    CSRILU0Preconditioner::CSRILU0Preconditioner(const CSRMatrix& A) {
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "ILU(0) preconditioner requires a square matrix");
+
+        const Size n = A.rows();
+        const std::vector<Size>& offsets = A.rowOffsets();
+        const std::vector<Size>& indices = A.columnIndices();
+        const std::vector<Size>& diagonal = A.diagonalPositions();
+        std::vector<Real> lu = A.values();
+
+        for (Size i=0; i < n; ++i)
+            QL_REQUIRE(diagonal[i] != Null<Size>(),
+                       "missing diagonal entry in row " << i);
+
+        // position of the entries of the current row by column
+        std::vector<Size> position(n, Null<Size>());
+
+        for (Size i=1; i < n; ++i) {
+            for (Size p=offsets[i]; p < offsets[i+1]; ++p)
+                position[indices[p]] = p;
+
+            for (Size p=offsets[i]; p < diagonal[i]; ++p) {
+                const Size k = indices[p];
+                QL_REQUIRE(lu[diagonal[k]] != 0.0,
+                           "zero pivot in row " << k);
+                lu[p] /= lu[diagonal[k]];
+
+                for (Size q=diagonal[k]+1; q < offsets[k+1]; ++q) {
+                    const Size j = position[indices[q]];
+                    if (j != Null<Size>())
+                        lu[j] -= lu[p]*lu[q];
+                }
+            }
+
+            for (Size p=offsets[i]; p < offsets[i+1]; ++p)
+                position[indices[p]] = Null<Size>();
+        }
+        QL_REQUIRE(n == 0 || lu[diagonal[n-1]] != 0.0,
+                   "zero pivot in row " << n-1);
+
+        LU_ = CSRMatrix(n, n, offsets, indices, lu);
+    }
+
+    void CSRILU0Preconditioner::apply(const Array& r, Array& z) const {
+        const Size n = LU_.rows();
+        QL_REQUIRE(r.size() == n && z.size() == n,
+                   "inconsistent vector sizes");
+        QL_REQUIRE(&r != &z, "result and argument must be different");
+
+        const std::vector<Size>& offsets = LU_.rowOffsets();
+        const std::vector<Size>& indices = LU_.columnIndices();
+        const std::vector<Size>& diagonal = LU_.diagonalPositions();
+        const std::vector<Real>& lu = LU_.values();
+
+        // forward substitution with the unit lower triangular factor
+        for (Size i=0; i < n; ++i) {
+            Real sum = r[i];
+            for (Size p=offsets[i]; p < diagonal[i]; ++p)
+                sum -= lu[p]*z[indices[p]];
+            z[i] = sum;
+        }
+
+        // backward substitution with the upper triangular factor
+        for (Size i=n; i > 0; --i) {
+            const Size row = i-1;
+            Real sum = z[row];
+            for (Size p=diagonal[row]+1; p < offsets[row+1]; ++p)
+                sum -= lu[p]*z[indices[p]];
+            z[row] = sum/lu[diagonal[row]];
+        }
+    }
+
+}
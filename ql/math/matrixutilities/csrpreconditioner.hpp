@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrpreconditioner.hpp
+    \brief preconditioners for sparse matrices in CSR storage
+*/
+
+#ifndef quantlib_csr_preconditioner_hpp
+#define quantlib_csr_preconditioner_hpp
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+namespace QuantLib {
+
+    //! preconditioner interface for the CSR Krylov solvers
+    class CSRPreconditioner {
+      public:
+        virtual ~CSRPreconditioner() {}
+        //! z = M^{-1} r; z must not be r
+        virtual void apply(const Array& r, Array& z) const = 0;
+        Disposable<Array> apply(const Array& r) const;
+    };
+
+    //! Jacobi (diagonal) preconditioner
+    class CSRJacobiPreconditioner : public CSRPreconditioner {
+      public:
+        explicit CSRJacobiPreconditioner(const CSRMatrix& A);
+        using CSRPreconditioner::apply;
+        void apply(const Array& r, Array& z) const;
+      private:
+        Array inverseDiagonal_;
+    };
+
+    //! incomplete LU factorization without fill-in
+    /*! The factors \f$ L \f$ (with unit diagonal) and \f$ U \f$ have
+        the sparsity pattern of \f$ A \f$ and are stored in a single
+        CSRMatrix.  All diagonal entries of \f$ A \f$ must be stored.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html, algorithm 10.4
+    */
+    class CSRILU0Preconditioner : public CSRPreconditioner {
+      public:
+        explicit CSRILU0Preconditioner(const CSRMatrix& A);
+        using CSRPreconditioner::apply;
+        void apply(const Array& r, Array& z) const;
+        //! L and U factors with the sparsity pattern of A
+        const CSRMatrix& LU() const;
+      private:
+        CSRMatrix LU_;
+    };
+
+
+    // inline definitions
+
+    inline const CSRMatrix& CSRILU0Preconditioner::LU() const {
+        return LU_;
+    }
+
+}
+
+#endif
@@ -26,6 +26,7 @@
 
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 #include <ql/math/matrix.hpp>
 
 namespace QuantLib {
@@ -139,6 +140,11 @@ namespace QuantLib {
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds the data collected by another statistics tool
+        /*! \pre the underlying statistics class must be mergeable,
+                 as is the case for TDigestStatistics.
+        */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_;
@@ -153,6 +159,8 @@ namespace QuantLib {
     */
     typedef GenericSequenceStatistics<Statistics> SequenceStatistics;
     typedef GenericSequenceStatistics<IncrementalStatistics> SequenceStatisticsInc;
+    typedef GenericSequenceStatistics<TDigestRiskStatistics>
+                                                   SequenceStatisticsTDigest;
 
     // inline definitions
 
@@ -244,6 +252,23 @@ namespace QuantLib {
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                  const GenericSequenceStatistics& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     Disposable<Matrix> GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
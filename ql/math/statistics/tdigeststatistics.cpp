@@ -0,0 +1,269 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_
+                   << ") must be at least 10");
+        bufferSize_ = 5*static_cast<Size>(std::ceil(compression_));
+        reset();
+    }
+
+    Real TDigestStatistics::mean() const {
+        QL_REQUIRE(samples_ != 0, "empty sample set");
+        return mean_;
+    }
+
+    Real TDigestStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1,
+                   "sample number <=1, unsufficient");
+        return (m2_/weightSum_)*N/(N-1.0);
+    }
+
+    Real TDigestStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2,
+                   "sample number <=2, unsufficient");
+
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+
+        return (x/(sigma*sigma*sigma))*(N/(N-1.0))*(N/(N-2.0));
+    }
+
+    Real TDigestStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3,
+                   "sample number <=3, unsufficient");
+
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+
+        Real c1 = (N/(N-1.0)) * (N/(N-2.0)) * ((N+1.0)/(N-3.0));
+        Real c2 = 3.0 * ((N-1.0)/(N-2.0)) * ((N-1.0)/(N-3.0));
+
+        return c1*(x/(sigma2*sigma2))-c2;
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0,
+                   "empty sample set");
+
+        return quantile(percent*weightSum_, false);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0,
+                   "empty sample set");
+
+        return quantile(percent*weightSum_, true);
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight>=0.0, "negative weight not allowed");
+        if (samples_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+        }
+        ++samples_;
+        if (weight > 0.0) {
+            addMoments(weight, value, 0.0, 0.0, 0.0);
+            Centroid c = { value, weight, 1 };
+            buffer_.push_back(c);
+            if (buffer_.size() >= bufferSize_)
+                compress();
+        }
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        if (samples_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+        samples_ += other.samples_;
+        if (other.weightSum_ > 0.0) {
+            addMoments(other.weightSum_, other.mean_,
+                       other.m2_, other.m3_, other.m4_);
+            buffer_.insert(buffer_.end(), other.centroids_.begin(),
+                           other.centroids_.end());
+            buffer_.insert(buffer_.end(), other.buffer_.begin(),
+                           other.buffer_.end());
+            if (buffer_.size() >= bufferSize_)
+                compress();
+        }
+    }
+
+    void TDigestStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = Null<Real>();
+        centroids_ = std::vector<Centroid>();
+        buffer_ = std::vector<Centroid>();
+        buffer_.reserve(bufferSize_);
+    }
+
+    bool TDigestStatistics::lowerMean(const Centroid& c1,
+                                      const Centroid& c2) {
+        return c1.mean < c2.mean;
+    }
+
+    void TDigestStatistics::addMoments(Real wb, Real xb,
+                                       Real m2b, Real m3b, Real m4b) {
+        // pairwise update of the central moments, see Pebay (2008)
+        const Real wa = weightSum_, m2a = m2_, m3a = m3_;
+        const Real w = wa + wb;
+        const Real delta = xb - mean_;
+        const Real d2 = delta*delta;
+
+        mean_ += delta*wb/w;
+        m4_ += m4b + d2*d2*wa*wb*(wa*wa - wa*wb + wb*wb)/(w*w*w)
+            + 6.0*d2*(wa*wa*m2b + wb*wb*m2a)/(w*w)
+            + 4.0*delta*(wa*m3b - wb*m3a)/w;
+        m3_ += m3b + d2*delta*wa*wb*(wa - wb)/(w*w)
+            + 3.0*delta*(wa*m2b - wb*m2a)/w;
+        m2_ += m2b + d2*wa*wb/w;
+        weightSum_ = w;
+    }
+
+    void TDigestStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(), lowerMean);
+        centroids_.clear();
+
+        // no need to merge centroids while they fit into the buffer
+        if (buffer_.size() < bufferSize_) {
+            centroids_.swap(buffer_);
+            return;
+        }
+
+        /* The size of the centroids is limited by the scale function
+               k(q) = \delta/Z \log(q/(1-q)),  Z = 4\log(n/\delta)+24,
+           i.e., each of them can span at most a unit interval in k.
+           Therefore, a centroid starting at q can reach the quantile
+               q' = aq/(1-q+aq),  a = \exp(Z/\delta)
+           which makes it small at both tails and, in particular,
+           keeps the extreme samples as single-sample centroids. */
+        const Real total = weightSum_;
+        const Real Z =
+            4.0*std::log(std::max(samples_/compression_, 1.0)) + 24.0;
+        const Real a = std::exp(Z/compression_);
+
+        Centroid current = buffer_.front();
+        Real weightSoFar = 0.0, q = 0.0, qLimit = 0.0;
+        for (Size i=1; i<buffer_.size(); ++i) {
+            const Centroid& next = buffer_[i];
+            if ((weightSoFar + current.weight + next.weight)/total
+                                                               <= qLimit) {
+                current.weight += next.weight;
+                current.mean += (next.mean - current.mean)
+                                * next.weight/current.weight;
+                current.samples += next.samples;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                current = next;
+                q = weightSoFar/total;
+                qLimit = a*q/(1.0 - q + a*q);
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+    Real TDigestStatistics::quantile(Real target, bool fromTop) const {
+        compress();
+        // for top percentiles, the centroids are visited in reverse
+        // order and the roles of minimum and maximum are swapped
+        if (fromTop)
+            return interpolate(centroids_.rbegin(), centroids_.rend(),
+                               max_, min_, target);
+        else
+            return interpolate(centroids_.begin(), centroids_.end(),
+                               min_, max_, target);
+    }
+
+    template <class Iterator>
+    Real TDigestStatistics::interpolate(Iterator begin, Iterator end,
+                                        Real lowest, Real highest,
+                                        Real target) {
+        // left tail, interpolated from the lowest value
+        const Centroid& first = *begin;
+        if (target < 0.5*first.weight) {
+            if (first.samples == 1)
+                return first.mean;
+            return lowest + (first.mean - lowest)*target/(0.5*first.weight);
+        }
+
+        // between centroids, each of them being centered on the
+        // middle of its cumulated weight; single-sample centroids
+        // are point masses and give back the sample exactly
+        Real cumulated = 0.5*first.weight;
+        Iterator current = begin, next = begin;
+        for (++next; next != end; ++current, ++next) {
+            const Real dw = 0.5*(current->weight + next->weight);
+            if (target <= cumulated + dw) {
+                Real left = cumulated, right = cumulated + dw;
+                if (current->samples == 1) {
+                    left += 0.5*current->weight;
+                    if (target <= left)
+                        return current->mean;
+                }
+                if (next->samples == 1) {
+                    right -= 0.5*next->weight;
+                    if (target >= right)
+                        return next->mean;
+                }
+                return current->mean + (next->mean - current->mean)
+                                       * (target - left)/(right - left);
+            }
+            cumulated += dw;
+        }
+
+        // right tail, interpolated up to the highest value
+        const Centroid& last = *current;
+        if (last.samples == 1)
+            return last.mean;
+        Real x = std::min((target - cumulated)/(0.5*last.weight), 1.0);
+        return last.mean + (highest - last.mean)*x;
+    }
+
+}
+
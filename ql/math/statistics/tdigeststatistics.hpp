@@ -0,0 +1,283 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief bounded-memory statistics tool based on a t-digest
+*/
+
+#ifndef quantlib_tdigest_statistics_hpp
+#define quantlib_tdigest_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Bounded-memory statistics tool
+    /*! This class can be used in place of GeneralStatistics when the
+        number of samples is too large for all of them to be stored.
+        Moments (mean, variance, skewness, kurtosis) are accumulated
+        exactly and in a numerically stable way; the empirical
+        distribution, used for percentiles and for the expectation
+        values on which GenericRiskStatistics relies, is approximated
+        by a merging t-digest, i.e., a sorted set of weighted
+        centroids which are smaller near the tails of the
+        distribution.
+
+        The number of centroids, and therefore the memory used, is
+        bounded by a multiple of the compression parameter
+        \f$ \delta \f$; the error on the quantile \f$ q \f$ is
+        roughly proportional to \f$ q(1-q)/\delta \f$, so that tail
+        percentiles are the most accurate.  Expectation values are
+        less accurate, since the centroid straddling the boundary of
+        the range is either included or excluded as a whole.  The
+        default compression keeps a few hundred centroids and
+        reproduces value-at-risk and expected shortfall of normal
+        samples within a fraction of a percent; a different one can
+        be passed to GenericRiskStatistics through its constructor.
+        As long as fewer than \f$ 5\delta \f$ samples are
+        collected, no centroids are merged and the results are the
+        same as the ones of GeneralStatistics.
+
+        Statistics collected on different threads can be combined
+        by means of the merge() method.
+
+        Samples with null weight are counted but don't contribute
+        to the digest.
+
+        References:
+
+        T. Dunning, O. Ertl, 2019. Computing extremely accurate
+        quantiles using t-digests, arXiv:1902.04023
+
+        P. Pebay, 2008. Formulas for robust, one-pass parallel
+        computation of covariances and arbitrary-order statistical
+        moments, Sandia Report SAND2008-6212
+
+        \test the correctness of the returned values is tested by
+              checking them against GeneralStatistics.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+        explicit TDigestStatistics(Real compression = 500.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, approximated as
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] =
+                \frac{\sum_{c_j \in \mathcal{R}} f(c_j) W_j}{
+                      \sum_{c_j \in \mathcal{R}} W_j} \f]
+            where \f$ c_j \f$ and \f$ W_j \f$ are the mean and the
+            weight of the centroids of the digest.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            std::vector<Centroid>::const_iterator i;
+            for (i=centroids_.begin(); i!=centroids_.end(); ++i) {
+                Real x = i->mean, w = i->weight;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += i->samples;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! \f$ y \f$-th percentile, defined as the value \f$ \bar{x} \f$
+            such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+            and interpolated between the centroids of the digest.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! \f$ y \f$-th top percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+            and interpolated between the centroids of the digest.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+
+        //! compression parameter of the digest
+        Real compression() const;
+
+        //! number of centroids currently used by the digest
+        Size centroids() const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+
+        //! adds the data collected by another statistics tool
+        /*! The moments are combined exactly; the digests are merged
+            and compressed as if their centroids were added one by one.
+        */
+        void merge(const TDigestStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size samples;
+        };
+        static bool lowerMean(const Centroid& c1, const Centroid& c2);
+        void addMoments(Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        void compress() const;
+        Real quantile(Real target, bool fromTop) const;
+        template <class Iterator>
+        static Real interpolate(Iterator begin, Iterator end,
+                                Real lowest, Real highest, Real target);
+
+        Real compression_;
+        Size bufferSize_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_;
+        Real min_, max_;
+        // sorted centroids, and the ones not yet merged into them
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+    //! risk measures based on a bounded-memory digest of the data
+    typedef GenericRiskStatistics<GenericGaussianStatistics<
+                                  TDigestStatistics> > TDigestRiskStatistics;
+
+
+    // inline definitions
+
+    inline Size TDigestStatistics::samples() const {
+        return samples_;
+    }
+
+    inline Real TDigestStatistics::weightSum() const {
+        return weightSum_;
+    }
+
+    inline Real TDigestStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    inline Real TDigestStatistics::errorEstimate() const {
+        return std::sqrt(variance()/samples());
+    }
+
+    inline Real TDigestStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    inline Real TDigestStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    inline Real TDigestStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Size TDigestStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
 
 namespace QuantLib {
 
@@ -42,6 +43,8 @@ namespace QuantLib {
       volTS_ (bsProcess->blackVolatility().currentLink()),
       localVol_((localVol) ? bsProcess->localVolatility().currentLink()
                            : ext::shared_ptr<LocalVolTermStructure>()),
+      griddedLocalVol_(
+          ext::dynamic_pointer_cast<GriddedLocalVolSurface>(localVol_)),
       x_     ((localVol) ? Array(Exp(mesher->locations(direction))) : Array()),
       dxMap_ (FirstDerivativeOp(direction, mesher)),
       dxxMap_(SecondDerivativeOp(direction, mesher)),
@@ -61,22 +64,30 @@ namespace QuantLib {
             const FdmLinearOpIterator endIter = layout->end();
 
             Array v(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
+            if (griddedLocalVol_ && illegalLocalVolOverwrite_ < 0.0) {
+                // whole mesh slice at once from the cached grid
+                v = griddedLocalVol_->localVols(0.5*(t1+t2), x_);
+                for (Size i=0; i < v.size(); ++i)
+                    v[i] *= v[i];
+            }
+            else {
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter!=endIter; ++iter) {
+                    const Size i = iter.index();
 
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = square<Real>()(
-                        localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
+                    if (illegalLocalVolOverwrite_ < 0.0) {
                         v[i] = square<Real>()(
                             localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = square<Real>()(illegalLocalVolOverwrite_);
                     }
+                    else {
+                        try {
+                            v[i] = square<Real>()(
+                                localVol_->localVol(0.5*(t1+t2), x_[i], true));
+                        } catch (Error&) {
+                            v[i] = square<Real>()(illegalLocalVolOverwrite_);
+                        }
 
+                    }
                 }
             }
 
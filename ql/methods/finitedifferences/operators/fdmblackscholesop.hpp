@@ -35,6 +35,8 @@
 
 namespace QuantLib {
 
+    class GriddedLocalVolSurface;
+
     class FdmBlackScholesOp : public FdmLinearOpComposite {
       public:
         FdmBlackScholesOp(
@@ -66,6 +68,7 @@ namespace QuantLib {
         const ext::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const ext::shared_ptr<BlackVolTermStructure> volTS_;
         const ext::shared_ptr<LocalVolTermStructure> localVol_;
+        const ext::shared_ptr<GriddedLocalVolSurface> griddedLocalVol_;
         const Array x_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
@@ -181,6 +181,31 @@ namespace QuantLib {
     }
 #endif
 
+    CSRMatrix NinePointLinearOp::toCSRMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> rowOffsets(n+1), columnIndices(9*n);
+        std::vector<Real> values(9*n);
+        for (Size i=0; i < n; ++i) {
+            const Size k = 9*i;
+            rowOffsets[i] = k;
+            columnIndices[k]   = i00_[i]; values[k]   = a00_[i];
+            columnIndices[k+1] = i01_[i]; values[k+1] = a01_[i];
+            columnIndices[k+2] = i02_[i]; values[k+2] = a02_[i];
+            columnIndices[k+3] = i10_[i]; values[k+3] = a10_[i];
+            columnIndices[k+4] = i;       values[k+4] = a11_[i];
+            columnIndices[k+5] = i12_[i]; values[k+5] = a12_[i];
+            columnIndices[k+6] = i20_[i]; values[k+6] = a20_[i];
+            columnIndices[k+7] = i21_[i]; values[k+7] = a21_[i];
+            columnIndices[k+8] = i22_[i]; values[k+8] = a22_[i];
+        }
+        rowOffsets[n] = 9*n;
+
+        // entries of the same column, e.g., at the boundaries,
+        // are summed by the constructor
+        return CSRMatrix(n, n, rowOffsets, columnIndices, values);
+    }
+
 
     Disposable<NinePointLinearOp>
         NinePointLinearOp::mult(const Array & u) const {
@@ -28,6 +28,7 @@
 
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 
 #include <boost/shared_array.hpp>
 
@@ -51,6 +52,8 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        //! the operator in CSR storage, built without uBLAS
+        CSRMatrix toCSRMatrix() const;
 
       protected:
         NinePointLinearOp() {}
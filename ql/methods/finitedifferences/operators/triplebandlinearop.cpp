@@ -281,52 +281,89 @@ namespace QuantLib {
     }
 #endif
 
+    CSRMatrix TripleBandLinearOp::toCSRMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> rowOffsets(n+1), columnIndices(3*n);
+        std::vector<Real> values(3*n);
+        for (Size i=0; i < n; ++i) {
+            const Size k = 3*i;
+            rowOffsets[i] = k;
+            columnIndices[k]   = i0_[i]; values[k]   = lower_[i];
+            columnIndices[k+1] = i;      values[k+1] = diag_[i];
+            columnIndices[k+2] = i2_[i]; values[k+2] = upper_[i];
+        }
+        rowOffsets[n] = 3*n;
+
+        // entries of the same column, e.g., at the boundaries,
+        // are summed by the constructor
+        return CSRMatrix(n, n, rowOffsets, columnIndices, values);
+    }
+
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
-#ifdef QL_EXTRA_SAFETY_CHECKS
-        for (FdmLinearOpIterator iter = layout->begin();
-             iter!=layout->end(); ++iter) {
-            const std::vector<Size>& coordinates = iter.coordinates();
-            QL_REQUIRE(   coordinates[direction_] != 0
-                       || lower_[iter.index()] == 0,"removing non zero entry!");
-            QL_REQUIRE(   coordinates[direction_] != layout->dim()[direction_]-1
-                       || upper_[iter.index()] == 0,"removing non zero entry!");
-        }
-#endif
+        const Size size = layout->size();
+        const Size lineSize = layout->dim()[direction_];
+        const long nLines = long(size/lineSize);
 
-        Array retVal(r.size()), tmp(r.size());
+        Array retVal(size), tmp(size);
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
+        const Size* rptr = reverseIndex_.get();
+
+        // the entries of the lower and upper bands pointing outside
+        // of the mesh must vanish; they would be dropped otherwise
+        for (long l=0; l < nLines; ++l) {
+            const Size j0 = l*lineSize, j1 = j0 + lineSize;
+            QL_REQUIRE(lptr[rptr[j0]] == 0.0 && uptr[rptr[j1-1]] == 0.0,
+                       "removing non zero entry!");
+        }
 
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        // The system decouples into independent lines along the
+        // direction of the operator, since the lower and upper
+        // entries at the boundaries vanish; lines are solved in
+        // parallel for large meshes.
+        long singular = 0;
+        #pragma omp parallel for reduction(+:singular) if(size >= 4096)
+        for (long l=0; l < nLines; ++l) {
+            const Size j0 = l*lineSize, j1 = j0 + lineSize;
+
+            Size rim1 = rptr[j0];
+            Real bet = a*dptr[rim1]+b;
+            if (bet == 0.0) {
+                ++singular;
+                continue;
+            }
+            bet = 1.0/bet;
+            retVal[rim1] = r[rim1]*bet;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            for (Size j=j0+1; j < j1; ++j) {
+                const Size ri = rptr[j];
+                tmp[j] = a*uptr[rim1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                if (bet == 0.0) {
+                    ++singular;
+                    break;
+                }
+                bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+                rim1 = ri;
+            }
+            for (Size j=j1-1; j > j0; --j)
+                retVal[rptr[j-1]] -= tmp[j]*retVal[rptr[j]];
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(singular == 0, "division by zero");
 
         return retVal;
     }
@@ -28,6 +28,7 @@
 #define quantlib_triple_band_linear_op_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <boost/shared_array.hpp>
 
 namespace QuantLib {
@@ -64,6 +65,8 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        //! the operator in CSR storage, built without uBLAS
+        CSRMatrix toCSRMatrix() const;
 
       protected:
         TripleBandLinearOp() {}
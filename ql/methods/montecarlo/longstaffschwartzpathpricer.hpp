@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
@@ -61,6 +62,30 @@ namespace QuantLib {
         Real operator()(const PathType& path) const;
         virtual void calibrate();
 
+        //! memory-bounded calibration
+        /*! Instead of storing the calibration paths, the paths are
+            regenerated once per exercise date by the given factory,
+            which must return a freshly seeded path generator on each
+            call. Only one deflated cash flow per path and the
+            normal-equation statistics of the current regression are
+            kept, and the regression is solved by means of a Cholesky
+            decomposition.
+
+            Within each exercise date the paths are processed in
+            blocks; the evaluation of the payoff and of the basis
+            functions is parallelized over a block if OpenMP is
+            enabled, whereas the accumulation of the statistics is
+            kept serial to guarantee reproducible results.
+
+            \warning post_processing is not called in this mode.
+        */
+        template <class PathGenerator>
+        void calibrate(
+            const ext::function<ext::shared_ptr<PathGenerator>()>&
+                                                        generatorFactory,
+            Size samples,
+            bool antitheticVariate);
+
         Real exerciseProbability() const;
 
       protected:
@@ -68,6 +93,9 @@ namespace QuantLib {
                                      const std::vector<StateType> &state,
                                      const std::vector<Real> &price,
                                      const std::vector<Real> &exercise) {}
+        Disposable<Array> solveNormalEquations(Matrix& ata,
+                                               const Array& atb) const;
+
         bool  calibrationPhase_;
         const ext::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
@@ -209,6 +237,133 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType>
+    template <class PathGenerator>
+    inline void LongstaffSchwartzPathPricer<PathType>::calibrate(
+        const ext::function<ext::shared_ptr<PathGenerator>()>&
+                                                        generatorFactory,
+        Size samples,
+        bool antitheticVariate) {
+
+        const Size n = antitheticVariate ? 2*samples : samples;
+        const Size m = v_.size();
+        // must be even in order to keep antithetic pairs together
+        const Size blockSize = 1024;
+
+        std::vector<Real> prices(n);
+        std::vector<PathType> paths;
+        paths.reserve(blockSize);
+        std::vector<Real> exercise(blockSize), y(blockSize);
+        std::vector<Real> basis(blockSize*m);
+
+        // the i-th pass rolls the cash flows back to the i-th time
+        // step and collects the regression data for the (i-1)-th one;
+        // time 0 is not an exercise time, so there is no pass for i=1
+        for (Size i=len_-1; i>1; --i) {
+            const ext::shared_ptr<PathGenerator> generator =
+                generatorFactory();
+
+            Matrix ata(m, m, 0.0);
+            Array atb(m, 0.0);
+            Size nItm = 0;
+
+            for (Size offset=0; offset<n; offset+=blockSize) {
+                const Size size = std::min(blockSize, n-offset);
+
+                paths.clear();
+                while (paths.size() < size) {
+                    paths.push_back(generator->next().value);
+                    if (antitheticVariate)
+                        paths.push_back(generator->antithetic().value);
+                }
+
+                #pragma omp parallel for
+                for (long k=0; k < (long)size; ++k) {
+                    const PathType& path = paths[k];
+                    Real& price = prices[offset+k];
+
+                    if (i == len_-1) {
+                        price = (*pathPricer_)(path, i);
+                    } else {
+                        price *= dF_[i];
+                        const Real exerciseValue = (*pathPricer_)(path, i);
+                        if (exerciseValue > 0.0) {
+                            const StateType regValue =
+                                pathPricer_->state(path, i);
+
+                            Real continuationValue = 0.0;
+                            for (Size l=0; l<m; ++l) {
+                                continuationValue +=
+                                    coeff_[i-1][l] * v_[l](regValue);
+                            }
+                            if (continuationValue < exerciseValue) {
+                                price = exerciseValue;
+                            }
+                        }
+                    }
+
+                    exercise[k] = (*pathPricer_)(path, i-1);
+                    if (exercise[k] > 0.0) {
+                        const StateType regValue =
+                            pathPricer_->state(path, i-1);
+                        for (Size l=0; l<m; ++l) {
+                            basis[k*m+l] = v_[l](regValue);
+                        }
+                        y[k] = dF_[i-1]*price;
+                    }
+                }
+
+                for (Size k=0; k<size; ++k) {
+                    if (exercise[k] > 0.0) {
+                        ++nItm;
+                        const Real* b = &basis[k*m];
+                        for (Size l=0; l<m; ++l) {
+                            atb[l] += b[l]*y[k];
+                            for (Size r=0; r<=l; ++r) {
+                                ata[l][r] += b[l]*b[r];
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (m <= nItm) {
+                coeff_[i-2] = solveNormalEquations(ata, atb);
+            }
+            else {
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if
+            // exerciseValue > 0
+                coeff_[i-2] = Array(m, 0.0);
+            }
+        }
+
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType> inline
+    Disposable<Array>
+    LongstaffSchwartzPathPricer<PathType>::solveNormalEquations(
+                                    Matrix& ata, const Array& atb) const {
+        const Size m = atb.size();
+        for (Size l=0; l<m; ++l) {
+            for (Size r=0; r<l; ++r) {
+                ata[r][l] = ata[l][r];
+            }
+        }
+
+        const Matrix L = CholeskyDecomposition(ata, true);
+        for (Size l=0; l<m; ++l) {
+            // rank deficient normal equations, fall back to the
+            // minimum-norm solution
+            if (L[l][l] <= 0.0)
+                return SVD(ata).solveFor(atb);
+        }
+
+        return CholeskySolveFor(L, atb);
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
         return exerciseProbability_.mean();
@@ -27,6 +27,7 @@
 
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/shared_ptr.hpp>
 
 namespace QuantLib {
@@ -45,6 +46,12 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Optionally, a second path pricer returning a sequence of
+        values (e.g., pathwise or likelihood-ratio estimators of the
+        greeks) can be evaluated on the very same paths; its results
+        are collected in a separate sequence accumulator.  The
+        control variate, if any, is not applied to such values.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -57,6 +64,9 @@ namespace QuantLib {
         typedef typename path_generator_type::sample_type sample_type;
         typedef typename path_pricer_type::result_type result_type;
         typedef S stats_type;
+        typedef PathPricer<typename sample_type::value_type, Array>
+            greeks_path_pricer_type;
+        typedef GenericSequenceStatistics<S> greeks_stats_type;
         // constructor
         MonteCarloModel(
                   const ext::shared_ptr<path_generator_type>& pathGenerator,
@@ -67,12 +77,16 @@ namespace QuantLib {
                         = ext::shared_ptr<path_pricer_type>(),
                   result_type cvOptionValue = result_type(),
                   const ext::shared_ptr<path_generator_type>& cvPathGenerator
-                        = ext::shared_ptr<path_generator_type>())
+                        = ext::shared_ptr<path_generator_type>(),
+                  const ext::shared_ptr<greeks_path_pricer_type>&
+                      greeksPathPricer
+                        = ext::shared_ptr<greeks_path_pricer_type>())
         : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator),
+          greeksPathPricer_(greeksPathPricer) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
@@ -80,6 +94,8 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! accumulator of the values returned by the greeks path pricer
+        const greeks_stats_type& greeksAccumulator() const;
       private:
         ext::shared_ptr<path_generator_type> pathGenerator_;
         ext::shared_ptr<path_pricer_type> pathPricer_;
@@ -89,6 +105,8 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         ext::shared_ptr<path_generator_type> cvPathGenerator_;
+        ext::shared_ptr<greeks_path_pricer_type> greeksPathPricer_;
+        greeks_stats_type greeksAccumulator_;
     };
 
     // inline definitions
@@ -109,6 +127,12 @@ namespace QuantLib {
                 }
             }
 
+            // the antithetic path is stored in the same buffer, so
+            // the greeks must be calculated before it's generated
+            Array greeks;
+            if (greeksPathPricer_)
+                greeks = (*greeksPathPricer_)(path.value);
+
             if (isAntitheticVariate_) {
                 const sample_type& atPath = pathGenerator_->antithetic();
                 result_type price2 = (*pathPricer_)(atPath.value);
@@ -122,8 +146,17 @@ namespace QuantLib {
                 }
 
                 sampleAccumulator_.add((price+price2)/2.0, path.weight);
+
+                if (greeksPathPricer_) {
+                    greeks += (*greeksPathPricer_)(atPath.value);
+                    greeks /= 2.0;
+                    greeksAccumulator_.add(greeks, path.weight);
+                }
             } else {
                 sampleAccumulator_.add(price, path.weight);
+
+                if (greeksPathPricer_)
+                    greeksAccumulator_.add(greeks, path.weight);
             }
         }
     }
@@ -134,6 +167,12 @@ namespace QuantLib {
         return sampleAccumulator_;
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MonteCarloModel<MC,RNG,S>::greeks_stats_type&
+    MonteCarloModel<MC,RNG,S>::greeksAccumulator() const {
+        return greeksAccumulator_;
+    }
+
 }
 
 
@@ -0,0 +1,236 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmontecarlomodel.hpp
+    \brief General-purpose multilevel Monte Carlo model
+*/
+
+#ifndef quantlib_multilevel_montecarlo_model_hpp
+#define quantlib_multilevel_montecarlo_model_hpp
+
+#include <ql/methods/montecarlo/multilevelpathgenerator.hpp>
+#include <ql/methods/montecarlo/multipathgenerator.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/statistics/statistics.hpp>
+
+namespace QuantLib {
+
+    //! multilevel Monte Carlo model
+    /*! The expectation of the payoff on the finest grid is written as
+        the telescopic sum
+        \f[
+            E[P_L] = E[P_0] + \sum_{l=1}^{L} E[P_l - P_{l-1}]
+        \f]
+        where the grid of level \f$ l \f$ is obtained by splitting each
+        step of the coarsest grid into \f$ M^l \f$ sub-steps. The
+        corrections are estimated independently of each other using
+        coupled fine and coarse paths; since their variance vanishes
+        as the grid is refined, most of the samples can be drawn on
+        the cheap coarse levels.
+
+        The path pricer is applied to the first component of the
+        simulated multi-path, which is the underlying asset for
+        one-dimensional as well as for stochastic-volatility processes.
+
+        The adaptive choice of levels and samples is left to the
+        client, see McMultilevelSimulation.
+
+        References:
+
+        M.B. Giles, 2008. Multilevel Monte Carlo path simulation,
+        Operations Research 56(3), 607-617
+
+        \ingroup mcarlo
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MultilevelMonteCarloModel {
+      public:
+        typedef typename RNG::rsg_type rsg_type;
+        typedef MultiPathGenerator<rsg_type> coarsest_generator_type;
+        typedef MultilevelPathGenerator<rsg_type> level_generator_type;
+        typedef PathPricer<Path> path_pricer_type;
+        typedef S stats_type;
+
+        MultilevelMonteCarloModel(
+                    const ext::shared_ptr<StochasticProcess>& process,
+                    const TimeGrid& coarsestGrid,
+                    Size refinementFactor = 2,
+                    BigNatural seed = 0);
+
+        //! time grid used on the given level
+        TimeGrid timeGrid(Size level) const;
+        //! adds the next level
+        /*! The path pricer must price paths on timeGrid(levels()). */
+        void addLevel(const ext::shared_ptr<path_pricer_type>& pathPricer);
+        Size levels() const { return accumulators_.size(); }
+        Size refinementFactor() const { return refinementFactor_; }
+
+        //! adds samples to the estimator of the given level
+        void addSamples(Size level, Size samples);
+        const stats_type& levelAccumulator(Size level) const;
+        //! number of time steps simulated for a sample of the given level
+        Real levelCost(Size level) const;
+        //! total number of time steps simulated so far
+        Real cost() const;
+
+        Real value() const;
+        Real errorEstimate() const;
+      private:
+        ext::shared_ptr<StochasticProcess> process_;
+        TimeGrid coarsestGrid_;
+        Size refinementFactor_;
+        BigNatural seed_;
+        ext::shared_ptr<coarsest_generator_type> coarsestGenerator_;
+        std::vector<ext::shared_ptr<level_generator_type> > generators_;
+        std::vector<ext::shared_ptr<path_pricer_type> > pathPricers_;
+        std::vector<stats_type> accumulators_;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline MultilevelMonteCarloModel<RNG,S>::MultilevelMonteCarloModel(
+                    const ext::shared_ptr<StochasticProcess>& process,
+                    const TimeGrid& coarsestGrid,
+                    Size refinementFactor,
+                    BigNatural seed)
+    : process_(process), coarsestGrid_(coarsestGrid),
+      refinementFactor_(refinementFactor), seed_(seed) {
+        QL_REQUIRE(refinementFactor_ > 1,
+                   "refinement factor must be greater than one");
+        QL_REQUIRE(coarsestGrid_.size() > 1, "no time steps given");
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid
+    MultilevelMonteCarloModel<RNG,S>::timeGrid(Size level) const {
+        Size factor = 1;
+        for (Size l=0; l<level; ++l)
+            factor *= refinementFactor_;
+        return level == 0 ? coarsestGrid_
+                          : refinedTimeGrid(coarsestGrid_, factor);
+    }
+
+    template <class RNG, class S>
+    inline void MultilevelMonteCarloModel<RNG,S>::addLevel(
+                    const ext::shared_ptr<path_pricer_type>& pathPricer) {
+        QL_REQUIRE(pathPricer, "null path pricer given");
+
+        const Size level = levels();
+        const TimeGrid grid = timeGrid(level);
+        // independent streams on each level
+        const BigNatural seed =
+            (seed_ == 0) ? 0 : seed_ + level*1768237423UL;
+        rsg_type generator = RNG::make_sequence_generator(
+                          process_->factors()*(grid.size()-1), seed);
+
+        if (level == 0) {
+            coarsestGenerator_ = ext::make_shared<coarsest_generator_type>(
+                                           process_, grid, generator, false);
+            generators_.push_back(ext::shared_ptr<level_generator_type>());
+        } else {
+            generators_.push_back(ext::make_shared<level_generator_type>(
+                                      process_, timeGrid(level-1),
+                                      refinementFactor_, generator));
+        }
+        pathPricers_.push_back(pathPricer);
+        accumulators_.push_back(stats_type());
+    }
+
+    template <class RNG, class S>
+    inline void MultilevelMonteCarloModel<RNG,S>::addSamples(Size level,
+                                                             Size samples) {
+        QL_REQUIRE(level < levels(),
+                   "level " << level << " not available, only "
+                   << levels() << " levels given");
+
+        const path_pricer_type& finePricer = *pathPricers_[level];
+        stats_type& accumulator = accumulators_[level];
+
+        if (level == 0) {
+            for (Size j=0; j<samples; ++j) {
+                const typename coarsest_generator_type::sample_type& path =
+                    coarsestGenerator_->next();
+                accumulator.add(finePricer(path.value[0]), path.weight);
+            }
+        } else {
+            const path_pricer_type& coarsePricer = *pathPricers_[level-1];
+            for (Size j=0; j<samples; ++j) {
+                const typename level_generator_type::sample_type& paths =
+                    generators_[level]->next();
+                const Real correction =
+                    finePricer(paths.value.first[0])
+                    - coarsePricer(paths.value.second[0]);
+                accumulator.add(correction, paths.weight);
+            }
+        }
+    }
+
+    template <class RNG, class S>
+    inline const typename MultilevelMonteCarloModel<RNG,S>::stats_type&
+    MultilevelMonteCarloModel<RNG,S>::levelAccumulator(Size level) const {
+        QL_REQUIRE(level < levels(),
+                   "level " << level << " not available, only "
+                   << levels() << " levels given");
+        return accumulators_[level];
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::levelCost(Size level) const {
+        const Real steps = coarsestGrid_.size()-1;
+        if (level == 0)
+            return steps;
+
+        Real factor = 1.0;
+        for (Size l=0; l<level; ++l)
+            factor *= refinementFactor_;
+        return steps*factor*(1.0 + 1.0/refinementFactor_);
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::cost() const {
+        Real result = 0.0;
+        for (Size l=0; l<levels(); ++l)
+            result += accumulators_[l].samples()*levelCost(l);
+        return result;
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::value() const {
+        Real result = 0.0;
+        for (Size l=0; l<levels(); ++l)
+            result += accumulators_[l].mean();
+        return result;
+    }
+
+    template <class RNG, class S>
+    inline Real MultilevelMonteCarloModel<RNG,S>::errorEstimate() const {
+        Real variance = 0.0;
+        for (Size l=0; l<levels(); ++l) {
+            const Real error = accumulators_[l].errorEstimate();
+            variance += error*error;
+        }
+        return std::sqrt(variance);
+    }
+
+}
+
+
+#endif
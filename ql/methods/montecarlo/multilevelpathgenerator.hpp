@@ -0,0 +1,172 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelpathgenerator.hpp
+    \brief Generates coupled fine and coarse paths for multilevel Monte Carlo
+*/
+
+#ifndef quantlib_multilevel_path_generator_hpp
+#define quantlib_multilevel_path_generator_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! splits each step of the given time grid into equal sub-steps
+    /*! \relates TimeGrid */
+    inline TimeGrid refinedTimeGrid(const TimeGrid& grid, Size factor) {
+        QL_REQUIRE(factor > 0, "refinement factor must be positive");
+        QL_REQUIRE(grid.size() > 1, "no time steps given");
+
+        std::vector<Time> times;
+        times.reserve((grid.size()-1)*factor + 1);
+        times.push_back(grid.front());
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time dt = grid.dt(i-1)/factor;
+            for (Size k=1; k<factor; ++k)
+                times.push_back(grid[i-1] + k*dt);
+            times.push_back(grid[i]);
+        }
+        return TimeGrid(times.begin(), times.end());
+    }
+
+
+    //! Generates pairs of coupled multipaths on a fine and a coarse grid
+    /*! The fine grid is obtained by splitting each step of the coarse
+        grid into \f$ M \f$ equal sub-steps. Both paths are driven by
+        the same Brownian motion, i.e., the Gaussian variate driving
+        the \f$ i \f$-th coarse step is
+        \f[
+            z^c_i = \frac{1}{\sqrt{\Delta t^c_i}}
+                    \sum_{k=1}^{M} \sqrt{\Delta t^f_{i,k}} \, z^f_{i,k}
+        \f]
+        where \f$ z^f_{i,k} \f$ are the variates used for the fine
+        sub-steps. This is the coupling required by multilevel
+        Monte Carlo estimators of the corrections
+        \f$ E[P_{fine} - P_{coarse}] \f$.
+
+        The first element of the returned sample is the fine path,
+        the second one the coarse path.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class MultilevelPathGenerator {
+      public:
+        typedef Sample<std::pair<MultiPath, MultiPath> > sample_type;
+        MultilevelPathGenerator(const ext::shared_ptr<StochasticProcess>&,
+                                const TimeGrid& coarseGrid,
+                                Size refinementFactor,
+                                GSG generator);
+        const sample_type& next() const;
+      private:
+        ext::shared_ptr<StochasticProcess> process_;
+        Size refinementFactor_;
+        GSG generator_;
+        mutable sample_type next_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    MultilevelPathGenerator<GSG>::MultilevelPathGenerator(
+                   const ext::shared_ptr<StochasticProcess>& process,
+                   const TimeGrid& coarseGrid,
+                   Size refinementFactor,
+                   GSG generator)
+    : process_(process), refinementFactor_(refinementFactor),
+      generator_(generator),
+      next_(std::make_pair(
+                MultiPath(process->size(),
+                          refinedTimeGrid(coarseGrid, refinementFactor)),
+                MultiPath(process->size(), coarseGrid)),
+            1.0) {
+
+        QL_REQUIRE(refinementFactor_ > 1,
+                   "refinement factor must be greater than one");
+        QL_REQUIRE(generator_.dimension() ==
+                   process->factors()*refinementFactor_*(coarseGrid.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process->factors() << " * "
+                   << refinementFactor_*(coarseGrid.size()-1)
+                   << ") the number of factors "
+                   << "times the number of fine time steps");
+    }
+
+    template <class GSG>
+    const typename MultilevelPathGenerator<GSG>::sample_type&
+    MultilevelPathGenerator<GSG>::next() const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ = generator_.nextSequence();
+
+        const Size m = process_->size();
+        const Size n = process_->factors();
+
+        MultiPath& fine = next_.value.first;
+        MultiPath& coarse = next_.value.second;
+
+        Array fineAsset = process_->initialValues();
+        Array coarseAsset = fineAsset;
+        for (Size j=0; j<m; j++)
+            fine[j].front() = coarse[j].front() = fineAsset[j];
+
+        next_.weight = sequence_.weight;
+
+        const TimeGrid& fineGrid = fine[0].timeGrid();
+        const TimeGrid& coarseGrid = coarse[0].timeGrid();
+
+        Array dw(n), dwCoarse(n);
+        for (Size i=1; i<coarse.pathSize(); i++) {
+            std::fill(dwCoarse.begin(), dwCoarse.end(), 0.0);
+            for (Size k=0; k<refinementFactor_; k++) {
+                const Size step = (i-1)*refinementFactor_ + k;
+                const Time dt = fineGrid.dt(step);
+                std::copy(sequence_.value.begin()+step*n,
+                          sequence_.value.begin()+(step+1)*n,
+                          dw.begin());
+
+                fineAsset = process_->evolve(fineGrid[step], fineAsset,
+                                             dt, dw);
+                for (Size j=0; j<m; j++)
+                    fine[j][step+1] = fineAsset[j];
+
+                const Real sqrtDt = std::sqrt(dt);
+                for (Size l=0; l<n; l++)
+                    dwCoarse[l] += sqrtDt*dw[l];
+            }
+
+            const Time dt = coarseGrid.dt(i-1);
+            dwCoarse /= std::sqrt(dt);
+            coarseAsset = process_->evolve(coarseGrid[i-1], coarseAsset,
+                                           dt, dwCoarse);
+            for (Size j=0; j<m; j++)
+                coarse[j][i] = coarseAsset[j];
+        }
+
+        return next_;
+    }
+
+}
+
+
+#endif
@@ -84,4 +84,45 @@ namespace QuantLib {
         
         return error;
     }
+
+    bool BlackCalibrationHelper::calibrationErrorGradient(Array& gradient) {
+        if (!modelValueGradient(gradient))
+            return false;
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            {
+              const Real market = marketValue();
+              gradient *= (modelValue() >= market ? 1.0 : -1.0)/market;
+            }
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              const Real modelPrice = modelValue();
+
+              if (modelPrice <= blackPrice(minVol)
+                  || modelPrice >= blackPrice(maxVol)) {
+                  // the implied volatility is floored or capped
+                  gradient = Array(gradient.size(), 0.0);
+              } else {
+                  const Volatility implied = this->impliedVolatility(
+                                      modelPrice, 1e-12, 5000, minVol, maxVol);
+                  const Real h = 1e-5*std::min(implied, 1.0);
+                  const Real vega =
+                      (blackPrice(implied+h) - blackPrice(implied-h))/(2*h);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return true;
+    }
 }
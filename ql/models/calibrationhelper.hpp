@@ -28,6 +28,7 @@
 #include <ql/quote.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <list>
 
@@ -41,6 +42,11 @@ namespace QuantLib {
         virtual ~CalibrationHelperBase() {}
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        //! derivatives of the error w.r.t. the model parameters
+        /*! Returns false if they are not available analytically;
+            calibrations then resort to finite differences.
+        */
+        virtual bool calibrationErrorGradient(Array&) { return false; }
     };
 
     //! liquid Black76 market instrument used during calibration
@@ -80,6 +86,14 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         Real calibrationError();
 
+        //! derivatives of the error w.r.t. the model parameters
+        /*! They are obtained from the ones of the model value. */
+        bool calibrationErrorGradient(Array& gradient);
+
+        //! derivatives of the model value w.r.t. the model parameters
+        /*! Returns false if they are not available analytically. */
+        virtual bool modelValueGradient(Array&) const { return false; }
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -91,10 +105,24 @@ namespace QuantLib {
 
         //! Black or Bachelier price given a volatility
         virtual Real blackPrice(Volatility volatility) const = 0;
+        //! whether blackPrice() can be called from parallel threads
+        /*! Helpers pricing with a temporary engine in blackPrice()
+            register it with the shared term structure, and are
+            therefore evaluated serially by parallel calibrations
+            when their error is an implied volatility.
+        */
+        virtual bool isBlackPriceThreadSafe() const { return false; }
+
+        CalibrationErrorType calibrationErrorType() const {
+            return calibrationErrorType_;
+        }
 
         void setPricingEngine(const ext::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const ext::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
@@ -20,6 +20,7 @@
 */
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
@@ -101,6 +102,17 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    bool HestonModelHelper::modelValueGradient(Array& gradient) const {
+        calculate();
+        const ext::shared_ptr<AnalyticHestonEngine> engine =
+            ext::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        if (!engine)
+            return false;
+        Real value;
+        return engine->valueAndGradient(exerciseDate_, strikePrice_, type_,
+                                        value, gradient);
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
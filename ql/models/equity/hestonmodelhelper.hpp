@@ -65,7 +65,10 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const {}
         void performCalculations() const;
         Real modelValue() const;
+        //! available with the AnalyticHestonEngine and the BatesEngine
+        bool modelValueGradient(Array& gradient) const;
         Real blackPrice(Real volatility) const;
+        bool isBlackPriceThreadSafe() const { return true; }
         Time maturity() const  { calculate(); return tau_; }
       private:
         const Period maturity_;
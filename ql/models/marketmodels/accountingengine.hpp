@@ -48,8 +48,11 @@ namespace QuantLib {
                          Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
-      private:
+        //! simulates a path, stores the product values and returns its weight
+        /*! \pre values must have numberOfValues() elements */
         Real singlePathValues(std::vector<Real>& values);
+        Size numberOfValues() const { return numberProducts_; }
+      private:
 
         ext::shared_ptr<MarketModelEvolver> evolver_;
         Clone<MarketModelMultiProduct> product_;
@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/callability/parallelupperboundengine.hpp>
+#include <ql/errors.hpp>
+#include <exception>
+#include <string>
+
+namespace QuantLib {
+
+    ParallelUpperBoundEngine::ParallelUpperBoundEngine(
+               const std::vector<ext::shared_ptr<UpperBoundEngine> >& engines)
+    : engines_(engines) {
+        QL_REQUIRE(!engines_.empty(), "no upper-bound engines given");
+        for (Size i=0; i<engines_.size(); ++i) {
+            QL_REQUIRE(engines_[i], "null upper-bound engine given");
+            for (Size j=0; j<i; ++j)
+                QL_REQUIRE(engines_[i] != engines_[j],
+                           "upper-bound engine #" << i
+                           << " is the same as #" << j);
+        }
+    }
+
+    void ParallelUpperBoundEngine::multiplePathValues(Statistics& stats,
+                                                      Size outerPaths,
+                                                      Size innerPaths) {
+        const Size n = engines_.size();
+
+        // outer paths to be simulated by each engine
+        std::vector<Size> paths(n, outerPaths/n);
+        for (Size i=0; i<outerPaths%n; ++i)
+            ++paths[i];
+
+        std::vector<std::vector<std::pair<Real,Real> > > values(n);
+        std::vector<std::string> errors(n);
+
+        // outer paths are expensive and their values are few, so
+        // each engine simulates all of its paths in a single task
+        #pragma omp parallel for schedule(dynamic)
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                values[i].reserve(paths[i]);
+                for (Size j=0; j<paths[i]; ++j)
+                    values[i].push_back(
+                                  engines_[i]->singlePathValue(innerPaths));
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(errors[i].empty(),
+                       "upper-bound engine #" << i << " failed: "
+                       << errors[i]);
+            for (Size j=0; j<paths[i]; ++j)
+                stats.add(values[i][j].first, values[i][j].second);
+        }
+    }
+
+}
+
@@ -0,0 +1,64 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelupperboundengine.hpp
+    \brief Upper-bound engine running several nested simulations
+*/
+
+#ifndef quantlib_parallel_upper_bound_engine_hpp
+#define quantlib_parallel_upper_bound_engine_hpp
+
+#include <ql/models/marketmodels/callability/upperboundengine.hpp>
+#include <ql/math/statistics/statistics.hpp>
+
+namespace QuantLib {
+
+    //! Market-model %engine for upper-bound estimation on several threads
+    /*! The outer paths are split among the given upper-bound engines,
+        each of which must own its outer and inner evolvers (and
+        therefore their Brownian generators); e.g., evolvers built
+        from MTBrownianGeneratorFactory instances with different
+        seeds give independent substreams.  Each engine runs the
+        inner simulations required by its own outer paths; when
+        OpenMP is enabled, the engines are run in parallel.  If the
+        engines split their inner simulations into blocks (see
+        UpperBoundEngine) the blocks are run serially within each
+        engine, unless nested OpenMP parallelism is enabled; when
+        the outer paths are few, running a single engine with many
+        inner blocks might make better use of the available threads.
+
+        The values of each engine are stored and added to the
+        statistics in a fixed order, i.e., first the paths of the
+        first engine, then the ones of the second, and so on.  The
+        results are therefore reproducible and only depend on the
+        engines, not on the number of threads actually used.
+    */
+    class ParallelUpperBoundEngine {
+      public:
+        explicit ParallelUpperBoundEngine(
+               const std::vector<ext::shared_ptr<UpperBoundEngine> >& engines);
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size innerPaths);
+      private:
+        std::vector<ext::shared_ptr<UpperBoundEngine> > engines_;
+    };
+
+}
+
+
+#endif
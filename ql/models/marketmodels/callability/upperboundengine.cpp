@@ -30,6 +30,9 @@
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <ql/auto_ptr.hpp>
 #include <algorithm>
+#include <exception>
+#include <numeric>
+#include <string>
 
 namespace QuantLib {
 
@@ -110,8 +113,8 @@ namespace QuantLib {
 
     UpperBoundEngine::UpperBoundEngine(
                    const ext::shared_ptr<MarketModelEvolver>& evolver,
-                   const std::vector<ext::shared_ptr<MarketModelEvolver> >&
-                                                                 innerEvolvers,
+                   const std::vector<std::vector<
+                       ext::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
                    const MarketModelMultiProduct& underlying,
                    const MarketModelExerciseValue& rebate,
                    const MarketModelMultiProduct& hedge,
@@ -121,6 +124,49 @@ namespace QuantLib {
     : evolver_(evolver), innerEvolvers_(innerEvolvers),
       composite_(MultiProductComposite()),
       initialNumeraireValue_(initialNumeraireValue) {
+        for (Size i=0; i<innerEvolvers_.size(); ++i) {
+            QL_REQUIRE(!innerEvolvers_[i].empty(),
+                       "no inner evolvers given for exercise #" << i);
+            for (Size j=0; j<innerEvolvers_[i].size(); ++j) {
+                QL_REQUIRE(innerEvolvers_[i][j],
+                           "null inner evolver given for exercise #" << i);
+                for (Size k=0; k<j; ++k)
+                    QL_REQUIRE(innerEvolvers_[i][j] != innerEvolvers_[i][k],
+                               "inner evolver #" << j << " for exercise #"
+                               << i << " is the same as #" << k);
+            }
+        }
+        initialize(underlying, rebate, hedge, hedgeRebate, hedgeStrategy);
+    }
+
+
+    UpperBoundEngine::UpperBoundEngine(
+                   const ext::shared_ptr<MarketModelEvolver>& evolver,
+                   const std::vector<ext::shared_ptr<MarketModelEvolver> >&
+                                                                 innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue)
+    : evolver_(evolver), composite_(MultiProductComposite()),
+      initialNumeraireValue_(initialNumeraireValue) {
+        innerEvolvers_.reserve(innerEvolvers.size());
+        for (Size i=0; i<innerEvolvers.size(); ++i)
+            innerEvolvers_.push_back(
+                std::vector<ext::shared_ptr<MarketModelEvolver> >(
+                                                    1, innerEvolvers[i]));
+        initialize(underlying, rebate, hedge, hedgeRebate, hedgeStrategy);
+    }
+
+
+    void UpperBoundEngine::initialize(
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy) {
 
         composite_.add(underlying);
         composite_.add(ExerciseAdapter(rebate));
@@ -246,24 +292,12 @@ namespace QuantLib {
                     // reset() method brings them to the current point
                     // rather than the beginning of the path.
 
-                    ext::shared_ptr<MarketModelEvolver> currentEvolver =
-                        innerEvolvers_[exercise++];
-                    currentEvolver->setInitialState(evolver_->currentState());
-
                     callable.stopRecording();
                     callable.enableCallability();
                     callable.save();
 
-                    // This allows us to write:
-                    AccountingEngine engine(currentEvolver, callable,
-                                            1.0); // this causes the result
-                                                  // to be in numeraire units
-                    SequenceStatisticsInc innerStats(callable.numberOfProducts());
-                    engine.multiplePathValues(innerStats, innerPaths);
-
-                    const std::vector<Real>& values = innerStats.mean();
                     unexercisedHedgeValue =
-                        std::accumulate(values.begin(), values.end(), Real(0.0))
+                        innerValue(exercise++, callable, innerPaths)
                         / principalInNumerairePortfolio;
 
                     callable.disableCallability();
@@ -323,6 +357,73 @@ namespace QuantLib {
     }
 
 
+    Real UpperBoundEngine::innerValue(Size exercise,
+                                      const MarketModelMultiProduct& callable,
+                                      Size innerPaths) const {
+        QL_REQUIRE(exercise < innerEvolvers_.size(),
+                   "no inner evolvers given for exercise #" << exercise);
+        const std::vector<ext::shared_ptr<MarketModelEvolver> >& evolvers =
+            innerEvolvers_[exercise];
+        const Size n = evolvers.size();
+
+        // inner paths to be simulated by each block
+        std::vector<Size> paths(n, innerPaths/n);
+        for (Size i=0; i<innerPaths%n; ++i)
+            ++paths[i];
+
+        // The inner evolvers start from the current state; the
+        // accounting engines hold their own copies of the callable,
+        // whose reset() brings them to the current point as well.
+        std::vector<ext::shared_ptr<AccountingEngine> > engines(n);
+        for (Size i=0; i<n; ++i) {
+            evolvers[i]->setInitialState(evolver_->currentState());
+            engines[i] = ext::make_shared<AccountingEngine>(
+                                     evolvers[i], callable,
+                                     1.0); // this causes the result
+                                           // to be in numeraire units
+        }
+
+        std::vector<Real> values(n, 0.0), weights(n, 0.0);
+        std::vector<std::string> errors(n);
+
+        #pragma omp parallel for schedule(dynamic) if (n > 1)
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                if (paths[i] > 0) {
+                    SequenceStatisticsInc innerStats(
+                                               callable.numberOfProducts());
+                    engines[i]->multiplePathValues(innerStats, paths[i]);
+                    const std::vector<Real>& means = innerStats.mean();
+                    values[i] = std::accumulate(means.begin(), means.end(),
+                                                Real(0.0));
+                    weights[i] = innerStats.weightSum();
+                }
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "inner block #" << i << " for exercise #"
+                       << exercise << " failed: " << errors[i]);
+
+        if (n == 1)
+            return values[0];
+
+        // the blocks are combined in a fixed order
+        Real value = 0.0, totalWeight = 0.0;
+        for (Size i=0; i<n; ++i) {
+            value += values[i]*weights[i];
+            totalWeight += weights[i];
+        }
+        QL_REQUIRE(totalWeight > 0.0, "no inner paths simulated");
+        return value/totalWeight;
+    }
+
+
     Real UpperBoundEngine::collectCashFlows(Size currentStep,
                                             Real principalInNumerairePortfolio,
                                             Size beginProduct,
@@ -37,11 +37,31 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! The inner simulations run at each exercise time can be split
+        into blocks by passing several inner evolvers for each
+        exercise; innerEvolvers[i][j] simulates the j-th block of
+        paths after the i-th exercise time.  Each block must own its
+        Brownian generator, so that the paths of each block only
+        depend on the outer path, the exercise and the block itself;
+        when OpenMP is enabled, the blocks are simulated in parallel
+        and their results are combined in a fixed order, so that the
+        estimate does not depend on the number of threads.
+
+        \pre product and hedge must have the same rate times
              and exercise times
     */
     class UpperBoundEngine {
       public:
+        UpperBoundEngine(
+                   const ext::shared_ptr<MarketModelEvolver>& evolver,
+                   const std::vector<std::vector<
+                       ext::shared_ptr<MarketModelEvolver> > >& innerEvolvers,
+                   const MarketModelMultiProduct& underlying,
+                   const MarketModelExerciseValue& rebate,
+                   const MarketModelMultiProduct& hedge,
+                   const MarketModelExerciseValue& hedgeRebate,
+                   const ExerciseStrategy<CurveState>& hedgeStrategy,
+                   Real initialNumeraireValue);
         UpperBoundEngine(
                    const ext::shared_ptr<MarketModelEvolver>& evolver,
                    const std::vector<ext::shared_ptr<MarketModelEvolver> >&
@@ -57,13 +77,22 @@ namespace QuantLib {
                                 Size innerPaths);
         std::pair<Real,Real> singlePathValue(Size innerPaths);
       private:
+        void initialize(const MarketModelMultiProduct& underlying,
+                        const MarketModelExerciseValue& rebate,
+                        const MarketModelMultiProduct& hedge,
+                        const MarketModelExerciseValue& hedgeRebate,
+                        const ExerciseStrategy<CurveState>& hedgeStrategy);
+        Real innerValue(Size exercise,
+                        const MarketModelMultiProduct& callable,
+                        Size innerPaths) const;
         Real collectCashFlows(Size currentStep,
                               Real principalInNumerairePortfolio,
                               Size beginProduct,
                               Size endProduct) const;
 
         ext::shared_ptr<MarketModelEvolver> evolver_;
-        std::vector<ext::shared_ptr<MarketModelEvolver> > innerEvolvers_;
+        std::vector<std::vector<ext::shared_ptr<MarketModelEvolver> > >
+                                                               innerEvolvers_;
         MultiProductComposite composite_;
 
         Real initialNumeraireValue_;
@@ -58,9 +58,8 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
-        mutable Matrix PjPnWk_; // < Wk, P_{j}/P_n> (k, j)
-        mutable Matrix wkaj_;    // < Wk , Aj/Pn> (k, j)
-        mutable Matrix wkajN_;    // < Wk , Aj/PN> (k, j)
+        mutable Matrix PjPnWk_; // < Wk, P_{j}/P_n> (j, k)
+        mutable Matrix wkaj_;    // < Wk , Aj/Pn> (j, k)
 
         std::vector<Size> downs_, ups_;
         Size spanningFwds_;
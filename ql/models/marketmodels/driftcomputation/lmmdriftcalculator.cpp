@@ -23,6 +23,7 @@
 
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -37,7 +38,7 @@ namespace QuantLib {
       numeraire_(numeraire), alive_(alive),
       displacements_(displacements), oneOverTaus_(taus.size()),
       pseudo_(pseudo), tmp_(taus.size(), 0.0),
-      e_(pseudo_.columns(), pseudo_.rows(), 0.0),
+      e_(pseudo_.columns(), 0.0),
       downs_(taus.size()), ups_(taus.size()) {
 
         // Check requirements
@@ -128,55 +129,137 @@ namespace QuantLib {
             tmp_[i] = (forwards[i]+displacements_[i]) /
                 (oneOverTaus_[i]+forwards[i]);
 
-        // Enforce initialization
-        for (Size r=0; r<numberOfFactors_; ++r)
-            e_[r][std::max(0,static_cast<Integer>(numeraire_)-1)] = 0.0;
-
         // Now compute drifts: take the numeraire P_N (numeraire_=N)
         // as the reference point, divide the summation into 3 steps,
-        // et impera:
+        // et impera. The running sums e_[r] are cumulated along the
+        // pseudo-root rows, which are contiguous in memory.
 
         // 1st step: the drift corresponding to the numeraire P_N is zero.
         // (if N=0 no drift is null, if N=numberOfRates_ the last drift is null).
         if (numeraire_>0) drifts[numeraire_-1] = 0.0;
 
         // 2nd step: then, move backward from N-2 (included) back to
-        // alive (included) (if N=0 jumps to 3rd step, if N=numberOfRates_ the
-        // e_[r][N-1] are correctly initialized):
-
+        // alive (included) (if N=0 jumps to 3rd step):
+        std::fill(e_.begin(), e_.end(), 0.0);
         for (Integer i=static_cast<Integer>(numeraire_)-2;
              i>=static_cast<Integer>(alive_); --i) {
-            drifts[i] = 0.0;
-            for (Size r=0; r<numberOfFactors_; ++r) {
-                e_[r][i] = e_[r][i+1] + tmp_[i+1] * pseudo_[i+1][r];
-                drifts[i] -= e_[r][i]*pseudo_[i][r];
-            }
-
-            /*
-            Matrix::column_iterator p1 = e_.column_begin(i);
-            Matrix::column_iterator end = e_.column_end(i);
-            Matrix::const_column_iterator p2 = e_.column_begin(i+1);
+            const Real x = tmp_[i+1];
             Matrix::const_row_iterator q1 = pseudo_.row_begin(i);
             Matrix::const_row_iterator q2 = pseudo_.row_begin(i+1);
-            Real x = tmp_[i+1];
-            while (p1 != end) {
-                *p1 = *p2 + x*(*q2);
-                drifts[i] -= *p1*(*q1);
-                ++p1; ++p2; ++q1; ++q2;
+            Real drift = 0.0;
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                e_[r] += x*q2[r];
+                drift -= e_[r]*q1[r];
             }
-            */
+            drifts[i] = drift;
         }
 
         // 3rd step: now, move forward from N (included) up to n (excluded)
         // (if N=0 this is the only relevant computation):
+        std::fill(e_.begin(), e_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            const Real x = tmp_[i];
+            Matrix::const_row_iterator q = pseudo_.row_begin(i);
+            Real drift = 0.0;
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                e_[r] += x*q[r];
+                drift += e_[r]*q[r];
+            }
+            drifts[i] = drift;
+        }
+    }
+
+    void LMMDriftCalculator::compute(const Matrix& forwards,
+                                     Matrix& drifts) const {
+        if (isFullFactor_)
+            computePlain(forwards, drifts);
+        else
+            computeReduced(forwards, drifts);
+    }
+
+    void LMMDriftCalculator::setBlockFactors(const Matrix& forwards,
+                                             Matrix& drifts) const {
+        QL_REQUIRE(forwards.rows()==numberOfRates_,
+                   "forwards have " << forwards.rows() << " rows, "
+                   << numberOfRates_ << " required");
+        QL_REQUIRE(drifts.rows()==forwards.rows() &&
+                   drifts.columns()==forwards.columns(),
+                   "drifts and forwards have different sizes");
+
+        const Size paths = forwards.columns();
+        if (tmpBlock_.columns() != paths) {
+            tmpBlock_ = Matrix(numberOfRates_, paths, 0.0);
+            eBlock_ = Matrix(numberOfFactors_, paths, 0.0);
+        }
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator t = tmpBlock_.row_begin(i);
+            const Real d = displacements_[i], y = oneOverTaus_[i];
+            for (Size p=0; p<paths; ++p)
+                t[p] = (f[p]+d) / (y+f[p]);
+        }
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& forwards,
+                                          Matrix& drifts) const {
+        setBlockFactors(forwards, drifts);
+
+        const Size paths = forwards.columns();
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            for (Size j=downs_[i]; j<ups_[i]; ++j) {
+                Matrix::const_row_iterator t = tmpBlock_.row_begin(j);
+                const Real c = C_[i][j];
+                for (Size p=0; p<paths; ++p)
+                    mu[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (Size p=0; p<paths; ++p)
+                    mu[p] = -mu[p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+        setBlockFactors(forwards, drifts);
+
+        const Size paths = forwards.columns();
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Matrix::const_row_iterator t = tmpBlock_.row_begin(i+1);
+            Matrix::row_iterator mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Matrix::row_iterator e = eBlock_.row_begin(r);
+                const Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    mu[p] -= e[p]*b;
+                }
+            }
+        }
+
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
         for (Size i=numeraire_; i<numberOfRates_; ++i) {
-            drifts[i] = 0.0;
+            Matrix::const_row_iterator t = tmpBlock_.row_begin(i);
+            Matrix::row_iterator mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
             for (Size r=0; r<numberOfFactors_; ++r) {
-                if (i==0)
-                    e_[r][i] = tmp_[i] * pseudo_[i][r];
-                else
-                    e_[r][i] = e_[r][i-1] + tmp_[i] * pseudo_[i][r];
-                drifts[i] += e_[r][i]*pseudo_[i][r];
+                Matrix::row_iterator e = eBlock_.row_begin(r);
+                const Real a = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    mu[p] += e[p]*a;
+                }
             }
         }
     }
@@ -19,6 +19,7 @@
 */
 
 #include <ql/models/marketmodels/driftcomputation/lmmnormaldriftcalculator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -159,4 +160,99 @@ namespace QuantLib {
         }
     }
 
+    void LMMNormalDriftCalculator::compute(const Matrix& forwards,
+                                           Matrix& drifts) const {
+        if (isFullFactor_)
+            computePlain(forwards, drifts);
+        else
+            computeReduced(forwards, drifts);
+    }
+
+    void LMMNormalDriftCalculator::setBlockFactors(const Matrix& forwards,
+                                                   Matrix& drifts) const {
+        QL_REQUIRE(forwards.rows()==numberOfRates_,
+                   "forwards have " << forwards.rows() << " rows, "
+                   << numberOfRates_ << " required");
+        QL_REQUIRE(drifts.rows()==forwards.rows() &&
+                   drifts.columns()==forwards.columns(),
+                   "drifts and forwards have different sizes");
+
+        const Size paths = forwards.columns();
+        if (tmpBlock_.columns() != paths) {
+            tmpBlock_ = Matrix(numberOfRates_, paths, 0.0);
+            eBlock_ = Matrix(numberOfFactors_, paths, 0.0);
+        }
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator f = forwards.row_begin(i);
+            Matrix::row_iterator t = tmpBlock_.row_begin(i);
+            const Real y = oneOverTaus_[i];
+            for (Size p=0; p<paths; ++p)
+                t[p] = 1.0/(y+f[p]);
+        }
+    }
+
+    void LMMNormalDriftCalculator::computePlain(const Matrix& forwards,
+                                                Matrix& drifts) const {
+        setBlockFactors(forwards, drifts);
+
+        const Size paths = forwards.columns();
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            Matrix::row_iterator mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            for (Size j=downs_[i]; j<ups_[i]; ++j) {
+                Matrix::const_row_iterator t = tmpBlock_.row_begin(j);
+                const Real c = C_[i][j];
+                for (Size p=0; p<paths; ++p)
+                    mu[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (Size p=0; p<paths; ++p)
+                    mu[p] = -mu[p];
+            }
+        }
+    }
+
+    void LMMNormalDriftCalculator::computeReduced(const Matrix& forwards,
+                                                  Matrix& drifts) const {
+        setBlockFactors(forwards, drifts);
+
+        const Size paths = forwards.columns();
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Matrix::const_row_iterator t = tmpBlock_.row_begin(i+1);
+            Matrix::row_iterator mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Matrix::row_iterator e = eBlock_.row_begin(r);
+                const Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    mu[p] -= e[p]*b;
+                }
+            }
+        }
+
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator t = tmpBlock_.row_begin(i);
+            Matrix::row_iterator mu = drifts.row_begin(i);
+            std::fill(mu, mu+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Matrix::row_iterator e = eBlock_.row_begin(r);
+                const Real a = pseudo_[i][r];
+                for (Size p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    mu[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
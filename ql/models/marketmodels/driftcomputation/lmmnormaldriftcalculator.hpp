@@ -65,8 +65,25 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! \name Blocks of paths
+            The following methods compute the drifts for a block of
+            paths at once.  The forward rates of each path are stored
+            in a column of fwds, and the drifts are returned in the
+            corresponding column of drifts; rates before alive are
+            not touched.  The results are the same as those of the
+            single-path methods.
+        */
+        //@{
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
+        //@}
 
       private:
+        void setBlockFactors(const Matrix& fwds, Matrix& drifts) const;
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
         Size numeraire_, alive_;
@@ -75,6 +92,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpBlock_, eBlock_;
         std::vector<Size> downs_, ups_;
     };
 
@@ -35,9 +35,8 @@ namespace QuantLib {
       pseudo_(pseudo),
       tmp_(taus.size(), 0.0),
       // zero initialization required for (used by) the last element
-      wkaj_(pseudo_.columns(), pseudo_.rows(), 0.0),
-      wkpj_(pseudo_.columns(), pseudo_.rows()+1, 0.0),
-      wkajshifted_(pseudo_.columns(), pseudo_.rows(), 0.0)
+      wkaj_(pseudo_.rows(), pseudo_.columns(), 0.0),
+      wkpj_(pseudo_.rows()+1, pseudo_.columns(), 0.0)
       /*,
       downs_(taus.size()), ups_(taus.size())*/ {
 
@@ -82,44 +81,50 @@ namespace QuantLib {
         // calculates and stores wkaj_, wkpj1_
         // assuming terminal bond measure
         // eq 5.4-5.7
+        // The rows of the workspace matrices (one for each rate) are
+        // updated at once for all factors, so that the inner loops
+        // run over contiguous memory and the curve-state quantities
+        // are only retrieved once for each rate.
         const std::vector<Time>& taus=cs.rateTaus();
-        for (Size k=0; k<numberOfFactors_; ++k) {
-                // taken care in the constructor
-                // wkpj1_[k][numberOfRates_-1]= 0.0;
-                // wkaj_[k][numberOfRates_-1] = 0.0;
-            for (Integer j=numberOfRates_-2; j>=static_cast<Integer>(alive_)-1; --j) {
-                 // < W(k) | P(j+1)/P(n) > =
-                 // = SR(j+1) a(j+1,k) A(j+1) / P(n) + SR(j+1) < W(k) | A(j+1)/P(n) >
-                Real annuity = cs.coterminalSwapAnnuity(numberOfRates_,j+1);
-                wkpj_[k][j+1]= SR[j+1] *
-                            ( pseudo_[j+1][k] * annuity +  wkaj_[k][j+1] )+
-                            pseudo_[j+1][k]*displacements_[j+1]* annuity;
-
-                if (j >=static_cast<Integer>(alive_))
-                    wkaj_[k][j] = wkpj_[k][j+1]*taus[j ]+wkaj_[k][j+1];
+        // taken care in the constructor
+        // wkpj1_[numberOfRates_-1][k]= 0.0;
+        // wkaj_[numberOfRates_-1][k] = 0.0;
+        for (Integer j=numberOfRates_-2; j>=static_cast<Integer>(alive_)-1; --j) {
+            // < W(k) | P(j+1)/P(n) > =
+            // = SR(j+1) a(j+1,k) A(j+1) / P(n) + SR(j+1) < W(k) | A(j+1)/P(n) >
+            const Real annuity = cs.coterminalSwapAnnuity(numberOfRates_,j+1);
+            const Real sr = SR[j+1], displacement = displacements_[j+1];
+            Matrix::const_row_iterator a = pseudo_.row_begin(j+1);
+            Matrix::const_row_iterator wka1 = wkaj_.row_begin(j+1);
+            Matrix::row_iterator wkp = wkpj_.row_begin(j+1);
+            for (Size k=0; k<numberOfFactors_; ++k)
+                wkp[k] = sr * ( a[k] * annuity + wka1[k] ) +
+                         a[k]*displacement* annuity;
+
+            if (j >=static_cast<Integer>(alive_)) {
+                const Real tau = taus[j];
+                Matrix::row_iterator wka = wkaj_.row_begin(j);
+                for (Size k=0; k<numberOfFactors_; ++k)
+                    wka[k] = wkp[k]*tau+wka1[k];
             }
-          }
-
+        }
 
         Real numeraireRatio = cs.discountRatio(numberOfRates_, numeraire_);
+        Matrix::const_row_iterator wkpN = wkpj_.row_begin(numeraire_);
 
 // change to work for general numeraire
-        for (Size k=0; k<numberOfFactors_; ++k) {
-            // compute < Wk, PN/pn>
-            for (Size j=alive_; j<numberOfRates_; ++j)
-            {
-                wkajshifted_[k][j] = -wkaj_[k][j]/cs.coterminalSwapAnnuity(numberOfRates_,j)
-                                    + wkpj_[k][numeraire_]
-                                                *numeraireRatio;
-            }
-        }
-
-        // eq 5.3 (in log coordinates)
+        // eq 5.3 (in log coordinates), using < Wk, PN/pn>
         for (Size j=alive_; j<numberOfRates_; ++j) {
-            drifts[j] = 0.0;
+            const Real annuity = cs.coterminalSwapAnnuity(numberOfRates_,j);
+            Matrix::const_row_iterator wka = wkaj_.row_begin(j);
+            Matrix::const_row_iterator a = pseudo_.row_begin(j);
+            Real drift = 0.0;
             for (Size k=0; k<numberOfFactors_; ++k) {
-                drifts[j] += wkajshifted_[k][j]*pseudo_[j][k];
+                const Real wkajshifted = -wka[k]/annuity
+                                         + wkpN[k]*numeraireRatio;
+                drift += wkajshifted*a[k];
             }
+            drifts[j] = drift;
         }
 
     }
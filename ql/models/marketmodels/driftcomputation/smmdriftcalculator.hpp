@@ -55,9 +55,8 @@ namespace QuantLib {
         Matrix C_, pseudo_;
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
-        mutable Matrix wkaj_;  // < W(k) | A(j)/P(n) >
-        mutable Matrix wkpj_; // < W(k) | P(j)/P(n) >
-        mutable Matrix wkajshifted_;
+        mutable Matrix wkaj_;  // < W(k) | A(j)/P(n) > (j, k)
+        mutable Matrix wkpj_; // < W(k) | P(j)/P(n) > (j, k)
     };
 
 }
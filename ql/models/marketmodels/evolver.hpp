@@ -21,7 +21,7 @@
 #ifndef quantlib_market_model_evolver_hpp
 #define quantlib_market_model_evolver_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/matrix.hpp>
 #include <vector>
 
 namespace QuantLib {
@@ -44,6 +44,29 @@ namespace QuantLib {
         virtual void setInitialState(const CurveState&) = 0;
     };
 
+    //! Market-model evolver advancing a block of paths at once
+    /*! The forward rates of the paths in the block are stored in the
+        columns of a rates-by-paths matrix, so that the drifts and
+        the diffusion terms are computed by loops running over
+        contiguous paths.  Each path gets the same Brownian variates
+        and weights, and therefore evolves in the same way, as it
+        would if the paths were evolved one after the other through
+        the MarketModelEvolver interface.
+    */
+    class MarketModelBlockEvolver {
+      public:
+        virtual ~MarketModelBlockEvolver() {}
+
+        //! starts a block of paths and returns their weights
+        virtual void startNewBlock(Size paths,
+                                   std::vector<Real>& weights) = 0;
+        //! advances all paths and returns the weights of the step
+        virtual void advanceBlockStep(std::vector<Real>& weights) = 0;
+        virtual Size currentBlockStep() const = 0;
+        //! forward rates of the paths in the block, one column per path
+        virtual const Matrix& currentBlockForwards() const = 0;
+    };
+
 }
 
 #endif
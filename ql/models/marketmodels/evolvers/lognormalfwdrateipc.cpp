@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/utilities.hpp>
 
 namespace QuantLib {
 
@@ -44,7 +45,8 @@ namespace QuantLib {
       g_(numberOfRates_), brownians_(numberOfFactors_),
       correlatedBrownians_(numberOfRates_),
       rateTaus_(marketModel->evolution().rateTaus()),
-      alive_(marketModel->evolution().firstAliveRate())
+      alive_(marketModel->evolution().firstAliveRate()),
+      currentBlockStep_(initialStep)
     {
         checkCompatibility(marketModel->evolution(), numeraires);
         QL_REQUIRE(isInTerminalMeasure(marketModel->evolution(), numeraires),
@@ -151,4 +153,91 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRateIpc::startNewBlock(Size paths,
+                                            std::vector<Real>& weights) {
+        QL_REQUIRE(paths>0, "at least one path required");
+        drawBrownianBlock(*generator_, paths, weights,
+                          blockBrownians_, blockStepWeights_);
+
+        if (blockForwards_.columns() != paths) {
+            blockForwards_ = Matrix(numberOfRates_, paths);
+            blockLogForwards_ = Matrix(numberOfRates_, paths);
+            blockDrifts1_ = Matrix(numberOfRates_, paths);
+            blockG_ = Matrix(numberOfRates_, paths);
+            blockDiffusion_.resize(paths);
+            blockDrifts2_.resize(paths);
+        }
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i), initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i), blockForwards_.row_end(i),
+                      std::exp(initialLogForwards_[i]) - displacements_[i]);
+        }
+        currentBlockStep_ = initialStep_;
+    }
+
+    void LogNormalFwdRateIpc::advanceBlockStep(std::vector<Real>& weights) {
+        const Size paths = blockForwards_.columns();
+        QL_REQUIRE(paths>0, "no block of paths started");
+        Size p;
+
+        // a) compute drifts D1 at T1;
+        Integer alive = alive_[currentBlockStep_];
+        if (currentBlockStep_ > initialStep_) {
+            calculators_[currentBlockStep_].computePlain(blockForwards_,
+                                                         blockDrifts1_);
+        } else {
+            for (Size i=alive; i<numberOfRates_; ++i)
+                std::fill(blockDrifts1_.row_begin(i),
+                          blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        const Size step = currentBlockStep_ - initialStep_;
+        const Matrix& brownians = blockBrownians_[step];
+        const Matrix& A = marketModel_->pseudoRoot(currentBlockStep_);
+        const Matrix& C = marketModel_->covariance(currentBlockStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentBlockStep_];
+
+        for (Integer i=numberOfRates_-1; i>=alive; --i) {
+            std::fill(blockDrifts2_.begin(), blockDrifts2_.end(), 0.0);
+            for (Size j=i+1; j<numberOfRates_; ++j) {
+                Matrix::const_row_iterator g = blockG_.row_begin(j);
+                const Real c = C[i][j];
+                for (p=0; p<paths; ++p)
+                    blockDrifts2_[p] -= g[p]*c;
+            }
+            std::fill(blockDiffusion_.begin(), blockDiffusion_.end(), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = A[i][r];
+                Matrix::const_row_iterator w = brownians.row_begin(r);
+                for (p=0; p<paths; ++p)
+                    blockDiffusion_[p] += a*w[p];
+            }
+            Matrix::row_iterator x = blockLogForwards_.row_begin(i);
+            Matrix::row_iterator f = blockForwards_.row_begin(i);
+            Matrix::row_iterator g = blockG_.row_begin(i);
+            Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+            const Real fixed = fixedDrift[i], d = displacements_[i],
+                tau = rateTaus_[i];
+            for (p=0; p<paths; ++p) {
+                x[p] += 0.5*(d1[p]+blockDrifts2_[p]) + fixed;
+                x[p] += blockDiffusion_[p];
+                f[p] = std::exp(x[p]) - d;
+                g[p] = tau*(f[p]+d)/(1.0+tau*f[p]);
+            }
+        }
+
+        weights.assign(blockStepWeights_.row_begin(step),
+                       blockStepWeights_.row_end(step));
+        ++currentBlockStep_;
+    }
+
+    Size LogNormalFwdRateIpc::currentBlockStep() const {
+        return currentBlockStep_;
+    }
+
+    const Matrix& LogNormalFwdRateIpc::currentBlockForwards() const {
+        return blockForwards_;
+    }
+
 }
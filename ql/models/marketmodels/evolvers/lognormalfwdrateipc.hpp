@@ -32,7 +32,8 @@ namespace QuantLib {
     class LMMDriftCalculator;
 
     //! Iterative Predictor-Corrector
-    class LogNormalFwdRateIpc : public MarketModelEvolver {
+    class LogNormalFwdRateIpc : public MarketModelEvolver,
+                                public MarketModelBlockEvolver {
       public:
         LogNormalFwdRateIpc(const ext::shared_ptr<MarketModel>&,
                             const BrownianGeneratorFactory&,
@@ -47,6 +48,13 @@ namespace QuantLib {
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
         //@}
+        //! \name MarketModelBlockEvolver interface
+        //@{
+        void startNewBlock(Size paths, std::vector<Real>& weights);
+        void advanceBlockStep(std::vector<Real>& weights);
+        Size currentBlockStep() const;
+        const Matrix& currentBlockForwards() const;
+        //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
         // inputs
@@ -65,6 +73,12 @@ namespace QuantLib {
         std::vector<Real> brownians_, correlatedBrownians_;
         std::vector<Time> rateTaus_;
         std::vector<Size> alive_;
+        // block of paths, one column per path
+        Size currentBlockStep_;
+        Matrix blockForwards_, blockLogForwards_, blockDrifts1_, blockG_;
+        Matrix blockStepWeights_;
+        std::vector<Matrix> blockBrownians_;
+        std::vector<Real> blockDiffusion_, blockDrifts2_;
         //std::vector<Matrix> C_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
@@ -23,6 +23,7 @@
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/utilities.hpp>
 
 namespace QuantLib {
 
@@ -43,7 +44,8 @@ namespace QuantLib {
       drifts1_(numberOfRates_), drifts2_(numberOfRates_),
       initialDrifts_(numberOfRates_), brownians_(numberOfFactors_),
       correlatedBrownians_(numberOfRates_),
-      alive_(marketModel->evolution().firstAliveRate())
+      alive_(marketModel->evolution().firstAliveRate()),
+      currentBlockStep_(initialStep)
     {
         checkCompatibility(marketModel->evolution(), numeraires);
 
@@ -152,4 +154,96 @@ namespace QuantLib {
         return curveState_;
     }
 
+    void LogNormalFwdRatePc::startNewBlock(Size paths,
+                                           std::vector<Real>& weights) {
+        QL_REQUIRE(paths>0, "at least one path required");
+        drawBrownianBlock(*generator_, paths, weights,
+                          blockBrownians_, blockStepWeights_);
+
+        if (blockForwards_.columns() != paths) {
+            blockForwards_ = Matrix(numberOfRates_, paths);
+            blockLogForwards_ = Matrix(numberOfRates_, paths);
+            blockDrifts1_ = Matrix(numberOfRates_, paths);
+            blockDrifts2_ = Matrix(numberOfRates_, paths);
+            blockDiffusion_.resize(paths);
+        }
+        for (Size i=0; i<numberOfRates_; ++i) {
+            std::fill(blockLogForwards_.row_begin(i),
+                      blockLogForwards_.row_end(i), initialLogForwards_[i]);
+            std::fill(blockForwards_.row_begin(i), blockForwards_.row_end(i),
+                      std::exp(initialLogForwards_[i]) - displacements_[i]);
+        }
+        currentBlockStep_ = initialStep_;
+    }
+
+    void LogNormalFwdRatePc::advanceBlockStep(std::vector<Real>& weights) {
+        const Size paths = blockForwards_.columns();
+        QL_REQUIRE(paths>0, "no block of paths started");
+        Size i, p, alive = alive_[currentBlockStep_];
+
+        // a) compute drifts D1 at T1;
+        if (currentBlockStep_ > initialStep_) {
+            calculators_[currentBlockStep_].compute(blockForwards_,
+                                                    blockDrifts1_);
+        } else {
+            for (i=alive; i<numberOfRates_; ++i)
+                std::fill(blockDrifts1_.row_begin(i),
+                          blockDrifts1_.row_end(i), initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        const Size step = currentBlockStep_ - initialStep_;
+        const Matrix& brownians = blockBrownians_[step];
+        const Matrix& A = marketModel_->pseudoRoot(currentBlockStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentBlockStep_];
+
+        for (i=alive; i<numberOfRates_; ++i) {
+            std::fill(blockDiffusion_.begin(), blockDiffusion_.end(), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = A[i][r];
+                Matrix::const_row_iterator w = brownians.row_begin(r);
+                for (p=0; p<paths; ++p)
+                    blockDiffusion_[p] += a*w[p];
+            }
+            Matrix::row_iterator x = blockLogForwards_.row_begin(i);
+            Matrix::row_iterator f = blockForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+            const Real fixed = fixedDrift[i], d = displacements_[i];
+            for (p=0; p<paths; ++p) {
+                x[p] += d1[p] + fixed;
+                x[p] += blockDiffusion_[p];
+                f[p] = std::exp(x[p]) - d;
+            }
+        }
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentBlockStep_].compute(blockForwards_,
+                                                blockDrifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Matrix::row_iterator x = blockLogForwards_.row_begin(i);
+            Matrix::row_iterator f = blockForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = blockDrifts1_.row_begin(i);
+            Matrix::const_row_iterator d2 = blockDrifts2_.row_begin(i);
+            const Real d = displacements_[i];
+            for (p=0; p<paths; ++p) {
+                x[p] += (d2[p]-d1[p])/2.0;
+                f[p] = std::exp(x[p]) - d;
+            }
+        }
+
+        weights.assign(blockStepWeights_.row_begin(step),
+                       blockStepWeights_.row_end(step));
+        ++currentBlockStep_;
+    }
+
+    Size LogNormalFwdRatePc::currentBlockStep() const {
+        return currentBlockStep_;
+    }
+
+    const Matrix& LogNormalFwdRatePc::currentBlockForwards() const {
+        return blockForwards_;
+    }
+
 }
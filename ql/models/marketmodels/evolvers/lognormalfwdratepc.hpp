@@ -32,7 +32,8 @@ namespace QuantLib {
     class BrownianGeneratorFactory;
 
     //! Predictor-Corrector
-    class LogNormalFwdRatePc : public MarketModelEvolver {
+    class LogNormalFwdRatePc : public MarketModelEvolver,
+                               public MarketModelBlockEvolver {
       public:
         LogNormalFwdRatePc(const ext::shared_ptr<MarketModel>&,
                            const BrownianGeneratorFactory&,
@@ -47,6 +48,13 @@ namespace QuantLib {
         const CurveState& currentState() const;
         void setInitialState(const CurveState&);
         //@}
+        //! \name MarketModelBlockEvolver interface
+        //@{
+        void startNewBlock(Size paths, std::vector<Real>& weights);
+        void advanceBlockStep(std::vector<Real>& weights);
+        Size currentBlockStep() const;
+        const Matrix& currentBlockForwards() const;
+        //@}
       private:
         void setForwards(const std::vector<Real>& forwards);
         // inputs
@@ -64,6 +72,12 @@ namespace QuantLib {
         std::vector<Real> drifts1_, drifts2_, initialDrifts_;
         std::vector<Real> brownians_, correlatedBrownians_;
         std::vector<Size> alive_;
+        // block of paths, one column per path
+        Size currentBlockStep_;
+        Matrix blockForwards_, blockLogForwards_;
+        Matrix blockDrifts1_, blockDrifts2_, blockStepWeights_;
+        std::vector<Matrix> blockBrownians_;
+        std::vector<Real> blockDiffusion_;
         // helper classes
         std::vector<LMMDriftCalculator> calculators_;
     };
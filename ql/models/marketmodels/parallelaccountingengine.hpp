@@ -0,0 +1,143 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelaccountingengine.hpp
+    \brief Accounting engine running several market-model simulations
+*/
+
+#ifndef quantlib_parallel_accounting_engine_hpp
+#define quantlib_parallel_accounting_engine_hpp
+
+#include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Engine collecting cash flows along several market-model simulations
+    /*! The paths are split among the given accounting engines, each
+        of which must own its evolver (and therefore its Brownian
+        generator) and its copy of the product; e.g., evolvers
+        built from MTBrownianGeneratorFactory instances with
+        different seeds give independent substreams.  When OpenMP
+        is enabled, the engines are run in parallel.
+
+        Paths are simulated in batches and added to the statistics
+        in a fixed order, i.e., first the batch of the first engine,
+        then the one of the second, and so on.  The results are
+        therefore reproducible and only depend on the engines
+        and on the batch size, not on the number of threads
+        actually used.
+
+        Engine can be AccountingEngine or PathwiseAccountingEngine.
+    */
+    template <class Engine = AccountingEngine>
+    class ParallelAccountingEngine {
+      public:
+        explicit ParallelAccountingEngine(
+                         const std::vector<ext::shared_ptr<Engine> >& engines,
+                         Size batchSize = 1024);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        std::vector<ext::shared_ptr<Engine> > engines_;
+        Size batchSize_;
+        // workspace
+        std::vector<std::vector<std::vector<Real> > > values_;
+        std::vector<std::vector<Real> > weights_;
+    };
+
+
+    // template definitions
+
+    template <class Engine>
+    ParallelAccountingEngine<Engine>::ParallelAccountingEngine(
+                         const std::vector<ext::shared_ptr<Engine> >& engines,
+                         Size batchSize)
+    : engines_(engines), batchSize_(batchSize),
+      values_(engines.size()), weights_(engines.size()) {
+        QL_REQUIRE(!engines_.empty(), "no accounting engines given");
+        QL_REQUIRE(batchSize_ > 0, "batch size must be positive");
+        for (Size i=0; i<engines_.size(); ++i) {
+            QL_REQUIRE(engines_[i], "null accounting engine given");
+            for (Size j=0; j<i; ++j)
+                QL_REQUIRE(engines_[i] != engines_[j],
+                           "accounting engine #" << i
+                           << " is the same as #" << j);
+        }
+        const Size numberOfValues = engines_.front()->numberOfValues();
+        for (Size i=0; i<engines_.size(); ++i) {
+            QL_REQUIRE(engines_[i]->numberOfValues() == numberOfValues,
+                       "accounting engine #" << i << " returns "
+                       << engines_[i]->numberOfValues() << " values, "
+                       << numberOfValues << " expected");
+            values_[i].resize(batchSize_,
+                              std::vector<Real>(numberOfValues));
+            weights_[i].resize(batchSize_);
+        }
+    }
+
+    template <class Engine>
+    void ParallelAccountingEngine<Engine>::multiplePathValues(
+                                                 SequenceStatisticsInc& stats,
+                                                 Size numberOfPaths) {
+        const Size n = engines_.size();
+
+        // paths to be simulated by each engine
+        std::vector<Size> remaining(n, numberOfPaths/n);
+        for (Size i=0; i<numberOfPaths%n; ++i)
+            ++remaining[i];
+
+        std::vector<Size> batch(n);
+        std::vector<std::string> errors(n);
+
+        while (remaining.front() > 0) {
+            for (Size i=0; i<n; ++i)
+                batch[i] = std::min(batchSize_, remaining[i]);
+
+            #pragma omp parallel for
+            for (long i=0; i<(long)n; ++i) {
+                try {
+                    for (Size j=0; j<batch[i]; ++j)
+                        weights_[i][j] =
+                            engines_[i]->singlePathValues(values_[i][j]);
+                } catch (std::exception& e) {
+                    errors[i] = e.what();
+                } catch (...) {
+                    errors[i] = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(errors[i].empty(),
+                           "accounting engine #" << i << " failed: "
+                           << errors[i]);
+                for (Size j=0; j<batch[i]; ++j)
+                    stats.add(values_[i][j], weights_[i][j]);
+                remaining[i] -= batch[i];
+            }
+        }
+    }
+
+}
+
+
+#endif
@@ -51,9 +51,13 @@ namespace QuantLib {
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        //! simulates a path, stores values and deltas and returns its weight
+        /*! \pre values must have numberOfValues() elements */
+        Real singlePathValues(std::vector<Real>& values);
+        Size numberOfValues() const {
+            return numberProducts_*(numberRates_+1);
+        }
       private:
-          Real singlePathValues(std::vector<Real>& values);
-
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         ext::shared_ptr<MarketModel> pseudoRootStructure_;
@@ -20,6 +20,7 @@
 */
 
 #include <ql/models/marketmodels/utilities.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/errors.hpp>
 #include <algorithm>
 #include <valarray>
@@ -126,4 +127,33 @@ namespace QuantLib {
     }
 
 
+    void drawBrownianBlock(BrownianGenerator& generator,
+                           Size paths,
+                           std::vector<Real>& pathWeights,
+                           std::vector<Matrix>& brownians,
+                           Matrix& stepWeights) {
+        const Size steps = generator.numberOfSteps();
+        const Size factors = generator.numberOfFactors();
+
+        pathWeights.resize(paths);
+        brownians.resize(steps);
+        for (Size i=0; i<steps; ++i) {
+            if (brownians[i].rows() != factors
+                || brownians[i].columns() != paths)
+                brownians[i] = Matrix(factors, paths);
+        }
+        if (stepWeights.rows() != steps || stepWeights.columns() != paths)
+            stepWeights = Matrix(steps, paths);
+
+        std::vector<Real> variates(factors);
+        for (Size p=0; p<paths; ++p) {
+            pathWeights[p] = generator.nextPath();
+            for (Size i=0; i<steps; ++i) {
+                stepWeights[i][p] = generator.nextStep(variates);
+                for (Size r=0; r<factors; ++r)
+                    brownians[i][r][p] = variates[r];
+            }
+        }
+    }
+
 }
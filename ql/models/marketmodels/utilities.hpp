@@ -22,12 +22,14 @@
 #ifndef quantlib_market_model_utilities_hpp
 #define quantlib_market_model_utilities_hpp
 
-#include <ql/types.hpp>
+#include <ql/math/matrix.hpp>
 #include <vector>
 #include <valarray>
 
 namespace QuantLib {
 
+    class BrownianGenerator;
+
     void mergeTimes(const std::vector<std::vector<Time> >& times,
                     std::vector<Time>& mergedTimes,
                     std::vector<std::valarray<bool> >& isPresent);
@@ -45,6 +47,19 @@ namespace QuantLib {
     void checkIncreasingTimes(const std::vector<Time>& times);
     void checkIncreasingTimesAndCalculateTaus(const std::vector<Time>& times,
                                               std::vector<Time>& taus);
+
+    /*! Draws a block of paths from the generator, in the same order
+        as a sequence of calls to nextPath() and nextStep() would.
+        The variates of the i-th step are stored in brownians[i],
+        one row per factor and one column per path; the weights of
+        the paths are stored in pathWeights and the weights of their
+        steps in the columns of stepWeights.
+    */
+    void drawBrownianBlock(BrownianGenerator& generator,
+                           Size paths,
+                           std::vector<Real>& pathWeights,
+                           std::vector<Matrix>& brownians,
+                           Matrix& stepWeights);
 }
 
 #endif
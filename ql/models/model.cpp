@@ -23,6 +23,10 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <exception>
+#include <map>
+#include <string>
 
 using std::vector;
 
@@ -31,7 +35,8 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      parallelCalibration_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -40,37 +45,175 @@ namespace QuantLib {
                             const vector<Real>& weights,
                             const Projection& projection)
             : model_(model, null_deleter()), instruments_(h),
-              weights_(weights), projection_(projection) {}
+              weights_(weights), projection_(projection),
+              firstEvaluation_(true) {
+            if (model->allowsParallelCalibration()
+                && !dynamic_cast<LazyObject*>(model)) {
+                // helpers sharing an engine are evaluated by one thread;
+                // helpers whose engines might modify shared state (e.g.,
+                // by registering with the model process) are evaluated
+                // serially
+                std::map<const PricingEngine*, Size> groupIndex;
+                for (Size i=0; i<instruments_.size(); i++) {
+                    ext::shared_ptr<BlackCalibrationHelper> helper =
+                        ext::dynamic_pointer_cast<BlackCalibrationHelper>(
+                                                             instruments_[i]);
+                    // implied-volatility errors also call blackPrice(),
+                    // which might register observers with shared
+                    // market data
+                    if (!helper || !helper->pricingEngine()
+                        || !helper->pricingEngine()->isThreadSafe()
+                        || (helper->calibrationErrorType() ==
+                                BlackCalibrationHelper::ImpliedVolError
+                            && !helper->isBlackPriceThreadSafe())) {
+                        serial_.push_back(i);
+                        continue;
+                    }
+                    const PricingEngine* engine =
+                        helper->pricingEngine().get();
+                    std::map<const PricingEngine*, Size>::const_iterator j =
+                        groupIndex.find(engine);
+                    if (j == groupIndex.end()) {
+                        groupIndex[engine] = groups_.size();
+                        groups_.push_back(vector<Size>(1, i));
+                    } else {
+                        groups_[j->second].push_back(i);
+                    }
+                }
+            }
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
+            const Array errors = calibrationErrors();
             Real value = 0.0;
-            for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
-            }
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = calibrationErrors();
+            for (Size i=0; i<instruments_.size(); i++)
+                values[i] *= std::sqrt(weights_[i]);
+            return values;
+        }
+
+        virtual void jacobian(Matrix& jac, const Array& params) const {
+            const Array allParams = projection_.include(params);
+            model_->setParams(allParams);
+            vector<Array> gradients(instruments_.size());
+            bool available = calibrationErrorGradients(gradients);
+            for (Size i=0; i<instruments_.size() && available; i++)
+                available = gradients[i].size() == allParams.size();
+            if (!available) {
+                // no analytic derivatives, use finite differences
+                CostFunction::jacobian(jac, params);
+                return;
+            }
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                const Array projected = projection_.project(gradients[i]);
+                for (Size j=0; j<projected.size(); j++)
+                    jac[i][j] = projected[j]*std::sqrt(weights_[i]);
             }
-            return values;
+        }
+
+        virtual void gradient(Array& grad, const Array& params) const {
+            Matrix jac(instruments_.size(), params.size());
+            jacobian(jac, params);
+            const Array errors = values(params);
+            const Real norm = std::sqrt(DotProduct(errors, errors));
+            grad = transpose(jac)*errors;
+            if (norm > 0.0)
+                grad /= norm;
         }
 
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Disposable<Array> calibrationErrors() const {
+            Array errors(instruments_.size());
+            if (groups_.size() < 2 || firstEvaluation_) {
+                for (Size i=0; i<instruments_.size(); i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                firstEvaluation_ = false;
+                return errors;
+            }
+
+            vector<std::string> failures(groups_.size());
+            #pragma omp parallel for
+            for (long g=0; g<(long)groups_.size(); ++g) {
+                try {
+                    for (Size k=0; k<groups_[g].size(); k++) {
+                        const Size i = groups_[g][k];
+                        errors[i] = instruments_[i]->calibrationError();
+                    }
+                } catch (std::exception& e) {
+                    failures[g] = e.what();
+                } catch (...) {
+                    failures[g] = "unknown error";
+                }
+            }
+            for (Size g=0; g<groups_.size(); g++)
+                QL_REQUIRE(failures[g].empty(), failures[g]);
+            for (Size k=0; k<serial_.size(); k++) {
+                const Size i = serial_[k];
+                errors[i] = instruments_[i]->calibrationError();
+            }
+            return errors;
+        }
+
+        bool calibrationErrorGradients(vector<Array>& gradients) const {
+            if (groups_.size() < 2 || firstEvaluation_) {
+                for (Size i=0; i<instruments_.size(); i++) {
+                    if (!instruments_[i]->calibrationErrorGradient(
+                                                              gradients[i]))
+                        return false;
+                }
+                return true;
+            }
+
+            vector<std::string> failures(groups_.size());
+            vector<int> available(groups_.size(), 1);
+            #pragma omp parallel for
+            for (long g=0; g<(long)groups_.size(); ++g) {
+                try {
+                    for (Size k=0; k<groups_[g].size() && available[g]; k++) {
+                        const Size i = groups_[g][k];
+                        available[g] =
+                            instruments_[i]->calibrationErrorGradient(
+                                                                gradients[i]);
+                    }
+                } catch (std::exception& e) {
+                    failures[g] = e.what();
+                } catch (...) {
+                    failures[g] = "unknown error";
+                }
+            }
+            bool result = true;
+            for (Size g=0; g<groups_.size(); g++) {
+                QL_REQUIRE(failures[g].empty(), failures[g]);
+                result = result && available[g];
+            }
+            for (Size k=0; k<serial_.size() && result; k++) {
+                const Size i = serial_[k];
+                result = instruments_[i]->calibrationErrorGradient(
+                                                                gradients[i]);
+            }
+            return result;
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelperBase> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        vector<vector<Size> > groups_;
+        // helpers evaluated after the parallel ones, by this thread
+        vector<Size> serial_;
+        mutable bool firstEvaluation_;
     };
 
     void CalibratedModel::calibrate(
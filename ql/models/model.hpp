@@ -134,6 +134,44 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! \name Parallel calibration
+        //@{
+        /*! When enabled, and OpenMP support is compiled in, the
+            calibration errors of the helpers are evaluated in
+            parallel after the model parameters have been set.
+
+            Helpers sharing a pricing engine are evaluated in
+            sequence by the same thread, since engines store their
+            arguments and results; each helper should therefore be
+            given its own engine (which can share the model) for the
+            evaluation to run in parallel.  Only helpers whose
+            engines declare themselves thread-safe (see
+            PricingEngine::isThreadSafe) are evaluated in parallel;
+            the others, as well as helpers other than
+            BlackCalibrationHelper instances and helpers with an
+            implied-volatility error whose blackPrice() isn't
+            thread-safe (see
+            BlackCalibrationHelper::isBlackPriceThreadSafe), are
+            evaluated serially after them.  The first
+            evaluation is serial, so that lazily-calculated market
+            data shared among the helpers (e.g., bootstrapped
+            curves) are calculated beforehand.
+
+            Models calculating their state lazily (e.g.,
+            Gaussian1dModel) are always calibrated serially.
+
+            The errors are stored in the order of the helpers, so
+            that the calibration gives the same result as in serial
+            mode.
+        */
+        void enableParallelCalibration(bool b = true) {
+            parallelCalibration_ = b;
+        }
+        bool allowsParallelCalibration() const {
+            return parallelCalibration_;
+        }
+        //@}
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -143,6 +181,7 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        bool parallelCalibration_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -40,6 +40,14 @@ namespace QuantLib {
         virtual const results* getResults() const = 0;
         virtual void reset() = 0;
         virtual void calculate() const = 0;
+        //! whether calculate() can run concurrently with other engines
+        /*! Engines returning true must not modify any state shared
+            with other engines (e.g., by registering observers with a
+            common process or term structure) during calculate().
+            Parallel model calibrations only evaluate helpers whose
+            engines return true in parallel.
+        */
+        virtual bool isThreadSafe() const { return false; }
     };
 
     class PricingEngine::arguments {
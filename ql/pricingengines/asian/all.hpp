@@ -9,4 +9,5 @@
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mcdiscreteasianengine.hpp>
+#include <ql/pricingengines/asian/mcmultilevelasianengine.hpp>
 
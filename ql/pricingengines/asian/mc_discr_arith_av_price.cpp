@@ -51,4 +51,51 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+
+    ArithmeticAPOGreeksPathPricer::ArithmeticAPOGreeksPathPricer(
+                 Option::Type type,
+                 Real strike,
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+                 const TimeGrid& grid,
+                 Time maturity,
+                 MonteCarloGreeks::Method method,
+                 Real runningSum,
+                 Size pastFixings)
+    : BlackScholesGreeksPathPricer(process, grid, method),
+      payoff_(type, strike), maturity_(maturity),
+      discount_(process->riskFreeRate()->discount(maturity)),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+        QL_REQUIRE(grid.mandatoryTimes()[0] != 0.0,
+                   "the initial value cannot be a fixing");
+    }
+
+    Real ArithmeticAPOGreeksPathPricer::averagePrice(const Path& path) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+        Real sum = std::accumulate(path.begin()+1,path.end(),runningSum_);
+        return sum/(pastFixings_ + n - 1);
+    }
+
+    Real ArithmeticAPOGreeksPathPricer::payoff(const Path& path,
+                                               Real& discountRho) const {
+        const Real value = discount_ * payoff_(averagePrice(path));
+        discountRho = -maturity_*value;
+        return value;
+    }
+
+    void ArithmeticAPOGreeksPathPricer::payoffGradient(
+                                                    const Path& path,
+                                                    Array& gradient) const {
+        const Real omega = payoff_.optionType() == Option::Call ? 1.0 : -1.0;
+        if (omega*(averagePrice(path) - payoff_.strike()) > 0.0) {
+            const Size n = path.length();
+            const Real g = omega * discount_ / (pastFixings_ + n - 1);
+            for (Size i=1; i<n; ++i)
+                gradient[i] = g;
+        }
+    }
+
 }
@@ -27,6 +27,7 @@
 
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/analytic_discr_geom_av_price.hpp>
+#include <ql/pricingengines/mcblackscholesgreeks.hpp>
 #include <ql/exercise.hpp>
 
 namespace QuantLib {
@@ -38,6 +39,11 @@ namespace QuantLib {
          AnalyticDiscreteGeometricAveragePriceAsianEngine (analytic discrete
          arithmetic average price engine) for control variation.
 
+         Delta, gamma, vega and rho can be estimated during the same
+         simulation, see MonteCarloGreeks; this is not possible when
+         the underlying value at the evaluation date is one of the
+         fixings.
+
          \ingroup asianengines
 
          \test the correctness of the returned value is tested by
@@ -55,6 +61,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename MCDiscreteAveragingAsianEngine<RNG,S>::stats_type
             stats_type;
+        typedef typename
+        MCDiscreteAveragingAsianEngine<RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
         // constructor
         MCDiscreteArithmeticAPEngine(
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -64,15 +73,18 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             MonteCarloGreeks::Method greeks = MonteCarloGreeks::None);
       protected:
         ext::shared_ptr<path_pricer_type> pathPricer() const;
+        ext::shared_ptr<greeks_path_pricer_type> greeksPathPricer() const;
         ext::shared_ptr<path_pricer_type> controlPathPricer() const;
         ext::shared_ptr<PricingEngine> controlPricingEngine() const {
             return ext::shared_ptr<PricingEngine>(
                 new AnalyticDiscreteGeometricAveragePriceAsianEngine(
                                                              this->process_));
         }
+        MonteCarloGreeks::Method greeks_;
     };
 
 
@@ -91,6 +103,29 @@ namespace QuantLib {
         Size pastFixings_;
     };
 
+    class ArithmeticAPOGreeksPathPricer : public BlackScholesGreeksPathPricer {
+      public:
+        ArithmeticAPOGreeksPathPricer(
+                 Option::Type type,
+                 Real strike,
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>&,
+                 const TimeGrid& grid,
+                 Time maturity,
+                 MonteCarloGreeks::Method method,
+                 Real runningSum = 0.0,
+                 Size pastFixings = 0);
+      protected:
+        Real payoff(const Path& path, Real& discountRho) const;
+        void payoffGradient(const Path& path, Array& gradient) const;
+      private:
+        Real averagePrice(const Path& path) const;
+        PlainVanillaPayoff payoff_;
+        Time maturity_;
+        DiscountFactor discount_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
 
     // inline definitions
 
@@ -104,7 +139,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             MonteCarloGreeks::Method greeks)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -112,7 +148,8 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed),
+      greeks_(greeks) {}
 
     template <class RNG, class S>
     inline
@@ -141,6 +178,42 @@ namespace QuantLib {
                     this->arguments_.pastFixings));
     }
 
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename
+        MCDiscreteArithmeticAPEngine<RNG,S>::greeks_path_pricer_type>
+        MCDiscreteArithmeticAPEngine<RNG,S>::greeksPathPricer() const {
+
+        if (greeks_ == MonteCarloGreeks::None)
+            return ext::shared_ptr<greeks_path_pricer_type>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        TimeGrid grid = this->timeGrid();
+        QL_REQUIRE(grid.mandatoryTimes()[0] != 0.0,
+                   "greeks not available when the current underlying "
+                   "value is one of the fixings");
+
+        return ext::make_shared<ArithmeticAPOGreeksPathPricer>(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    this->process_,
+                    grid,
+                    this->process_->riskFreeRate()->timeFromReference(
+                                                        exercise->lastDate()),
+                    greeks_,
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings);
+    }
+
     template <class RNG, class S>
     inline
     ext::shared_ptr<
@@ -182,6 +255,8 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withGreeks(
+                                             MonteCarloGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -191,6 +266,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        MonteCarloGreeks::Method greeks_;
     };
 
     template <class RNG, class S>
@@ -199,7 +275,8 @@ namespace QuantLib {
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      greeks_(MonteCarloGreeks::None) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -258,6 +335,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withGreeks(
+                                             MonteCarloGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -268,7 +353,8 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                greeks_));
     }
 
 
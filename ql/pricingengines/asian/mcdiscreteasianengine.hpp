@@ -61,6 +61,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename McSimulation<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef typename
+        McSimulation<SingleVariate,RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
         // constructor
         MCDiscreteAveragingAsianEngine(
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -96,6 +99,16 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+
+            if (this->mcModel_->greeksAccumulator().samples() > 0) {
+                // value, delta, gamma, vega and rho
+                std::vector<Real> greeks =
+                    this->mcModel_->greeksAccumulator().mean();
+                results_.delta = greeks[1];
+                results_.gamma = greeks[2];
+                results_.vega = greeks[3];
+                results_.rho = greeks[4];
+            }
         }
       protected:
         // McSimulation implementation
@@ -0,0 +1,46 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/asian/mcmultilevelasianengine.hpp>
+
+namespace QuantLib {
+
+    ArithmeticAPOFixingsPathPricer::ArithmeticAPOFixingsPathPricer(
+                                        Option::Type type,
+                                        Real strike,
+                                        DiscountFactor discount,
+                                        const std::vector<Size>& fixingNodes,
+                                        Real runningSum,
+                                        Size pastFixings)
+    : payoff_(type, strike), discount_(discount), fixingNodes_(fixingNodes),
+      runningSum_(runningSum), pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+        QL_REQUIRE(!fixingNodes_.empty(), "no fixings given");
+    }
+
+    Real ArithmeticAPOFixingsPathPricer::operator()(const Path& path) const {
+        Real sum = runningSum_;
+        for (Size i=0; i<fixingNodes_.size(); ++i)
+            sum += path[fixingNodes_[i]];
+
+        const Real averagePrice = sum/(pastFixings_ + fixingNodes_.size());
+        return discount_ * payoff_(averagePrice);
+    }
+
+}
+
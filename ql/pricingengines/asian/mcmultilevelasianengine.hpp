@@ -0,0 +1,203 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcmultilevelasianengine.hpp
+    \brief Multilevel Monte Carlo engine for arithmetic average price Asians
+*/
+
+#ifndef quantlib_mc_multilevel_asian_engine_hpp
+#define quantlib_mc_multilevel_asian_engine_hpp
+
+#include <ql/instruments/asianoption.hpp>
+#include <ql/pricingengines/mcmultilevelsimulation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/exercise.hpp>
+
+namespace QuantLib {
+
+    //!  Multilevel Monte Carlo engine for discrete arithmetic average price Asians
+    /*!  The fixing times are part of all simulation grids; the
+         intermediate steps between fixings are refined adaptively
+         until the discretization bias of the underlying process is
+         below the required tolerance. For processes that are
+         simulated exactly on the fixing times, such as the
+         Black-Scholes process, the corrections vanish and the engine
+         reduces to plain Monte Carlo on the coarsest grid.
+
+         The process type P must provide riskFreeRate() and its first
+         component must be the underlying asset, as it is the case for
+         the GeneralizedBlackScholesProcess and for the HestonProcess.
+
+         \ingroup asianengines
+
+         \test the correctness of the returned value is tested by
+               reproducing results of the single-level engine.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics,
+              class P = GeneralizedBlackScholesProcess>
+    class MCMultilevelDiscreteArithmeticAPEngine
+        : public DiscreteAveragingAsianOption::engine,
+          public McMultilevelSimulation<RNG,S> {
+      public:
+        typedef typename McMultilevelSimulation<RNG,S>::model_type
+            model_type;
+        typedef typename McMultilevelSimulation<RNG,S>::path_pricer_type
+            path_pricer_type;
+
+        /*! The coarsest grid contains the fixing times and, if
+            timeSteps is given, additional regularly spaced points
+            as in TimeGrid. */
+        MCMultilevelDiscreteArithmeticAPEngine(
+                                    const ext::shared_ptr<P>& process,
+                                    Size timeSteps,
+                                    Real requiredTolerance,
+                                    Size maxLevels = 10,
+                                    Size refinementFactor = 2,
+                                    Size initialSamples = 1000,
+                                    BigNatural seed = 0);
+        void calculate() const;
+      protected:
+        // McMultilevelSimulation implementation
+        TimeGrid timeGrid() const;
+        ext::shared_ptr<path_pricer_type> pathPricer(const TimeGrid&) const;
+        ext::shared_ptr<model_type> model() const {
+            return ext::make_shared<model_type>(process_, timeGrid(),
+                                                refinementFactor_, seed_);
+        }
+        std::vector<Time> fixingTimes() const;
+        // data members
+        ext::shared_ptr<P> process_;
+        Size timeSteps_;
+        Real requiredTolerance_;
+        Size maxLevels_, refinementFactor_, initialSamples_;
+        BigNatural seed_;
+    };
+
+
+    //! arithmetic average price path pricer with fixings on given nodes
+    class ArithmeticAPOFixingsPathPricer : public PathPricer<Path> {
+      public:
+        ArithmeticAPOFixingsPathPricer(Option::Type type,
+                                       Real strike,
+                                       DiscountFactor discount,
+                                       const std::vector<Size>& fixingNodes,
+                                       Real runningSum = 0.0,
+                                       Size pastFixings = 0);
+        Real operator()(const Path& path) const;
+      private:
+        PlainVanillaPayoff payoff_;
+        DiscountFactor discount_;
+        std::vector<Size> fixingNodes_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline MCMultilevelDiscreteArithmeticAPEngine<RNG,S,P>::
+    MCMultilevelDiscreteArithmeticAPEngine(const ext::shared_ptr<P>& process,
+                                           Size timeSteps,
+                                           Real requiredTolerance,
+                                           Size maxLevels,
+                                           Size refinementFactor,
+                                           Size initialSamples,
+                                           BigNatural seed)
+    : process_(process), timeSteps_(timeSteps),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      refinementFactor_(refinementFactor), initialSamples_(initialSamples),
+      seed_(seed) {
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline void
+    MCMultilevelDiscreteArithmeticAPEngine<RNG,S,P>::calculate() const {
+        QL_REQUIRE(arguments_.averageType == Average::Arithmetic,
+                   "arithmetic averaging required");
+
+        McMultilevelSimulation<RNG,S>::calculate(requiredTolerance_,
+                                                 maxLevels_,
+                                                 initialSamples_);
+        results_.value = this->mlmcModel_->value();
+        results_.errorEstimate = this->mlmcModel_->errorEstimate();
+        results_.additionalResults["levels"] = this->mlmcModel_->levels();
+        results_.additionalResults["cost"] = this->mlmcModel_->cost();
+    }
+
+    template <class RNG, class S, class P>
+    inline std::vector<Time>
+    MCMultilevelDiscreteArithmeticAPEngine<RNG,S,P>::fixingTimes() const {
+        const Date referenceDate = process_->riskFreeRate()->referenceDate();
+        std::vector<Time> fixingTimes;
+        for (Size i=0; i<arguments_.fixingDates.size(); i++) {
+            if (arguments_.fixingDates[i] >= referenceDate)
+                fixingTimes.push_back(
+                                  process_->time(arguments_.fixingDates[i]));
+        }
+
+        QL_REQUIRE(!fixingTimes.empty() &&
+                   (fixingTimes.size() > 1 || fixingTimes.front() > 0.0),
+                   "all fixings are in the past");
+        return fixingTimes;
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid
+    MCMultilevelDiscreteArithmeticAPEngine<RNG,S,P>::timeGrid() const {
+        const std::vector<Time> times = fixingTimes();
+        if (timeSteps_ != Null<Size>())
+            return TimeGrid(times.begin(), times.end(), timeSteps_);
+        else
+            return TimeGrid(times.begin(), times.end());
+    }
+
+    template <class RNG, class S, class P>
+    inline ext::shared_ptr<typename
+        MCMultilevelDiscreteArithmeticAPEngine<RNG,S,P>::path_pricer_type>
+    MCMultilevelDiscreteArithmeticAPEngine<RNG,S,P>::pathPricer(
+                                            const TimeGrid& grid) const {
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        const std::vector<Time> times = fixingTimes();
+        std::vector<Size> fixingNodes(times.size());
+        for (Size i=0; i<times.size(); ++i)
+            fixingNodes[i] = grid.index(times[i]);
+
+        return ext::make_shared<ArithmeticAPOFixingsPathPricer>(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    process_->riskFreeRate()->discount(exercise->lastDate()),
+                    fixingNodes,
+                    arguments_.runningAccumulator,
+                    arguments_.pastFixings);
+    }
+
+}
+
+
+#endif
@@ -248,4 +248,136 @@ namespace QuantLib {
         }
     }
 
+
+
+    BrownianBridgeBarrierPathPricer::BrownianBridgeBarrierPathPricer(
+                                Barrier::Type barrierType,
+                                Real barrier,
+                                Real rebate,
+                                Option::Type type,
+                                Real strike,
+                                const std::vector<DiscountFactor>& discounts,
+                                const std::vector<Real>& stepVariances)
+    : barrierType_(barrierType), barrier_(barrier),
+      rebate_(rebate), payoff_(type, strike), discounts_(discounts),
+      stepVariances_(stepVariances) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+        QL_REQUIRE(stepVariances_.size()+1 == discounts_.size(),
+                   "mismatch between step variances ("
+                   << stepVariances_.size() << ") and discounts ("
+                   << discounts_.size() << ")");
+    }
+
+
+    Real BrownianBridgeBarrierPathPricer::operator()(const Path& path) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+        QL_REQUIRE(n == discounts_.size(),
+                   "path length (" << n << ") doesn't match discounts ("
+                   << discounts_.size() << ")");
+
+        const bool isUp = (barrierType_ == Barrier::UpIn ||
+                           barrierType_ == Barrier::UpOut);
+        const bool knockIn = (barrierType_ == Barrier::DownIn ||
+                              barrierType_ == Barrier::UpIn);
+
+        // probability of not having crossed the barrier so far, and
+        // expected discounted rebate paid at the knock-out time
+        Real survival = 1.0, knockedOutRebate = 0.0;
+        for (Size i = 0; i < n-1 && survival > 0.0; i++) {
+            Real x = std::log(path[i] / barrier_);
+            Real y = std::log(path[i+1] / barrier_);
+            if (isUp) {
+                x = -x;
+                y = -y;
+            }
+            Real stepSurvival = 0.0;
+            if (x > 0.0 && y > 0.0 && stepVariances_[i] > 0.0)
+                stepSurvival =
+                    1.0 - std::exp(-2.0*x*y/stepVariances_[i]);
+            else if (x > 0.0 && y > 0.0)
+                stepSurvival = 1.0;
+            knockedOutRebate +=
+                survival*(1.0-stepSurvival)*rebate_*discounts_[i+1];
+            survival *= stepSurvival;
+        }
+
+        const Real vanilla = payoff_(path.back()) * discounts_.back();
+        if (knockIn)
+            return (1.0-survival)*vanilla
+                + survival*rebate_*discounts_.back();
+        else
+            return survival*vanilla + knockedOutRebate;
+    }
+
+
+    BiasedBarrierGreeksPathPricer::BiasedBarrierGreeksPathPricer(
+                 Barrier::Type barrierType,
+                 Real barrier,
+                 Real rebate,
+                 Option::Type type,
+                 Real strike,
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+                 const TimeGrid& grid)
+    : BlackScholesGreeksPathPricer(process, grid,
+                                   MonteCarloGreeks::LikelihoodRatio),
+      barrierType_(barrierType), barrier_(barrier),
+      rebate_(rebate), payoff_(type, strike), discounts_(grid.size()) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+        for (Size i=0; i<grid.size(); i++)
+            discounts_[i] = process->riskFreeRate()->discount(grid[i]);
+    }
+
+    Real BiasedBarrierGreeksPathPricer::payoff(const Path& path,
+                                               Real& discountRho) const {
+        static Size null = Null<Size>();
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        Size knockNode = null;
+        for (Size i = 1; i < n && knockNode == null; i++) {
+            switch (barrierType_) {
+              case Barrier::DownIn:
+              case Barrier::DownOut:
+                if (path[i] <= barrier_)
+                    knockNode = i;
+                break;
+              case Barrier::UpIn:
+              case Barrier::UpOut:
+                if (path[i] >= barrier_)
+                    knockNode = i;
+                break;
+              default:
+                QL_FAIL("unknown barrier type");
+            }
+        }
+
+        const bool knockIn = (barrierType_ == Barrier::DownIn ||
+                              barrierType_ == Barrier::UpIn);
+        const bool isOptionActive = knockIn ? (knockNode != null)
+                                            : (knockNode == null);
+        const TimeGrid& grid = path.timeGrid();
+
+        Real value;
+        Time paymentTime;
+        if (isOptionActive) {
+            value = payoff_(path.back()) * discounts_.back();
+            paymentTime = grid.back();
+        } else if (knockIn) {
+            value = rebate_*discounts_.back();
+            paymentTime = grid.back();
+        } else {
+            value = rebate_*discounts_[knockNode];
+            paymentTime = grid[knockNode];
+        }
+        discountRho = -paymentTime*value;
+        return value;
+    }
+
 }
@@ -28,6 +28,7 @@
 
 #include <ql/instruments/barrieroption.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/pricingengines/mcblackscholesgreeks.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/exercise.hpp>
 
@@ -47,6 +48,10 @@ namespace QuantLib {
         Journal of Derivatives; Winter 1998; 6, 2; pg. 65-83
         </i>
 
+        For the biased estimator, delta, gamma, vega and rho can be
+        estimated during the same simulation with the
+        likelihood-ratio method, see MonteCarloGreeks.
+
         \ingroup barrierengines
 
         \test the correctness of the returned value is tested by
@@ -63,6 +68,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename McSimulation<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef
+        typename McSimulation<SingleVariate,RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
         // constructor
         MCBarrierEngine(
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -74,7 +82,8 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed);
+             BigNatural seed,
+             MonteCarloGreeks::Method greeks = MonteCarloGreeks::None);
         void calculate() const {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
@@ -86,6 +95,16 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+
+            if (this->mcModel_->greeksAccumulator().samples() > 0) {
+                // value, delta, gamma, vega and rho
+                std::vector<Real> greeks =
+                    this->mcModel_->greeksAccumulator().mean();
+                results_.delta = greeks[1];
+                results_.gamma = greeks[2];
+                results_.vega = greeks[3];
+                results_.rho = greeks[4];
+            }
         }
       protected:
         // McSimulation implementation
@@ -99,6 +118,7 @@ namespace QuantLib {
                                                  grid, gen, brownianBridge_));
         }
         ext::shared_ptr<path_pricer_type> pathPricer() const;
+        ext::shared_ptr<greeks_path_pricer_type> greeksPathPricer() const;
         // data members
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -107,6 +127,7 @@ namespace QuantLib {
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
+        MonteCarloGreeks::Method greeks_;
     };
 
 
@@ -126,6 +147,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withGreeks(MonteCarloGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +156,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        MonteCarloGreeks::Method greeks_;
     };
 
 
@@ -178,6 +201,60 @@ namespace QuantLib {
     };
 
 
+    //! barrier path pricer using Brownian-bridge survival probabilities
+    /*! Instead of checking the barrier on the path nodes only, each
+        step is weighted with the probability that the Brownian bridge
+        between its end points does not cross the barrier.  No
+        additional random numbers are drawn, so that the estimator is
+        a smooth function of the path; this makes it suitable for
+        multilevel simulations.
+
+        The variances of the logarithm of the underlying on each step
+        are passed by the engine.
+    */
+    class BrownianBridgeBarrierPathPricer : public PathPricer<Path> {
+      public:
+        BrownianBridgeBarrierPathPricer(
+                                Barrier::Type barrierType,
+                                Real barrier,
+                                Real rebate,
+                                Option::Type type,
+                                Real strike,
+                                const std::vector<DiscountFactor>& discounts,
+                                const std::vector<Real>& stepVariances);
+        Real operator()(const Path& path) const;
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+        std::vector<Real> stepVariances_;
+    };
+
+
+    //! likelihood-ratio greeks for discretely-monitored barrier options
+    class BiasedBarrierGreeksPathPricer : public BlackScholesGreeksPathPricer {
+      public:
+        BiasedBarrierGreeksPathPricer(
+                 Barrier::Type barrierType,
+                 Real barrier,
+                 Real rebate,
+                 Option::Type type,
+                 Real strike,
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>&,
+                 const TimeGrid& grid);
+      protected:
+        Real payoff(const Path& path, Real& discountRho) const;
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+    };
+
+
 
     // template definitions
 
@@ -192,14 +269,15 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed)
+             BigNatural seed,
+             MonteCarloGreeks::Method greeks)
     : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance),
       isBiased_(isBiased),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), greeks_(greeks) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -212,6 +290,12 @@ namespace QuantLib {
         QL_REQUIRE(timeStepsPerYear != 0,
                    "timeStepsPerYear must be positive, " << timeStepsPerYear <<
                    " not allowed");
+        QL_REQUIRE(greeks_ == MonteCarloGreeks::None ||
+                   greeks_ == MonteCarloGreeks::LikelihoodRatio,
+                   "only likelihood-ratio greeks are available "
+                   "for barrier options");
+        QL_REQUIRE(greeks_ == MonteCarloGreeks::None || isBiased_,
+                   "greeks are only available for the biased estimator");
         registerWith(process_);
     }
 
@@ -271,6 +355,27 @@ namespace QuantLib {
         }
     }
 
+    template <class RNG, class S>
+    inline ext::shared_ptr<
+        typename MCBarrierEngine<RNG,S>::greeks_path_pricer_type>
+    MCBarrierEngine<RNG,S>::greeksPathPricer() const {
+        if (greeks_ == MonteCarloGreeks::None)
+            return ext::shared_ptr<greeks_path_pricer_type>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return ext::make_shared<BiasedBarrierGreeksPathPricer>(
+                                                     arguments_.barrierType,
+                                                     arguments_.barrier,
+                                                     arguments_.rebate,
+                                                     payoff->optionType(),
+                                                     payoff->strike(),
+                                                     process_,
+                                                     timeGrid());
+    }
+
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>::MakeMCBarrierEngine(
@@ -278,7 +383,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), greeks_(MonteCarloGreeks::None) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +455,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withGreeks(MonteCarloGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -367,7 +479,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   greeks_));
     }
 
 }
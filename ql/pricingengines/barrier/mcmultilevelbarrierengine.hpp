@@ -0,0 +1,186 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcmultilevelbarrierengine.hpp
+    \brief Multilevel Monte Carlo barrier option engine
+*/
+
+#ifndef quantlib_mc_multilevel_barrier_engine_hpp
+#define quantlib_mc_multilevel_barrier_engine_hpp
+
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/mcmultilevelsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo pricing engine for barrier options
+    /*! The barrier is monitored continuously: between the points of
+        the simulation grid, the crossing probability of the Brownian
+        bridge is taken into account (see
+        BrownianBridgeBarrierPathPricer) using the volatility of the
+        underlying at its initial state.  The grid refinement is then
+        chosen adaptively so that the remaining discretization bias
+        is below the required tolerance.
+
+        The process type P must provide riskFreeRate() and its first
+        component must be the underlying asset, as it is the case for
+        the GeneralizedBlackScholesProcess (e.g. with local volatility)
+        and for the HestonProcess.
+
+        \ingroup barrierengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics,
+              class P = GeneralizedBlackScholesProcess>
+    class MCMultilevelBarrierEngine : public BarrierOption::engine,
+                                      public McMultilevelSimulation<RNG,S> {
+      public:
+        typedef typename McMultilevelSimulation<RNG,S>::model_type
+            model_type;
+        typedef typename McMultilevelSimulation<RNG,S>::path_pricer_type
+            path_pricer_type;
+
+        MCMultilevelBarrierEngine(const ext::shared_ptr<P>& process,
+                                  Size timeSteps,
+                                  Size timeStepsPerYear,
+                                  Real requiredTolerance,
+                                  Size maxLevels = 10,
+                                  Size refinementFactor = 2,
+                                  Size initialSamples = 1000,
+                                  BigNatural seed = 0);
+        void calculate() const;
+      protected:
+        // McMultilevelSimulation implementation
+        TimeGrid timeGrid() const;
+        ext::shared_ptr<path_pricer_type> pathPricer(const TimeGrid&) const;
+        ext::shared_ptr<model_type> model() const {
+            return ext::make_shared<model_type>(process_, timeGrid(),
+                                                refinementFactor_, seed_);
+        }
+        // data members
+        ext::shared_ptr<P> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, refinementFactor_, initialSamples_;
+        BigNatural seed_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline MCMultilevelBarrierEngine<RNG,S,P>::MCMultilevelBarrierEngine(
+                                             const ext::shared_ptr<P>& process,
+                                             Size timeSteps,
+                                             Size timeStepsPerYear,
+                                             Real requiredTolerance,
+                                             Size maxLevels,
+                                             Size refinementFactor,
+                                             Size initialSamples,
+                                             BigNatural seed)
+    : process_(process), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      refinementFactor_(refinementFactor), initialSamples_(initialSamples),
+      seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline void MCMultilevelBarrierEngine<RNG,S,P>::calculate() const {
+        // one-dimensional processes hide the multi-dimensional interface
+        const StochasticProcess& process = *process_;
+        const Real spot = process.initialValues()[0];
+        QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
+        QL_REQUIRE(!triggered(spot), "barrier touched");
+
+        McMultilevelSimulation<RNG,S>::calculate(requiredTolerance_,
+                                                 maxLevels_,
+                                                 initialSamples_);
+        results_.value = this->mlmcModel_->value();
+        results_.errorEstimate = this->mlmcModel_->errorEstimate();
+        results_.additionalResults["levels"] = this->mlmcModel_->levels();
+        results_.additionalResults["cost"] = this->mlmcModel_->cost();
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid MCMultilevelBarrierEngine<RNG,S,P>::timeGrid() const {
+        const Time residualTime =
+            process_->time(arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(residualTime, timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*residualTime);
+            return TimeGrid(residualTime, std::max<Size>(steps, 1));
+        } else {
+            QL_FAIL("time steps not specified");
+        }
+    }
+
+    template <class RNG, class S, class P>
+    inline ext::shared_ptr<
+        typename MCMultilevelBarrierEngine<RNG,S,P>::path_pricer_type>
+    MCMultilevelBarrierEngine<RNG,S,P>::pathPricer(
+                                            const TimeGrid& grid) const {
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        // variance of the log of the underlying over each step
+        const StochasticProcess& process = *process_;
+        const Array x0 = process.initialValues();
+        std::vector<Real> variances(grid.size()-1);
+        for (Size i=0; i<variances.size(); i++) {
+            Matrix sigma = process.diffusion(grid[i], x0);
+            Real v = 0.0;
+            for (Size j=0; j<sigma.columns(); j++)
+                v += sigma[0][j]*sigma[0][j];
+            variances[i] = v*grid.dt(i);
+        }
+
+        return ext::make_shared<BrownianBridgeBarrierPathPricer>(
+                                                     arguments_.barrierType,
+                                                     arguments_.barrier,
+                                                     arguments_.rebate,
+                                                     payoff->optionType(),
+                                                     payoff->strike(),
+                                                     discounts,
+                                                     variances);
+    }
+
+}
+
+
+#endif
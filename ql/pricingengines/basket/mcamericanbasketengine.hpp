@@ -60,7 +60,8 @@ namespace QuantLib {
                                Size nCalibrationSamples = Null<Size>(),
                                Size polynomOrder = 2,
                                LsmBasisSystem::PolynomType
-                                   polynomType = LsmBasisSystem::Monomial);
+                                   polynomType = LsmBasisSystem::Monomial,
+                               bool streamingCalibration = false);
       protected:
         ext::shared_ptr<LongstaffSchwartzPathPricer<MultiPath> >
             lsmPathPricer() const;
@@ -90,6 +91,7 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withPolynomialOrder(Size polynmOrder);
         MakeMCAmericanBasketEngine&
             withBasisSystem(LsmBasisSystem::PolynomType polynomType);
+        MakeMCAmericanBasketEngine& withStreamingCalibration(bool b = true);
 
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
@@ -101,6 +103,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         Real tolerance_;
         BigNatural seed_;
+        bool streamingCalibration_;
     };
 
 
@@ -141,7 +144,8 @@ namespace QuantLib {
                    BigNatural seed,
                    Size nCalibrationSamples,
                    Size polynomOrder,
-                   LsmBasisSystem::PolynomType polynomType)
+                   LsmBasisSystem::PolynomType polynomType,
+                   bool streamingCalibration)
         : MCLongstaffSchwartzEngine<BasketOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -153,7 +157,11 @@ namespace QuantLib {
                                                       requiredTolerance,
                                                       maxSamples,
                                                       seed,
-                                                      nCalibrationSamples),
+                                                      nCalibrationSamples,
+                                                      boost::none,
+                                                      boost::none,
+                                                      Null<Size>(),
+                                                      streamingCalibration),
           polynomOrder_(polynomOrder), polynomType_(polynomType) {}
 
     template <class RNG>
@@ -201,7 +209,7 @@ namespace QuantLib {
       calibrationSamples_(Null<Size>()),
       polynomOrder_(2),
       polynomType_(LsmBasisSystem::Monomial),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), streamingCalibration_(false) {}
 
     template <class RNG>
     inline MakeMCAmericanBasketEngine<RNG>&
@@ -288,6 +296,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withStreamingCalibration(bool b) {
+        streamingCalibration_ = b;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -308,7 +323,8 @@ namespace QuantLib {
                                         seed_,
                                         calibrationSamples_,
                                         polynomOrder_,
-                                        polynomType_));
+                                        polynomType_,
+                                        streamingCalibration_));
     }
 
 }
@@ -20,6 +20,8 @@
 */
 
 #include <ql/pricingengines/basket/mceuropeanbasketengine.hpp>
+#include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -44,5 +46,212 @@ namespace QuantLib {
         return (*payoff_)(finalPrice) * discount_;
     }
 
-}
 
+    EuropeanBasketGreeksPathPricer::EuropeanBasketGreeksPathPricer(
+                     const ext::shared_ptr<BasketPayoff>& payoff,
+                     const ext::shared_ptr<StochasticProcessArray>& processes,
+                     const TimeGrid& grid,
+                     MonteCarloGreeks::Method method)
+    : payoff_(payoff), method_(method), basketType_(Linear),
+      maturity_(grid.back()), drifts_(processes->size()),
+      stdDevs_(processes->size()), sqrtDts_(grid.size()-1) {
+        QL_REQUIRE(method_ == MonteCarloGreeks::Pathwise ||
+                   method_ == MonteCarloGreeks::LikelihoodRatio,
+                   "invalid greeks method (" << method_ << ")");
+
+        const Size numAssets = processes->size();
+        for (Size j=0; j<numAssets; ++j) {
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+                ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                    processes->process(j));
+            QL_REQUIRE(process, "Black-Scholes process required");
+            detail::blackScholesLogMoments(*process, grid,
+                                           drifts_[j], stdDevs_[j]);
+            if (j == 0)
+                discount_ = process->riskFreeRate()->discount(maturity_);
+        }
+        for (Size i=0; i<sqrtDts_.size(); ++i)
+            sqrtDts_[i] = std::sqrt(grid.dt(i));
+
+        // w = L e, with w the correlated and e the independent
+        // variates; the diagonal of the inverse correlation is the
+        // one of (L^{-1})^T L^{-1}
+        const Matrix L = CholeskyDecomposition(processes->correlation());
+        inverseCholesky_ = Matrix(numAssets, numAssets, 0.0);
+        for (Size k=0; k<numAssets; ++k) {
+            QL_REQUIRE(L[k][k] > 0.0,
+                       "correlation matrix must be positive definite");
+            inverseCholesky_[k][k] = 1.0/L[k][k];
+            for (Size j=0; j<k; ++j) {
+                Real sum = 0.0;
+                for (Size m=j; m<k; ++m)
+                    sum += L[k][m]*inverseCholesky_[m][j];
+                inverseCholesky_[k][j] = -sum/L[k][k];
+            }
+        }
+        inverseCorrelationDiagonal_ = Array(numAssets, 0.0);
+        for (Size k=0; k<numAssets; ++k)
+            for (Size j=0; j<=k; ++j)
+                inverseCorrelationDiagonal_[j] +=
+                    inverseCholesky_[k][j]*inverseCholesky_[k][j];
+
+        if (method_ == MonteCarloGreeks::Pathwise) {
+            vanillaPayoff_ = ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                    payoff_->basePayoff());
+            QL_REQUIRE(vanillaPayoff_,
+                       "pathwise greeks are only available for "
+                       "plain-vanilla basket payoffs");
+            if (ext::dynamic_pointer_cast<MinBasketPayoff>(payoff_)) {
+                basketType_ = Min;
+            } else if (ext::dynamic_pointer_cast<MaxBasketPayoff>(payoff_)) {
+                basketType_ = Max;
+            } else if (ext::shared_ptr<AverageBasketPayoff> average =
+                       ext::dynamic_pointer_cast<AverageBasketPayoff>(
+                                                                payoff_)) {
+                weights_ = average->weights();
+                QL_REQUIRE(weights_.size() == numAssets,
+                           "wrong number of basket weights ("
+                           << weights_.size() << ", " << numAssets
+                           << " required)");
+            } else if (ext::dynamic_pointer_cast<SpreadBasketPayoff>(
+                                                                payoff_)) {
+                QL_REQUIRE(numAssets == 2,
+                           "payoff is only defined for two underlyings");
+                weights_ = Array(2, 1.0);
+                weights_[1] = -1.0;
+            } else {
+                QL_FAIL("pathwise greeks not available for this basket "
+                        "payoff; use the likelihood-ratio method");
+            }
+        }
+    }
+
+    void EuropeanBasketGreeksPathPricer::payoffGradient(
+                                                  const Array& finalPrice,
+                                                  Array& gradient) const {
+        std::fill(gradient.begin(), gradient.end(), 0.0);
+
+        const Real omega =
+            vanillaPayoff_->optionType() == Option::Call ? 1.0 : -1.0;
+        if (omega*(payoff_->accumulate(finalPrice)
+                   - vanillaPayoff_->strike()) <= 0.0)
+            return;
+
+        switch (basketType_) {
+          case Min:
+            gradient[std::min_element(finalPrice.begin(), finalPrice.end())
+                     - finalPrice.begin()] = omega*discount_;
+            break;
+          case Max:
+            gradient[std::max_element(finalPrice.begin(), finalPrice.end())
+                     - finalPrice.begin()] = omega*discount_;
+            break;
+          case Linear:
+            for (Size j=0; j<gradient.size(); ++j)
+                gradient[j] = omega*discount_*weights_[j];
+            break;
+          default:
+            QL_FAIL("unknown basket type");
+        }
+    }
+
+    Array EuropeanBasketGreeksPathPricer::operator()(
+                                           const MultiPath& multiPath) const {
+        const Size numAssets = multiPath.assetNumber();
+        QL_REQUIRE(numAssets == drifts_.size(),
+                   "wrong number of assets (" << numAssets << ", "
+                   << drifts_.size() << " required)");
+        const Size n = multiPath.pathSize();
+        QL_REQUIRE(n == sqrtDts_.size()+1,
+                   "path length (" << n << ") does not match time grid ("
+                   << sqrtDts_.size()+1 << " points)");
+
+        Array finalPrice(numAssets);
+        for (Size j=0; j<numAssets; ++j)
+            finalPrice[j] = multiPath[j].back();
+
+        const Real value = (*payoff_)(finalPrice) * discount_;
+
+        Array result(2 + 3*numAssets, 0.0);
+        result[0] = value;
+        result[1] = -maturity_*value;
+
+        // correlated Gaussian variates w driving each step, and the
+        // corresponding u = C^{-1} w, with C the correlation, which
+        // is the gradient of -log(density) wrt w
+        std::vector<Array> w(n-1, Array(numAssets)),
+                           u(n-1, Array(numAssets, 0.0));
+        Array e(numAssets);
+        for (Size i=0; i<n-1; ++i) {
+            for (Size j=0; j<numAssets; ++j) {
+                const Path& path = multiPath[j];
+                w[i][j] = (std::log(path[i+1]/path[i]) - drifts_[j][i])
+                        / stdDevs_[j][i];
+            }
+            // e = L^{-1} w and u = (L^{-1})^T e
+            for (Size k=0; k<numAssets; ++k) {
+                e[k] = 0.0;
+                for (Size j=0; j<=k; ++j)
+                    e[k] += inverseCholesky_[k][j]*w[i][j];
+            }
+            for (Size k=0; k<numAssets; ++k)
+                for (Size j=0; j<=k; ++j)
+                    u[i][j] += inverseCholesky_[k][j]*e[k];
+        }
+
+        // likelihood-ratio weights for the deltas; the initial values
+        // only enter the density of the first step
+        Array deltaWeights(numAssets);
+        for (Size j=0; j<numAssets; ++j)
+            deltaWeights[j] =
+                u[0][j]/(multiPath[j].front()*stdDevs_[j][0]);
+
+        if (method_ == MonteCarloGreeks::Pathwise) {
+            Array gradient(numAssets);
+            payoffGradient(finalPrice, gradient);
+
+            for (Size j=0; j<numAssets; ++j) {
+                const Real x0 = multiPath[j].front();
+                const Real g = gradient[j]*finalPrice[j];
+
+                // derivative of the final log-price w.r.t. a parallel
+                // shift of the volatility, at fixed Gaussian variates
+                Real dLogSdSigma = 0.0;
+                for (Size i=0; i<n-1; ++i)
+                    dLogSdSigma += sqrtDts_[i]*(w[i][j] - stdDevs_[j][i]);
+
+                const Real delta = g/x0;
+                result[1] += g*maturity_;
+                result[2+j] = delta;
+                result[2+numAssets+j] = delta*(deltaWeights[j] - 1.0/x0);
+                result[2+2*numAssets+j] = g*dLogSdSigma;
+            }
+        } else {
+            Real rhoWeight = 0.0;
+            for (Size j=0; j<numAssets; ++j) {
+                const Real x0 = multiPath[j].front();
+                const Real s0 = stdDevs_[j][0];
+
+                Real vegaWeight = 0.0;
+                for (Size i=0; i<n-1; ++i) {
+                    const Real s = stdDevs_[j][i];
+                    const Real dt = sqrtDts_[i]*sqrtDts_[i];
+                    vegaWeight +=
+                        sqrtDts_[i]*((u[i][j]*w[i][j] - 1.0)/s - u[i][j]);
+                    rhoWeight += u[i][j]*dt/s;
+                }
+
+                result[2+j] = value*deltaWeights[j];
+                result[2+numAssets+j] =
+                    value*((u[0][j]*u[0][j]
+                            - inverseCorrelationDiagonal_[j])/(s0*s0)
+                           - u[0][j]/s0)/(x0*x0);
+                result[2+2*numAssets+j] = value*vegaWeight;
+            }
+            result[1] += value*rhoWeight;
+        }
+
+        return result;
+    }
+
+}
@@ -27,6 +27,7 @@
 
 #include <ql/instruments/basketoption.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/pricingengines/mcblackscholesgreeks.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/exercise.hpp>
@@ -34,10 +35,21 @@
 namespace QuantLib {
 
     //! Pricing engine for European basket options using Monte Carlo simulation
-    /*! \ingroup basketengines
-
-        \test the correctness of the returned value is tested by
-              reproducing results available in literature.
+    /*! Estimators of rho and of the delta, gamma and vega with
+        respect to each underlying can be calculated during the same
+        simulation, either by the pathwise or by the likelihood-ratio
+        method; they are returned as the rho result and as the
+        "deltas", "gammas" and "vegas" additional results,
+        respectively.  See EuropeanBasketGreeksPathPricer for the
+        payoffs supported by each method.
+
+        \ingroup basketengines
+
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in literature.
+        - the correctness of the returned greeks is tested by
+          checking them against finite-difference results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanBasketEngine  : public BasketOption::engine,
@@ -49,6 +61,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename McSimulation<MultiVariate,RNG,S>::stats_type
             stats_type;
+        typedef typename
+        McSimulation<MultiVariate,RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
         // constructor
         MCEuropeanBasketEngine(const ext::shared_ptr<StochasticProcessArray>&,
                                Size timeSteps,
@@ -58,7 +73,9 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               MonteCarloGreeks::Method greeks =
+                                                     MonteCarloGreeks::None);
         void calculate() const {
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
@@ -67,6 +84,19 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+            if (greeks_ != MonteCarloGreeks::None &&
+                this->greeksAccumulator().samples() > 0) {
+                std::vector<Real> greeks = this->greeksAccumulator().mean();
+                const Size n = processes_->size();
+                results_.rho = greeks[1];
+                results_.additionalResults["deltas"] =
+                    std::vector<Real>(greeks.begin()+2, greeks.begin()+2+n);
+                results_.additionalResults["gammas"] =
+                    std::vector<Real>(greeks.begin()+2+n,
+                                      greeks.begin()+2+2*n);
+                results_.additionalResults["vegas"] =
+                    std::vector<Real>(greeks.begin()+2+2*n, greeks.end());
+            }
         }
       protected:
         // McSimulation implementation
@@ -89,6 +119,7 @@ namespace QuantLib {
                                                  grid, gen, brownianBridge_));
         }
         ext::shared_ptr<path_pricer_type> pathPricer() const;
+        ext::shared_ptr<greeks_path_pricer_type> greeksPathPricer() const;
         // data members
         ext::shared_ptr<StochasticProcessArray> processes_;
         Size timeSteps_, timeStepsPerYear_;
@@ -97,6 +128,7 @@ namespace QuantLib {
         Real requiredTolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        MonteCarloGreeks::Method greeks_;
     };
 
 
@@ -115,6 +147,8 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
         MakeMCEuropeanBasketEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanBasketEngine& withGreeks(
+                                            MonteCarloGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -123,6 +157,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        MonteCarloGreeks::Method greeks_;
     };
 
 
@@ -136,6 +171,55 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    //! greeks of European basket options
+    /*! The returned array contains the discounted payoff, its rho
+        and its deltas, gammas and vegas with respect to each
+        underlying.
+
+        The correlated Gaussian variates driving the path are
+        recovered from its log-increments and decorrelated by means
+        of the Cholesky decomposition of the correlation matrix,
+        which must therefore be positive definite.  The
+        likelihood-ratio method works for any basket payoff.  The
+        pathwise method needs the gradient of the payoff with respect
+        to the final prices, which is calculated analytically (almost
+        everywhere) for plain-vanilla payoffs on the minimum, the
+        maximum, the weighted average or the spread of the basket;
+        other payoffs are rejected.  As for single assets, pathwise
+        gammas are obtained by applying the likelihood-ratio method
+        to the pathwise deltas.
+
+        \warning All the processes in the array must be
+                 Black-Scholes processes without forced
+                 discretization, see BlackScholesGreeksPathPricer.
+    */
+    class EuropeanBasketGreeksPathPricer
+        : public PathPricer<MultiPath, Array> {
+      public:
+        EuropeanBasketGreeksPathPricer(
+                     const ext::shared_ptr<BasketPayoff>& payoff,
+                     const ext::shared_ptr<StochasticProcessArray>& processes,
+                     const TimeGrid& grid,
+                     MonteCarloGreeks::Method method =
+                                                 MonteCarloGreeks::Pathwise);
+        Array operator()(const MultiPath& multiPath) const;
+      private:
+        enum BasketType { Min, Max, Linear };
+        // derivatives of the discounted payoff wrt the final prices
+        void payoffGradient(const Array& finalPrice, Array& gradient) const;
+        ext::shared_ptr<BasketPayoff> payoff_;
+        MonteCarloGreeks::Method method_;
+        BasketType basketType_;
+        Array weights_;
+        ext::shared_ptr<PlainVanillaPayoff> vanillaPayoff_;
+        Time maturity_;
+        DiscountFactor discount_;
+        std::vector<std::vector<Real> > drifts_, stdDevs_;
+        std::vector<Real> sqrtDts_;
+        Matrix inverseCholesky_;
+        Array inverseCorrelationDiagonal_;
+    };
+
 
     // template definitions
 
@@ -149,13 +233,14 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
+                   BigNatural seed,
+                   MonteCarloGreeks::Method greeks)
     : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), greeks_(greeks) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -207,6 +292,23 @@ namespace QuantLib {
                                            arguments_.exercise->lastDate())));
     }
 
+    template <class RNG, class S>
+    inline ext::shared_ptr<
+        typename MCEuropeanBasketEngine<RNG,S>::greeks_path_pricer_type>
+    MCEuropeanBasketEngine<RNG,S>::greeksPathPricer() const {
+
+        if (greeks_ == MonteCarloGreeks::None)
+            return ext::shared_ptr<greeks_path_pricer_type>();
+
+        ext::shared_ptr<BasketPayoff> payoff =
+            ext::dynamic_pointer_cast<BasketPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-basket payoff given");
+
+        return ext::make_shared<EuropeanBasketGreeksPathPricer>(
+                                                 payoff, processes_,
+                                                 timeGrid(), greeks_);
+    }
+
 
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>::MakeMCEuropeanBasketEngine(
@@ -214,7 +316,8 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0),
+      greeks_(MonteCarloGreeks::None) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
@@ -279,6 +382,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withGreeks(
+                                            MonteCarloGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanBasketEngine<RNG,S>::operator
@@ -295,7 +406,8 @@ namespace QuantLib {
                                           antithetic_,
                                           samples_, tolerance_,
                                           maxSamples_,
-                                          seed_));
+                                          seed_,
+                                          greeks_));
     }
 
 }
@@ -35,6 +35,7 @@
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
 #endif
 #include <boost/math/special_functions/atanh.hpp>
+#include <boost/math/special_functions/erf.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
@@ -815,4 +816,480 @@ namespace QuantLib {
         return bachelierBlackFormulaAssetItmProbability(payoff->optionType(),
             payoff->strike(), forward, stdDev);
     }
+
+    namespace {
+
+        void checkBatchSizes(const std::vector<Real>& strikes,
+                             const std::vector<Real>& forwards,
+                             const std::vector<Real>& stdDevs,
+                             const std::vector<Real>& discounts) {
+            const Size n = strikes.size();
+            QL_REQUIRE(forwards.size() == n,
+                       "wrong number of forwards (" << forwards.size()
+                       << "), " << n << " expected");
+            QL_REQUIRE(stdDevs.size() == n,
+                       "wrong number of stdDevs (" << stdDevs.size()
+                       << "), " << n << " expected");
+            QL_REQUIRE(discounts.size() == n,
+                       "wrong number of discounts (" << discounts.size()
+                       << "), " << n << " expected");
+            for (Size i=0; i<n; ++i) {
+                QL_REQUIRE(stdDevs[i]>=0.0,
+                           "stdDev (" << stdDevs[i]
+                           << ") must be non-negative");
+                QL_REQUIRE(discounts[i]>0.0,
+                           "discount (" << discounts[i]
+                           << ") must be positive");
+            }
+        }
+
+        void checkBatchParameters(const std::vector<Real>& strikes,
+                                  const std::vector<Real>& forwards,
+                                  const std::vector<Real>& stdDevs,
+                                  const std::vector<Real>& discounts,
+                                  Real displacement) {
+            checkBatchSizes(strikes, forwards, stdDevs, discounts);
+            for (Size i=0; i<strikes.size(); ++i)
+                checkParameters(strikes[i], forwards[i], displacement);
+        }
+
+    }
+
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Real>& forwards,
+                      const std::vector<Real>& stdDevs,
+                      const std::vector<Real>& discounts,
+                      std::vector<Real>& values,
+                      Real displacement) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts,
+                             displacement);
+
+        const Size n = strikes.size();
+        values.resize(n);
+        const CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real stdDev = stdDevs[i], discount = discounts[i];
+            if (stdDev==0.0) {
+                values[i] = std::max((forwards[i]-strikes[i])*optionType,
+                                     Real(0.0))*discount;
+                continue;
+            }
+            const Real forward = forwards[i] + displacement;
+            const Real strike = strikes[i] + displacement;
+            if (strike==0.0) {
+                values[i] = (optionType==Option::Call ? forward*discount
+                                                      : 0.0);
+                continue;
+            }
+            const Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+            const Real d2 = d1 - stdDev;
+            values[i] = discount * optionType *
+                (forward*phi(optionType*d1) - strike*phi(optionType*d2));
+        }
+    }
+
+    void blackFormulaWithGreeks(Option::Type optionType,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& stdDevs,
+                                const std::vector<Real>& discounts,
+                                std::vector<Real>& values,
+                                std::vector<Real>& deltas,
+                                std::vector<Real>& stdDevDerivatives,
+                                std::vector<Real>& gammas,
+                                Real displacement) {
+        checkBatchParameters(strikes, forwards, stdDevs, discounts,
+                             displacement);
+
+        const Size n = strikes.size();
+        values.resize(n);
+        deltas.resize(n);
+        stdDevDerivatives.resize(n);
+        gammas.resize(n);
+        const CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real stdDev = stdDevs[i], discount = discounts[i];
+            if (stdDev==0.0) {
+                const Real intrinsic = (forwards[i]-strikes[i])*optionType;
+                values[i] = std::max(intrinsic, Real(0.0))*discount;
+                deltas[i] = intrinsic > 0.0 ? optionType*discount : 0.0;
+                stdDevDerivatives[i] = gammas[i] = 0.0;
+                continue;
+            }
+            const Real forward = forwards[i] + displacement;
+            const Real strike = strikes[i] + displacement;
+            if (strike==0.0) {
+                const bool call = (optionType==Option::Call);
+                values[i] = call ? forward*discount : 0.0;
+                deltas[i] = call ? discount : 0.0;
+                stdDevDerivatives[i] = gammas[i] = 0.0;
+                continue;
+            }
+            const Real d1 = std::log(forward/strike)/stdDev + 0.5*stdDev;
+            const Real d2 = d1 - stdDev;
+            const Real nd1 = phi(optionType*d1);
+            const Real nd2 = phi(optionType*d2);
+            const Real density = phi.derivative(d1);
+            values[i] = discount * optionType * (forward*nd1 - strike*nd2);
+            deltas[i] = discount * optionType * nd1;
+            stdDevDerivatives[i] = discount * forward * density;
+            gammas[i] = discount * density / (forward*stdDev);
+        }
+    }
+
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               std::vector<Real>& values) {
+        checkBatchSizes(strikes, forwards, stdDevs, discounts);
+
+        const Size n = strikes.size();
+        values.resize(n);
+        const CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real stdDev = stdDevs[i], discount = discounts[i];
+            const Real d = (forwards[i]-strikes[i])*optionType;
+            if (stdDev==0.0) {
+                values[i] = discount*std::max(d, 0.0);
+                continue;
+            }
+            const Real h = d/stdDev;
+            values[i] = discount*(stdDev*phi.derivative(h) + d*phi(h));
+        }
+    }
+
+    void bachelierBlackFormulaWithGreeks(
+                                Option::Type optionType,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& stdDevs,
+                                const std::vector<Real>& discounts,
+                                std::vector<Real>& values,
+                                std::vector<Real>& deltas,
+                                std::vector<Real>& stdDevDerivatives,
+                                std::vector<Real>& gammas) {
+        checkBatchSizes(strikes, forwards, stdDevs, discounts);
+
+        const Size n = strikes.size();
+        values.resize(n);
+        deltas.resize(n);
+        stdDevDerivatives.resize(n);
+        gammas.resize(n);
+        const CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real stdDev = stdDevs[i], discount = discounts[i];
+            const Real d = (forwards[i]-strikes[i])*optionType;
+            if (stdDev==0.0) {
+                values[i] = discount*std::max(d, 0.0);
+                deltas[i] = d > 0.0 ? optionType*discount : 0.0;
+                stdDevDerivatives[i] = gammas[i] = 0.0;
+                continue;
+            }
+            const Real h = d/stdDev;
+            const Real nh = phi(h);
+            const Real density = phi.derivative(h);
+            values[i] = discount*(stdDev*density + d*nh);
+            deltas[i] = discount*optionType*nh;
+            stdDevDerivatives[i] = discount*density;
+            gammas[i] = discount*density/stdDev;
+        }
+    }
+
+    namespace {
+
+        // one step of Householder's method of order 3 for f(s) = 0,
+        // given nu = -f/f', h2 = f''/f' and h3 = f'''/f'
+        Real householderStep(Real nu, Real h2, Real h3) {
+            return nu*(1.0+0.5*h2*nu)/(1.0+nu*(h2+h3*nu/6.0));
+        }
+
+        // falls back to bisection (or to doubling, if no upper bound
+        // is known yet) when the step leaves the current bracket
+        Real safeguardedIterate(Real s, Real step, Real lower, Real upper) {
+            const Real next = s + step;
+            if (next > lower && next < upper)
+                return next;
+            return upper == QL_MAX_REAL ? 2.0*s : 0.5*(lower+upper);
+        }
+
+        // unlike CumulativeNormalDistribution, these keep full relative
+        // accuracy in the lower tail, which is needed to invert the
+        // prices of far out-of-the-money options
+        Real normalCdf(Real z) {
+            return 0.5*boost::math::erfc(-z*M_SQRT1_2);
+        }
+
+        Real normalPdf(Real z) {
+            return M_SQRT1_2*M_1_SQRTPI*std::exp(-0.5*z*z);
+        }
+
+        const Size maxImpliedStdDevIterations = 16;
+        const Real impliedStdDevTolerance = 1.0e-7;
+
+        /* The time value of the option equals the value of the
+           out-of-the-money option with the same strike (put-call
+           parity), whose normalized price is
+
+               b(x,s) = exp(x/2) N(x/s+s/2) - exp(-x/2) N(x/s-s/2)
+
+           with x = -|ln(F/K)| and s the standard deviation.  b is
+           increasing in s, convex below the inflection point
+           s_c = sqrt(-2x) and concave above it; on the convex branch
+           the iteration is run on ln(b), which is close to linear in
+           1/s for small prices.
+        */
+        Real householderBlackImpliedStdDev(Option::Type optionType,
+                                           Real strike,
+                                           Real forward,
+                                           Real undiscountedPrice) {
+            const Real intrinsic =
+                std::max(optionType*(forward-strike), Real(0.0));
+            const Real timeValue = undiscountedPrice - intrinsic;
+            // allow for round-off in the price of options deep in the money
+            if (timeValue == 0.0 || (intrinsic > 0.0 &&
+                                     close_enough(undiscountedPrice,
+                                                  intrinsic)))
+                return 0.0;
+            QL_REQUIRE(timeValue > 0.0,
+                       "option price (" << undiscountedPrice
+                       << ") below intrinsic value (" << intrinsic << ")");
+
+            const Real x = -std::fabs(std::log(forward/strike));
+            const Real beta = timeValue/std::sqrt(forward*strike);
+            const Real ex = std::exp(0.5*x);
+            QL_REQUIRE(beta < ex,
+                       "option price (" << undiscountedPrice
+                       << ") not below upper bound ("
+                       << (optionType == Option::Call ? forward : strike)
+                       << ")");
+            if (x == 0.0)
+                return 2.0*M_SQRT2*boost::math::erf_inv(beta);
+
+            const Real sc = std::sqrt(-2.0*x);
+            const bool convexBranch =
+                beta < ex*normalCdf(-0.5*sc) - normalCdf(-1.5*sc)/ex;
+
+            const Option::Type otmType =
+                intrinsic > 0.0 ? Option::Type(-optionType) : optionType;
+            Real s = blackFormulaImpliedStdDevApproximationRS(
+                             otmType, strike, forward, timeValue, 1.0, 0.0);
+            if (!(s > 0.0 && s < QL_MAX_REAL))
+                s = (sc > 0.0) ? sc : 1.0;
+
+            Real lower = 0.0, upper = QL_MAX_REAL;
+            for (Size i=0; i<maxImpliedStdDevIterations; ++i) {
+                const Real h = x/s, t = 0.5*s;
+                const Real b = ex*normalCdf(h+t) - normalCdf(h-t)/ex;
+                if (b < beta)
+                    lower = s;
+                else
+                    upper = s;
+
+                Real step;
+                if (convexBranch && b <= 0.0) {
+                    step = QL_MAX_REAL;
+                } else {
+                    const Real vega = normalPdf(h)*std::exp(-0.5*t*t);
+                    // b''/b' and b'''/b'
+                    const Real g2 = h*h/s - 0.5*t;
+                    const Real g3 = g2*g2 - 3.0*h*h/(s*s) - 0.25;
+                    if (convexBranch) {
+                        const Real r = vega/b;
+                        step = householderStep(-std::log(b/beta)/r,
+                                               g2 - r,
+                                               g3 - 3.0*g2*r + 2.0*r*r);
+                    } else {
+                        step = householderStep((beta-b)/vega, g2, g3);
+                    }
+                }
+
+                // with cubic convergence, the error after a step of
+                // this size is already at the level of round-off
+                if (std::fabs(step) <= impliedStdDevTolerance*s)
+                    return s + step;
+                s = safeguardedIterate(s, step, lower, upper);
+            }
+            QL_FAIL("Black implied volatility did not converge in "
+                    << maxImpliedStdDevIterations << " iterations"
+                    << " (strike " << strike << ", forward " << forward
+                    << ", undiscounted price " << undiscountedPrice
+                    << ", last estimate " << s << ")");
+        }
+
+        // The time value v(s) = s n(d/s) + d N(d/s), with d = -|F-K|,
+        // is convex in s; for small prices the iteration is run on ln(v).
+        Real householderBachelierImpliedStdDev(Option::Type optionType,
+                                               Real strike,
+                                               Real forward,
+                                               Real undiscountedPrice) {
+            const Real intrinsic =
+                std::max(optionType*(forward-strike), Real(0.0));
+            const Real timeValue = undiscountedPrice - intrinsic;
+            // allow for round-off in the price of options deep in the money
+            if (timeValue == 0.0 || (intrinsic > 0.0 &&
+                                     close_enough(undiscountedPrice,
+                                                  intrinsic)))
+                return 0.0;
+            QL_REQUIRE(timeValue > 0.0,
+                       "option price (" << undiscountedPrice
+                       << ") below intrinsic value (" << intrinsic << ")");
+
+            const Real d = -std::fabs(forward-strike);
+            if (d == 0.0)
+                return timeValue*M_SQRT2/M_1_SQRTPI;
+
+            const bool lowPrice =
+                timeValue < -d*(normalPdf(1.0) - normalCdf(-1.0));
+
+            const Option::Type otmType =
+                intrinsic > 0.0 ? Option::Type(-optionType) : optionType;
+            Real s = bachelierBlackFormulaImpliedVol(
+                             otmType, strike, forward, 1.0, timeValue, 1.0);
+            if (!(s > 0.0 && s < QL_MAX_REAL))
+                s = -d;
+
+            Real lower = 0.0, upper = QL_MAX_REAL;
+            for (Size i=0; i<maxImpliedStdDevIterations; ++i) {
+                const Real u = d/s;
+                const Real vega = normalPdf(u);
+                const Real v = s*vega + d*normalCdf(u);
+                if (v < timeValue)
+                    lower = s;
+                else
+                    upper = s;
+
+                Real step;
+                if (lowPrice && v <= 0.0) {
+                    step = QL_MAX_REAL;
+                } else {
+                    // v''/v' and v'''/v'
+                    const Real g2 = u*u/s;
+                    const Real g3 = g2*g2 - 3.0*g2/s;
+                    if (lowPrice) {
+                        const Real r = vega/v;
+                        step = householderStep(-std::log(v/timeValue)/r,
+                                               g2 - r,
+                                               g3 - 3.0*g2*r + 2.0*r*r);
+                    } else {
+                        step = householderStep((timeValue-v)/vega, g2, g3);
+                    }
+                }
+
+                // with cubic convergence, the error after a step of
+                // this size is already at the level of round-off
+                if (std::fabs(step) <= impliedStdDevTolerance*s)
+                    return s + step;
+                s = safeguardedIterate(s, step, lower, upper);
+            }
+            QL_FAIL("Bachelier implied volatility did not converge in "
+                    << maxImpliedStdDevIterations << " iterations"
+                    << " (strike " << strike << ", forward " << forward
+                    << ", undiscounted price " << undiscountedPrice
+                    << ", last estimate " << s << ")");
+        }
+
+        void checkImpliedBatchSizes(const std::vector<Real>& strikes,
+                                    const std::vector<Real>& forwards,
+                                    const std::vector<Real>& prices,
+                                    const std::vector<Real>& discounts) {
+            const Size n = strikes.size();
+            QL_REQUIRE(forwards.size() == n,
+                       "wrong number of forwards (" << forwards.size()
+                       << "), " << n << " expected");
+            QL_REQUIRE(prices.size() == n,
+                       "wrong number of prices (" << prices.size()
+                       << "), " << n << " expected");
+            QL_REQUIRE(discounts.size() == n,
+                       "wrong number of discounts (" << discounts.size()
+                       << "), " << n << " expected");
+        }
+
+    }
+
+    Real blackFormulaImpliedStdDevHouseholder(Option::Type optionType,
+                                              Real strike,
+                                              Real forward,
+                                              Real blackPrice,
+                                              Real discount,
+                                              Real displacement) {
+        checkParameters(strike, forward, displacement);
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+        return householderBlackImpliedStdDev(optionType,
+                                             strike + displacement,
+                                             forward + displacement,
+                                             blackPrice/discount);
+    }
+
+    Real blackFormulaImpliedStdDevHouseholder(
+                        const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+                        Real forward,
+                        Real blackPrice,
+                        Real discount,
+                        Real displacement) {
+        return blackFormulaImpliedStdDevHouseholder(payoff->optionType(),
+                                                    payoff->strike(),
+                                                    forward, blackPrice,
+                                                    discount, displacement);
+    }
+
+    Real bachelierBlackFormulaImpliedStdDev(Option::Type optionType,
+                                            Real strike,
+                                            Real forward,
+                                            Real bachelierPrice,
+                                            Real discount) {
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+        return householderBachelierImpliedStdDev(optionType, strike, forward,
+                                                 bachelierPrice/discount);
+    }
+
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   std::vector<Real>& stdDevs,
+                                   Real displacement) {
+        checkImpliedBatchSizes(strikes, forwards, blackPrices, discounts);
+
+        const Size n = strikes.size();
+        stdDevs.resize(n);
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i]
+                       << ") must be positive");
+            stdDevs[i] = householderBlackImpliedStdDev(
+                                              optionType,
+                                              strikes[i] + displacement,
+                                              forwards[i] + displacement,
+                                              blackPrices[i]/discounts[i]);
+        }
+    }
+
+    void bachelierBlackFormulaImpliedStdDev(
+                                Option::Type optionType,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& bachelierPrices,
+                                const std::vector<Real>& discounts,
+                                std::vector<Real>& stdDevs) {
+        checkImpliedBatchSizes(strikes, forwards, bachelierPrices, discounts);
+
+        const Size n = strikes.size();
+        stdDevs.resize(n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(discounts[i]>0.0,
+                       "discount (" << discounts[i]
+                       << ") must be positive");
+            stdDevs[i] = householderBachelierImpliedStdDev(
+                                          optionType, strikes[i], forwards[i],
+                                          bachelierPrices[i]/discounts[i]);
+        }
+    }
+
 }
@@ -175,6 +175,35 @@ namespace QuantLib {
                         Real accuracy = 1.0e-6,
                         Natural maxIterations = 100);
 
+    /*! Black 1976 implied standard deviation,
+        i.e. volatility*sqrt(timeToMaturity), at machine precision.
+
+        The price is reduced to the normalized price of the
+        out-of-the-money option and the normalized Black function is
+        inverted with Householder iterations of order 3, started from
+        the Radoicic-Stefanica approximation and run on the logarithm
+        of the price below the inflection point, in the spirit of
+
+        "Let's Be Rational"
+        P. Jaeckel, Wilmott Magazine, 2015(75), pp. 40-53
+
+        Two or three iterations are usually enough; no guess,
+        accuracy or maximum number of iterations is required.
+    */
+    Real blackFormulaImpliedStdDevHouseholder(Option::Type optionType,
+                                              Real strike,
+                                              Real forward,
+                                              Real blackPrice,
+                                              Real discount = 1.0,
+                                              Real displacement = 0.0);
+
+    Real blackFormulaImpliedStdDevHouseholder(
+                        const ext::shared_ptr<PlainVanillaPayoff>& payoff,
+                        Real forward,
+                        Real blackPrice,
+                        Real discount = 1.0,
+                        Real displacement = 0.0);
+
     /*! Black 1976 implied standard deviation,
          i.e. volatility*sqrt(timeToMaturity)
 
@@ -357,6 +386,19 @@ namespace QuantLib {
                                    Real bachelierPrice,
                                    Real discount = 1.0);
 
+    /*! Bachelier implied standard deviation, i.e.
+        volatility*sqrt(timeToMaturity), at machine precision.
+
+        The approximation by Choi, Kim and Kwak (see
+        bachelierBlackFormulaImpliedVol) is refined by Householder
+        iterations of order 3; one or two are usually enough.
+    */
+    Real bachelierBlackFormulaImpliedStdDev(Option::Type optionType,
+                                            Real strike,
+                                            Real forward,
+                                            Real bachelierPrice,
+                                            Real discount = 1.0);
+
     /*! Bachelier formula for standard deviation derivative
         \warning instead of volatility it uses standard deviation, i.e.
                  volatility*sqrt(timeToMaturity), and it returns the
@@ -394,6 +436,98 @@ namespace QuantLib {
                         Real forward,
                         Real stdDev);                                                
 
+    /*! Black 1976 formula on arrays of options sharing the same
+        type and displacement.  The results are the same as the ones
+        of blackFormula(); inputs are validated once and the
+        calculation runs in a single pass over contiguous arrays.
+
+        The output vector is resized as needed.
+    */
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      const std::vector<Real>& forwards,
+                      const std::vector<Real>& stdDevs,
+                      const std::vector<Real>& discounts,
+                      std::vector<Real>& values,
+                      Real displacement = 0.0);
+
+    /*! Black 1976 formula and its sensitivities on arrays of options
+        sharing the same type and displacement.  For each option it
+        returns the value, the delta and the gamma with respect to
+        the forward, and the derivative with respect to the standard
+        deviation (as in blackFormulaStdDevDerivative); the log-moneyness
+        and the normal distribution are evaluated only once and shared
+        among them.
+
+        The output vectors are resized as needed.
+    */
+    void blackFormulaWithGreeks(Option::Type optionType,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& stdDevs,
+                                const std::vector<Real>& discounts,
+                                std::vector<Real>& values,
+                                std::vector<Real>& deltas,
+                                std::vector<Real>& stdDevDerivatives,
+                                std::vector<Real>& gammas,
+                                Real displacement = 0.0);
+
+    /*! Bachelier formula on arrays of options sharing the same type.
+        The results are the same as the ones of bachelierBlackFormula().
+
+        The output vector is resized as needed.
+    */
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               const std::vector<Real>& forwards,
+                               const std::vector<Real>& stdDevs,
+                               const std::vector<Real>& discounts,
+                               std::vector<Real>& values);
+
+    /*! Bachelier formula and its sensitivities on arrays of options
+        sharing the same type; see blackFormulaWithGreeks().
+
+        The output vectors are resized as needed.
+    */
+    void bachelierBlackFormulaWithGreeks(
+                                Option::Type optionType,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& stdDevs,
+                                const std::vector<Real>& discounts,
+                                std::vector<Real>& values,
+                                std::vector<Real>& deltas,
+                                std::vector<Real>& stdDevDerivatives,
+                                std::vector<Real>& gammas);
+
+    /*! Black 1976 implied standard deviations of arrays of options
+        sharing the same type and displacement, as returned by
+        blackFormulaImpliedStdDevHouseholder().
+
+        The output vector is resized as needed.
+    */
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   const std::vector<Real>& discounts,
+                                   std::vector<Real>& stdDevs,
+                                   Real displacement = 0.0);
+
+    /*! Bachelier implied standard deviations of arrays of options
+        sharing the same type, as returned by
+        bachelierBlackFormulaImpliedStdDev().
+
+        The output vector is resized as needed.
+    */
+    void bachelierBlackFormulaImpliedStdDev(
+                                Option::Type optionType,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Real>& forwards,
+                                const std::vector<Real>& bachelierPrices,
+                                const std::vector<Real>& discounts,
+                                std::vector<Real>& stdDevs);
+
 }
 
 #endif
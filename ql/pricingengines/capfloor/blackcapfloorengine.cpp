@@ -89,6 +89,13 @@ namespace QuantLib {
         Date today = vol_->referenceDate();
         Date settlement = discountCurve_->referenceDate();
 
+        // collect the optionlets still alive...
+        std::vector<Size> alive;
+        std::vector<Real> forwards, discountedAccruals, sqrtTimes;
+        std::vector<Real> capStrikes, capStdDevs, floorStrikes, floorStdDevs;
+        bool hasCaplets = (type == CapFloor::Cap || type == CapFloor::Collar);
+        bool hasFloorlets =
+            (type == CapFloor::Floor || type == CapFloor::Collar);
         for (Size i=0; i<optionlets; ++i) {
             Date paymentDate = arguments_.endDates[i];
             // handling of settlementDate, npvDate and includeSettlementFlows
@@ -100,61 +107,85 @@ namespace QuantLib {
                 Real accrualFactor = arguments_.nominals[i] *
                                    arguments_.gearings[i] *
                                    arguments_.accrualTimes[i];
-                Real discountedAccrual = d * accrualFactor;
-                Rate forward = arguments_.forwards[i];
+                alive.push_back(i);
+                discountedAccruals.push_back(d * accrualFactor);
+                forwards.push_back(arguments_.forwards[i]);
 
                 Date fixingDate = arguments_.fixingDates[i];
                 Time sqrtTime = 0.0;
                 if (fixingDate > today)
                     sqrtTime = std::sqrt(vol_->timeFromReference(fixingDate));
+                sqrtTimes.push_back(sqrtTime);
 
-                if (type == CapFloor::Cap || type == CapFloor::Collar) {
+                // include optionlets with past fixing date
+                if (hasCaplets) {
                     Rate strike = arguments_.capRates[i];
-                    if (sqrtTime>0.0) {
-                        stdDevs[i] = std::sqrt(vol_->blackVariance(fixingDate,
-                                                                   strike));
-                        vegas[i] = blackFormulaStdDevDerivative(strike,
-                            forward, stdDevs[i], discountedAccrual, displacement_) 
-                            * sqrtTime;
-                        deltas[i] = blackFormulaAssetItmProbability(Option::Call,
-                            strike, forward, stdDevs[i], displacement_);
-                    }
-                    // include caplets with past fixing date
-                    values[i] = blackFormula(Option::Call,
-                        strike, forward, stdDevs[i], discountedAccrual, 
-                        displacement_);
+                    capStrikes.push_back(strike);
+                    capStdDevs.push_back(sqrtTime > 0.0 ?
+                        std::sqrt(vol_->blackVariance(fixingDate, strike)) :
+                        0.0);
                 }
-                if (type == CapFloor::Floor || type == CapFloor::Collar) {
+                if (hasFloorlets) {
                     Rate strike = arguments_.floorRates[i];
-                    Real floorletVega = 0.0;
-                    Real floorletDelta = 0.0;
-                    if (sqrtTime>0.0) {
-                        stdDevs[i] = std::sqrt(vol_->blackVariance(fixingDate,
-                                                                   strike));
-                        floorletVega = blackFormulaStdDevDerivative(strike,
-                            forward, stdDevs[i], discountedAccrual, displacement_) 
-                            * sqrtTime;
-                        floorletDelta = Option::Put * blackFormulaAssetItmProbability(
-                                                        Option::Put, strike, forward, 
-                                                        stdDevs[i], displacement_);
-                    }
-                    Real floorlet = blackFormula(Option::Put,
-                        strike, forward, stdDevs[i], discountedAccrual, displacement_);
-                    if (type == CapFloor::Floor) {
-                        values[i] = floorlet;
-                        vegas[i] = floorletVega;
-                        deltas[i] = floorletDelta;
-                    } else {
-                        // a collar is long a cap and short a floor
-                        values[i] -= floorlet;
-                        vegas[i] -= floorletVega;
-                        deltas[i] -= floorletDelta; 
-                    }
+                    floorStrikes.push_back(strike);
+                    floorStdDevs.push_back(sqrtTime > 0.0 ?
+                        std::sqrt(vol_->blackVariance(fixingDate, strike)) :
+                        0.0);
                 }
-                value += values[i];
-                vega += vegas[i];
             }
         }
+
+        // ...and price them in batches; the formulas are evaluated
+        // on unit discounts, which are then applied together with
+        // the accruals, so that deltas are returned undiscounted
+        std::vector<Real> unitDiscounts(alive.size(), 1.0);
+        std::vector<Real> prices, unitDeltas, stdDevDerivatives, gammas;
+        if (hasCaplets) {
+            blackFormulaWithGreeks(Option::Call, capStrikes, forwards, capStdDevs,
+                unitDiscounts, prices, unitDeltas, stdDevDerivatives,
+                gammas, displacement_);
+            for (Size j=0; j<alive.size(); ++j) {
+                Size i = alive[j];
+                stdDevs[i] = capStdDevs[j];
+                values[i] = prices[j] * discountedAccruals[j];
+                if (sqrtTimes[j] > 0.0) {
+                    vegas[i] = stdDevDerivatives[j] * discountedAccruals[j]
+                        * sqrtTimes[j];
+                    deltas[i] = unitDeltas[j];
+                }
+            }
+        }
+        if (hasFloorlets) {
+            blackFormulaWithGreeks(Option::Put, floorStrikes, forwards, floorStdDevs,
+                unitDiscounts, prices, unitDeltas, stdDevDerivatives,
+                gammas, displacement_);
+            for (Size j=0; j<alive.size(); ++j) {
+                Size i = alive[j];
+                stdDevs[i] = floorStdDevs[j];
+                Real floorlet = prices[j] * discountedAccruals[j];
+                Real floorletVega = 0.0;
+                Real floorletDelta = 0.0;
+                if (sqrtTimes[j] > 0.0) {
+                    floorletVega = stdDevDerivatives[j]
+                        * discountedAccruals[j] * sqrtTimes[j];
+                    floorletDelta = unitDeltas[j];
+                }
+                if (type == CapFloor::Floor) {
+                    values[i] = floorlet;
+                    vegas[i] = floorletVega;
+                    deltas[i] = floorletDelta;
+                } else {
+                    // a collar is long a cap and short a floor
+                    values[i] -= floorlet;
+                    vegas[i] -= floorletVega;
+                    deltas[i] -= floorletDelta;
+                }
+            }
+        }
+        for (Size j=0; j<alive.size(); ++j) {
+            value += values[alive[j]];
+            vega += vegas[alive[j]];
+        }
         results_.value = value;
         results_.additionalResults["vega"] = vega;
 
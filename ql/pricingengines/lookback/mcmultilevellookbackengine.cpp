@@ -0,0 +1,60 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/lookback/mcmultilevellookbackengine.hpp>
+
+namespace QuantLib {
+
+    LookbackFloatingPathPricer::LookbackFloatingPathPricer(
+                                                   Option::Type type,
+                                                   Real minmax,
+                                                   DiscountFactor discount,
+                                                   Real stepStdDev)
+    : type_(type), minmax_(minmax), discount_(discount) {
+        QL_REQUIRE(minmax_ > 0.0, "positive running extremum required");
+        QL_REQUIRE(stepStdDev >= 0.0,
+                   "negative step standard deviation ("
+                   << stepStdDev << ") not allowed");
+        // -zeta(1/2)/sqrt(2 pi)
+        const Real beta = 0.5825971579390106;
+        correction_ = std::exp(beta*stepStdDev);
+    }
+
+    Real LookbackFloatingPathPricer::operator()(const Path& path) const {
+        const Real terminal = path.back();
+        switch (type_) {
+          case Option::Call: {
+              Real minimum = path.front();
+              for (Size i=1; i<path.length(); ++i)
+                  minimum = std::min(minimum, path[i]);
+              minimum = std::min(minmax_, minimum/correction_);
+              return discount_ * (terminal - minimum);
+          }
+          case Option::Put: {
+              Real maximum = path.front();
+              for (Size i=1; i<path.length(); ++i)
+                  maximum = std::max(maximum, path[i]);
+              maximum = std::max(minmax_, maximum*correction_);
+              return discount_ * (maximum - terminal);
+          }
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+}
+
@@ -0,0 +1,200 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcmultilevellookbackengine.hpp
+    \brief Multilevel Monte Carlo engine for floating-strike lookbacks
+*/
+
+#ifndef quantlib_mc_multilevel_lookback_engine_hpp
+#define quantlib_mc_multilevel_lookback_engine_hpp
+
+#include <ql/instruments/lookbackoption.hpp>
+#include <ql/pricingengines/mcmultilevelsimulation.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+
+namespace QuantLib {
+
+    //! Multilevel Monte Carlo engine for continuous floating-strike lookbacks
+    /*! The running extremum is taken on the points of the simulation
+        grid and shifted by the continuity correction of Broadie,
+        Glasserman and Kou (see LookbackFloatingPathPricer) using the
+        volatility of the underlying at its initial state; the grid
+        refinement is then chosen adaptively so that the remaining
+        monitoring bias is below the required tolerance.
+
+        The process type P must provide riskFreeRate() and its first
+        component must be the underlying asset, as it is the case for
+        the GeneralizedBlackScholesProcess and for the HestonProcess.
+
+        \ingroup lookbackengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics,
+              class P = GeneralizedBlackScholesProcess>
+    class MCMultilevelContinuousFloatingLookbackEngine
+        : public ContinuousFloatingLookbackOption::engine,
+          public McMultilevelSimulation<RNG,S> {
+      public:
+        typedef typename McMultilevelSimulation<RNG,S>::model_type
+            model_type;
+        typedef typename McMultilevelSimulation<RNG,S>::path_pricer_type
+            path_pricer_type;
+
+        MCMultilevelContinuousFloatingLookbackEngine(
+                                    const ext::shared_ptr<P>& process,
+                                    Size timeSteps,
+                                    Size timeStepsPerYear,
+                                    Real requiredTolerance,
+                                    Size maxLevels = 10,
+                                    Size refinementFactor = 2,
+                                    Size initialSamples = 1000,
+                                    BigNatural seed = 0);
+        void calculate() const;
+      protected:
+        // McMultilevelSimulation implementation
+        TimeGrid timeGrid() const;
+        ext::shared_ptr<path_pricer_type> pathPricer(const TimeGrid&) const;
+        ext::shared_ptr<model_type> model() const {
+            return ext::make_shared<model_type>(process_, timeGrid(),
+                                                refinementFactor_, seed_);
+        }
+        // data members
+        ext::shared_ptr<P> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        Size maxLevels_, refinementFactor_, initialSamples_;
+        BigNatural seed_;
+    };
+
+
+    //! floating-strike lookback path pricer
+    /*! The extremum over the path nodes is shifted by
+        \f$ \exp(\pm \beta \sigma \sqrt{\Delta t}) \f$ with
+        \f$ \beta = -\zeta(1/2)/\sqrt{2\pi} \simeq 0.5826 \f$, which
+        removes the leading term of the bias of discrete monitoring
+        with respect to the continuous extremum; a null step standard
+        deviation gives the discretely monitored extremum.
+    */
+    class LookbackFloatingPathPricer : public PathPricer<Path> {
+      public:
+        LookbackFloatingPathPricer(Option::Type type,
+                                   Real minmax,
+                                   DiscountFactor discount,
+                                   Real stepStdDev = 0.0);
+        Real operator()(const Path& path) const;
+      private:
+        Option::Type type_;
+        Real minmax_;
+        DiscountFactor discount_;
+        Real correction_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S, class P>
+    inline MCMultilevelContinuousFloatingLookbackEngine<RNG,S,P>::
+    MCMultilevelContinuousFloatingLookbackEngine(
+                                             const ext::shared_ptr<P>& process,
+                                             Size timeSteps,
+                                             Size timeStepsPerYear,
+                                             Real requiredTolerance,
+                                             Size maxLevels,
+                                             Size refinementFactor,
+                                             Size initialSamples,
+                                             BigNatural seed)
+    : process_(process), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), maxLevels_(maxLevels),
+      refinementFactor_(refinementFactor), initialSamples_(initialSamples),
+      seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S, class P>
+    inline void
+    MCMultilevelContinuousFloatingLookbackEngine<RNG,S,P>::calculate() const {
+        McMultilevelSimulation<RNG,S>::calculate(requiredTolerance_,
+                                                 maxLevels_,
+                                                 initialSamples_);
+        results_.value = this->mlmcModel_->value();
+        results_.errorEstimate = this->mlmcModel_->errorEstimate();
+        results_.additionalResults["levels"] = this->mlmcModel_->levels();
+        results_.additionalResults["cost"] = this->mlmcModel_->cost();
+    }
+
+    template <class RNG, class S, class P>
+    inline TimeGrid
+    MCMultilevelContinuousFloatingLookbackEngine<RNG,S,P>::timeGrid() const {
+        const Time residualTime =
+            process_->time(arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(residualTime, timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*residualTime);
+            return TimeGrid(residualTime, std::max<Size>(steps, 1));
+        } else {
+            QL_FAIL("time steps not specified");
+        }
+    }
+
+    template <class RNG, class S, class P>
+    inline ext::shared_ptr<typename
+        MCMultilevelContinuousFloatingLookbackEngine<RNG,S,P>::path_pricer_type>
+    MCMultilevelContinuousFloatingLookbackEngine<RNG,S,P>::pathPricer(
+                                                const TimeGrid& grid) const {
+        ext::shared_ptr<FloatingTypePayoff> payoff =
+            ext::dynamic_pointer_cast<FloatingTypePayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-floating payoff given");
+
+        // average standard deviation of the log of the underlying
+        // over a step, used for the continuity correction
+        const StochasticProcess& process = *process_;
+        const Array x0 = process.initialValues();
+        Real variance = 0.0;
+        for (Size i=0; i<grid.size()-1; i++) {
+            Matrix sigma = process.diffusion(grid[i], x0);
+            for (Size j=0; j<sigma.columns(); j++)
+                variance += sigma[0][j]*sigma[0][j]*grid.dt(i);
+        }
+        const Real stepStdDev = std::sqrt(variance/(grid.size()-1));
+
+        return ext::make_shared<LookbackFloatingPathPricer>(
+                              payoff->optionType(),
+                              arguments_.minmax,
+                              process_->riskFreeRate()->discount(grid.back()),
+                              stepStdDev);
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,157 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/mcblackscholesgreeks.hpp>
+
+namespace QuantLib {
+
+    std::ostream& operator<<(std::ostream& out, MonteCarloGreeks::Method m) {
+        switch (m) {
+          case MonteCarloGreeks::None:
+            return out << "None";
+          case MonteCarloGreeks::Pathwise:
+            return out << "Pathwise";
+          case MonteCarloGreeks::LikelihoodRatio:
+            return out << "LikelihoodRatio";
+          default:
+            QL_FAIL("unknown Monte Carlo greeks method (" << Integer(m) << ")");
+        }
+    }
+
+
+    namespace detail {
+
+        void blackScholesLogMoments(
+                            const GeneralizedBlackScholesProcess& process,
+                            const TimeGrid& grid,
+                            std::vector<Real>& drifts,
+                            std::vector<Real>& stdDevs) {
+            QL_REQUIRE(grid.size() > 1, "no time steps given");
+            QL_REQUIRE(grid.front() == 0.0,
+                       "time grid must start at the evaluation date");
+
+            const Real x0 = process.x0();
+            const Size n = grid.size()-1;
+            drifts.resize(n);
+            stdDevs.resize(n);
+
+            Real previousVariance = 0.0;
+            for (Size i=0; i<n; ++i) {
+                const Time t0 = grid[i], t1 = grid[i+1];
+                const Real variance =
+                    process.blackVolatility()->blackVariance(t1, x0, true);
+                const Real v = variance - previousVariance;
+                QL_REQUIRE(v > 0.0,
+                           "non-positive variance (" << v
+                           << ") between times " << t0 << " and " << t1);
+                previousVariance = variance;
+
+                const Real mu =
+                    std::log(process.riskFreeRate()->discount(t0, true)
+                             / process.riskFreeRate()->discount(t1, true))
+                    - std::log(process.dividendYield()->discount(t0, true)
+                               / process.dividendYield()->discount(t1, true));
+                drifts[i] = mu - 0.5*v;
+                stdDevs[i] = std::sqrt(v);
+            }
+        }
+
+    }
+
+
+    BlackScholesGreeksPathPricer::BlackScholesGreeksPathPricer(
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+                 const TimeGrid& grid,
+                 MonteCarloGreeks::Method method)
+    : method_(method), sqrtDts_(grid.size()-1) {
+        QL_REQUIRE(method_ == MonteCarloGreeks::Pathwise ||
+                   method_ == MonteCarloGreeks::LikelihoodRatio,
+                   "invalid greeks method (" << method_ << ")");
+        detail::blackScholesLogMoments(*process, grid, drifts_, stdDevs_);
+        for (Size i=0; i<sqrtDts_.size(); ++i)
+            sqrtDts_[i] = std::sqrt(grid.dt(i));
+    }
+
+    void BlackScholesGreeksPathPricer::payoffGradient(const Path&,
+                                                      Array&) const {
+        QL_FAIL("pathwise greeks not available for this payoff");
+    }
+
+    Array BlackScholesGreeksPathPricer::operator()(const Path& path) const {
+        const Size n = path.length();
+        QL_REQUIRE(n == drifts_.size()+1,
+                   "path length (" << n << ") does not match time grid ("
+                   << drifts_.size()+1 << " points)");
+
+        const Real x0 = path.front();
+        const TimeGrid& grid = path.timeGrid();
+
+        // Gaussian variates driving the path
+        std::vector<Real> z(n-1);
+        for (Size i=0; i<n-1; ++i)
+            z[i] = (std::log(path[i+1]/path[i]) - drifts_[i])/stdDevs_[i];
+
+        Real discountRho;
+        const Real value = payoff(path, discountRho);
+
+        Array result(5);
+        result[0] = value;
+
+        // likelihood-ratio weight for delta; the initial value only
+        // enters the density of the first step
+        const Real s0 = stdDevs_[0];
+        const Real deltaWeight = z[0]/(x0*s0);
+
+        if (method_ == MonteCarloGreeks::Pathwise) {
+            Array gradient(n, 0.0);
+            payoffGradient(path, gradient);
+
+            // the pathwise delta is differentiated again by means of
+            // the likelihood-ratio weight; the 1/x0 term accounts for
+            // its explicit dependence on the initial value
+            Real delta = 0.0, vega = 0.0, rho = discountRho;
+            // derivative of the log-path wrt the volatility shift
+            Real dLogPath = 0.0;
+            for (Size i=1; i<n; ++i) {
+                dLogPath += sqrtDts_[i-1]*(z[i-1] - stdDevs_[i-1]);
+                const Real g = gradient[i]*path[i];
+                delta += g/x0;
+                vega += g*dLogPath;
+                rho += g*grid[i];
+            }
+            result[1] = delta;
+            result[2] = delta*(deltaWeight - 1.0/x0);
+            result[3] = vega;
+            result[4] = rho;
+        } else {
+            Real vegaWeight = 0.0, rhoWeight = 0.0;
+            for (Size i=0; i<n-1; ++i) {
+                const Real dt = sqrtDts_[i]*sqrtDts_[i];
+                vegaWeight += sqrtDts_[i]*((z[i]*z[i]-1.0)/stdDevs_[i] - z[i]);
+                rhoWeight += z[i]*dt/stdDevs_[i];
+            }
+            result[1] = value*deltaWeight;
+            result[2] = value*((z[0]*z[0]-1.0)/(x0*x0*s0*s0)
+                               - z[0]/(x0*x0*s0));
+            result[3] = value*vegaWeight;
+            result[4] = value*rhoWeight + discountRho;
+        }
+        return result;
+    }
+
+}
+
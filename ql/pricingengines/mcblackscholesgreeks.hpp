@@ -0,0 +1,113 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcblackscholesgreeks.hpp
+    \brief Monte Carlo greeks estimators for Black-Scholes processes
+*/
+
+#ifndef quantlib_mc_black_scholes_greeks_hpp
+#define quantlib_mc_black_scholes_greeks_hpp
+
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/array.hpp>
+
+namespace QuantLib {
+
+    //! Monte Carlo greeks estimators
+    struct MonteCarloGreeks {
+        enum Method { None,            /*!< no greeks calculation */
+                      Pathwise,        /*!< differentiates the discounted
+                                            payoff along each path; gamma
+                                            is obtained by applying the
+                                            likelihood-ratio method to
+                                            the pathwise delta */
+                      LikelihoodRatio  /*!< weights the discounted payoff
+                                            with the score of the path
+                                            density; works for
+                                            discontinuous payoffs */
+        };
+    };
+
+    /*! \relates MonteCarloGreeks */
+    std::ostream& operator<<(std::ostream&, MonteCarloGreeks::Method);
+
+
+    //! base class for path pricers returning value and greeks
+    /*! The path pricer returns the discounted payoff followed by
+        estimators of its delta, gamma, vega and rho; their averages
+        over the simulated paths are unbiased estimators of the
+        corresponding greeks.
+
+        The Gaussian variates driving the path are recovered from the
+        log-increments of the path itself, so that any path generator
+        (e.g., using a Brownian bridge) can be used.  Vega and rho are
+        the sensitivities to parallel shifts of the instantaneous
+        volatility and of the risk-free rate, respectively.
+
+        \warning The estimators assume that the process is evolved
+                 exactly, i.e., that the volatility does not depend
+                 on the strike and that no discretization is forced.
+                 The payoff must not depend on the first value of the
+                 path, which is the initial value of the process.
+
+        \ingroup mcarlo
+    */
+    class BlackScholesGreeksPathPricer : public PathPricer<Path, Array> {
+      public:
+        //! value, delta, gamma, vega and rho estimators
+        Array operator()(const Path& path) const;
+      protected:
+        BlackScholesGreeksPathPricer(
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>&,
+                 const TimeGrid& grid,
+                 MonteCarloGreeks::Method method);
+        //! discounted payoff
+        /*! The contribution of discounting to rho, i.e., the
+            derivative of the discounted payoff with respect to the
+            risk-free rate at fixed path, must be returned in
+            discountRho.
+        */
+        virtual Real payoff(const Path& path, Real& discountRho) const = 0;
+        //! derivatives of the discounted payoff with respect to the path
+        /*! Only needed by the pathwise method; the gradient has the
+            size of the path and its first element is ignored.  The
+            default implementation fails.
+        */
+        virtual void payoffGradient(const Path& path,
+                                    Array& gradient) const;
+      private:
+        MonteCarloGreeks::Method method_;
+        std::vector<Real> drifts_, stdDevs_, sqrtDts_;
+    };
+
+
+    namespace detail {
+
+        //! drift and standard deviation of the log-increments over a grid
+        void blackScholesLogMoments(const GeneralizedBlackScholesProcess&,
+                                    const TimeGrid& grid,
+                                    std::vector<Real>& drifts,
+                                    std::vector<Real>& stdDevs);
+
+    }
+
+}
+
+
+#endif
@@ -30,6 +30,7 @@
 #include <ql/exercise.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/methods/montecarlo/longstaffschwartzpathpricer.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
 
 
 namespace QuantLib {
@@ -68,7 +69,13 @@ namespace QuantLib {
           calibration and pricing; note however that this has no effect
           for low discrepancy RNGs usually, it is therefore recommended
           to use pseudo random generators for the calibration phase always
-          (and possibly quasi monte carlo in the subsequent pricing). */
+          (and possibly quasi monte carlo in the subsequent pricing).
+
+          If streamingCalibration is set, the calibration paths are
+          not stored but regenerated from the calibration seed for
+          each exercise date; this bounds the memory used by the
+          calibration to a few numbers per path and allows for
+          a much larger number of calibration samples. */
         MCLongstaffSchwartzEngine(
             const ext::shared_ptr<StochasticProcess>& process,
             Size timeSteps,
@@ -83,7 +90,8 @@ namespace QuantLib {
             Size nCalibrationSamples = Null<Size>(),
             boost::optional<bool> brownianBridgeCalibration = boost::none,
             boost::optional<bool> antitheticVariateCalibration = boost::none,
-            BigNatural seedCalibration = Null<Size>());
+            BigNatural seedCalibration = Null<Size>(),
+            bool streamingCalibration = false);
 
         void calculate() const;
 
@@ -94,6 +102,8 @@ namespace QuantLib {
         TimeGrid timeGrid() const;
         ext::shared_ptr<path_pricer_type> pathPricer() const;
         ext::shared_ptr<path_generator_type> pathGenerator() const;
+        ext::shared_ptr<path_generator_type_calibration>
+            pathGeneratorCalibration(BigNatural seed) const;
 
         ext::shared_ptr<StochasticProcess> process_;
         const Size timeSteps_;
@@ -107,6 +117,7 @@ namespace QuantLib {
         const bool brownianBridgeCalibration_;
         const bool antitheticVariateCalibration_;
         const BigNatural seedCalibration_;
+        const bool streamingCalibration_;
 
         mutable ext::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
@@ -131,7 +142,8 @@ namespace QuantLib {
             Size nCalibrationSamples,
             boost::optional<bool> brownianBridgeCalibration,
             boost::optional<bool> antitheticVariateCalibration,
-            BigNatural seedCalibration)
+            BigNatural seedCalibration,
+            bool streamingCalibration)
     : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
       process_            (process),
       timeSteps_          (timeSteps),
@@ -148,7 +160,8 @@ namespace QuantLib {
       antitheticVariateCalibration_(antitheticVariateCalibration ?
                                     *antitheticVariateCalibration : antitheticVariate),
       seedCalibration_(seedCalibration != Null<Real>() ?
-                         seedCalibration : (seed == 0 ? 0 : seed+1768237423L))
+                         seedCalibration : (seed == 0 ? 0 : seed+1768237423L)),
+      streamingCalibration_(streamingCalibration)
     {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
@@ -182,23 +195,29 @@ namespace QuantLib {
                                           RNG_Calibration>::calculate() const {
         // calibration
         pathPricer_ = this->lsmPathPricer();
-        Size dimensions = process_->factors();
-        TimeGrid grid = this->timeGrid();
-        typename RNG_Calibration::rsg_type generator =
-            RNG_Calibration::make_sequence_generator(
-                dimensions * (grid.size() - 1), seedCalibration_);
-        ext::shared_ptr<path_generator_type_calibration>
-            pathGeneratorCalibration =
-                ext::make_shared<path_generator_type_calibration>(
-                    process_, grid, generator, brownianBridgeCalibration_);
-        mcModelCalibration_ =
-            ext::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >(
-                new MonteCarloModel<MC, RNG_Calibration, S>(
-                    pathGeneratorCalibration, pathPricer_, stats_type(),
-                    this->antitheticVariateCalibration_));
+        if (streamingCalibration_) {
+            // every pass must regenerate the same paths, so a random
+            // seed is drawn once and shared by all of them
+            const BigNatural seed = (seedCalibration_ != 0)
+                ? seedCalibration_ : SeedGenerator::instance().get();
+            ext::function<ext::shared_ptr<path_generator_type_calibration>()>
+                generatorFactory = ext::bind(
+                    &MCLongstaffSchwartzEngine::pathGeneratorCalibration,
+                    this, seed);
+            pathPricer_->calibrate(generatorFactory,
+                                   nCalibrationSamples_,
+                                   antitheticVariateCalibration_);
+        } else {
+            mcModelCalibration_ =
+                ext::shared_ptr<MonteCarloModel<MC, RNG_Calibration, S> >(
+                    new MonteCarloModel<MC, RNG_Calibration, S>(
+                        pathGeneratorCalibration(seedCalibration_),
+                        pathPricer_,
+                        stats_type(), this->antitheticVariateCalibration_));
 
-        mcModelCalibration_->addSamples(nCalibrationSamples_);
-        pathPricer_->calibrate();
+            mcModelCalibration_->addSamples(nCalibrationSamples_);
+            pathPricer_->calibrate();
+        }
         // pricing
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
@@ -212,6 +231,23 @@ namespace QuantLib {
         }
     }
 
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline ext::shared_ptr<typename MCLongstaffSchwartzEngine<
+        GenericEngine, MC, RNG, S,
+        RNG_Calibration>::path_generator_type_calibration>
+    MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S,
+                              RNG_Calibration>::pathGeneratorCalibration(
+                                                   BigNatural seed) const {
+        Size dimensions = process_->factors();
+        TimeGrid grid = this->timeGrid();
+        typename RNG_Calibration::rsg_type generator =
+            RNG_Calibration::make_sequence_generator(
+                dimensions * (grid.size() - 1), seed);
+        return ext::make_shared<path_generator_type_calibration>(
+                    process_, grid, generator, brownianBridgeCalibration_);
+    }
+
     template <class GenericEngine, template <class> class MC, class RNG,
               class S, class RNG_Calibration>
     inline TimeGrid
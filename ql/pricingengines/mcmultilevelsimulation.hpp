@@ -0,0 +1,195 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcmultilevelsimulation.hpp
+    \brief framework for multilevel Monte Carlo engines
+*/
+
+#ifndef quantlib_mc_multilevel_simulation_hpp
+#define quantlib_mc_multilevel_simulation_hpp
+
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+
+namespace QuantLib {
+
+    //! base class for multilevel Monte Carlo engines
+    /*! This class is the multilevel counterpart of McSimulation.
+        Deriving engines provide the coarsest time grid, a path
+        pricer for any grid and the MultilevelMonteCarloModel to
+        be used; levels and samples are then added following the
+        adaptive algorithm by Giles until both the bias and the
+        statistical error of the estimate are below the required
+        tolerance.
+
+        Half of the mean squared error is allotted to the bias and
+        half to the statistical error; the number of samples on each
+        level is chosen as to minimize the total cost for the given
+        statistical error.
+
+        See MCMultilevelBarrierEngine as an example.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class McMultilevelSimulation {
+      public:
+        typedef MultilevelMonteCarloModel<RNG,S> model_type;
+        typedef typename model_type::path_pricer_type path_pricer_type;
+        typedef typename model_type::stats_type stats_type;
+
+        virtual ~McMultilevelSimulation() {}
+        //! add levels and samples until the required tolerance is reached
+        Real value(Real tolerance,
+                   Size maxLevels = 10,
+                   Size initialSamples = 1000) const;
+        //! error estimated using the samples simulated so far
+        Real errorEstimate() const;
+        //! access to the underlying model for richer statistics
+        const model_type& multilevelModel() const;
+        //! basic calculate method provided to inherited pricing engines
+        void calculate(Real requiredTolerance,
+                       Size maxLevels,
+                       Size initialSamples) const;
+      protected:
+        McMultilevelSimulation() {}
+        virtual ext::shared_ptr<model_type> model() const = 0;
+        virtual ext::shared_ptr<path_pricer_type> pathPricer(
+                                               const TimeGrid& grid) const = 0;
+        //! coarsest time grid
+        virtual TimeGrid timeGrid() const = 0;
+
+        mutable ext::shared_ptr<model_type> mlmcModel_;
+      private:
+        void addLevel() const;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline void McMultilevelSimulation<RNG,S>::addLevel() const {
+        mlmcModel_->addLevel(
+            pathPricer(mlmcModel_->timeGrid(mlmcModel_->levels())));
+    }
+
+    template <class RNG, class S>
+    inline Real McMultilevelSimulation<RNG,S>::value(
+                                                Real tolerance,
+                                                Size maxLevels,
+                                                Size initialSamples) const {
+        QL_REQUIRE(tolerance > 0.0,
+                   "positive tolerance required, " << tolerance
+                   << " not allowed");
+
+        const Size minLevels = 3;
+        QL_REQUIRE(maxLevels >= minLevels,
+                   "at least " << minLevels << " levels required, "
+                   << maxLevels << " given");
+        QL_REQUIRE(initialSamples > 1,
+                   "at least two initial samples required");
+
+        // fraction of the mean squared error allotted to the bias
+        const Real theta = 0.5;
+        const Real M = mlmcModel_->refinementFactor();
+
+        while (mlmcModel_->levels() < minLevels)
+            addLevel();
+        std::vector<Size> newSamples(mlmcModel_->levels(), initialSamples);
+
+        for (;;) {
+            const Size L = mlmcModel_->levels();
+            for (Size l=0; l<L; ++l) {
+                if (newSamples[l] > 0)
+                    mlmcModel_->addSamples(l, newSamples[l]);
+            }
+
+            std::vector<Real> variances(L), costs(L);
+            Real sum = 0.0;
+            for (Size l=0; l<L; ++l) {
+                costs[l] = mlmcModel_->levelCost(l);
+                variances[l] = mlmcModel_->levelAccumulator(l).variance();
+                sum += std::sqrt(variances[l]*costs[l]);
+            }
+
+            // optimal number of samples per level
+            bool converged = true;
+            for (Size l=0; l<L; ++l) {
+                const Real optimal =
+                    std::ceil(std::sqrt(variances[l]/costs[l])*sum
+                              / ((1.0-theta)*tolerance*tolerance));
+                const Size samples =
+                    mlmcModel_->levelAccumulator(l).samples();
+                newSamples[l] = (optimal > samples)
+                                ? Size(optimal) - samples : 0;
+                if (newSamples[l] > 0.01*samples)
+                    converged = false;
+            }
+
+            if (converged) {
+                // bias estimated from the corrections on the finest levels
+                const Real yL =
+                    std::fabs(mlmcModel_->levelAccumulator(L-1).mean());
+                const Real yL1 =
+                    std::fabs(mlmcModel_->levelAccumulator(L-2).mean());
+                Real alpha = 1.0;
+                if (yL > 0.0 && yL1 > 0.0)
+                    alpha = std::max(0.5, std::log(yL1/yL)/std::log(M));
+                const Real Ma = std::pow(M, alpha);
+                const Real bias = std::max(yL, yL1/Ma)/(Ma - 1.0);
+
+                if (bias <= std::sqrt(theta)*tolerance)
+                    break;
+
+                QL_REQUIRE(L < maxLevels,
+                           "max number of levels (" << maxLevels
+                           << ") reached, while the estimated bias ("
+                           << bias << ") is still above tolerance ("
+                           << std::sqrt(theta)*tolerance << ")");
+                addLevel();
+                newSamples.push_back(initialSamples);
+            }
+        }
+
+        return mlmcModel_->value();
+    }
+
+    template <class RNG, class S>
+    inline Real McMultilevelSimulation<RNG,S>::errorEstimate() const {
+        return mlmcModel_->errorEstimate();
+    }
+
+    template <class RNG, class S>
+    inline const typename McMultilevelSimulation<RNG,S>::model_type&
+    McMultilevelSimulation<RNG,S>::multilevelModel() const {
+        QL_REQUIRE(mlmcModel_, "multilevel model not initialized");
+        return *mlmcModel_;
+    }
+
+    template <class RNG, class S>
+    inline void McMultilevelSimulation<RNG,S>::calculate(
+                                                Real requiredTolerance,
+                                                Size maxLevels,
+                                                Size initialSamples) const {
+        QL_REQUIRE(requiredTolerance != Null<Real>(),
+                   "tolerance not set");
+
+        mlmcModel_ = model();
+        value(requiredTolerance, maxLevels, initialSamples);
+    }
+
+}
+
+
+#endif
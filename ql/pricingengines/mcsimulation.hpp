@@ -32,9 +32,10 @@
 namespace QuantLib {
 
     //! base class for Monte Carlo engines
-    /*! Eventually this class might offer greeks methods.  Deriving a
-        class from McSimulation gives an easy way to write a Monte
-        Carlo engine.
+    /*! Deriving a class from McSimulation gives an easy way to write
+        a Monte Carlo engine.  Engines can provide greeks by returning
+        a path pricer from greeksPathPricer(); its results are
+        accumulated during the same simulation used for the value.
 
         See McVanillaEngine as an example.
     */
@@ -49,6 +50,10 @@ namespace QuantLib {
         typedef typename MonteCarloModel<MC,RNG,S>::stats_type
             stats_type;
         typedef typename MonteCarloModel<MC,RNG,S>::result_type result_type;
+        typedef typename MonteCarloModel<MC,RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
+        typedef typename MonteCarloModel<MC,RNG,S>::greeks_stats_type
+            greeks_stats_type;
 
         virtual ~McSimulation() {}
         //! add samples until the required absolute tolerance is reached
@@ -61,6 +66,8 @@ namespace QuantLib {
         result_type errorEstimate() const;
         //! access to the sample accumulator for richer statistics
         const stats_type& sampleAccumulator() const;
+        //! access to the accumulator of the greeks path pricer, if any
+        const greeks_stats_type& greeksAccumulator() const;
         //! basic calculate method provided to inherited pricing engines
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
@@ -87,6 +94,10 @@ namespace QuantLib {
         virtual result_type controlVariateValue() const {
             return Null<result_type>();
         }
+        virtual ext::shared_ptr<greeks_path_pricer_type>
+        greeksPathPricer() const {
+            return ext::shared_ptr<greeks_path_pricer_type>();
+        }
         template <class Sequence>
         static Real maxError(const Sequence& sequence) {
             return *std::max_element(sequence.begin(), sequence.end());
@@ -186,13 +197,18 @@ namespace QuantLib {
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG));
+                           controlVariateValue, controlPG,
+                           this->greeksPathPricer()));
         } else {
             this->mcModel_ =
                 ext::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                     new MonteCarloModel<MC,RNG,S>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_));
+                           this->antitheticVariate_,
+                           ext::shared_ptr<path_pricer_type>(),
+                           result_type(),
+                           ext::shared_ptr<path_generator_type>(),
+                           this->greeksPathPricer()));
         }
 
         if (requiredTolerance != Null<Real>()) {
@@ -218,6 +234,12 @@ namespace QuantLib {
         return mcModel_->sampleAccumulator();
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline const typename McSimulation<MC,RNG,S>::greeks_stats_type&
+    McSimulation<MC,RNG,S>::greeksAccumulator() const {
+        return mcModel_->greeksAccumulator();
+    }
+
 }
 
 
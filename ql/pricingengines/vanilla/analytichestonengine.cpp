@@ -150,6 +150,16 @@ namespace QuantLib {
 
         Real operator()(Real phi) const;
 
+        // strike-independent part of the integrand, i.e.
+        // operator()(phi) = exp(lnChF(phi) + i*phi*(dd-ln(strike))).imag()/phi
+        // for phi != 0, with dd the log of the forward price
+        std::complex<Real> lnChF(Real phi) const;
+
+        // lnChF and its derivatives w.r.t. theta, kappa, sigma, rho and
+        // v0, apart from the add-on term (Gatheral's formulation only)
+        std::complex<Real> lnChF(Real phi,
+                                 std::complex<Real> gradient[5]) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -249,6 +259,35 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        return std::exp(lnChF(phi)
+                        + std::complex<Real>(0.0, phi*(dd_-sx_))).imag()/phi;
+    }
+
+    std::complex<Real> AnalyticHestonEngine::Fj_Helper::lnChF(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -261,54 +300,24 @@ namespace QuantLib {
             = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                    + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                    + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                    + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                    + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -354,11 +363,9 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -366,6 +373,63 @@ namespace QuantLib {
     }
 
 
+    std::complex<Real> AnalyticHestonEngine::Fj_Helper::lnChF(
+                            Real phi, std::complex<Real> gradient[5]) const {
+        QL_REQUIRE(cpxLog_ == Gatheral && sigma_ > 1e-5 && phi != 0.0,
+                   "derivatives not available");
+
+        const Real rho = rsigma_/sigma_;
+        const std::complex<Real> q(-phi*phi, (j_== 1)? phi : -phi);
+
+        const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rsigma_*phi);
+        const std::complex<Real> d = std::sqrt(t1*t1 - sigma2_*q);
+        const std::complex<Real> ex = std::exp(-d*term_);
+        const std::complex<Real> p = (t1-d)/(t1+d);
+        const std::complex<Real> g = std::log((1.0 - p*ex)/(1.0 - p));
+
+        // lnChF = v0*A + kappa*theta/sigma^2*B + add-on term
+        const std::complex<Real> h = 1.0/(sigma2_*(1.0-ex*p));
+        const std::complex<Real> A = (t1-d)*(1.0-ex)*h;
+        const std::complex<Real> B = (t1-d)*term_-2.0*g;
+        const Real kts = (kappa_*theta_)/sigma2_;
+
+        gradient[0] = kappa_/sigma2_*B;
+        gradient[4] = A;
+
+        // derivatives w.r.t. kappa, sigma and rho by the chain rule
+        const std::complex<Real> dt1[] = {
+            std::complex<Real>(1.0, 0.0),
+            std::complex<Real>((j_== 1)? -rho : 0.0, -rho*phi),
+            std::complex<Real>((j_== 1)? -sigma_ : 0.0, -sigma_*phi) };
+        const Real dKappa[] = { 1.0, 0.0, 0.0 };
+        const Real dSigma[] = { 0.0, 1.0, 0.0 };
+
+        for (Size l=0; l < 3; ++l) {
+            const std::complex<Real> dd
+                = (t1*dt1[l] - sigma_*dSigma[l]*q)/d;
+            const std::complex<Real> dex = -term_*ex*dd;
+            const std::complex<Real> dp
+                = 2.0*(d*dt1[l] - t1*dd)/((t1+d)*(t1+d));
+            const std::complex<Real> dg = dp/(1.0 - p)
+                - (dp*ex + p*dex)/(1.0 - p*ex);
+
+            const std::complex<Real> dA =
+                ((dt1[l]-dd)*(1.0-ex) - (t1-d)*dex)*h
+                + A*((dex*p + ex*dp)/(1.0-ex*p) - 2.0*dSigma[l]/sigma_);
+            const std::complex<Real> dB = (dt1[l]-dd)*term_ - 2.0*dg;
+
+            gradient[l+1] = v0_*dA + kts*dB
+                + (theta_*dKappa[l] - 2.0*kappa_*theta_*dSigma[l]/sigma_)
+                  /sigma2_*B;
+        }
+
+        const std::complex<Real> addOnTerm
+            = engine_ ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
+        return v0_*A + kts*B + addOnTerm;
+    }
+
+
     class AnalyticHestonEngine::AP_Helper {
       public:
         AP_Helper(Time term, Real s0, Real strike, Real ratio,
@@ -381,6 +445,12 @@ namespace QuantLib {
         }
 
         Real operator()(Real u) const {
+            return (std::exp(std::complex<Real>(0.0, u*(dd_-sx_)))
+                    * controlVariateTerm(u)).real();
+        }
+
+        // strike-independent part of the integrand
+        std::complex<Real> controlVariateTerm(Real u) const {
             QL_REQUIRE(   enginePtr_->addOnTerm(u, term_, 1)
                             == std::complex<Real>(0.0)
                        && enginePtr_->addOnTerm(u, term_, 2)
@@ -393,8 +463,7 @@ namespace QuantLib {
                 = std::exp(-0.5*sigmaBS_*sigmaBS_*term_
                            *(z*z + std::complex<Real>(-z.imag(), z.real())));
 
-            return (std::exp(std::complex<Real>(0.0, u*(dd_-sx_)))
-                * (phiBS - enginePtr_->chF(z, term_)) / (u*u + 0.25)).real();
+            return (phiBS - enginePtr_->chF(z, term_)) / (u*u + 0.25);
         }
 
       private:
@@ -618,6 +687,261 @@ namespace QuantLib {
     }
 
 
+    std::vector<Real> AnalyticHestonEngine::sliceValues(
+                            const Date& maturity,
+                            const std::vector<Real>& strikes,
+                            const std::vector<Option::Type>& types) const {
+        QL_REQUIRE(strikes.size() == types.size(),
+                   "number of strikes (" << strikes.size()
+                   << ") and of option types (" << types.size()
+                   << ") differ");
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0 = model_->v0();
+        const Real rho = model_->rho();
+
+        const Size n = strikes.size();
+        std::vector<Real> values(n);
+
+        if (!integration_->isGaussianQuadrature()) {
+            evaluations_ = 0;
+            for (Size i=0; i<n; ++i) {
+                Size evaluations;
+                doCalculation(riskFreeDiscount, dividendDiscount,
+                              spotPrice, strikes[i], term,
+                              kappa, theta, sigma, v0, rho,
+                              PlainVanillaPayoff(types[i], strikes[i]),
+                              *integration_, cpxLog_, this,
+                              values[i], evaluations);
+                evaluations_ += evaluations;
+            }
+            return values;
+        }
+
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real dd = std::log(spotPrice)-std::log(ratio);
+
+        std::vector<Real> u, w;
+
+        switch(cpxLog_) {
+          case Gatheral:
+          case BranchCorrection: {
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+            integration_->quadratureNodes(c_inf, u, w);
+            const Size m = u.size();
+
+            // the nodes are visited in the order of summation,
+            // as needed by the branch correction
+            const Fj_Helper f1(kappa, theta, sigma, v0, spotPrice, rho,
+                               this, cpxLog_, term, spotPrice, ratio, 1);
+            const Fj_Helper f2(kappa, theta, sigma, v0, spotPrice, rho,
+                               this, cpxLog_, term, spotPrice, ratio, 2);
+            std::vector<std::complex<Real> > lnF1(m), lnF2(m);
+            for (Size k=0; k<m; ++k) {
+                if (u[k] != 0.0) {
+                    lnF1[k] = f1.lnChF(u[k]);
+                    lnF2[k] = f2.lnChF(u[k]);
+                }
+            }
+            evaluations_ = 2*m;
+
+            for (Size i=0; i<n; ++i) {
+                const Real strike = strikes[i];
+                const Real sx = std::log(strike);
+
+                Real p1 = 0.0, p2 = 0.0;
+                for (Size k=0; k<m; ++k) {
+                    if (u[k] != 0.0) {
+                        const std::complex<Real> iu(0.0, u[k]*(dd-sx));
+                        p1 += w[k]*std::exp(lnF1[k] + iu).imag()/u[k];
+                        p2 += w[k]*std::exp(lnF2[k] + iu).imag()/u[k];
+                    } else {
+                        p1 += w[k]*Fj_Helper(kappa, theta, sigma, v0,
+                                             spotPrice, rho, this, cpxLog_,
+                                             term, strike, ratio, 1)(0.0);
+                        p2 += w[k]*Fj_Helper(kappa, theta, sigma, v0,
+                                             spotPrice, rho, this, cpxLog_,
+                                             term, strike, ratio, 2)(0.0);
+                    }
+                }
+                p1 /= M_PI;
+                p2 /= M_PI;
+
+                switch (types[i]) {
+                  case Option::Call:
+                    values[i] = spotPrice*dividendDiscount*(p1+0.5)
+                                   - strike*riskFreeDiscount*(p2+0.5);
+                    break;
+                  case Option::Put:
+                    values[i] = spotPrice*dividendDiscount*(p1-0.5)
+                                   - strike*riskFreeDiscount*(p2-0.5);
+                    break;
+                  default:
+                    QL_FAIL("unknown option type");
+                }
+            }
+          }
+          break;
+          case AndersenPiterbarg: {
+            const Real c_inf =
+                std::sqrt(1.0-rho*rho)*(v0 + kappa*theta*term)/sigma;
+            integration_->quadratureNodes(c_inf, u, w);
+            const Size m = u.size();
+
+            const Real fwdPrice = spotPrice / ratio;
+            const Real vAvg
+                = (1-std::exp(-kappa*term))*(v0-theta)/(kappa*term) + theta;
+
+            const AP_Helper cv(term, spotPrice, spotPrice, ratio,
+                               std::sqrt(vAvg), this);
+            std::vector<std::complex<Real> > cvTerm(m);
+            for (Size k=0; k<m; ++k)
+                cvTerm[k] = cv.controlVariateTerm(u[k]);
+            evaluations_ = m;
+
+            for (Size i=0; i<n; ++i) {
+                const Real strike = strikes[i];
+                const Real sx = std::log(strike);
+
+                Real h = 0.0;
+                for (Size k=0; k<m; ++k)
+                    h += w[k]*(std::exp(std::complex<Real>(0.0, u[k]*(dd-sx)))
+                               * cvTerm[k]).real();
+                const Real h_cv = h
+                    * std::sqrt(strike * fwdPrice)*riskFreeDiscount/M_PI;
+
+                const Real bsPrice
+                    = BlackCalculator(Option::Call, strike,
+                                      fwdPrice, std::sqrt(vAvg*term),
+                                      riskFreeDiscount).value();
+
+                switch (types[i]) {
+                  case Option::Call:
+                    values[i] = bsPrice + h_cv;
+                    break;
+                  case Option::Put:
+                    values[i] = bsPrice + h_cv
+                        - riskFreeDiscount*(fwdPrice - strike);
+                    break;
+                  default:
+                    QL_FAIL("unknown option type");
+                }
+            }
+          }
+          break;
+
+          default:
+            QL_FAIL("unknown complex log formula");
+        }
+
+        return values;
+    }
+
+
+    bool AnalyticHestonEngine::valueAndGradient(const Date& maturity,
+                                                Real strike,
+                                                Option::Type type,
+                                                Real& value,
+                                                Array& gradient) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0 = model_->v0();
+        const Real rho = model_->rho();
+
+        if (cpxLog_ != Gatheral || !integration_->isGaussianQuadrature()
+            || sigma <= 1e-5)
+            return false;
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real phase = std::log(spotPrice)-std::log(ratio)
+                         - std::log(strike);
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+        std::vector<Real> u, w;
+        integration_->quadratureNodes(c_inf, u, w);
+
+        const Size nHeston = 5;
+        const Size nParams = model_->params().size();
+
+        Real p[2];
+        Array dp[2];
+        std::complex<Real> hestonGradient[nHeston];
+        std::vector<std::complex<Real> > addOnGradient;
+
+        for (Size j=1; j <= 2; ++j) {
+            const Fj_Helper f(kappa, theta, sigma, v0, spotPrice, rho,
+                              this, cpxLog_, term, strike, ratio, j);
+            p[j-1] = 0.0;
+            dp[j-1] = Array(nParams, 0.0);
+
+            for (Size k=0; k < u.size(); ++k) {
+                const Real phi = u[k];
+                if (phi == 0.0
+                    || !addOnTermGradient(phi, term, j, addOnGradient)
+                    || nHeston + addOnGradient.size() != nParams)
+                    return false;
+
+                const std::complex<Real> e = std::exp(
+                    f.lnChF(phi, hestonGradient)
+                    + std::complex<Real>(0.0, phi*phase));
+                const Real wk = w[k]/phi;
+
+                p[j-1] += wk*e.imag();
+                for (Size l=0; l < nHeston; ++l)
+                    dp[j-1][l] += wk*(e*hestonGradient[l]).imag();
+                for (Size l=0; l < addOnGradient.size(); ++l)
+                    dp[j-1][nHeston+l] += wk*(e*addOnGradient[l]).imag();
+            }
+        }
+        evaluations_ = 2*u.size();
+
+        const Real s = spotPrice*dividendDiscount;
+        const Real k = strike*riskFreeDiscount;
+        switch (type) {
+          case Option::Call:
+            value = s*(p[0]/M_PI+0.5) - k*(p[1]/M_PI+0.5);
+            break;
+          case Option::Put:
+            value = s*(p[0]/M_PI-0.5) - k*(p[1]/M_PI-0.5);
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+
+        gradient = (s*dp[0] - k*dp[1])/M_PI;
+
+        return true;
+    }
+
+
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
             const ext::shared_ptr<Integrator>& integrator)
@@ -731,6 +1055,40 @@ namespace QuantLib {
             || intAlgo_ == Trapezoid;
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return intAlgo_ == GaussLaguerre
+            || intAlgo_ == GaussLegendre
+            || intAlgo_ == GaussChebyshev
+            || intAlgo_ == GaussChebyshev2nd;
+    }
+
+    void AnalyticHestonEngine::Integration::quadratureNodes(
+                               Real c_inf,
+                               std::vector<Real>& nodes,
+                               std::vector<Real>& weights) const {
+        QL_REQUIRE(isGaussianQuadrature(),
+                   "Gaussian quadrature required");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+
+        nodes.clear();
+        weights.clear();
+        for (Integer i = gaussianQuadrature_->order()-1; i >= 0; --i) {
+            if (intAlgo_ == GaussLaguerre) {
+                nodes.push_back(x[i]);
+                weights.push_back(w[i]);
+            } else {
+                // change of variable as in integrand1
+                const Real scale = (1.0-x[i])*c_inf;
+                if (scale > QL_EPSILON) {
+                    nodes.push_back(-std::log(0.5-0.5*x[i])/c_inf);
+                    weights.push_back(w[i]/scale);
+                }
+            }
+        }
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
                                Real c_inf,
                                const ext::function<Real(Real)>& f,
@@ -33,6 +33,7 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <vector>
 
 namespace QuantLib {
 
@@ -116,8 +117,41 @@ namespace QuantLib {
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
         void calculate() const;
+        //! only reads the model and its (already calculated) curves
+        bool isThreadSafe() const { return true; }
         Size numberOfEvaluations() const;
 
+        //! values of European plain-vanilla options with the same maturity
+        /*! For the Gaussian quadratures the strike-independent part of
+            the integrand, i.e. the characteristic function, is
+            evaluated once per integration node and shared among all
+            strikes. Adaptive and discrete integration algorithms
+            choose their nodes according to the integrand, therefore
+            the options are priced one at a time.
+        */
+        virtual std::vector<Real> sliceValues(
+                                const Date& maturity,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Option::Type>& types) const;
+
+        //! value and gradient w.r.t. the model parameters
+        /*! The derivatives of the characteristic function are
+            integrated along with the option value on the same nodes,
+            so that the gradient costs little more than the value.
+            They are available for Gatheral's formulation of the
+            complex logarithm and Gaussian quadratures; false is
+            returned otherwise, or if the add-on term of a derived
+            engine does not provide its derivatives.
+
+            The gradient follows the order of the model parameters,
+            i.e., of CalibratedModel::params().
+        */
+        bool valueAndGradient(const Date& maturity,
+                              Real strike,
+                              Option::Type type,
+                              Real& value,
+                              Array& gradient) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -137,6 +171,11 @@ namespace QuantLib {
         virtual std::complex<Real> addOnTerm(Real phi,
                                              Time t,
                                              Size j) const;
+        // derivatives of the add-on term w.r.t. the model parameters
+        // following the Heston ones; false if they are not available
+        virtual bool addOnTermGradient(
+                            Real phi, Time t, Size j,
+                            std::vector<std::complex<Real> >& gradient) const;
 
       private:
         class Fj_Helper;
@@ -183,6 +222,13 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
+
+        // nodes u_k and weights w_k of the Gaussian quadratures, such
+        // that calculate(c_inf, f) = sum_k w_k f(u_k)
+        void quadratureNodes(Real c_inf,
+                             std::vector<Real>& nodes,
+                             std::vector<Real>& weights) const;
 
       private:
         enum Algorithm
@@ -210,6 +256,13 @@ namespace QuantLib {
                                                        Size) const {
         return std::complex<Real>(0,0);
     }
+
+    inline bool AnalyticHestonEngine::addOnTermGradient(
+                            Real phi, Time t, Size j,
+                            std::vector<std::complex<Real> >& gradient) const {
+        gradient.clear();
+        return addOnTerm(phi, t, j) == std::complex<Real>(0.0);
+    }
 }
 
 #endif
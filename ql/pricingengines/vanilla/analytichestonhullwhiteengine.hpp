@@ -78,6 +78,10 @@ namespace QuantLib {
 
         void update();
         void calculate() const;
+        std::vector<Real> sliceValues(
+                                const Date& maturity,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Option::Type>& types) const;
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const;
@@ -85,15 +89,22 @@ namespace QuantLib {
         const ext::shared_ptr<HullWhite> hullWhiteModel_;
 
       private:
+        // variance term of the Hull-White contribution up to time t
+        Real m(Time t) const;
+        // stores m(t) for the maturity of the options being priced
+        void cacheM(Time t) const;
+
+        Real a_, sigma_;
+        mutable Time mTime_;
         mutable Real m_;
-        mutable Real a_, sigma_;
     };
 
     inline
     std::complex<Real> AnalyticHestonHullWhiteEngine::addOnTerm(Real u,
-                                                                Time,
+                                                                Time t,
                                                                 Size j) const {
-        return std::complex<Real>(-m_*u*u, u*(m_-2*m_*(j-1)));
+        const Real m = (t == mTime_) ? m_ : this->m(t);
+        return std::complex<Real>(-m*u*u, u*(m-2*m*(j-1)));
     }
 
 }
@@ -48,6 +48,32 @@ namespace QuantLib {
                           -g*(std::exp(nu_+delta2_) - 1.0));
     }
 
+    bool BatesEngine::addOnTermGradient(
+                            Real phi, Time t, Size j,
+                            std::vector<std::complex<Real> >& gradient) const {
+
+        ext::shared_ptr<BatesModel> batesModel =
+                            ext::dynamic_pointer_cast<BatesModel>(*model_);
+
+        const Real nu     = batesModel->nu();
+        const Real delta  = batesModel->delta();
+        const Real lambda = batesModel->lambda();
+        const Real i      = (j == 1)? 1.0 : 0.0;
+        const std::complex<Real> g(i, phi);
+
+        const std::complex<Real> e1 = std::exp(nu*g + 0.5*delta*delta*g*g);
+        const Real e0 = std::exp(nu + 0.5*delta*delta);
+
+        gradient.resize(3);
+        gradient[0] = t*lambda*g*(e1 - e0);
+        gradient[1] = t*lambda*delta*g*(g*e1 - e0);
+        gradient[2] = t*(e1 - 1.0 - g*(e0 - 1.0));
+
+        // derived engines with further parameters are detected
+        // by the caller, as the gradient would be too short
+        return true;
+    }
+
 
     BatesDetJumpEngine::BatesDetJumpEngine(
         const ext::shared_ptr<BatesDetJumpModel>& model,
@@ -112,6 +112,10 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const;
+        // derivatives w.r.t. nu, delta and lambda
+        bool addOnTermGradient(
+                            Real phi, Time t, Size j,
+                            std::vector<std::complex<Real> >& gradient) const;
     };
 
 
@@ -0,0 +1,234 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/vanilla/carrmadanfftengine.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/exercise.hpp>
+
+namespace QuantLib {
+
+    HestonCharacteristicFunction::HestonCharacteristicFunction(
+                                    const ext::shared_ptr<HestonModel>& model)
+    : model_(model) {
+        QL_REQUIRE(model_, "null Heston model given");
+        registerWith(model_);
+    }
+
+    std::complex<Real> HestonCharacteristicFunction::operator()(
+                                   const std::complex<Real>& z, Time t) const {
+        const Real kappa = model_->kappa();
+        const Real sigma = model_->sigma();
+        const Real theta = model_->theta();
+        const Real rho   = model_->rho();
+        const Real v0    = model_->v0();
+
+        const Real sigma2 = sigma*sigma;
+
+        const std::complex<Real> g
+            = kappa + rho*sigma*std::complex<Real>(z.imag(), -z.real());
+
+        const std::complex<Real> D = std::sqrt(
+            g*g + (z*z + std::complex<Real>(-z.imag(), z.real()))*sigma2);
+
+        const std::complex<Real> G = (g-D)/(g+D);
+
+        return std::exp(v0/sigma2*(1.0-std::exp(-D*t))/(1.0-G*std::exp(-D*t))
+                        *(g-D) + kappa*theta/sigma2*((g-D)*t
+                        -2.0*std::log((1.0-G*std::exp(-D*t))/(1.0-G))));
+    }
+
+
+    BatesCharacteristicFunction::BatesCharacteristicFunction(
+                                     const ext::shared_ptr<BatesModel>& model)
+    : HestonCharacteristicFunction(model), batesModel_(model) {}
+
+    std::complex<Real> BatesCharacteristicFunction::operator()(
+                                   const std::complex<Real>& z, Time t) const {
+        const Real nu     = batesModel_->nu();
+        const Real delta2 = 0.5*batesModel_->delta()*batesModel_->delta();
+        const Real lambda = batesModel_->lambda();
+        const std::complex<Real> g(-z.imag(), z.real());
+
+        return HestonCharacteristicFunction::operator()(z, t)
+            * std::exp(t*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                                 - g*(std::exp(nu+delta2) - 1.0)));
+    }
+
+
+    CarrMadanFFTEngine::CarrMadanFFTEngine(
+            const ext::shared_ptr<ForwardCharacteristicFunction>& chF,
+            const Handle<Quote>& s0,
+            const Handle<YieldTermStructure>& riskFreeTS,
+            const Handle<YieldTermStructure>& dividendTS,
+            Size log2Points,
+            Real logStrikeSpacing,
+            Real frequencySpacing,
+            Real alpha)
+    : chF_(chF), s0_(s0), riskFreeTS_(riskFreeTS), dividendTS_(dividendTS),
+      log2Points_(log2Points), lambda_(logStrikeSpacing),
+      eta_(frequencySpacing), alpha_(alpha), transforms_(0) {
+        QL_REQUIRE(chF_, "null characteristic function given");
+        QL_REQUIRE(log2Points_ > 0, "at least two points required");
+        QL_REQUIRE(lambda_ > 0.0,
+                   "log-strike spacing (" << lambda_
+                   << ") must be positive");
+        QL_REQUIRE(eta_ == Null<Real>() || eta_ > 0.0,
+                   "frequency spacing (" << eta_ << ") must be positive");
+        QL_REQUIRE(alpha_ > 0.0,
+                   "damping factor (" << alpha_ << ") must be positive");
+        registerWith(chF_);
+        registerWith(s0_);
+        registerWith(riskFreeTS_);
+        registerWith(dividendTS_);
+    }
+
+    void CarrMadanFFTEngine::update() {
+        slices_.clear();
+        VanillaOption::engine::update();
+    }
+
+    Size CarrMadanFFTEngine::numberOfTransforms() const {
+        return transforms_;
+    }
+
+    void CarrMadanFFTEngine::calculate() const {
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        const ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+        QL_REQUIRE(payoff->strike() > 0.0,
+                   "strike (" << payoff->strike() << ") must be positive");
+
+        const Date maturity = arguments_.exercise->lastDate();
+        const Time t = riskFreeTS_->dayCounter().yearFraction(
+                                   riskFreeTS_->referenceDate(), maturity);
+        QL_REQUIRE(t > 0.0, "expired option");
+
+        const DiscountFactor df = riskFreeTS_->discount(maturity);
+        const Real fwd = s0_->value()*dividendTS_->discount(maturity)/df;
+        const Real strike = payoff->strike();
+        const Real k = std::log(strike/fwd);
+
+        const Slice& s = slice(maturity, t);
+        QL_REQUIRE(k >= s.logStrikes.front() && k <= s.logStrikes.back(),
+                   "strike (" << strike << ") out of the log-strike grid ["
+                   << fwd*std::exp(s.logStrikes.front()) << ", "
+                   << fwd*std::exp(s.logStrikes.back()) << "]");
+
+        const Real callValue = df*fwd*s.interpolation(k);
+        switch (payoff->optionType()) {
+          case Option::Call:
+            results_.value = callValue;
+            break;
+          case Option::Put:
+            results_.value = callValue - df*(fwd - strike);
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+    const CarrMadanFFTEngine::Slice& CarrMadanFFTEngine::slice(
+                                      const Date& maturity, Time t) const {
+        std::map<Date, Slice>::iterator iter = slices_.find(maturity);
+        if (iter != slices_.end())
+            return iter->second;
+
+        const Size n = Size(1) << log2Points_;
+        const Real eta =
+            (eta_ == Null<Real>()) ? 2.0*M_PI/(n*lambda_) : eta_;
+        const Real b = 0.5*n*lambda_;
+        const std::complex<Real> i1(0.0, 1.0);
+
+        /* Transform of the damped call values.  The trapezoidal rule
+           is used instead of Simpson's: the integrand is smooth and
+           decays fast, and Simpson's weights alias the damped values
+           with half the period of the log-strike grid. */
+        std::vector<std::complex<Real> > x(n);
+        for (Size j=0; j<n; ++j) {
+            const Real v = eta*j;
+            const Real w = (j == 0) ? 0.5 : 1.0;
+            const std::complex<Real> psi =
+                (*chF_)(std::complex<Real>(v, -(alpha_+1.0)), t)
+                / std::complex<Real>(alpha_*alpha_ + alpha_ - v*v,
+                                     (2.0*alpha_ + 1.0)*v);
+            x[j] = std::exp(i1*b*v)*psi*eta*w;
+        }
+
+        transform(x);
+        ++transforms_;
+
+        Slice& s = slices_[maturity];
+        s.logStrikes.resize(n);
+        s.callValues.resize(n);
+        for (Size m=0; m<n; ++m) {
+            const Real k = -b + lambda_*m;
+            s.logStrikes[m] = k;
+            s.callValues[m] = std::exp(-alpha_*k)/M_PI*x[m].real();
+        }
+        s.interpolation = CubicNaturalSpline(s.logStrikes.begin(),
+                                             s.logStrikes.end(),
+                                             s.callValues.begin());
+        s.interpolation.update();
+
+        return s;
+    }
+
+    void CarrMadanFFTEngine::transform(
+                                std::vector<std::complex<Real> >& x) const {
+        const Size n = x.size();
+
+        if (eta_ == Null<Real>()) {
+            std::vector<std::complex<Real> > y(n);
+            FastFourierTransform(log2Points_).transform(x.begin(), x.end(),
+                                                        y.begin());
+            x.swap(y);
+            return;
+        }
+
+        // fractional FFT as a circular convolution of size 2n
+        const Real beta = eta_*lambda_/(2.0*M_PI);
+        std::vector<std::complex<Real> > chirp(n);
+        for (Size j=0; j<n; ++j) {
+            const Real phase = M_PI*beta*Real(j)*Real(j);
+            chirp[j] = std::complex<Real>(std::cos(phase), std::sin(phase));
+        }
+
+        std::vector<std::complex<Real> > a(2*n), c(2*n);
+        for (Size j=0; j<n; ++j) {
+            a[j] = x[j]*std::conj(chirp[j]);
+            c[j] = chirp[j];
+            if (j > 0)
+                c[2*n-j] = chirp[j];
+        }
+
+        const FastFourierTransform fft(log2Points_+1);
+        std::vector<std::complex<Real> > fa(2*n), fc(2*n);
+        fft.transform(a.begin(), a.end(), fa.begin());
+        fft.transform(c.begin(), c.end(), fc.begin());
+        for (Size j=0; j<2*n; ++j)
+            fa[j] *= fc[j];
+        fft.inverse_transform(fa.begin(), fa.end(), a.begin());
+
+        for (Size m=0; m<n; ++m)
+            x[m] = std::conj(chirp[m])*a[m]/Real(2*n);
+    }
+
+}
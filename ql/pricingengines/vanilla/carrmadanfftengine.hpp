@@ -0,0 +1,153 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file carrmadanfftengine.hpp
+    \brief Carr-Madan FFT engine for models with known characteristic function
+*/
+
+#ifndef quantlib_carr_madan_fft_engine_hpp
+#define quantlib_carr_madan_fft_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/math/interpolation.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/quote.hpp>
+#include <complex>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! characteristic function of the log-return to the forward
+    /*! Derived classes return
+        \f[
+            \phi(u,t) = E\left[ e^{iu\ln(S_t/F_t)} \right]
+        \f]
+        for complex \f$ u \f$, where \f$ F_t \f$ is the forward of the
+        underlying \f$ S \f$ for the maturity \f$ t \f$.  Observers
+        are notified whenever the underlying model changes.
+    */
+    class ForwardCharacteristicFunction : public virtual Observable,
+                                          public virtual Observer {
+      public:
+        virtual ~ForwardCharacteristicFunction() {}
+        virtual std::complex<Real> operator()(const std::complex<Real>& u,
+                                              Time t) const = 0;
+        void update() { notifyObservers(); }
+    };
+
+    //! characteristic function of the Heston model
+    class HestonCharacteristicFunction
+        : public ForwardCharacteristicFunction {
+      public:
+        explicit HestonCharacteristicFunction(
+                                   const ext::shared_ptr<HestonModel>& model);
+        std::complex<Real> operator()(const std::complex<Real>& u,
+                                      Time t) const;
+      protected:
+        ext::shared_ptr<HestonModel> model_;
+    };
+
+    //! characteristic function of the Bates model
+    class BatesCharacteristicFunction : public HestonCharacteristicFunction {
+      public:
+        explicit BatesCharacteristicFunction(
+                                    const ext::shared_ptr<BatesModel>& model);
+        std::complex<Real> operator()(const std::complex<Real>& u,
+                                      Time t) const;
+      private:
+        ext::shared_ptr<BatesModel> batesModel_;
+    };
+
+
+    //! Carr-Madan FFT engine for European vanilla options
+    /*! The damped call price is transformed to the characteristic
+        function of the model, so that a single (fractional) fast
+        Fourier transform gives call prices on a whole grid of log
+        strikes \f$ k_m = \ln(K_m/F) \f$ centered around the forward.
+        Prices for the actual strikes are interpolated with a cubic
+        spline on this grid.
+
+        The grids are cached by maturity date and shared among all
+        options priced by the engine until it is notified of a change
+        in the model or in the market data; pricing (or calibrating
+        to) a whole option surface therefore takes one transform per
+        expiry.  Options should share the engine for this to work.
+
+        The number of points is \f$ n = 2^{\mathrm{log2Points}} \f$
+        and the log-strike spacing is \f$ \lambda \f$.  When no
+        frequency spacing \f$ \eta \f$ is given, the plain FFT is used
+        and \f$ \eta = 2\pi/(n\lambda) \f$; otherwise, the fractional
+        FFT allows to choose the two spacings independently at the
+        cost of three transforms of size \f$ 2n \f$.
+
+        References:
+
+        Carr, P. and D. B. Madan (1998), Option Valuation using the
+        fast Fourier transform, Journal of Computational Finance,
+        2, 61-73.
+
+        Chourdakis, K. (2005), Option pricing using the fractional
+        FFT, Journal of Computational Finance, 8(2), 1-18.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston and Bates engines.
+    */
+    class CarrMadanFFTEngine : public VanillaOption::engine {
+      public:
+        CarrMadanFFTEngine(
+            const ext::shared_ptr<ForwardCharacteristicFunction>& chF,
+            const Handle<Quote>& s0,
+            const Handle<YieldTermStructure>& riskFreeTS,
+            const Handle<YieldTermStructure>& dividendTS,
+            Size log2Points = 12,
+            Real logStrikeSpacing = 0.005,
+            Real frequencySpacing = Null<Real>(),
+            Real alpha = 1.25);
+
+        void update();
+        void calculate() const;
+
+        //! total number of transforms performed by the engine
+        /*! The count is cumulative; it is not reset when the engine
+            is notified of a change and its slices are discarded.
+        */
+        Size numberOfTransforms() const;
+
+      private:
+        struct Slice {
+            std::vector<Real> logStrikes, callValues;
+            Interpolation interpolation;
+        };
+        const Slice& slice(const Date& maturity, Time t) const;
+        void transform(std::vector<std::complex<Real> >& x) const;
+
+        ext::shared_ptr<ForwardCharacteristicFunction> chF_;
+        Handle<Quote> s0_;
+        Handle<YieldTermStructure> riskFreeTS_, dividendTS_;
+        Size log2Points_;
+        Real lambda_, eta_, alpha_;
+        mutable std::map<Date, Slice> slices_;
+        mutable Size transforms_;
+    };
+
+}
+
+#endif
@@ -59,9 +59,23 @@ namespace QuantLib {
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
+        results_.value = sliceValues(
+            arguments_.exercise->lastDate(),
+            std::vector<Real>(1, payoff->strike()),
+            std::vector<Option::Type>(1, payoff->optionType())).front();
+    }
+
+    std::vector<Real> COSHestonEngine::sliceValues(
+                            const Date& maturityDate,
+                            const std::vector<Real>& strikes,
+                            const std::vector<Option::Type>& types) const {
+        QL_REQUIRE(strikes.size() == types.size(),
+                   "number of strikes (" << strikes.size()
+                   << ") and of option types (" << types.size()
+                   << ") differ");
+
         const ext::shared_ptr<HestonProcess> process = model_->process();
 
-        const Date maturityDate = arguments_.exercise->lastDate();
         const Time maturity = process->time(maturityDate);
 
         const Real cum1 = c1(maturity);
@@ -70,7 +84,6 @@ namespace QuantLib {
             // + std::sqrt(std::fabs(c4(maturity)))
         );
 
-        const Real k = payoff->strike();
         const Real spot = process->s0()->value();
         QL_REQUIRE(spot > 0.0, "negative or null underlying given");
 
@@ -79,34 +92,46 @@ namespace QuantLib {
         const DiscountFactor qf
             = process->dividendYield()->discount(maturityDate);
         const Real fwd = spot*qf/df;
-        const Real x = std::log(fwd/k);
 
-        const Real a = x + cum1 - L_*w;
-        const Real b = x + cum1 + L_*w;
+        // the truncation range [a, b] = x + [cum1 - L*w, cum1 + L*w]
+        // with x = ln(fwd/k) moves with the strike, while its width,
+        // and therefore the frequencies r_n, do not
+        const Real shift = cum1 - L_*w;
+        const Real d = 1.0/(2.0*L_*w);
 
-        const Real d = 1.0/(b-a);
+        std::vector<Real> r(N_), c(N_);
+        const Real c0 = chF(0, maturity).real();
+        for (Size n=1; n < N_; ++n) {
+            r[n] = n*M_PI*d;
+            c[n] = (chF(r[n], maturity)
+                    *std::exp(std::complex<Real>(0, -r[n]*shift))).real();
+        }
 
-        const Real expA = std::exp(a);
-        Real s = chF(0, maturity).real()*(expA-1-a)*d;
+        std::vector<Real> values(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real k = strikes[i];
+            const Real a = std::log(fwd/k) + shift;
 
-        for (Size n=1; n < N_; ++n) {
-            const Real r = n*M_PI*d;
-            const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
-                *(expA + r*std::sin(r*a) - std::cos(r*a)) - 1.0/r*std::sin(r*a));
+            const Real expA = std::exp(a);
+            Real s = c0*(expA-1-a)*d;
 
-            s += U_n*(chF(r, maturity)
-                     *std::exp(std::complex<Real>(0, r*(x-a)))).real();
-        }
+            for (Size n=1; n < N_; ++n) {
+                const Real sinRA = std::sin(r[n]*a);
+                const Real U_n = 2.0*d*( 1.0/(1.0 + r[n]*r[n])
+                    *(expA + r[n]*sinRA - std::cos(r[n]*a)) - 1.0/r[n]*sinRA);
 
-        if (payoff->optionType() == Option::Put)
-            results_.value = k*df*s;
-        else if (payoff->optionType() == Option::Call) {
-            const DiscountFactor qf
-                = process->dividendYield()->discount(maturityDate);
-            results_.value = spot*qf - k*df*(1-s);
+                s += U_n*c[n];
+            }
+
+            if (types[i] == Option::Put)
+                values[i] = k*df*s;
+            else if (types[i] == Option::Call)
+                values[i] = spot*qf - k*df*(1-s);
+            else
+                QL_FAIL("unknown payoff type");
         }
-        else
-            QL_FAIL("unknown payoff type");
+
+        return values;
     }
 
     Real COSHestonEngine::muT(Time t) const {
@@ -29,6 +29,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 #include <complex>
+#include <vector>
 
 namespace QuantLib {
 
@@ -61,6 +62,16 @@ namespace QuantLib {
         void update();
         void calculate() const;
 
+        //! values of European plain-vanilla options with the same maturity
+        /*! The cosine coefficients of the characteristic function
+            only depend on the maturity; they are computed once and
+            shared among all strikes.
+        */
+        std::vector<Real> sliceValues(
+                                const Date& maturity,
+                                const std::vector<Real>& strikes,
+                                const std::vector<Option::Type>& types) const;
+
         // normalized characteristic function
         std::complex<Real> chF(Real u, Real t) const;
 
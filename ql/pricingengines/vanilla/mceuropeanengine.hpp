@@ -27,6 +27,7 @@
 #define quantlib_montecarlo_european_engine_hpp
 
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
+#include <ql/pricingengines/mcblackscholesgreeks.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
@@ -34,10 +35,17 @@
 namespace QuantLib {
 
     //! European option pricing engine using Monte Carlo simulation
-    /*! \ingroup vanillaengines
+    /*! Delta, gamma, vega and rho can be estimated during the same
+        simulation by means of pathwise or likelihood-ratio
+        estimators, see MonteCarloGreeks.
 
-        \test the correctness of the returned value is tested by
-              checking it against analytic results.
+        \ingroup vanillaengines
+
+        \test
+        - the correctness of the returned value is tested by
+          checking it against analytic results.
+        - the correctness of the returned greeks is tested by
+          checking them against analytic results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -50,6 +58,9 @@ namespace QuantLib {
             path_pricer_type;
         typedef typename MCVanillaEngine<SingleVariate,RNG,S>::stats_type
             stats_type;
+        typedef typename
+        MCVanillaEngine<SingleVariate,RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
         // constructor
         MCEuropeanEngine(
              const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
@@ -60,9 +71,12 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             MonteCarloGreeks::Method greeks = MonteCarloGreeks::None);
       protected:
         ext::shared_ptr<path_pricer_type> pathPricer() const;
+        ext::shared_ptr<greeks_path_pricer_type> greeksPathPricer() const;
+        MonteCarloGreeks::Method greeks_;
     };
 
     //! Monte Carlo European engine factory
@@ -80,6 +94,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withGreeks(MonteCarloGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -89,6 +104,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        MonteCarloGreeks::Method greeks_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -102,6 +118,23 @@ namespace QuantLib {
         DiscountFactor discount_;
     };
 
+    class EuropeanGreeksPathPricer : public BlackScholesGreeksPathPricer {
+      public:
+        EuropeanGreeksPathPricer(
+                 Option::Type type,
+                 Real strike,
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>&,
+                 const TimeGrid& grid,
+                 MonteCarloGreeks::Method method);
+      protected:
+        Real payoff(const Path& path, Real& discountRho) const;
+        void payoffGradient(const Path& path, Array& gradient) const;
+      private:
+        PlainVanillaPayoff payoff_;
+        Time maturity_;
+        DiscountFactor discount_;
+    };
+
 
     // inline definitions
 
@@ -116,7 +149,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             MonteCarloGreeks::Method greeks)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +160,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed),
+      greeks_(greeks) {}
 
 
     template <class RNG, class S>
@@ -152,6 +187,32 @@ namespace QuantLib {
               process->riskFreeRate()->discount(this->timeGrid().back())));
     }
 
+    template <class RNG, class S>
+    inline ext::shared_ptr<
+        typename MCEuropeanEngine<RNG,S>::greeks_path_pricer_type>
+    MCEuropeanEngine<RNG,S>::greeksPathPricer() const {
+
+        if (greeks_ == MonteCarloGreeks::None)
+            return ext::shared_ptr<greeks_path_pricer_type>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        return ext::make_shared<EuropeanGreeksPathPricer>(
+                                                 payoff->optionType(),
+                                                 payoff->strike(),
+                                                 process,
+                                                 this->timeGrid(),
+                                                 greeks_);
+    }
+
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>::MakeMCEuropeanEngine(
@@ -159,7 +220,8 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0),
+      greeks_(MonteCarloGreeks::None) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -224,6 +286,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withGreeks(MonteCarloGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -240,7 +309,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    greeks_));
     }
 
 
@@ -258,6 +328,35 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+
+    inline EuropeanGreeksPathPricer::EuropeanGreeksPathPricer(
+                 Option::Type type,
+                 Real strike,
+                 const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+                 const TimeGrid& grid,
+                 MonteCarloGreeks::Method method)
+    : BlackScholesGreeksPathPricer(process, grid, method),
+      payoff_(type, strike), maturity_(grid.back()),
+      discount_(process->riskFreeRate()->discount(maturity_)) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+    }
+
+    inline Real EuropeanGreeksPathPricer::payoff(const Path& path,
+                                                 Real& discountRho) const {
+        const Real value = payoff_(path.back()) * discount_;
+        discountRho = -maturity_*value;
+        return value;
+    }
+
+    inline void EuropeanGreeksPathPricer::payoffGradient(
+                                                    const Path& path,
+                                                    Array& gradient) const {
+        const Real omega = payoff_.optionType() == Option::Call ? 1.0 : -1.0;
+        if (omega*(path.back() - payoff_.strike()) > 0.0)
+            gradient[path.length()-1] = omega * discount_;
+    }
+
 }
 
 
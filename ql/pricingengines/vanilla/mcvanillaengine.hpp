@@ -45,6 +45,15 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             this->results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+            if (this->mcModel_->greeksAccumulator().samples() > 0) {
+                // value, delta, gamma, vega and rho
+                std::vector<Real> greeks =
+                    this->mcModel_->greeksAccumulator().mean();
+                this->results_.delta = greeks[1];
+                this->results_.gamma = greeks[2];
+                this->results_.vega = greeks[3];
+                this->results_.rho = greeks[4];
+            }
         }
       protected:
         typedef typename McSimulation<MC,RNG,S>::path_generator_type
@@ -55,6 +64,8 @@ namespace QuantLib {
             stats_type;
         typedef typename McSimulation<MC,RNG,S>::result_type
             result_type;
+        typedef typename McSimulation<MC,RNG,S>::greeks_path_pricer_type
+            greeks_path_pricer_type;
         // constructor
         MCVanillaEngine(const ext::shared_ptr<StochasticProcess>&,
                         Size timeSteps,
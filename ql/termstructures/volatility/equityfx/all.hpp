@@ -19,6 +19,7 @@
 #include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
 #include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/fxblackvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/svifxblackvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/kahalefxblackvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/sabrfxblackvolsurface.hpp>
@@ -38,10 +38,13 @@
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/equityfx/andreasenhugevolatilityinterpl.hpp>
+#include <ql/experimental/finitedifferences/modtriplebandlinearop.hpp>
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#include <exception>
 #include <limits>
+#include <string>
 
 namespace QuantLib {
 
@@ -81,58 +84,71 @@ namespace QuantLib {
           dxxMap_(SecondDerivativeOp(0, mesher_)),
           d2CdK2_(dxMap_.mult(Array(mesher->layout()->size(), -1.0))
                         .add(dxxMap_)),
-          mapT_  (0, mesher_) {
-        }
-
-        Disposable<Array> d2CdK2(const Array& c) const {
-            return d2CdK2_.apply(c);
-        }
-
-        Disposable<Array> solveFor(
-            Time dT, const Array& sig, const Array& b) const {
-
-            Array x(lnMarketStrikes_.size());
-            Interpolation sigInterpl;
-
-            switch (interpolationType_) {
-              case AndreasenHugeVolatilityInterpl::CubicSpline:
-                sigInterpl = CubicNaturalSpline(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::Linear:
-                sigInterpl = LinearInterpolation(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
+          mapT_  (0, mesher_),
+          localVolWeights_(nGridPoints_, lnMarketStrikes_.size()),
+          splineWeights_(lnMarketStrikes_.size(), nGridPoints_, 0.0) {
+
+            // all interpolation schemes are linear in the volatilities,
+            // hence the local volatilities on the grid are given by
+            // localVolWeights_*sig for any set of volatilities sig.
+            Array x(lnMarketStrikes_);
+            if (interpolationType_
+                    == AndreasenHugeVolatilityInterpl::PiecewiseConstant)
                 for (Size i=0; i < x.size()-1; ++i)
                     x[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
-                x.back() = lnMarketStrikes_.back();
-
-                sigInterpl = BackwardFlatInterpolation(
-                    x.begin(), x.end(), sig.begin());
-                break;
-              default:
-                QL_FAIL("unknown interpolation type");
-            }
 
             const ext::shared_ptr<FdmLinearOpLayout> layout =
                 mesher_->layout();
             const FdmLinearOpIterator endIter = layout->end();
 
-            Array z(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
-                const Real lnStrike = mesher_->location(iter, 0);
+            Array e(lnMarketStrikes_.size(), 0.0);
+            for (Size j=0; j < e.size(); ++j) {
+                e[j] = 1.0;
+
+                Interpolation sigInterpl;
+                switch (interpolationType_) {
+                  case AndreasenHugeVolatilityInterpl::CubicSpline:
+                    sigInterpl = CubicNaturalSpline(
+                        lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                        e.begin());
+                    break;
+                  case AndreasenHugeVolatilityInterpl::Linear:
+                    sigInterpl = LinearInterpolation(
+                        lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                        e.begin());
+                    break;
+                  case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
+                    sigInterpl = BackwardFlatInterpolation(
+                        x.begin(), x.end(), e.begin());
+                    break;
+                  default:
+                    QL_FAIL("unknown interpolation type");
+                }
+
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter!=endIter; ++iter) {
+                    const Real lnStrike = mesher_->location(iter, 0);
+
+                    localVolWeights_[iter.index()][j] = sigInterpl(
+                        std::min(std::max(lnStrike, lnMarketStrikes_.front()),
+                                lnMarketStrikes_.back()), true);
+                }
+
+                e[j] = 0.0;
+            }
 
-                const Real vol = sigInterpl(
-                    std::min(std::max(lnStrike, lnMarketStrikes_.front()),
-                            lnMarketStrikes_.back()), true);
+            setSplineWeights();
+        }
 
-                z[i] = 0.5*vol*vol;
-            }
+        Disposable<Array> d2CdK2(const Array& c) const {
+            return d2CdK2_.apply(c);
+        }
+
+        Disposable<Array> solveFor(
+            Time dT, const Array& sig, const Array& b) const {
+
+            const Array vol = localVolWeights_*sig;
+            const Array z = 0.5*vol*vol;
 
             mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
             return mapT_.mult(Array(z.size(), dT)).solve_splitting(b, 1.0);
@@ -144,20 +160,46 @@ namespace QuantLib {
         }
 
         Disposable<Array> values(const Array& sig) const {
-            Array newNPVs = solveFor(dT_, sig, previousNPVs_);
-
-            const std::vector<Real>& gridPoints =
-                mesher_->getFdm1dMeshers().front()->locations();
+            return calibrationErrors(solveFor(dT_, sig, previousNPVs_));
+        }
 
-            const MonotonicCubicNaturalSpline interpl(
-                gridPoints.begin(), gridPoints.end(), newNPVs.begin());
+        void jacobian(Matrix& jac, const Array& sig) const {
+            const Array newNPVs = solveFor(dT_, sig, previousNPVs_);
+
+            /* The step solves (1 + dT z (D - D^2)) c = b with
+               z = 0.5 vol^2, hence dc/dsig_j = A^{-1} dc_j with
+               dc_j = dT vol w_j (D^2 - D) c and w_j the j-th column
+               of the interpolation weights. The tridiagonal matrix A
+               depends on the volatilities; it is factored once here
+               and each column only needs a back-substitution. */
+            ModTripleBandLinearOp op(mapT_.mult(Array(nGridPoints_, dT_)));
+
+            // forward elimination of the Thomas algorithm
+            Array bet(nGridPoints_), gam(nGridPoints_);
+            bet[0] = 1.0 + op.diag()[0];
+            QL_REQUIRE(!close(bet[0], 0.0), "division by zero");
+            for (Size i=1; i < nGridPoints_; ++i) {
+                gam[i] = op.upper()[i-1]/bet[i-1];
+                bet[i] = 1.0 + op.diag()[i] - op.lower()[i]*gam[i];
+                QL_ENSURE(!close(bet[i], 0.0), "division by zero");
+            }
 
-            Array retVal(lnMarketStrikes_.size());
-            for (Size i=0; i < retVal.size(); ++i) {
-                const Real strike = lnMarketStrikes_[i];
-                retVal[i] = interpl(strike) - marketNPVs_[i];
+            const Array dz = dT_*(localVolWeights_*sig)
+                *(dxxMap_.apply(newNPVs) - dxMap_.apply(newNPVs));
+
+            Array dc(nGridPoints_);
+            for (Size j=0; j < sig.size(); ++j) {
+                dc[0] = localVolWeights_[0][j]*dz[0]/bet[0];
+                for (Size i=1; i < nGridPoints_; ++i)
+                    dc[i] = (localVolWeights_[i][j]*dz[i]
+                             - op.lower()[i]*dc[i-1])/bet[i];
+                for (Size i=nGridPoints_-1; i > 0; --i)
+                    dc[i-1] -= gam[i]*dc[i];
+
+                const Array dNPVs = splineWeights_*dc;
+                for (Size i=0; i < dNPVs.size(); ++i)
+                    jac[i][j] = dNPVs[i];
             }
-            return retVal;
         }
 
         Disposable<Array> vegaCalibrationError(const Array& sig) const {
@@ -171,6 +213,82 @@ namespace QuantLib {
 
 
       private:
+        /* Sensitivities of the natural cubic spline through the grid
+           values at the market strikes. They are used for the Jacobian
+           only, hence the monotonicity filter applied to the prices
+           is not taken into account. */
+        void setSplineWeights() {
+            const std::vector<Real>& x =
+                mesher_->getFdm1dMeshers().front()->locations();
+            const Size n = x.size();
+
+            Array dx(n-1);
+            for (Size i=0; i < n-1; ++i)
+                dx[i] = x[i+1] - x[i];
+
+            // transposed system for the spline slopes m: M m = R y
+            Array lower(n-1), diag(n), upper(n-1);
+            diag[0] = 2.0;
+            lower[0] = 1.0;
+            for (Size i=1; i < n-1; ++i) {
+                diag[i] = 2.0*(dx[i] + dx[i-1]);
+                upper[i-1] = dx[i];
+                lower[i] = dx[i-1];
+            }
+            upper[n-2] = 1.0;
+            diag[n-1] = 2.0;
+            const TridiagonalOperator mT(lower, diag, upper);
+
+            for (Size k=0; k < lnMarketStrikes_.size(); ++k) {
+                const Size j = std::min<Size>(n-2, std::max<Size>(1,
+                    std::upper_bound(x.begin(), x.end(), lnMarketStrikes_[k])
+                        - x.begin()) - 1);
+                const Real h = dx[j];
+                const Real d = lnMarketStrikes_[k] - x[j];
+                const Real t = d/h;
+
+                // value = y_j + h S_j (3t^2 - 2t^3)
+                //       + h m_j (t - 2t^2 + t^3) + h m_{j+1} (t^3 - t^2)
+                const Real wS = 3*t*t - 2*t*t*t;
+                splineWeights_[k][j]   = 1.0 - wS;
+                splineWeights_[k][j+1] = wS;
+
+                Array g(n, 0.0);
+                g[j]   = h*(t - 2*t*t + t*t*t);
+                g[j+1] = h*(t*t*t - t*t);
+                const Array w = mT.solveFor(g);
+
+                // R^T w with (R y)_i = 3(dx_i S_{i-1} + dx_{i-1} S_i)
+                for (Size i=0; i < n-1; ++i) {
+                    Real dRdS;
+                    if (i == 0)
+                        dRdS = 3.0*w[0] + 3.0*dx[1]*w[1];
+                    else if (i == n-2)
+                        dRdS = 3.0*dx[i-1]*w[i] + 3.0*w[n-1];
+                    else
+                        dRdS = 3.0*(dx[i-1]*w[i] + dx[i+1]*w[i+1]);
+
+                    splineWeights_[k][i]   -= dRdS/dx[i];
+                    splineWeights_[k][i+1] += dRdS/dx[i];
+                }
+            }
+        }
+
+        Disposable<Array> calibrationErrors(const Array& newNPVs) const {
+            const std::vector<Real>& gridPoints =
+                mesher_->getFdm1dMeshers().front()->locations();
+
+            const MonotonicCubicNaturalSpline interpl(
+                gridPoints.begin(), gridPoints.end(), newNPVs.begin());
+
+            Array retVal(lnMarketStrikes_.size());
+            for (Size i=0; i < retVal.size(); ++i) {
+                const Real strike = lnMarketStrikes_[i];
+                retVal[i] = interpl(strike) - marketNPVs_[i];
+            }
+            return retVal;
+        }
+
         const Array marketNPVs_, marketVegas_;
         const Array lnMarketStrikes_, previousNPVs_;
         const ext::shared_ptr<FdmMesherComposite> mesher_;
@@ -183,6 +301,7 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         const TripleBandLinearOp d2CdK2_;
         mutable TripleBandLinearOp mapT_;
+        Matrix localVolWeights_, splineWeights_;
     };
 
     class CombinedCostFunction : public CostFunction {
@@ -195,12 +314,13 @@ namespace QuantLib {
 
         Disposable<Array> values(const Array& sig) const {
             if (putCostFct_ && callCostFct_) {
-                const Array pv = putCostFct_->values(sig);
-                const Array cv = callCostFct_->values(sig);
+                std::vector<Array> v(2);
+                evaluateBothSides(sig, v);
 
-                Array retVal(pv.size() + cv.size());
-                std::copy(pv.begin(), pv.end(), retVal.begin());
-                std::copy(cv.begin(), cv.end(), retVal.begin() + cv.size());
+                Array retVal(v[0].size() + v[1].size());
+                std::copy(v[0].begin(), v[0].end(), retVal.begin());
+                std::copy(v[1].begin(), v[1].end(),
+                          retVal.begin() + v[0].size());
 
                 return retVal;
             }
@@ -212,6 +332,36 @@ namespace QuantLib {
                 QL_FAIL("internal error: cost function not set");
         }
 
+        void jacobian(Matrix& jac, const Array& sig) const {
+            if (putCostFct_ && callCostFct_) {
+                std::vector<Array> v(2);
+                std::vector<Matrix> jacs(2, Matrix(sig.size(), sig.size()));
+                evaluateBothSides(sig, v, &jacs);
+
+                std::copy(jacs[0].begin(), jacs[0].end(), jac.begin());
+                std::copy(jacs[1].begin(), jacs[1].end(),
+                          jac.begin() + jacs[0].rows()*jacs[0].columns());
+            }
+            else if (putCostFct_)
+                putCostFct_->jacobian(jac, sig);
+            else if (callCostFct_)
+                callCostFct_->jacobian(jac, sig);
+            else
+                QL_FAIL("internal error: cost function not set");
+        }
+
+        void gradient(Array& grad, const Array& sig) const {
+            const Array v = values(sig);
+            Matrix jac(v.size(), sig.size());
+            jacobian(jac, sig);
+
+            const Real value = std::sqrt(DotProduct(v, v)/v.size());
+            if (value == 0.0)
+                std::fill(grad.begin(), grad.end(), 0.0);
+            else
+                grad = transpose(jac)*v/(v.size()*value);
+        }
+
         Disposable<Array> initialValues() const {
             if (putCostFct_ && callCostFct_)
                 return 0.5*(  putCostFct_->initialValues()
@@ -225,6 +375,31 @@ namespace QuantLib {
         }
 
       private:
+        // put and call side are independent and are evaluated in parallel
+        void evaluateBothSides(const Array& sig,
+                               std::vector<Array>& values,
+                               std::vector<Matrix>* jacobians = 0) const {
+            const ext::shared_ptr<AndreasenHugeCostFunction> costFcts[] = {
+                putCostFct_, callCostFct_ };
+
+            std::vector<std::string> failures(2);
+            #pragma omp parallel for
+            for (long i=0; i < 2; ++i) {
+                try {
+                    if (jacobians != 0)
+                        costFcts[i]->jacobian((*jacobians)[i], sig);
+                    else
+                        values[i] = costFcts[i]->values(sig);
+                } catch (std::exception& e) {
+                    failures[i] = e.what();
+                } catch (...) {
+                    failures[i] = "unknown error";
+                }
+            }
+            for (Size i=0; i < 2; ++i)
+                QL_REQUIRE(failures[i].empty(), failures[i]);
+        }
+
         const ext::shared_ptr<AndreasenHugeCostFunction> putCostFct_;
         const ext::shared_ptr<AndreasenHugeCostFunction> callCostFct_;
     };
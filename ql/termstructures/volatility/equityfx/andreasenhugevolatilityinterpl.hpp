@@ -45,7 +45,14 @@ namespace QuantLib {
 
     //! Calibration of a local volatility surface to a sparse grid of options
 
-    /*! References:
+    /*! The local volatilities are calibrated expiry by expiry.  The
+        cost functions provide the Jacobian of the one-step implicit
+        finite difference solution with respect to the volatilities,
+        which is used by the default Levenberg-Marquardt optimizer and
+        by the gradient based optimizers; put and call side are
+        evaluated in parallel if OpenMP is enabled.
+
+        References:
 
         Andreasen J., Huge B., 2010. Volatility Interpolation
         https://ssrn.com/abstract=1694972
@@ -73,7 +80,8 @@ namespace QuantLib {
             Real minStrike = Null<Real>(),
             Real maxStrike = Null<Real>(),
             const ext::shared_ptr<OptimizationMethod>& optimizationMethod =
-                ext::shared_ptr<OptimizationMethod>(new LevenbergMarquardt),
+                ext::shared_ptr<OptimizationMethod>(
+                    new LevenbergMarquardt(1e-8, 1e-8, 1e-8, true)),
             const EndCriteria& endCriteria =
                 EndCriteria(500, 100, 1e-12, 1e-10, 1e-10));
 
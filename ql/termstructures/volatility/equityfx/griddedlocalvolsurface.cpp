@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    GriddedLocalVolSurface::GriddedLocalVolSurface(
+                                const Handle<LocalVolTermStructure>& localVol,
+                                const std::vector<Time>& times,
+                                Real sMin, Real sMax, Size sGrid)
+    : LocalVolTermStructure(localVol->businessDayConvention(),
+                            localVol->dayCounter()),
+      localVol_(localVol), times_(times), x_(sGrid),
+      xMin_(std::log(sMin)),
+      dx_((sGrid > 1) ? (std::log(sMax) - std::log(sMin))/(sGrid-1) : 0.0),
+      localVolMatrix_(times.size(), sGrid) {
+
+        QL_REQUIRE(!times_.empty(), "at least one time required");
+        QL_REQUIRE(times_.front() >= 0.0,
+                   "negative time (" << times_.front() << ") given");
+        for (Size i=1; i < times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be sorted and unique");
+        QL_REQUIRE(sMin > 0.0 && sMax > sMin,
+                   "invalid underlying range [" << sMin << ", "
+                   << sMax << "]");
+        QL_REQUIRE(sGrid > 1, "at least two underlying values required");
+
+        for (Size j=0; j < x_.size(); ++j)
+            x_[j] = xMin_ + j*dx_;
+
+        registerWith(localVol_);
+    }
+
+    const Date& GriddedLocalVolSurface::referenceDate() const {
+        return localVol_->referenceDate();
+    }
+
+    DayCounter GriddedLocalVolSurface::dayCounter() const {
+        return localVol_->dayCounter();
+    }
+
+    Date GriddedLocalVolSurface::maxDate() const {
+        return localVol_->maxDate();
+    }
+
+    Real GriddedLocalVolSurface::minStrike() const {
+        return localVol_->minStrike();
+    }
+
+    Real GriddedLocalVolSurface::maxStrike() const {
+        return localVol_->maxStrike();
+    }
+
+    void GriddedLocalVolSurface::update() {
+        // it dispatches notifications only if (!calculated_ && !frozen_)
+        LazyObject::update();
+
+        // do not use LocalVolTermStructure::update() as it would
+        // always notify observers
+        if (moving_)
+            updated_ = false;
+    }
+
+    void GriddedLocalVolSurface::performCalculations() const {
+        for (Size i=0; i < times_.size(); ++i)
+            for (Size j=0; j < x_.size(); ++j)
+                localVolMatrix_[i][j] =
+                    localVol_->localVol(times_[i], std::exp(x_[j]), true);
+    }
+
+    void GriddedLocalVolSurface::locateTime(Time t, Size& i, Real& w) const {
+        if (t <= times_.front()) {
+            i = 0;
+            w = 0.0;
+        }
+        else if (t >= times_.back()) {
+            i = times_.size()-1;
+            w = 0.0;
+        }
+        else {
+            i = std::upper_bound(times_.begin(), times_.end(), t)
+                - times_.begin() - 1;
+            w = (t - times_[i])/(times_[i+1] - times_[i]);
+        }
+    }
+
+    Real GriddedLocalVolSurface::interpolate(Size i, Real w, Real x) const {
+        const Real u = std::min(std::max((x - xMin_)/dx_, 0.0),
+                                Real(x_.size()-1));
+        const Size j = std::min(Size(u), x_.size()-2);
+        const Real v = u - j;
+
+        const Real* row = localVolMatrix_.row_begin(i);
+        const Real lv = (1.0-v)*row[j] + v*row[j+1];
+        if (w == 0.0)
+            return lv;
+
+        const Real* next = localVolMatrix_.row_begin(i+1);
+        return (1.0-w)*lv + w*((1.0-v)*next[j] + v*next[j+1]);
+    }
+
+    Volatility GriddedLocalVolSurface::localVolImpl(
+                                        Time t, Real underlyingLevel) const {
+        calculate();
+
+        Size i;
+        Real w;
+        locateTime(t, i, w);
+
+        return interpolate(i, w, std::log(underlyingLevel));
+    }
+
+    Disposable<Array> GriddedLocalVolSurface::localVols(
+                                Time t, const Array& underlyings) const {
+        calculate();
+
+        Size i;
+        Real w;
+        locateTime(t, i, w);
+
+        Array retVal(underlyings.size());
+        for (Size k=0; k < underlyings.size(); ++k)
+            retVal[k] = interpolate(i, w, std::log(underlyings[k]));
+
+        return retVal;
+    }
+}
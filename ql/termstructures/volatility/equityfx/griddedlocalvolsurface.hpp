@@ -0,0 +1,117 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file griddedlocalvolsurface.hpp
+    \brief Local volatility surface cached on a (t, ln S) grid
+*/
+
+#ifndef quantlib_gridded_local_vol_surface_hpp
+#define quantlib_gridded_local_vol_surface_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Local volatility surface cached on a (t, ln S) grid
+    /*! The local volatility of the wrapped surface, e.g. a Dupire
+        LocalVolSurface, is evaluated once on the grid given by the
+        times and by equally spaced points in the logarithm of the
+        underlying between \f$ S_{min} \f$ and \f$ S_{max} \f$.
+        Lookups are bilinear interpolations in \f$ (t, \ln S) \f$ with
+        flat extrapolation outside of the grid.
+
+        Unlike FixedLocalVolSurface, the cached values are discarded
+        whenever the wrapped surface notifies a change, e.g. of the
+        underlying quote or of the Black volatility surface, and are
+        recomputed at the next lookup.
+
+        Finite-difference operators can retrieve the local volatility
+        of a whole slice of the mesh with a single call to
+        localVols(), which locates the time only once.
+    */
+    class GriddedLocalVolSurface : public LocalVolTermStructure,
+                                   public LazyObject {
+      public:
+        GriddedLocalVolSurface(const Handle<LocalVolTermStructure>& localVol,
+                               const std::vector<Time>& times,
+                               Real sMin, Real sMax, Size sGrid = 100);
+
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const;
+        DayCounter dayCounter() const;
+        Date maxDate() const;
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const;
+        Real maxStrike() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const;
+        const std::vector<Real>& logUnderlyings() const;
+        //! local volatilities at the grid points (times x log-underlyings)
+        const Matrix& localVolMatrix() const;
+        //@}
+
+        //! interpolated local volatilities for a set of underlying values
+        Disposable<Array> localVols(Time t, const Array& underlyings) const;
+
+      protected:
+        Volatility localVolImpl(Time t, Real underlyingLevel) const;
+        void performCalculations() const;
+
+      private:
+        void locateTime(Time t, Size& i, Real& w) const;
+        Real interpolate(Size i, Real w, Real x) const;
+
+        const Handle<LocalVolTermStructure> localVol_;
+        const std::vector<Time> times_;
+        std::vector<Real> x_;
+        const Real xMin_, dx_;
+        mutable Matrix localVolMatrix_;
+    };
+
+
+    // inline definitions
+
+    inline const std::vector<Time>& GriddedLocalVolSurface::times() const {
+        return times_;
+    }
+
+    inline const std::vector<Real>&
+    GriddedLocalVolSurface::logUnderlyings() const {
+        return x_;
+    }
+
+    inline const Matrix& GriddedLocalVolSurface::localVolMatrix() const {
+        calculate();
+        return localVolMatrix_;
+    }
+
+}
+
+#endif
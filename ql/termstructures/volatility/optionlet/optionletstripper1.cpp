@@ -24,12 +24,8 @@
 
 #include <ql/termstructures/volatility/optionlet/optionletstripper1.hpp>
 #include <ql/instruments/makecapfloor.hpp>
-#include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
-#include <ql/pricingengine.hpp>
-#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/indexes/iborindex.hpp>
-#include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
@@ -55,36 +51,34 @@ OptionletStripper1::OptionletStripper1(
 
     void OptionletStripper1::performCalculations() const {
 
-        // update dates
         const Date& referenceDate = termVolSurface_->referenceDate();
         const DayCounter& dc = termVolSurface_->dayCounter();
-        ext::shared_ptr<BlackCapFloorEngine> dummy(new
-                    BlackCapFloorEngine(// discounting does not matter here
-                                        iborIndex_->forwardingTermStructure(),
-                                        0.20, dc));
-        for (Size i=0; i<nOptionletTenors_; ++i) {
-            CapFloor temp = MakeCapFloor(CapFloor::Cap,
-                                         capFloorLengths_[i],
-                                         iborIndex_,
-                                         0.04, // dummy strike
-                                         0*Days)
-                .withPricingEngine(dummy);
-            ext::shared_ptr<FloatingRateCoupon> lFRC =
-                                                temp.lastFloatingRateCoupon();
-            optionletDates_[i] = lFRC->fixingDate();
-            optionletPaymentDates_[i] = lFRC->date();
-            optionletAccrualPeriods_[i] = lFRC->accrualPeriod();
-            optionletTimes_[i] = dc.yearFraction(referenceDate,
-                                                 optionletDates_[i]);
-            atmOptionletRate_[i] = lFRC->indexFixing();
-        }
+        const Date today = Settings::instance().evaluationDate();
 
-        if (floatingSwitchStrike_) {
-            Rate averageAtmOptionletRate = 0.0;
+        // update dates; the generated schedules only depend on them
+        bool restripAll = false;
+        if (referenceDate != cachedReferenceDate_ ||
+            today != cachedEvaluationDate_) {
+            lastCoupons_.resize(nOptionletTenors_);
             for (Size i=0; i<nOptionletTenors_; ++i) {
-                averageAtmOptionletRate += atmOptionletRate_[i];
+                CapFloor temp = MakeCapFloor(CapFloor::Cap,
+                                             capFloorLengths_[i],
+                                             iborIndex_,
+                                             0.04, // dummy strike
+                                             0*Days);
+                lastCoupons_[i] = temp.lastFloatingRateCoupon();
+                optionletDates_[i] = lastCoupons_[i]->fixingDate();
+                optionletPaymentDates_[i] = lastCoupons_[i]->date();
+                optionletAccrualPeriods_[i] =
+                    lastCoupons_[i]->accrualPeriod();
+                optionletTimes_[i] = dc.yearFraction(referenceDate,
+                                                     optionletDates_[i]);
             }
-            switchStrike_ = averageAtmOptionletRate / nOptionletTenors_;
+            capFloors_ = std::vector<std::vector<ext::shared_ptr<CapFloor> > >(
+                                                                  nStrikes_);
+            cachedReferenceDate_ = referenceDate;
+            cachedEvaluationDate_ = today;
+            restripAll = true;
         }
 
         const Handle<YieldTermStructure>& discountCurve =
@@ -92,84 +86,170 @@ OptionletStripper1::OptionletStripper1(
                 iborIndex_->forwardingTermStructure() :
                 discount_;
 
-        const std::vector<Rate>& strikes = termVolSurface_->strikes();
+        optionletDiscounts_.resize(nOptionletTenors_);
+        for (Size i=0; i<nOptionletTenors_; ++i) {
+            atmOptionletRate_[i] = lastCoupons_[i]->indexFixing();
+            optionletDiscounts_[i] =
+                discountCurve->discount(optionletPaymentDates_[i]);
+        }
 
-        ext::shared_ptr<PricingEngine> capFloorEngine;
-        ext::shared_ptr<SimpleQuote> volQuote(new SimpleQuote);
-
-        if (volatilityType_ == ShiftedLognormal) {
-            capFloorEngine = ext::make_shared<BlackCapFloorEngine>(
-                        
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc, displacement_);
-        } else if (volatilityType_ == Normal) {
-            capFloorEngine = ext::make_shared<BachelierCapFloorEngine>(
-                        
-                            discountCurve, Handle<Quote>(volQuote),
-                            dc);
-        } else {
-            QL_FAIL("unknown volatility type: " << volatilityType_);
+        if (floatingSwitchStrike_) {
+            Rate averageAtmOptionletRate = 0.0;
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                averageAtmOptionletRate += atmOptionletRate_[i];
+            }
+            switchStrike_ = averageAtmOptionletRate / nOptionletTenors_;
         }
 
+        const std::vector<Rate>& strikes = termVolSurface_->strikes();
+
+        // the instruments are only used for their type and to set up
+        // the optionlet data below; they are generated here and not in
+        // the parallel loop, since they register with the index.
+        std::vector<bool> changed(nStrikes_, restripAll);
         for (Size j=0; j<nStrikes_; ++j) {
             // using out-of-the-money options
             CapFloor::Type capFloorType =
                 strikes[j] < switchStrike_ ? CapFloor::Floor : CapFloor::Cap;
-            Option::Type optionletType =
-                strikes[j] < switchStrike_ ? Option::Put : Option::Call;
+            if (capFloors_[j].empty() ||
+                capFloors_[j].front()->type() != capFloorType) {
+                capFloors_[j].resize(nOptionletTenors_);
+                for (Size i=0; i<nOptionletTenors_; ++i)
+                    capFloors_[j][i] =
+                        MakeCapFloor(capFloorType, capFloorLengths_[i],
+                                     iborIndex_, strikes[j], -0 * Days);
+                changed[j] = true;
+            }
+        }
 
-            Real previousCapFloorPrice = 0.0;
-            for (Size i=0; i<nOptionletTenors_; ++i) {
+        // the optionlets of the caps/floors only differ in their strike
+        // across columns; their data are collected here, as done by the
+        // pricing engines, so that the parallel loop below doesn't
+        // calculate the instruments.  The optionlet prices of all
+        // strikes depend on the curves only through these data.
+        std::vector<CapFloorData> capFloorData(nOptionletTenors_);
+        const Date settlement = discountCurve->referenceDate();
+        CapFloor::arguments arguments;
+        for (Size i=0; i<nOptionletTenors_; ++i) {
+            capFloors_.front()[i]->setupArguments(&arguments);
+            CapFloorData& data = capFloorData[i];
+            for (Size k=0; k<arguments.endDates.size(); ++k) {
+                // expired optionlets are discarded as in the engines
+                if (arguments.endDates[k] <= settlement)
+                    continue;
+                data.forwards.push_back(arguments.forwards[k]);
+                data.discountedAccruals.push_back(
+                    discountCurve->discount(arguments.endDates[k]) *
+                    arguments.nominals[k] * arguments.gearings[k] *
+                    arguments.accrualTimes[k]);
+                const Date& fixingDate = arguments.fixingDates[k];
+                data.sqrtTimes.push_back(fixingDate > today ?
+                    std::sqrt(dc.yearFraction(today, fixingDate)) : 0.0);
+            }
+        }
+        if (capFloorData != capFloorData_) {
+            changed = std::vector<bool>(nStrikes_, true);
+            capFloorData_.swap(capFloorData);
+        }
 
-                capFloorVols_[i][j] = termVolSurface_->volatility(
+        // select the strike columns to be stripped
+        std::vector<Size> columns;
+        for (Size j=0; j<nStrikes_; ++j) {
+            for (Size i=0; i<nOptionletTenors_; ++i) {
+                Volatility vol = termVolSurface_->volatility(
                     capFloorLengths_[i], strikes[j], true);
-                volQuote->setValue(capFloorVols_[i][j]);
-                ext::shared_ptr<CapFloor> capFloor =
-                    MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                 iborIndex_, strikes[j], -0 * Days)
-                        .withPricingEngine(capFloorEngine);
-                capFloorPrices_[i][j] = capFloor->NPV();
-                optionletPrices_[i][j] = capFloorPrices_[i][j] -
-                                                        previousCapFloorPrice;
-                previousCapFloorPrice = capFloorPrices_[i][j];
-                DiscountFactor d =
-                    discountCurve->discount(optionletPaymentDates_[i]);
-                DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
-                try {
-                  if (volatilityType_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
-                  } else if (volatilityType_ == Normal) {
-                    optionletStDevs_[i][j] =
-                        std::sqrt(optionletTimes_[i]) *
-                        bachelierBlackFormulaImpliedVol(
-                            optionletType, strikes[j], atmOptionletRate_[i],
-                            optionletTimes_[i], optionletPrices_[i][j],
-                            optionletAnnuity);
-                  } else {
-                    QL_FAIL("Unknown volatility type: " << volatilityType_);
-                  }
-                }
-                catch (std::exception &e) {
-                    if(dontThrow_)
-                        optionletStDevs_[i][j]=0.0;
-                    else
-                        QL_FAIL("could not bootstrap optionlet:"
-                            "\n type:    " << optionletType <<
-                            "\n strike:  " << io::rate(strikes[j]) <<
-                            "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
-                            "\n price:   " << optionletPrices_[i][j] <<
-                            "\n annuity: " << optionletAnnuity <<
-                            "\n expiry:  " << optionletDates_[i] <<
-                            "\n error:   " << e.what());
-                }
-                optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
-                                                std::sqrt(optionletTimes_[i]);
+                if (vol != capFloorVols_[i][j])
+                    changed[j] = true;
+                capFloorVols_[i][j] = vol;
+            }
+            if (changed[j])
+                columns.push_back(j);
+        }
+
+        if (columns.empty())
+            return;
+
+        std::vector<std::string> failures(columns.size());
+        #pragma omp parallel for
+        for (long k=0; k<(long)columns.size(); ++k) {
+            try {
+                stripStrike(columns[k]);
+            } catch (std::exception& e) {
+                failures[k] = e.what();
+            } catch (...) {
+                failures[k] = "unknown error";
+            }
+        }
+        for (Size k=0; k<columns.size(); ++k) {
+            if (!failures[k].empty()) {
+                // the results are incomplete; strip all columns next time
+                cachedReferenceDate_ = Date();
+                QL_FAIL(failures[k]);
             }
         }
+    }
+
+    void OptionletStripper1::stripStrike(Size j) const {
+
+        const Rate strike = termVolSurface_->strikes()[j];
+        Option::Type optionletType =
+            capFloors_[j].front()->type() == CapFloor::Floor ?
+                Option::Put : Option::Call;
+
+        Real previousCapFloorPrice = 0.0;
+        for (Size i=0; i<nOptionletTenors_; ++i) {
 
+            const CapFloorData& data = capFloorData_[i];
+            const Volatility vol = capFloorVols_[i][j];
+            Real capFloorPrice = 0.0;
+            for (Size k=0; k<data.forwards.size(); ++k) {
+                const Real stdDev = vol*data.sqrtTimes[k];
+                const Real optionlet = volatilityType_ == Normal ?
+                    bachelierBlackFormula(optionletType, strike,
+                                          data.forwards[k], stdDev) :
+                    blackFormula(optionletType, strike, data.forwards[k],
+                                 stdDev, 1.0, displacement_);
+                capFloorPrice += optionlet*data.discountedAccruals[k];
+            }
+            capFloorPrices_[i][j] = capFloorPrice;
+            optionletPrices_[i][j] = capFloorPrices_[i][j] -
+                                                    previousCapFloorPrice;
+            previousCapFloorPrice = capFloorPrices_[i][j];
+            DiscountFactor optionletAnnuity =
+                optionletAccrualPeriods_[i]*optionletDiscounts_[i];
+            try {
+              if (volatilityType_ == ShiftedLognormal) {
+                optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
+                    optionletType, strike, atmOptionletRate_[i],
+                    optionletPrices_[i][j], optionletAnnuity, displacement_,
+                    optionletStDevs_[i][j], accuracy_, maxIter_);
+              } else if (volatilityType_ == Normal) {
+                optionletStDevs_[i][j] =
+                    std::sqrt(optionletTimes_[i]) *
+                    bachelierBlackFormulaImpliedVol(
+                        optionletType, strike, atmOptionletRate_[i],
+                        optionletTimes_[i], optionletPrices_[i][j],
+                        optionletAnnuity);
+              } else {
+                QL_FAIL("Unknown volatility type: " << volatilityType_);
+              }
+            }
+            catch (std::exception &e) {
+                if(dontThrow_)
+                    optionletStDevs_[i][j]=0.0;
+                else
+                    QL_FAIL("could not bootstrap optionlet:"
+                        "\n type:    " << optionletType <<
+                        "\n strike:  " << io::rate(strike) <<
+                        "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
+                        "\n price:   " << optionletPrices_[i][j] <<
+                        "\n annuity: " << optionletAnnuity <<
+                        "\n expiry:  " << optionletDates_[i] <<
+                        "\n error:   " << e.what());
+            }
+            optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
+                                            std::sqrt(optionletTimes_[i]);
+        }
     }
 
     const Matrix &OptionletStripper1::capletVols() const {
@@ -33,13 +33,23 @@
 
 namespace QuantLib {
 
-    class SimpleQuote;
     class CapFloor;
-    class PricingEngine;
+    class FloatingRateCoupon;
 
     /*! Helper class to strip optionlet (i.e. caplet/floorlet) volatilities
         (a.k.a. forward-forward volatilities) from the (cap/floor) term
         volatilities of a CapFloorTermVolSurface.
+
+        The cap/floor instruments used for the stripping are generated
+        once and kept until the reference date changes.  When only
+        some term volatilities change, only the affected strike
+        columns are stripped again; a change in any optionlet forward
+        or discounted accrual (i.e., in the forwarding or discounting
+        curves) causes all columns to be stripped.  The strike columns
+        are independent of each other and are stripped in parallel if
+        OpenMP is enabled; the cap/floor prices are computed from the
+        optionlet data with the Black or Bachelier formula, without
+        pricing engines.
     */
     class OptionletStripper1 : public OptionletStripper {
       public:
@@ -64,6 +74,18 @@ namespace QuantLib {
         void performCalculations() const;
         //@}
       private:
+        // strike-independent data of the optionlets of a cap/floor
+        struct CapFloorData {
+            std::vector<Rate> forwards;
+            std::vector<Real> discountedAccruals, sqrtTimes;
+            bool operator==(const CapFloorData& other) const {
+                return forwards == other.forwards
+                    && discountedAccruals == other.discountedAccruals
+                    && sqrtTimes == other.sqrtTimes;
+            }
+        };
+        void stripStrike(Size j) const;
+
         mutable Matrix capFloorPrices_, optionletPrices_;
         mutable Matrix capFloorVols_;
         mutable Matrix optionletStDevs_, capletVols_;
@@ -74,6 +96,15 @@ namespace QuantLib {
         Real accuracy_;
         Natural maxIter_;
         bool dontThrow_;
+
+        // generated instruments, cached across recalculations
+        mutable Date cachedEvaluationDate_, cachedReferenceDate_;
+        mutable std::vector<ext::shared_ptr<FloatingRateCoupon> >
+                                                          lastCoupons_;
+        mutable std::vector<DiscountFactor> optionletDiscounts_;
+        mutable std::vector<CapFloorData> capFloorData_;
+        mutable std::vector<std::vector<ext::shared_ptr<CapFloor> > >
+                                                                 capFloors_;
     };
 
 }
@@ -21,12 +21,12 @@
 #include <ql/termstructures/volatility/optionlet/optionletstripper2.hpp>
 #include <ql/termstructures/volatility/optionlet/optionletstripper1.hpp>
 #include <ql/termstructures/volatility/optionlet/strippedoptionletadapter.hpp>
-#include <ql/termstructures/volatility/optionlet/spreadedoptionletvol.hpp>
 #include <ql/termstructures/volatility/capfloor/capfloortermvolcurve.hpp>
-#include <ql/quotes/simplequote.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/instruments/makecapfloor.hpp>
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
+#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/indexes/iborindex.hpp>
 
 
@@ -79,14 +79,30 @@ namespace QuantLib {
         for (Size j=0; j<nOptionExpiries_; ++j) {
             Volatility atmOptionVol = atmCapFloorTermVolCurve_->volatility(
                 optionExpiriesTimes[j], 33.3333); // dummy strike
-            ext::shared_ptr<BlackCapFloorEngine> engine(new
-                    BlackCapFloorEngine(iborIndex_->forwardingTermStructure(),
-                                        atmOptionVol, dc_));
+            // the atm vols are read with the type and displacement
+            // of the stripped optionlet volatilities
+            ext::shared_ptr<PricingEngine> engine;
+            if (volatilityType_ == ShiftedLognormal) {
+                engine = ext::make_shared<BlackCapFloorEngine>(
+                    iborIndex_->forwardingTermStructure(),
+                    atmOptionVol, dc_, displacement_);
+            } else if (volatilityType_ == Normal) {
+                engine = ext::make_shared<BachelierCapFloorEngine>(
+                    iborIndex_->forwardingTermStructure(),
+                    atmOptionVol, dc_);
+            } else {
+                QL_FAIL("unknown volatility type: " << volatilityType_);
+            }
+            // MakeCapFloor needs a Black engine to find the atm strike
             caps_[j] = MakeCapFloor(CapFloor::Cap,
                                     optionExpiriesTenors[j],
                                     iborIndex_,
                                     Null<Rate>(),
-                                    0*Days).withPricingEngine(engine);
+                                    0*Days)
+                .withPricingEngine(ext::make_shared<BlackCapFloorEngine>(
+                    iborIndex_->forwardingTermStructure(),
+                    atmOptionVol, dc_));
+            caps_[j]->setPricingEngine(engine);
             atmCapFloorStrikes_[j] =
                 caps_[j]->atmRate(**iborIndex_->forwardingTermStructure());
             atmCapFloorPrices_[j] = caps_[j]->NPV();
@@ -125,16 +141,39 @@ namespace QuantLib {
 
     std::vector<Volatility> OptionletStripper2::spreadsVolImplied() const {
 
-        Brent solver;
         std::vector<Volatility> result(nOptionExpiries_);
         Volatility guess = 0.0001, minSpread = -0.1, maxSpread = 0.1;
-        for (Size j=0; j<nOptionExpiries_; ++j) {
-            ObjectiveFunction f(stripper1_, caps_[j], atmCapFloorPrices_[j]);
-            solver.setMaxEvaluations(maxEvaluations_);
-            Volatility root = solver.solve(f, accuracy_, guess,
-                                           minSpread, maxSpread);
-            result[j] = root;
+        // normal volatilities are about a hundred times smaller
+        if (volatilityType_ == Normal) {
+            minSpread = -0.01;
+            maxSpread = 0.01;
         }
+
+        // the objective functions collect the caplet data from the
+        // curves and the stripped volatilities, and are built serially;
+        // their evaluation only uses these data
+        std::vector<ObjectiveFunction> f;
+        f.reserve(nOptionExpiries_);
+        for (Size j=0; j<nOptionExpiries_; ++j)
+            f.push_back(ObjectiveFunction(stripper1_, caps_[j],
+                                          atmCapFloorPrices_[j]));
+
+        std::vector<std::string> failures(nOptionExpiries_);
+        #pragma omp parallel for
+        for (long j=0; j<(long)nOptionExpiries_; ++j) {
+            try {
+                Brent solver;
+                solver.setMaxEvaluations(maxEvaluations_);
+                result[j] = solver.solve(f[j], accuracy_, guess,
+                                         minSpread, maxSpread);
+            } catch (std::exception& e) {
+                failures[j] = e.what();
+            } catch (...) {
+                failures[j] = "unknown error";
+            }
+        }
+        for (Size j=0; j<nOptionExpiries_; ++j)
+            QL_REQUIRE(failures[j].empty(), failures[j]);
         return result;
     }
 
@@ -161,33 +200,57 @@ namespace QuantLib {
             const ext::shared_ptr<OptionletStripper1>& optionletStripper1,
             const ext::shared_ptr<CapFloor>& cap,
             Real targetValue)
-    : cap_(cap),
+    : volatilityType_(optionletStripper1->volatilityType()),
+      displacement_(optionletStripper1->displacement()),
       targetValue_(targetValue)
     {
-        ext::shared_ptr<OptionletVolatilityStructure> adapter(new
-            StrippedOptionletAdapter(optionletStripper1));
-        adapter->enableExtrapolation();
-
-        // set an implausible value, so that calculation is forced
-        // at first operator()(Volatility x) call
-        spreadQuote_ = ext::make_shared<SimpleQuote>(-1.0);
-
-        ext::shared_ptr<OptionletVolatilityStructure> spreadedAdapter(new
-            SpreadedOptionletVolatility(Handle<OptionletVolatilityStructure>(
-                adapter), Handle<Quote>(spreadQuote_)));
-
-        ext::shared_ptr<BlackCapFloorEngine> engine(new
-            BlackCapFloorEngine(
-                optionletStripper1->iborIndex()->forwardingTermStructure(),
-                Handle<OptionletVolatilityStructure>(spreadedAdapter)));
+        StrippedOptionletAdapter adapter(optionletStripper1);
+        adapter.enableExtrapolation();
 
-        cap_->setPricingEngine(engine);
+        // the caplets are collected as done by the pricing engine,
+        // so that the cap is priced on the spreaded stripped
+        // volatilities without setting quotes or recalculating
+        const Handle<YieldTermStructure>& discountCurve =
+            optionletStripper1->iborIndex()->forwardingTermStructure();
+        const Date settlement = discountCurve->referenceDate();
+        const Date today = adapter.referenceDate();
+        CapFloor::arguments arguments;
+        cap->setupArguments(&arguments);
+        for (Size i=0; i<arguments.endDates.size(); ++i) {
+            // expired caplets are discarded as in the engine
+            if (arguments.endDates[i] <= settlement)
+                continue;
+            forwards_.push_back(arguments.forwards[i]);
+            strikes_.push_back(arguments.capRates[i]);
+            discountedAccruals_.push_back(
+                discountCurve->discount(arguments.endDates[i]) *
+                arguments.nominals[i] * arguments.gearings[i] *
+                arguments.accrualTimes[i]);
+            const Date& fixingDate = arguments.fixingDates[i];
+            Time t = 0.0;
+            Volatility vol = 0.0;
+            if (fixingDate > today) {
+                t = adapter.timeFromReference(fixingDate);
+                vol = adapter.volatility(t, strikes_.back(), true);
+            }
+            times_.push_back(t);
+            volatilities_.push_back(vol);
+        }
     }
 
     Real OptionletStripper2::ObjectiveFunction::operator()(Volatility s) const
     {
-        if (s!=spreadQuote_->value())
-            spreadQuote_->setValue(s);
-        return cap_->NPV()-targetValue_;
+        Real value = 0.0;
+        for (Size i=0; i<forwards_.size(); ++i) {
+            const Volatility vol = volatilities_[i] + s;
+            const Real stdDev = std::sqrt(vol*vol*times_[i]);
+            const Real caplet = volatilityType_ == Normal ?
+                bachelierBlackFormula(Option::Call, strikes_[i],
+                                      forwards_[i], stdDev) :
+                blackFormula(Option::Call, strikes_[i], forwards_[i],
+                             stdDev, 1.0, displacement_);
+            value += caplet*discountedAccruals_[i];
+        }
+        return value-targetValue_;
     }
 }
@@ -31,13 +31,18 @@ namespace QuantLib {
 
     class CapFloorTermVolCurve;
     class OptionletStripper1;
-    class SimpleQuote;
     class CapFloor;
 
     /*! Helper class to extend an OptionletStripper1 object stripping
         additional optionlet (i.e. caplet/floorlet) volatilities (a.k.a.
         forward-forward volatilities) from the (cap/floor) At-The-Money
         term volatilities of a CapFloorTermVolCurve.
+
+        The At-The-Money term volatilities are taken to be of the
+        same type, and with the same displacement, as the ones
+        stripped by the OptionletStripper1 object; the caps are
+        priced with the Black formula, or with the Bachelier one for
+        normal volatilities.
     */
     class OptionletStripper2 : public OptionletStripper {
       public:
@@ -65,8 +70,13 @@ namespace QuantLib {
                               Real targetValue);
             Real operator()(Volatility spreadVol) const;
           private:
-            ext::shared_ptr<SimpleQuote> spreadQuote_;
-            ext::shared_ptr<CapFloor> cap_;
+            VolatilityType volatilityType_;
+            Real displacement_;
+            // data of the caplets still alive
+            std::vector<Rate> forwards_, strikes_;
+            std::vector<Real> discountedAccruals_;
+            std::vector<Time> times_;
+            std::vector<Volatility> volatilities_;
             Real targetValue_;
         };
 
@@ -37,6 +37,8 @@
 #include <ql/math/interpolations/backwardflatlinearinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/quote.hpp>
+#include <exception>
+#include <string>
 
 
 #ifndef SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL
@@ -52,6 +54,20 @@ namespace QuantLib {
     class EndCriteria;
     class OptimizationMethod;
 
+    //! Swaption volatility cube fitting a smile model at each node
+    /*! The smiles of the nodes are calibrated independently of each
+        other; when OpenMP is enabled and no optimization method is
+        given (so that each smile uses its own one) the calibrations
+        run in parallel.
+
+        When the cube is recalculated, smiles whose strikes, market
+        volatilities, forward, shift and parameter guesses did not
+        change are not calibrated again.  If warm start is enabled,
+        the other smiles start from their last calibrated parameters
+        instead of the guesses, as long as the latter did not change;
+        this is usually faster after small market moves, but the
+        result then depends on the previous calibrations.
+    */
     template<class Model>
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
         class Cube {
@@ -129,7 +145,8 @@ namespace QuantLib {
             const bool useMaxError = false,
             const Size maxGuesses = 50,
             const bool backwardFlat = false,
-            const Real cutoffStrike = 0.0001);
+            const Real cutoffStrike = 0.0001,
+            const bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
@@ -174,6 +191,27 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        // inputs and results of the calibration of a single smile
+        struct SmileCalibration {
+            Time optionTime;
+            Rate forward;
+            Real shift;
+            std::vector<Real> strikes, volatilities, guess;
+            // alpha, beta, nu, rho, forward, rms error, max error,
+            // end criteria, as in the layers of the parameters cube
+            std::vector<Real> result;
+            bool sameInputs(const SmileCalibration& o) const {
+                return optionTime == o.optionTime && forward == o.forward
+                    && shift == o.shift && strikes == o.strikes
+                    && volatilities == o.volatilities && guess == o.guess;
+            }
+        };
+        SmileCalibration smileCalibrationInputs(const Cube& marketVolCube,
+                                                Size j, Size k) const;
+        void calibrateSmile(SmileCalibration& smile,
+                            const std::vector<Real>& start) const;
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             std::vector<SmileCalibration>& previous) const;
         Size requiredNumberOfStrikes() const { return 1; }
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
@@ -193,6 +231,9 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        const bool warmStart_;
+        mutable std::vector<SmileCalibration> sparseCalibrations_,
+                                              denseCalibrations_;
 
         class PrivateObserver : public Observer {
           public:
@@ -230,7 +271,8 @@ namespace QuantLib {
         const ext::shared_ptr<OptimizationMethod> &optMethod,
         const Real errorAccept, const bool useMaxError, const Size maxGuesses,
         const bool backwardFlat,
-        const Real cutoffStrike)
+        const Real cutoffStrike,
+        const bool warmStart)
         : SwaptionVolatilityCube(atmVolStructure, optionTenors, swapTenors,
                                  strikeSpreads, volSpreads, swapIndexBase,
                                  shortSwapIndexBase, vegaWeightedSmileFit),
@@ -239,7 +281,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          warmStart_(warmStart) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -310,7 +353,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_,
+                                            sparseCalibrations_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -318,7 +362,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibrations_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -327,7 +372,8 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibrations_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -336,12 +382,126 @@ namespace QuantLib {
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        std::vector<SmileCalibration> previous;
+        return sabrCalibration(marketVolCube, previous);
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::SmileCalibration
+    SwaptionVolCube1x<Model>::smileCalibrationInputs(
+                                                const Cube& marketVolCube,
+                                                Size j, Size k) const {
+        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
+        const Time swapLength = marketVolCube.swapLengths()[k];
+
+        SmileCalibration smile;
+        smile.optionTime = marketVolCube.optionTimes()[j];
+        smile.forward = atmStrike(marketVolCube.optionDates()[j],
+                                  marketVolCube.swapTenors()[k]);
+        smile.shift = atmVol_->shift(smile.optionTime, swapLength);
+        for (Size i=0; i<nStrikes_; i++){
+            Real strike = smile.forward+strikeSpreads_[i];
+            if(strike + smile.shift >=cutoffStrike_) {
+                smile.strikes.push_back(strike);
+                smile.volatilities.push_back(tmpMarketVolCube[i][j][k]);
+            }
+        }
+        smile.guess = parametersGuess_(smile.optionTime, swapLength);
+        return smile;
+    }
+
+    template <class Model>
+    void SwaptionVolCube1x<Model>::calibrateSmile(
+                                    SmileCalibration& smile,
+                                    const std::vector<Real>& start) const {
+        const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
+            ext::shared_ptr<typename Model::Interpolation>(new
+                                  (typename Model::Interpolation)(
+                                  smile.strikes.begin(), smile.strikes.end(),
+                                  smile.volatilities.begin(),
+                                  smile.optionTime, smile.forward,
+                                  start[0], start[1],
+                                  start[2], start[3],
+                                  isParameterFixed_[0],
+                                  isParameterFixed_[1],
+                                  isParameterFixed_[2],
+                                  isParameterFixed_[3],
+                                  vegaWeightedSmileFit_,
+                                  endCriteria_,
+                                  optMethod_,
+                                  errorAccept_,
+                                  useMaxError_,
+                                  maxGuesses_,
+                                  smile.shift));
+        sabrInterpolation->update();
+
+        smile.result.resize(8);
+        smile.result[0] = sabrInterpolation->alpha();
+        smile.result[1] = sabrInterpolation->beta();
+        smile.result[2] = sabrInterpolation->nu();
+        smile.result[3] = sabrInterpolation->rho();
+        smile.result[4] = smile.forward;
+        smile.result[5] = sabrInterpolation->rmsError();
+        smile.result[6] = sabrInterpolation->maxError();
+        smile.result[7] = sabrInterpolation->endCriteria();
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                        const Cube &marketVolCube,
+                        std::vector<SmileCalibration>& previous) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
         const std::vector<Date>& optionDates = marketVolCube.optionDates();
         const std::vector<Period>& swapTenors = marketVolCube.swapTenors();
-        Matrix alphas(optionTimes.size(), swapLengths.size(),0.);
+        const Size nOptions = optionTimes.size(), nSwaps = swapLengths.size();
+
+        // market data are collected serially, since the underlying
+        // term structures and indexes are calculated lazily
+        std::vector<SmileCalibration> smiles(nOptions*nSwaps);
+        for (Size j=0; j<nOptions; j++)
+            for (Size k=0; k<nSwaps; k++)
+                smiles[j*nSwaps+k] = smileCalibrationInputs(marketVolCube,
+                                                            j, k);
+
+        // only the smiles whose inputs changed are calibrated again
+        const bool hasPrevious = (previous.size() == smiles.size());
+        std::vector<Size> changed;
+        for (Size n=0; n<smiles.size(); n++) {
+            if (hasPrevious && smiles[n].sameInputs(previous[n]))
+                smiles[n].result = previous[n].result;
+            else
+                changed.push_back(n);
+        }
+
+        // a given optimization method is shared by all the smiles,
+        // which must then be calibrated serially
+        std::vector<std::string> failures(changed.size());
+        #pragma omp parallel for if(!optMethod_)
+        for (long m=0; m<(long)changed.size(); ++m) {
+            const Size n = changed[m];
+            try {
+                std::vector<Real> start = smiles[n].guess;
+                if (warmStart_ && hasPrevious
+                    && smiles[n].guess == previous[n].guess) {
+                    for (Size i=0; i<4; i++) {
+                        if (!isParameterFixed_[i])
+                            start[i] = previous[n].result[i];
+                    }
+                }
+                calibrateSmile(smiles[n], start);
+            } catch (std::exception& e) {
+                failures[m] = e.what();
+            } catch (...) {
+                failures[m] = "unknown error";
+            }
+        }
+        for (Size m=0; m<changed.size(); m++)
+            QL_REQUIRE(failures[m].empty(), failures[m]);
+
+        Matrix alphas(nOptions, nSwaps, 0.);
         Matrix betas(alphas);
         Matrix nus(alphas);
         Matrix rhos(alphas);
@@ -350,58 +510,19 @@ namespace QuantLib {
         Matrix maxErrors(alphas);
         Matrix endCriteria(alphas);
 
-        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
-
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
-        for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
-                for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
-                    }
-                }
-
-                const std::vector<Real>& guess =
-                    parametersGuess_(optionTimes[j], swapLengths[k]);
-
-                const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    ext::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
-                                          isParameterFixed_[0],
-                                          isParameterFixed_[1],
-                                          isParameterFixed_[2],
-                                          isParameterFixed_[3],
-                                          vegaWeightedSmileFit_,
-                                          endCriteria_,
-                                          optMethod_,
-                                          errorAccept_,
-                                          useMaxError_,
-                                          maxGuesses_,
-                                          shiftTmp));
-                sabrInterpolation->update();
-
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                const std::vector<Real>& result = smiles[j*nSwaps+k].result;
+                Real rmsError = result[5];
+                Real maxError = result[6];
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                endCriteria[j][k] = result[7];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -432,6 +553,8 @@ namespace QuantLib {
                               << "   rho = " << rhos[j][k] << "\n");
             }
         }
+        previous.swap(smiles);
+
         Cube sabrParametersCube(optionDates, swapTenors,
                                 optionTimes, swapLengths, 8,
                                 true, backwardFlat_);
@@ -462,57 +585,11 @@ namespace QuantLib {
                            swapTenor) - swapTenors.begin();
         QL_REQUIRE(k != swapTenors.size(), "swap tenor not found");
 
-        std::vector<Real> calibrationResult(8,0.);
-        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
-
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
-
         for (Size j=0; j<optionTimes.size(); j++) {
-            Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-            Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-            strikes.clear();
-            volatilities.clear();
-            for (Size i=0; i<nStrikes_; i++){
-                Real strike = atmForward+strikeSpreads_[i];
-                if(strike+shiftTmp>=cutoffStrike_) {
-                    strikes.push_back(strike);
-                    volatilities.push_back(tmpMarketVolCube[i][j][k]);
-                }
-            }
-
-            const std::vector<Real>& guess =
-                parametersGuess_(optionTimes[j], swapLengths[k]);
-
-                const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    ext::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                      volatilities.begin(),
-                                      optionTimes[j], atmForward,
-                                      guess[0], guess[1],
-                                      guess[2], guess[3],
-                                      isParameterFixed_[0],
-                                      isParameterFixed_[1],
-                                      isParameterFixed_[2],
-                                      isParameterFixed_[3],
-                                      vegaWeightedSmileFit_,
-                                      endCriteria_,
-                                      optMethod_,
-                                      errorAccept_,
-                                      useMaxError_,
-                                      maxGuesses_,
-                                      shiftTmp));
-
-            sabrInterpolation->update();
-            Real interpolationError = sabrInterpolation->rmsError();
-            calibrationResult[0]=sabrInterpolation->alpha();
-            calibrationResult[1]=sabrInterpolation->beta();
-            calibrationResult[2]=sabrInterpolation->nu();
-            calibrationResult[3]=sabrInterpolation->rho();
-            calibrationResult[4]=atmForward;
-            calibrationResult[5]=interpolationError;
-            calibrationResult[6]=sabrInterpolation->maxError();
-            calibrationResult[7]=sabrInterpolation->endCriteria();
+            SmileCalibration smile =
+                smileCalibrationInputs(marketVolCube, j, k);
+            calibrateSmile(smile, smile.guess);
+            const std::vector<Real>& calibrationResult = smile.result;
 
             QL_ENSURE(calibrationResult[7]!=EndCriteria::MaxIterations,
                       "section calibration failed: "
@@ -22,9 +22,18 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    Date::serial_type Calendar::Impl::businessDaysUpTo(const Date&) const {
+        QL_FAIL("no business-day index available for " << name());
+    }
+
+    Date Calendar::Impl::nthBusinessDay(Date::serial_type) const {
+        QL_FAIL("no business-day index available for " << name());
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -113,6 +122,18 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+#ifndef QL_HIGH_RESOLUTION_DATE
+            if (hasBusinessDayIndex()) {
+                // the n-th business day after d, or the |n|-th before it
+                Date::serial_type rank = impl_->businessDaysUpTo(d) + n;
+                if (n < 0 && !isBusinessDay(d))
+                    ++rank;
+                const Date d1 = impl_->nthBusinessDay(rank);
+                // out of range: let the loop below raise the error
+                if (d1 != Date())
+                    return d1;
+            }
+#endif
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -157,7 +178,13 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            if (hasBusinessDayIndex()) {
+                const Date& first = std::min(from, to);
+                const Date& last = std::max(from, to);
+                wd = impl_->businessDaysUpTo(last)
+                   - impl_->businessDaysUpTo(first)
+                   + (isBusinessDay(first) ? 1 : 0);
+            } else if (from < to) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
                 for (Date d = from; d < to; ++d) {
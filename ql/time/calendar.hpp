@@ -65,9 +65,25 @@ namespace QuantLib {
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            /*! \name Business-day index
+                Implementations storing precomputed business days
+                (see BitmapCalendar) override these methods, which
+                are then used for counting and advancing by days
+                instead of testing each date in turn.
+            */
+            //@{
+            virtual bool hasBusinessDayIndex() const { return false; }
+            //! number of business days from Date::minDate() to d included
+            virtual Date::serial_type businessDaysUpTo(const Date& d) const;
+            /*! n-th business day from Date::minDate(), starting at 1;
+                returns a null date if out of range.
+            */
+            virtual Date nthBusinessDay(Date::serial_type n) const;
+            //@}
             std::set<Date> addedHolidays, removedHolidays;
         };
         ext::shared_ptr<Impl> impl_;
+        bool hasBusinessDayIndex() const;
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -78,6 +94,14 @@ namespace QuantLib {
         //@{
         //!  Returns whether or not the calendar is initialized
         bool empty() const;
+        //! Returns the identity of the calendar implementation
+        /*! Copies of a calendar share their implementation, including
+            the added and removed holidays, and return the same
+            identity; distinct calendars with the same name (e.g., two
+            BespokeCalendar instances) don't.  The identity can be
+            used as a key by caches of calendar-dependent data.
+        */
+        ext::shared_ptr<const void> identity() const;
         //! Returns the name of the calendar.
         /*! \warning This method is used for output and comparison between
                 calendars. It is <b>not</b> meant to be used for writing
@@ -196,6 +220,10 @@ namespace QuantLib {
         return !impl_;
     }
 
+    inline ext::shared_ptr<const void> Calendar::identity() const {
+        return impl_;
+    }
+
     inline std::string Calendar::name() const {
         QL_REQUIRE(impl_, "no calendar implementation provided");
         return impl_->name();
@@ -211,6 +239,14 @@ namespace QuantLib {
         return impl_->removedHolidays;
     }
 
+    inline bool Calendar::hasBusinessDayIndex() const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
+        // the index does not include holidays added or removed later
+        return impl_->hasBusinessDayIndex()
+            && impl_->addedHolidays.empty()
+            && impl_->removedHolidays.empty();
+    }
+
     inline bool Calendar::isBusinessDay(const Date& d) const {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -4,6 +4,7 @@
 #include <ql/time/calendars/argentina.hpp>
 #include <ql/time/calendars/australia.hpp>
 #include <ql/time/calendars/bespokecalendar.hpp>
+#include <ql/time/calendars/bitmapcalendar.hpp>
 #include <ql/time/calendars/botswana.hpp>
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/calendars/canada.hpp>
@@ -0,0 +1,189 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/calendars/bitmapcalendar.hpp>
+#ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#endif
+#include <algorithm>
+#include <map>
+
+namespace QuantLib {
+
+    namespace {
+
+        Date::serial_type bitCount(boost::uint32_t x) {
+            x = x - ((x >> 1) & 0x55555555U);
+            x = (x & 0x33333333U) + ((x >> 2) & 0x33333333U);
+            x = (x + (x >> 4)) & 0x0F0F0F0FU;
+            return Date::serial_type((x * 0x01010101U) >> 24);
+        }
+
+        unsigned int weekendMask(const Calendar& calendar) {
+            unsigned int mask = 0;
+            for (Integer w=Sunday; w<=Saturday; ++w) {
+                if (calendar.isWeekend(Weekday(w)))
+                    mask |= 1U << w;
+            }
+            return mask;
+        }
+
+        #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+        boost::mutex tablesMutex;
+        #endif
+
+        struct OwnerLess {
+            bool operator()(const ext::weak_ptr<const void>& x,
+                            const ext::weak_ptr<const void>& y) const {
+                return x.owner_before(y);
+            }
+        };
+
+    }
+
+    BitmapCalendar::Impl::Tables::Tables(const Calendar& calendar)
+    : weekends(weekendMask(calendar)),
+      firstSerial(Date::minDate().serialNumber()) {
+        const Date::serial_type days =
+            Date::maxDate().serialNumber() - firstSerial + 1;
+        const Size words = (days+31)/32;
+
+        bits.resize(words, 0);
+        for (Date::serial_type i=0; i < days; ++i) {
+            if (calendar.isBusinessDay(Date(firstSerial+i)))
+                bits[i >> 5] |= boost::uint32_t(1) << (i & 31);
+        }
+
+        counts.resize(words+1, 0);
+        for (Size k=0; k < words; ++k)
+            counts[k+1] = counts[k] + bitCount(bits[k]);
+    }
+
+    ext::shared_ptr<const BitmapCalendar::Impl::Tables>
+    BitmapCalendar::Impl::sharedTables(const Calendar& calendar) {
+        // the holidays of a modified calendar might change again
+        if (!calendar.addedHolidays().empty() ||
+            !calendar.removedHolidays().empty())
+            return ext::make_shared<Tables>(calendar);
+
+        typedef std::map<ext::weak_ptr<const void>,
+                         ext::shared_ptr<const Tables>,
+                         OwnerLess> cache_type;
+        static cache_type cache;
+
+        const ext::weak_ptr<const void> key = calendar.identity();
+        ext::shared_ptr<const Tables> tables;
+        #pragma omp critical(ql_bitmap_calendar_tables)
+        {
+            #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+            boost::lock_guard<boost::mutex> lock(tablesMutex);
+            #endif
+            cache_type::const_iterator i = cache.find(key);
+            if (i != cache.end())
+                tables = i->second;
+        }
+        // the weekends of a bespoke calendar might have changed
+        if (tables && tables->weekends == weekendMask(calendar))
+            return tables;
+
+        // the tables are built outside the critical section
+        tables = ext::make_shared<Tables>(calendar);
+        #pragma omp critical(ql_bitmap_calendar_tables)
+        {
+            #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+            boost::lock_guard<boost::mutex> lock(tablesMutex);
+            #endif
+            // drop the tables of the calendars no longer in use
+            for (cache_type::iterator i=cache.begin(); i!=cache.end();) {
+                if (i->first.expired())
+                    cache.erase(i++);
+                else
+                    ++i;
+            }
+            cache[key] = tables;
+        }
+        return tables;
+    }
+
+    BitmapCalendar::Impl::Impl(const Calendar& calendar)
+    : calendar_(calendar) {
+        QL_REQUIRE(!calendar_.empty(), "no calendar implementation provided");
+        tables_ = sharedTables(calendar_);
+    }
+
+    std::string BitmapCalendar::Impl::name() const {
+        return calendar_.name();
+    }
+
+    bool BitmapCalendar::Impl::isWeekend(Weekday w) const {
+        return calendar_.isWeekend(w);
+    }
+
+    bool BitmapCalendar::Impl::isBusinessDay(const Date& date) const {
+        const Tables& t = *tables_;
+        const Date::serial_type i = date.serialNumber() - t.firstSerial;
+        return ((t.bits[i >> 5] >> (i & 31)) & 1) != 0;
+    }
+
+    bool BitmapCalendar::Impl::hasBusinessDayIndex() const {
+        return true;
+    }
+
+    Date::serial_type BitmapCalendar::Impl::businessDaysUpTo(
+                                                    const Date& date) const {
+        const Tables& t = *tables_;
+        const Date::serial_type i = date.serialNumber() - t.firstSerial;
+        const Date::serial_type b = i & 31;
+        const boost::uint32_t mask =
+            (b == 31) ? ~boost::uint32_t(0)
+                      : (boost::uint32_t(1) << (b+1)) - 1;
+        return t.counts[i >> 5] + bitCount(t.bits[i >> 5] & mask);
+    }
+
+    Date BitmapCalendar::Impl::nthBusinessDay(Date::serial_type n) const {
+        const Tables& t = *tables_;
+        if (n < 1 || n > t.counts.back())
+            return Date();
+
+        // the word containing the n-th business day
+        const Size k =
+            std::lower_bound(t.counts.begin(), t.counts.end(), n)
+            - t.counts.begin() - 1;
+
+        Date::serial_type left = n - t.counts[k];
+        const boost::uint32_t word = t.bits[k];
+        Date::serial_type b = 0;
+        for (;; ++b) {
+            if (((word >> b) & 1) != 0 && --left == 0)
+                break;
+        }
+        return Date(t.firstSerial + Date::serial_type(32*k) + b);
+    }
+
+
+    BitmapCalendar::BitmapCalendar(const Calendar& calendar) {
+        impl_ = ext::make_shared<BitmapCalendar::Impl>(calendar);
+    }
+
+    bool BitmapCalendar::sharesTablesWith(const BitmapCalendar& other) const {
+        return ext::static_pointer_cast<Impl>(impl_)->sharesTablesWith(
+                                 *ext::static_pointer_cast<Impl>(other.impl_));
+    }
+
+}
+
@@ -0,0 +1,107 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file bitmapcalendar.hpp
+    \brief Calendar with precomputed business days
+*/
+
+#ifndef quantlib_bitmap_calendar_hpp
+#define quantlib_bitmap_calendar_hpp
+
+#include <ql/time/calendar.hpp>
+#include <boost/cstdint.hpp>
+
+namespace QuantLib {
+
+    //! Calendar with precomputed business days
+    /*! This calendar stores the business days of the given calendar
+        between Date::minDate() and Date::maxDate() as a bitmap,
+        together with the number of business days preceding each
+        word of the bitmap.  Testing a date is a table lookup;
+        counting business days and advancing by a number of days
+        no longer test each intermediate date.
+
+        The tables are built once for each calendar implementation
+        (see Calendar::identity) and shared by all the bitmap
+        calendars built on it, so that only the first construction
+        pays for them; they are not modified afterwards, and
+        instances can therefore be shared among threads.  The cache
+        of shared tables is guarded by a mutex when the thread-safe
+        observer pattern is enabled, and by an OpenMP critical
+        section when OpenMP is; otherwise, as for the rest of the
+        library, bitmap calendars (and Business252 day counters)
+        must not be constructed from several threads at once.  Tables of
+        calendars with added or removed holidays are built for each
+        instance and not shared; tables are rebuilt if the weekends
+        of the calendar changed.  The calendar has the same name as
+        the original one and compares equal to it.
+
+        \warning the business days are taken at construction.
+                 Holidays added to or removed from the original
+                 calendar later are not seen by this one; holidays
+                 added to or removed from this calendar are honored,
+                 but counting and advancing then go back to testing
+                 each date.  Holidays added to or removed from the
+                 components of a calendar (e.g., of a JointCalendar)
+                 after the first bitmap calendar was built on it are
+                 not seen by the later ones either.
+
+        \ingroup calendars
+
+        \test the correctness of the returned results is tested
+              against the original calendar.
+    */
+    class BitmapCalendar : public Calendar {
+      private:
+        class Impl : public Calendar::Impl {
+          public:
+            explicit Impl(const Calendar&);
+            std::string name() const;
+            bool isWeekend(Weekday) const;
+            bool isBusinessDay(const Date&) const;
+            bool hasBusinessDayIndex() const;
+            Date::serial_type businessDaysUpTo(const Date&) const;
+            Date nthBusinessDay(Date::serial_type) const;
+            bool sharesTablesWith(const Impl& other) const {
+                return tables_ == other.tables_;
+            }
+          private:
+            struct Tables {
+                explicit Tables(const Calendar&);
+                unsigned int weekends;
+                Date::serial_type firstSerial;
+                // bit i of the bitmap is set if firstSerial+i is a
+                // business day; counts[k] is the number of business
+                // days in the first k words
+                std::vector<boost::uint32_t> bits;
+                std::vector<Date::serial_type> counts;
+            };
+            static ext::shared_ptr<const Tables> sharedTables(
+                                                        const Calendar&);
+            Calendar calendar_;
+            ext::shared_ptr<const Tables> tables_;
+        };
+      public:
+        explicit BitmapCalendar(const Calendar&);
+        //! whether the two calendars use the same precomputed tables
+        bool sharesTablesWith(const BitmapCalendar&) const;
+    };
+
+}
+
+
+#endif
@@ -32,7 +32,18 @@
 namespace QuantLib {
 
     //! Business/252 day count convention
-    /*! \ingroup daycounters */
+    /*! Business days are counted on the precomputed business days of
+        the given calendar (see BitmapCalendar).  They are built the
+        first time a day counter is built on the calendar and shared
+        by the later ones.
+
+        \warning holidays added to or removed from a calendar after a
+                 day counter was built on it are not seen by the day
+                 counter; build a new day counter on the modified
+                 calendar instead.
+
+        \ingroup daycounters
+    */
     class Business252 : public DayCounter {
       private:
         class Impl : public DayCounter::Impl {
@@ -46,7 +57,7 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
-            explicit Impl(Calendar c) { calendar_ = c; }
+            explicit Impl(const Calendar& c);
         };
       public:
         Business252(Calendar c = Brazil())
@@ -61,6 +61,13 @@ namespace QuantLib {
             return result;
         }
 
+        template <class T>
+        ext::shared_ptr<const std::vector<T> > shared(std::vector<T>& v) {
+            ext::shared_ptr<std::vector<T> > result(new std::vector<T>);
+            result->swap(v);
+            return result;
+        }
+
         bool allowsEndOfMonth(const Period& tenor) {
             return (tenor.units() == Months || tenor.units() == Years)
                 && tenor >= 1*Months;
@@ -69,6 +76,9 @@ namespace QuantLib {
     }
 
 
+    Schedule::Schedule()
+    : dates_(new std::vector<Date>), isRegular_(new std::vector<bool>) {}
+
     Schedule::Schedule(const std::vector<Date>& dates,
                        const Calendar& calendar,
                        BusinessDayConvention convention,
@@ -82,7 +92,8 @@ namespace QuantLib {
       convention_(convention),
       terminationDateConvention_(terminationDateConvention),
       rule_(rule),
-      dates_(dates), isRegular_(isRegular) {
+      dates_(new std::vector<Date>(dates)),
+      isRegular_(new std::vector<bool>(isRegular)) {
 
         if (tenor != boost::none && !allowsEndOfMonth(*tenor))
             endOfMonth_ = false;
@@ -90,9 +101,9 @@ namespace QuantLib {
             endOfMonth_ = endOfMonth;
 
         QL_REQUIRE(
-            isRegular_.size() == 0 || isRegular_.size() == dates.size() - 1,
+            isRegular.size() == 0 || isRegular.size() == dates.size() - 1,
             "isRegular size ("
-                << isRegular_.size()
+                << isRegular.size()
                 << ") must be zero or equal to the number of dates minus 1 ("
                 << dates.size() - 1 << ")");
     }
@@ -204,6 +215,9 @@ namespace QuantLib {
         }
 
 
+        std::vector<Date> dates;
+        std::vector<bool> isRegular;
+
         // calendar needed for endOfMonth adjustment
         Calendar nullCalendar = NullCalendar();
         Integer periods = 1;
@@ -212,24 +226,24 @@ namespace QuantLib {
 
           case DateGeneration::Zero:
             tenor_ = 0*Years;
-            dates_.push_back(effectiveDate);
-            dates_.push_back(terminationDate);
-            isRegular_.push_back(true);
+            dates.push_back(effectiveDate);
+            dates.push_back(terminationDate);
+            isRegular.push_back(true);
             break;
 
           case DateGeneration::Backward:
 
-            dates_.push_back(terminationDate);
+            dates.push_back(terminationDate);
 
             seed = terminationDate;
             if (nextToLastDate_ != Date()) {
-                dates_.insert(dates_.begin(), nextToLastDate_);
+                dates.insert(dates.begin(), nextToLastDate_);
                 Date temp = nullCalendar.advance(seed,
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp!=nextToLastDate_)
-                    isRegular_.insert(isRegular_.begin(), false);
+                    isRegular.insert(isRegular.begin(), false);
                 else
-                    isRegular_.insert(isRegular_.begin(), true);
+                    isRegular.insert(isRegular.begin(), true);
                 seed = nextToLastDate_;
             }
 
@@ -242,28 +256,28 @@ namespace QuantLib {
                     -periods*(*tenor_), convention, *endOfMonth_);
                 if (temp < exitDate) {
                     if (firstDate_ != Date() &&
-                        (calendar_.adjust(dates_.front(),convention)!=
+                        (calendar_.adjust(dates.front(),convention)!=
                          calendar_.adjust(firstDate_,convention))) {
-                        dates_.insert(dates_.begin(), firstDate_);
-                        isRegular_.insert(isRegular_.begin(), false);
+                        dates.insert(dates.begin(), firstDate_);
+                        isRegular.insert(isRegular.begin(), false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.front(),convention)!=
+                    if (calendar_.adjust(dates.front(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.insert(dates_.begin(), temp);
-                        isRegular_.insert(isRegular_.begin(), true);
+                        dates.insert(dates.begin(), temp);
+                        isRegular.insert(isRegular.begin(), true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.front(),convention)!=
+            if (calendar_.adjust(dates.front(),convention)!=
                 calendar_.adjust(effectiveDate,convention)) {
-                dates_.insert(dates_.begin(), effectiveDate);
-                isRegular_.insert(isRegular_.begin(), false);
+                dates.insert(dates.begin(), effectiveDate);
+                isRegular.insert(isRegular.begin(), false);
             }
             break;
 
@@ -280,21 +294,21 @@ namespace QuantLib {
           case DateGeneration::Forward:
 
             if (*rule_ == DateGeneration::CDS || *rule_ == DateGeneration::CDS2015) {
-                dates_.push_back(previousTwentieth(effectiveDate, *rule_));
+                dates.push_back(previousTwentieth(effectiveDate, *rule_));
             } else {
-                dates_.push_back(effectiveDate);
+                dates.push_back(effectiveDate);
             }
 
-            seed = dates_.back();
+            seed = dates.back();
 
             if (firstDate_!=Date()) {
-                dates_.push_back(firstDate_);
+                dates.push_back(firstDate_);
                 Date temp = nullCalendar.advance(seed, periods*(*tenor_),
                                                  convention, *endOfMonth_);
                 if (temp!=firstDate_)
-                    isRegular_.push_back(false);
+                    isRegular.push_back(false);
                 else
-                    isRegular_.push_back(true);
+                    isRegular.push_back(true);
                 seed = firstDate_;
             } else if (*rule_ == DateGeneration::Twentieth ||
                        *rule_ == DateGeneration::TwentiethIMM ||
@@ -311,8 +325,8 @@ namespace QuantLib {
                     }
                 }
                 if (next20th != effectiveDate) {
-                    dates_.push_back(next20th);
-                    isRegular_.push_back(false);
+                    dates.push_back(next20th);
+                    isRegular.push_back(false);
                     seed = next20th;
                 }
             }
@@ -330,42 +344,42 @@ namespace QuantLib {
                                                  convention, *endOfMonth_);
                 if (temp > exitDate) {
                     if (nextToLastDate_ != Date() &&
-                        (calendar_.adjust(dates_.back(),convention)!=
+                        (calendar_.adjust(dates.back(),convention)!=
                          calendar_.adjust(nextToLastDate_,convention))) {
-                        dates_.push_back(nextToLastDate_);
-                        isRegular_.push_back(false);
+                        dates.push_back(nextToLastDate_);
+                        isRegular.push_back(false);
                     }
                     break;
                 } else {
                     // skip dates that would result in duplicates
                     // after adjustment
-                    if (calendar_.adjust(dates_.back(),convention)!=
+                    if (calendar_.adjust(dates.back(),convention)!=
                         calendar_.adjust(temp,convention)) {
-                        dates_.push_back(temp);
-                        isRegular_.push_back(true);
+                        dates.push_back(temp);
+                        isRegular.push_back(true);
                     }
                     ++periods;
                 }
             }
 
-            if (calendar_.adjust(dates_.back(),terminationDateConvention)!=
+            if (calendar_.adjust(dates.back(),terminationDateConvention)!=
                 calendar_.adjust(terminationDate,terminationDateConvention)) {
                 if (*rule_ == DateGeneration::Twentieth ||
                     *rule_ == DateGeneration::TwentiethIMM ||
                     *rule_ == DateGeneration::OldCDS ||
                     *rule_ == DateGeneration::CDS) {
-                    dates_.push_back(nextTwentieth(terminationDate, *rule_));
-                    isRegular_.push_back(true);
+                    dates.push_back(nextTwentieth(terminationDate, *rule_));
+                    isRegular.push_back(true);
                 } else if(*rule_ == DateGeneration::CDS2015) {
                     Date tentativeTerminationDate =
                         nextTwentieth(terminationDate, *rule_);
                     if(tentativeTerminationDate.month() %2 == 0) {
-                        dates_.push_back(tentativeTerminationDate);
-                        isRegular_.push_back(true);
+                        dates.push_back(tentativeTerminationDate);
+                        isRegular.push_back(true);
                     }
                 } else {
-                    dates_.push_back(terminationDate);
-                    isRegular_.push_back(false);
+                    dates.push_back(terminationDate);
+                    isRegular.push_back(false);
                 }
             }
 
@@ -377,44 +391,44 @@ namespace QuantLib {
 
         // adjustments
         if (*rule_==DateGeneration::ThirdWednesday)
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = Date::nthWeekday(3, Wednesday,
-                                             dates_[i].month(),
-                                             dates_[i].year());
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = Date::nthWeekday(3, Wednesday,
+                                             dates[i].month(),
+                                             dates[i].year());
 
         if (*endOfMonth_ && calendar_.isEndOfMonth(seed)) {
             // adjust to end of month
             if (convention == Unadjusted) {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = Date::endOfMonth(dates_[i]);
+                for (Size i=1; i<dates.size()-1; ++i)
+                    dates[i] = Date::endOfMonth(dates[i]);
             } else {
-                for (Size i=1; i<dates_.size()-1; ++i)
-                    dates_[i] = calendar_.endOfMonth(dates_[i]);
+                for (Size i=1; i<dates.size()-1; ++i)
+                    dates[i] = calendar_.endOfMonth(dates[i]);
             }
-            Date d1 = dates_.front(), d2 = dates_.back();
+            Date d1 = dates.front(), d2 = dates.back();
             if (terminationDateConvention != Unadjusted) {
-                d1 = calendar_.endOfMonth(dates_.front());
-                d2 = calendar_.endOfMonth(dates_.back());
+                d1 = calendar_.endOfMonth(dates.front());
+                d2 = calendar_.endOfMonth(dates.back());
             } else {
                 // the termination date is the first if going backwards,
                 // the last otherwise.
                 if (*rule_ == DateGeneration::Backward)
-                    d2 = Date::endOfMonth(dates_.back());
+                    d2 = Date::endOfMonth(dates.back());
                 else
-                    d1 = Date::endOfMonth(dates_.front());
+                    d1 = Date::endOfMonth(dates.front());
             }
             // if the eom adjustment leads to a single date schedule
             // we do not apply it
             if(d1 != d2) {
-                dates_.front() = d1;
-                dates_.back() = d2;
+                dates.front() = d1;
+                dates.back() = d2;
             }
         } else {
             // first date not adjusted for old CDS schedules
             if (*rule_ != DateGeneration::OldCDS)
-                dates_[0] = calendar_.adjust(dates_[0], convention);
-            for (Size i=1; i<dates_.size()-1; ++i)
-                dates_[i] = calendar_.adjust(dates_[i], convention);
+                dates[0] = calendar_.adjust(dates[0], convention);
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = calendar_.adjust(dates[i], convention);
 
             // termination date is NOT adjusted as per ISDA
             // specifications, unless otherwise specified in the
@@ -423,7 +437,7 @@ namespace QuantLib {
             if (terminationDateConvention != Unadjusted
                 && *rule_ != DateGeneration::CDS
                 && *rule_ != DateGeneration::CDS2015) {
-                dates_.back() = calendar_.adjust(dates_.back(),
+                dates.back() = calendar_.adjust(dates.back(),
                                                  terminationDateConvention);
             }
         }
@@ -432,26 +446,26 @@ namespace QuantLib {
         // necessary.  It can happen to be equal or later than the end
         // date due to EOM adjustments (see the Schedule test suite
         // for an example).
-        if (dates_.size() >= 2 && dates_[dates_.size()-2] >= dates_.back()) {
-            // there might be two dates only, then isRegular_ has size one
-            if (isRegular_.size() >= 2) {
-                isRegular_[isRegular_.size() - 2] =
-                    (dates_[dates_.size() - 2] == dates_.back());
+        if (dates.size() >= 2 && dates[dates.size()-2] >= dates.back()) {
+            // there might be two dates only, then isRegular has size one
+            if (isRegular.size() >= 2) {
+                isRegular[isRegular.size() - 2] =
+                    (dates[dates.size() - 2] == dates.back());
             }
-            dates_[dates_.size() - 2] = dates_.back();
-            dates_.pop_back();
-            isRegular_.pop_back();
+            dates[dates.size() - 2] = dates.back();
+            dates.pop_back();
+            isRegular.pop_back();
         }
-        if (dates_.size() >= 2 && dates_[1] <= dates_.front()) {
-            isRegular_[1] =
-                (dates_[1] == dates_.front());
-            dates_[1] = dates_.front();
-            dates_.erase(dates_.begin());
-            isRegular_.erase(isRegular_.begin());
+        if (dates.size() >= 2 && dates[1] <= dates.front()) {
+            isRegular[1] =
+                (dates[1] == dates.front());
+            dates[1] = dates.front();
+            dates.erase(dates.begin());
+            isRegular.erase(isRegular.begin());
         }
 
-        QL_ENSURE(dates_.size()>1,
-            "degenerate single date (" << dates_[0] << ") schedule" <<
+        QL_ENSURE(dates.size()>1,
+            "degenerate single date (" << dates[0] << ") schedule" <<
             "\n seed date: " << seed <<
             "\n exit date: " << exitDate <<
             "\n effective date: " << effectiveDate <<
@@ -461,72 +475,84 @@ namespace QuantLib {
             "\n generation rule: " << *rule_ <<
             "\n end of month: " << *endOfMonth_);
 
+        dates_ = shared(dates);
+        isRegular_ = shared(isRegular);
     }
 
     Schedule Schedule::after(const Date& truncationDate) const {
-        Schedule result = *this;
-
-        QL_REQUIRE(truncationDate < result.dates_.back(),
+        QL_REQUIRE(truncationDate < dates_->back(),
             "truncation date " << truncationDate <<
             " must be before the last schedule date " <<
-            result.dates_.back());
-        if (truncationDate > result.dates_[0]) {
-            // remove earlier dates
-            while (result.dates_[0] < truncationDate) {
-                result.dates_.erase(result.dates_.begin());
-                if (!result.isRegular_.empty())
-                    result.isRegular_.erase(result.isRegular_.begin());
-            }
+            dates_->back());
+        if (truncationDate <= dates_->front())
+            return *this;
 
-            // add truncationDate if missing
-            if (truncationDate != result.dates_.front()) {
-                result.dates_.insert(result.dates_.begin(), truncationDate);
-                result.isRegular_.insert(result.isRegular_.begin(), false);
-                result.terminationDateConvention_ = Unadjusted;
-            }
-            else {
-                result.terminationDateConvention_ = convention_;
-            }
+        Schedule result = *this;
+        std::vector<Date> dates = *dates_;
+        std::vector<bool> isRegular = *isRegular_;
+
+        // remove earlier dates
+        while (dates[0] < truncationDate) {
+            dates.erase(dates.begin());
+            if (!isRegular.empty())
+                isRegular.erase(isRegular.begin());
+        }
 
-            if (result.nextToLastDate_ <= truncationDate)
-                result.nextToLastDate_ = Date();
-            if (result.firstDate_ <= truncationDate)
-                result.firstDate_ = Date();
+        // add truncationDate if missing
+        if (truncationDate != dates.front()) {
+            dates.insert(dates.begin(), truncationDate);
+            isRegular.insert(isRegular.begin(), false);
+            result.terminationDateConvention_ = Unadjusted;
         }
+        else {
+            result.terminationDateConvention_ = convention_;
+        }
+
+        if (result.nextToLastDate_ <= truncationDate)
+            result.nextToLastDate_ = Date();
+        if (result.firstDate_ <= truncationDate)
+            result.firstDate_ = Date();
 
+        result.dates_ = shared(dates);
+        result.isRegular_ = shared(isRegular);
         return result;
     }
 
     Schedule Schedule::until(const Date& truncationDate) const {
-        Schedule result = *this;
-
-        QL_REQUIRE(truncationDate>result.dates_[0],
+        QL_REQUIRE(truncationDate>dates_->front(),
                    "truncation date " << truncationDate <<
                    " must be later than schedule first date " <<
-                   result.dates_[0]);
-        if (truncationDate<result.dates_.back()) {
-            // remove later dates
-            while (result.dates_.back()>truncationDate) {
-                result.dates_.pop_back();
-                if(!result.isRegular_.empty())
-                    result.isRegular_.pop_back();
-            }
+                   dates_->front());
+        if (truncationDate>=dates_->back())
+            return *this;
 
-            // add truncationDate if missing
-            if (truncationDate!=result.dates_.back()) {
-                result.dates_.push_back(truncationDate);
-                result.isRegular_.push_back(false);
-                result.terminationDateConvention_ = Unadjusted;
-            } else {
-                result.terminationDateConvention_ = convention_;
-            }
+        Schedule result = *this;
+        std::vector<Date> dates = *dates_;
+        std::vector<bool> isRegular = *isRegular_;
+
+        // remove later dates
+        while (dates.back()>truncationDate) {
+            dates.pop_back();
+            if(!isRegular.empty())
+                isRegular.pop_back();
+        }
 
-            if (result.nextToLastDate_>=truncationDate)
-                result.nextToLastDate_ = Date();
-            if (result.firstDate_>=truncationDate)
-                result.firstDate_ = Date();
+        // add truncationDate if missing
+        if (truncationDate!=dates.back()) {
+            dates.push_back(truncationDate);
+            isRegular.push_back(false);
+            result.terminationDateConvention_ = Unadjusted;
+        } else {
+            result.terminationDateConvention_ = convention_;
         }
 
+        if (result.nextToLastDate_>=truncationDate)
+            result.nextToLastDate_ = Date();
+        if (result.firstDate_>=truncationDate)
+            result.firstDate_ = Date();
+
+        result.dates_ = shared(dates);
+        result.isRegular_ = shared(isRegular);
         return result;
     }
 
@@ -535,12 +561,12 @@ namespace QuantLib {
         Date d = (refDate==Date() ?
                   Settings::instance().evaluationDate() :
                   refDate);
-        return std::lower_bound(dates_.begin(), dates_.end(), d);
+        return std::lower_bound(dates_->begin(), dates_->end(), d);
     }
 
     Date Schedule::nextDate(const Date& refDate) const {
         std::vector<Date>::const_iterator res = lower_bound(refDate);
-        if (res!=dates_.end())
+        if (res!=dates_->end())
             return *res;
         else
             return Date();
@@ -548,29 +574,29 @@ namespace QuantLib {
 
     Date Schedule::previousDate(const Date& refDate) const {
         std::vector<Date>::const_iterator res = lower_bound(refDate);
-        if (res!=dates_.begin())
+        if (res!=dates_->begin())
             return *(--res);
         else
             return Date();
     }
 
     bool Schedule::hasIsRegular() const {
-        return isRegular_.size() > 0;
+        return isRegular_->size() > 0;
     }
 
     bool Schedule::isRegular(Size i) const {
         QL_REQUIRE(hasIsRegular(),
                    "full interface (isRegular) not available");
-        QL_REQUIRE(i<=isRegular_.size() && i>0,
+        QL_REQUIRE(i<=isRegular_->size() && i>0,
                    "index (" << i << ") must be in [1, " <<
-                   isRegular_.size() <<"]");
-        return isRegular_[i-1];
+                   isRegular_->size() <<"]");
+        return (*isRegular_)[i-1];
     }
 
     const std::vector<bool>& Schedule::isRegular() const {
-        QL_REQUIRE(isRegular_.size() > 0,
+        QL_REQUIRE(isRegular_->size() > 0,
                    "full interface (isRegular) not available");
-        return isRegular_;
+        return *isRegular_;
     }
 
     MakeSchedule::MakeSchedule()
@@ -64,23 +64,23 @@ namespace QuantLib {
                  bool endOfMonth,
                  const Date& firstDate = Date(),
                  const Date& nextToLastDate = Date());
-        Schedule() {}
+        Schedule();
         //! \name Date access
         //@{
-        Size size() const { return dates_.size(); }
+        Size size() const { return dates_->size(); }
         const Date& operator[](Size i) const;
         const Date& at(Size i) const;
         const Date& date(Size i) const;
         Date previousDate(const Date& refDate) const;
         Date nextDate(const Date& refDate) const;
-        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Date>& dates() const { return *dates_; }
         bool hasIsRegular() const;
         bool isRegular(Size i) const;
         const std::vector<bool>& isRegular() const;
         //@}
         //! \name Other inspectors
         //@{
-        bool empty() const { return dates_.empty(); }
+        bool empty() const { return dates_->empty(); }
         const Calendar& calendar() const;
         const Date& startDate() const;
         const Date& endDate() const;
@@ -97,8 +97,8 @@ namespace QuantLib {
         //! \name Iterators
         //@{
         typedef std::vector<Date>::const_iterator const_iterator;
-        const_iterator begin() const { return dates_.begin(); }
-        const_iterator end() const { return dates_.end(); }
+        const_iterator begin() const { return dates_->begin(); }
+        const_iterator end() const { return dates_->end(); }
         const_iterator lower_bound(const Date& d = Date()) const;
         //@}
         //! \name Utilities
@@ -115,8 +115,9 @@ namespace QuantLib {
         boost::optional<DateGeneration::Rule> rule_;
         boost::optional<bool> endOfMonth_;
         Date firstDate_, nextToLastDate_;
-        std::vector<Date> dates_;
-        std::vector<bool> isRegular_;
+        // immutable once built, so that copies can share them
+        ext::shared_ptr<const std::vector<Date> > dates_;
+        ext::shared_ptr<const std::vector<bool> > isRegular_;
     };
 
 
@@ -157,19 +158,19 @@ namespace QuantLib {
     // inline definitions
 
     inline const Date& Schedule::date(Size i) const {
-        return dates_.at(i);
+        return dates_->at(i);
     }
 
     inline const Date& Schedule::operator[](Size i) const {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
-        return dates_.at(i);
+        return dates_->at(i);
         #else
-        return dates_[i];
+        return (*dates_)[i];
         #endif
     }
 
     inline const Date& Schedule::at(Size i) const {
-        return dates_.at(i);
+        return dates_->at(i);
     }
 
     inline const Calendar& Schedule::calendar() const {
@@ -177,10 +178,10 @@ namespace QuantLib {
     }
 
     inline const Date& Schedule::startDate() const {
-        return dates_.front();
+        return dates_->front();
     }
 
-    inline const Date &Schedule::endDate() const { return dates_.back(); }
+    inline const Date &Schedule::endDate() const { return dates_->back(); }
 
     inline bool Schedule::hasTenor() const {
         return tenor_ != boost::none;
@@ -0,0 +1,194 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+#include <ql/time/calendars/bitmapcalendar.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        bool modified(const Calendar& calendar) {
+            return !calendar.addedHolidays().empty()
+                || !calendar.removedHolidays().empty();
+        }
+
+        unsigned int weekendMask(const Calendar& calendar) {
+            unsigned int mask = 0;
+            for (Integer w=Sunday; w<=Saturday; ++w) {
+                if (calendar.isWeekend(Weekday(w)))
+                    mask |= 1U << w;
+            }
+            return mask;
+        }
+
+        // the given schedule, holding the given calendar
+        Schedule withCalendar(const Schedule& s, const Calendar& calendar) {
+            return Schedule(s.dates(), calendar, s.businessDayConvention(),
+                            s.terminationDateBusinessDayConvention(),
+                            s.tenor(), s.rule(), s.endOfMonth(),
+                            s.hasIsRegular() ? s.isRegular()
+                                             : std::vector<bool>());
+        }
+
+    }
+
+    bool ScheduleCache::Key::operator<(const Key& other) const {
+        if (effectiveDate != other.effectiveDate)
+            return effectiveDate < other.effectiveDate;
+        if (terminationDate != other.terminationDate)
+            return terminationDate < other.terminationDate;
+        if (tenorLength != other.tenorLength)
+            return tenorLength < other.tenorLength;
+        if (tenorUnits != other.tenorUnits)
+            return tenorUnits < other.tenorUnits;
+        if (calendar != other.calendar)
+            return calendar < other.calendar;
+        if (weekends != other.weekends)
+            return weekends < other.weekends;
+        if (convention != other.convention)
+            return convention < other.convention;
+        if (terminationDateConvention != other.terminationDateConvention)
+            return terminationDateConvention < other.terminationDateConvention;
+        if (rule != other.rule)
+            return rule < other.rule;
+        if (endOfMonth != other.endOfMonth)
+            return endOfMonth < other.endOfMonth;
+        if (firstDate != other.firstDate)
+            return firstDate < other.firstDate;
+        return nextToLastDate < other.nextToLastDate;
+    }
+
+    Calendar ScheduleCache::indexedCalendar(const Calendar& calendar) {
+        QL_REQUIRE(!calendar.empty(), "no calendar implementation provided");
+
+        if (modified(calendar))
+            return calendar;
+
+        // the weekends of a bespoke calendar might have changed
+        const CalendarKey key(calendar.identity(), weekendMask(calendar));
+        std::map<CalendarKey, Calendar>::const_iterator
+            i = calendars_.find(key);
+        if (i == calendars_.end())
+            i = calendars_.insert(std::make_pair(
+                    key, BitmapCalendar(calendar))).first;
+        return i->second;
+    }
+
+    Schedule ScheduleCache::schedule(
+                          const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate,
+                          const Date& nextToLastDate) {
+        return schedule(effectiveDate, terminationDate, tenor,
+                        calendar, indexedCalendar(calendar),
+                        convention, terminationDateConvention,
+                        rule, endOfMonth, firstDate, nextToLastDate);
+    }
+
+    std::vector<Schedule> ScheduleCache::schedules(
+                          const std::vector<Date>& effectiveDates,
+                          const std::vector<Date>& terminationDates,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth) {
+        QL_REQUIRE(effectiveDates.size() == terminationDates.size(),
+                   "the number of effective dates ("
+                   << effectiveDates.size()
+                   << ") does not match the number of termination dates ("
+                   << terminationDates.size() << ")");
+
+        const Calendar indexed = indexedCalendar(calendar);
+
+        std::vector<Schedule> result;
+        result.reserve(effectiveDates.size());
+        for (Size i=0; i<effectiveDates.size(); ++i)
+            result.push_back(schedule(effectiveDates[i], terminationDates[i],
+                                      tenor, calendar, indexed,
+                                      convention, terminationDateConvention,
+                                      rule, endOfMonth, Date(), Date()));
+        return result;
+    }
+
+    Schedule ScheduleCache::schedule(
+                          const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          const Calendar& indexedCalendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate,
+                          const Date& nextToLastDate) {
+        if (effectiveDate == Date() || modified(calendar)) {
+            Schedule s(effectiveDate, terminationDate, tenor,
+                       indexedCalendar, convention,
+                       terminationDateConvention, rule, endOfMonth,
+                       firstDate, nextToLastDate);
+            return indexedCalendar.identity() == calendar.identity() ?
+                s : withCalendar(s, calendar);
+        }
+
+        Key key;
+        key.effectiveDate = effectiveDate;
+        key.terminationDate = terminationDate;
+        key.tenorLength = tenor.length();
+        key.tenorUnits = tenor.units();
+        key.calendar = calendar.identity();
+        key.weekends = weekendMask(calendar);
+        key.convention = convention;
+        key.terminationDateConvention = terminationDateConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate;
+        key.nextToLastDate = nextToLastDate;
+
+        std::map<Key, Schedule>::const_iterator i = schedules_.find(key);
+        if (i == schedules_.end())
+            i = schedules_.insert(std::make_pair(
+                    key, withCalendar(
+                             Schedule(effectiveDate, terminationDate, tenor,
+                                      indexedCalendar, convention,
+                                      terminationDateConvention, rule,
+                                      endOfMonth, firstDate,
+                                      nextToLastDate),
+                             calendar))).first;
+        return i->second;
+    }
+
+    Size ScheduleCache::size() const {
+        return schedules_.size();
+    }
+
+    void ScheduleCache::clear() {
+        schedules_.clear();
+        calendars_.clear();
+    }
+
+}
+
@@ -0,0 +1,119 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief cache of rule-based schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! cache of rule-based schedules
+    /*! Schedules generated with the same parameters are built once;
+        the returned copies share their dates.  Their dates are
+        generated on a calendar with precomputed business days (see
+        BitmapCalendar), which is built once per calendar and reused
+        by all the schedules in the cache; the returned schedules
+        still hold the calendar they were requested with.  Calendars
+        are told apart by their identity (see Calendar::identity)
+        rather than by their name, so that distinct calendars sharing
+        a name (e.g., two BespokeCalendar instances) don't share
+        schedules, and by their weekends, so that weekends added to
+        a BespokeCalendar after its first use are taken into
+        account.
+
+        Schedules with a null effective date (which depends on the
+        evaluation date) or on a calendar with added or removed
+        holidays are generated each time and not stored.
+
+        \warning the dates are generated on a snapshot of the business
+                 days of the calendar, taken the first time the cache
+                 uses it.  Holidays changed afterwards through other
+                 calendars (e.g., the components of a JointCalendar)
+                 are not seen by the cache, which returns the schedules
+                 generated before; call clear() after such changes.
+
+        \warning the cache is not thread-safe; use one cache per
+                 thread.
+    */
+    class ScheduleCache {
+      public:
+        //! same arguments as the rule-based Schedule constructor
+        Schedule schedule(const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate = Date(),
+                          const Date& nextToLastDate = Date());
+        //! schedules sharing all parameters but the start and end dates
+        std::vector<Schedule> schedules(
+                          const std::vector<Date>& effectiveDates,
+                          const std::vector<Date>& terminationDates,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth);
+        //! number of stored schedules
+        Size size() const;
+        void clear();
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            ext::shared_ptr<const void> calendar;
+            unsigned int weekends;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator<(const Key&) const;
+        };
+        Calendar indexedCalendar(const Calendar&);
+        Schedule schedule(const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          const Calendar& indexedCalendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate,
+                          const Date& nextToLastDate);
+        std::map<Key, Schedule> schedules_;
+        // calendar identity and weekday mask of the weekends
+        typedef std::pair<ext::shared_ptr<const void>, unsigned int>
+                                                           CalendarKey;
+        std::map<CalendarKey, Calendar> calendars_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,326 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/marketdatafile.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/cstdint.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#endif
+#include <boost/algorithm/string/case_conv.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic pop
+#endif
+#include <cstring>
+#include <fstream>
+
+using boost::algorithm::to_upper_copy;
+using boost::uint32_t;
+using boost::uint64_t;
+using boost::int32_t;
+
+namespace QuantLib {
+
+    namespace {
+
+        // file layout; all offsets are from the start of the file
+        //
+        // header:        magic[8], version (u32), byte-order mark (u32),
+        //                file size, histories, quotes, reserved (u64)
+        // history entry: name offset, name length, fixings,
+        //                dates offset, values offset (u64)
+        // quote entry:   name offset, name length (u64), value (double)
+        //
+        // followed by the date serial numbers (i32), the values
+        // (double) and the names, with each array 8-byte aligned.
+
+        const char magic[8] = { 'Q', 'L', 'M', 'K', 'T', 'D', 'A', 'T' };
+        const uint32_t version = 1;
+        const uint32_t byteOrderMark = 0x01020304;
+        const Size headerSize = 48;
+        const Size historyEntrySize = 40;
+        const Size quoteEntrySize = 24;
+
+        uint64_t readU64(const char* p) {
+            uint64_t x;
+            std::memcpy(&x, p, sizeof(x));
+            return x;
+        }
+
+        uint32_t readU32(const char* p) {
+            uint32_t x;
+            std::memcpy(&x, p, sizeof(x));
+            return x;
+        }
+
+        double readDouble(const char* p) {
+            double x;
+            std::memcpy(&x, p, sizeof(x));
+            return x;
+        }
+
+        Size aligned(Size n) {
+            return (n + 7) & ~Size(7);
+        }
+
+        template <class T>
+        void put(std::vector<char>& buffer, Size offset, const T& x) {
+            std::memcpy(&buffer[offset], &x, sizeof(T));
+        }
+
+    }
+
+    struct MarketDataFile::Mapping {
+        explicit Mapping(const std::string& path)
+        : file(path.c_str(), boost::interprocess::read_only),
+          region(file, boost::interprocess::read_only) {}
+        boost::interprocess::file_mapping file;
+        boost::interprocess::mapped_region region;
+    };
+
+    MarketDataFile::MarketDataFile(const std::string& path) {
+        try {
+            mapping_ = ext::make_shared<Mapping>(path);
+        } catch (std::exception& e) {
+            QL_FAIL("unable to map " << path << ": " << e.what());
+        }
+        data_ = static_cast<const char*>(mapping_->region.get_address());
+        size_ = mapping_->region.get_size();
+
+        QL_REQUIRE(size_ >= headerSize
+                   && std::memcmp(data_, magic, sizeof(magic)) == 0,
+                   path << " is not a market-data file");
+        QL_REQUIRE(readU32(data_+12) == byteOrderMark,
+                   path << " was written with a different byte order");
+        QL_REQUIRE(readU32(data_+8) == version,
+                   "unsupported market-data file version ("
+                   << readU32(data_+8) << ")");
+        QL_REQUIRE(readU64(data_+16) == size_,
+                   path << " is truncated");
+
+        histories_ = readU64(data_+24);
+        quotes_ = readU64(data_+32);
+        QL_REQUIRE(histories_ <= size_/historyEntrySize
+                   && quotes_ <= size_/quoteEntrySize
+                   && headerSize + histories_*historyEntrySize
+                      + quotes_*quoteEntrySize <= size_,
+                   path << " has an invalid directory");
+
+        for (Size i=0; i<histories_; ++i) {
+            const char* entry = historyEntry(i);
+            Size n = readU64(entry+16);
+            QL_REQUIRE(n <= size_/sizeof(double)
+                       && readU64(entry+24) % 8 == 0
+                       && readU64(entry+32) % 8 == 0,
+                       path << " has an invalid history entry");
+            address(readU64(entry), readU64(entry+8));
+            address(readU64(entry+24), n*sizeof(int32_t));
+            address(readU64(entry+32), n*sizeof(double));
+        }
+        for (Size i=0; i<quotes_; ++i) {
+            const char* entry = quoteEntry(i);
+            address(readU64(entry), readU64(entry+8));
+        }
+    }
+
+    const char* MarketDataFile::address(Size offset, Size size) const {
+        QL_REQUIRE(offset <= size_ && size <= size_ - offset,
+                   "market-data file entry out of range");
+        return data_ + offset;
+    }
+
+    const char* MarketDataFile::historyEntry(Size i) const {
+        QL_REQUIRE(i < histories_,
+                   "history index (" << i << ") out of range");
+        return data_ + headerSize + i*historyEntrySize;
+    }
+
+    const char* MarketDataFile::quoteEntry(Size i) const {
+        QL_REQUIRE(i < quotes_, "quote index (" << i << ") out of range");
+        return data_ + headerSize + histories_*historyEntrySize
+            + i*quoteEntrySize;
+    }
+
+    Size MarketDataFile::histories() const {
+        return histories_;
+    }
+
+    std::string MarketDataFile::historyName(Size i) const {
+        const char* entry = historyEntry(i);
+        return std::string(data_ + readU64(entry), readU64(entry+8));
+    }
+
+    Size MarketDataFile::historySize(Size i) const {
+        return readU64(historyEntry(i)+16);
+    }
+
+    void MarketDataFile::loadHistory(Size i) const {
+        const char* entry = historyEntry(i);
+        Size n = readU64(entry+16);
+        // the arrays are 8-byte aligned within a page-aligned mapping
+        const int32_t* serials =
+            reinterpret_cast<const int32_t*>(data_ + readU64(entry+24));
+        const double* values =
+            reinterpret_cast<const double*>(data_ + readU64(entry+32));
+
+        std::vector<Date> dates(n);
+        for (Size k=0; k<n; ++k)
+            dates[k] = Date(Date::serial_type(serials[k]));
+        std::vector<Real> fixings(values, values+n);
+
+        // the arrays are handed over to the manager, not copied again
+        IndexManager& manager = IndexManager::instance();
+        manager.swapHistory(manager.handle(historyName(i)), dates, fixings);
+    }
+
+    void MarketDataFile::loadHistories() const {
+        for (Size i=0; i<histories_; ++i)
+            loadHistory(i);
+    }
+
+    Size MarketDataFile::quotes() const {
+        return quotes_;
+    }
+
+    std::string MarketDataFile::quoteName(Size i) const {
+        const char* entry = quoteEntry(i);
+        return std::string(data_ + readU64(entry), readU64(entry+8));
+    }
+
+    Real MarketDataFile::quoteValue(Size i) const {
+        return readDouble(quoteEntry(i)+16);
+    }
+
+    std::map<std::string, ext::shared_ptr<SimpleQuote> >
+    MarketDataFile::simpleQuotes() const {
+        std::map<std::string, ext::shared_ptr<SimpleQuote> > result;
+        for (Size i=0; i<quotes_; ++i)
+            result[quoteName(i)] =
+                ext::make_shared<SimpleQuote>(quoteValue(i));
+        return result;
+    }
+
+    Size MarketDataFile::updateQuotes(
+        const std::map<std::string, ext::shared_ptr<SimpleQuote> >& quotes)
+                                                                     const {
+        Size updated = 0;
+        for (Size i=0; i<quotes_; ++i) {
+            std::map<std::string,
+                     ext::shared_ptr<SimpleQuote> >::const_iterator q =
+                quotes.find(quoteName(i));
+            if (q != quotes.end()) {
+                q->second->setValue(quoteValue(i));
+                ++updated;
+            }
+        }
+        return updated;
+    }
+
+    void MarketDataFile::write(
+            const std::string& path,
+            const std::vector<std::string>& indexNames,
+            const std::map<std::string, ext::shared_ptr<Quote> >& quotes) {
+
+        IndexManager& manager = IndexManager::instance();
+        std::vector<Size> handles(indexNames.size());
+        std::vector<std::string> names(indexNames.size());
+        for (Size i=0; i<indexNames.size(); ++i) {
+            names[i] = to_upper_copy(indexNames[i]);
+            handles[i] = manager.handle(names[i]);
+        }
+
+        std::vector<std::pair<std::string, double> > values;
+        for (std::map<std::string, ext::shared_ptr<Quote> >::const_iterator
+                 q = quotes.begin(); q != quotes.end(); ++q) {
+            if (q->second && q->second->isValid())
+                values.push_back(std::make_pair(q->first,
+                                                q->second->value()));
+        }
+
+        // layout
+        Size offset = headerSize + handles.size()*historyEntrySize
+            + values.size()*quoteEntrySize;
+        std::vector<Size> datesOffsets(handles.size()),
+                          valuesOffsets(handles.size());
+        for (Size i=0; i<handles.size(); ++i) {
+            Size n = manager.fixingDates(handles[i]).size();
+            datesOffsets[i] = offset;
+            offset += aligned(n*sizeof(int32_t));
+            valuesOffsets[i] = offset;
+            offset += n*sizeof(double);
+        }
+        std::vector<Size> historyNameOffsets(handles.size()),
+                          quoteNameOffsets(values.size());
+        for (Size i=0; i<names.size(); ++i) {
+            historyNameOffsets[i] = offset;
+            offset += names[i].size();
+        }
+        for (Size i=0; i<values.size(); ++i) {
+            quoteNameOffsets[i] = offset;
+            offset += values[i].first.size();
+        }
+
+        std::vector<char> buffer(aligned(offset), 0);
+        std::memcpy(&buffer[0], magic, sizeof(magic));
+        put(buffer, 8, version);
+        put(buffer, 12, byteOrderMark);
+        put(buffer, 16, uint64_t(buffer.size()));
+        put(buffer, 24, uint64_t(handles.size()));
+        put(buffer, 32, uint64_t(values.size()));
+
+        for (Size i=0; i<handles.size(); ++i) {
+            const std::vector<Date>& dates =
+                manager.fixingDates(handles[i]);
+            const std::vector<Real>& fixings =
+                manager.fixingValues(handles[i]);
+            Size entry = headerSize + i*historyEntrySize;
+            put(buffer, entry, uint64_t(historyNameOffsets[i]));
+            put(buffer, entry+8, uint64_t(names[i].size()));
+            put(buffer, entry+16, uint64_t(dates.size()));
+            put(buffer, entry+24, uint64_t(datesOffsets[i]));
+            put(buffer, entry+32, uint64_t(valuesOffsets[i]));
+            for (Size k=0; k<dates.size(); ++k) {
+                put(buffer, datesOffsets[i] + k*sizeof(int32_t),
+                    int32_t(dates[k].serialNumber()));
+                put(buffer, valuesOffsets[i] + k*sizeof(double),
+                    double(fixings[k]));
+            }
+            std::copy(names[i].begin(), names[i].end(),
+                      buffer.begin() + historyNameOffsets[i]);
+        }
+
+        for (Size i=0; i<values.size(); ++i) {
+            Size entry = headerSize + handles.size()*historyEntrySize
+                + i*quoteEntrySize;
+            put(buffer, entry, uint64_t(quoteNameOffsets[i]));
+            put(buffer, entry+8, uint64_t(values[i].first.size()));
+            put(buffer, entry+16, values[i].second);
+            std::copy(values[i].first.begin(), values[i].first.end(),
+                      buffer.begin() + quoteNameOffsets[i]);
+        }
+
+        std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+        QL_REQUIRE(out, "unable to open " << path << " for writing");
+        out.write(&buffer[0], buffer.size());
+        out.close();
+        QL_REQUIRE(out, "error writing " << path);
+    }
+
+}
@@ -0,0 +1,100 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file marketdatafile.hpp
+    \brief binary, memory-mapped store of fixings and quote values
+*/
+
+#ifndef quantlib_market_data_file_hpp
+#define quantlib_market_data_file_hpp
+
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/date.hpp>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! binary, memory-mapped store of fixings and quote values
+    /*! The file holds the fixing histories of a set of indexes and a
+        snapshot of named quote values in a fixed binary layout: a
+        header, a directory of histories and quotes, and the date
+        serial numbers (32-bit integers) and values (doubles) of each
+        history in contiguous, 8-byte aligned blocks.  Data are
+        written in the byte order of the host; files written on a
+        host with a different byte order are rejected.
+
+        The file is mapped read-only into memory, so that processes
+        on the same host share its pages; loading a history copies
+        its arrays into the IndexManager without any parsing.
+    */
+    class MarketDataFile {
+      public:
+        //! maps the given file into memory and validates its layout
+        explicit MarketDataFile(const std::string& path);
+
+        //! \name Fixing histories
+        //@{
+        Size histories() const;
+        //! upper-case name of the i-th index, as in IndexManager
+        std::string historyName(Size i) const;
+        Size historySize(Size i) const;
+        //! stores the i-th history in the IndexManager
+        void loadHistory(Size i) const;
+        //! stores all histories in the IndexManager
+        void loadHistories() const;
+        //@}
+
+        //! \name Quotes
+        //@{
+        Size quotes() const;
+        std::string quoteName(Size i) const;
+        Real quoteValue(Size i) const;
+        //! builds a SimpleQuote for each stored value
+        std::map<std::string, ext::shared_ptr<SimpleQuote> >
+        simpleQuotes() const;
+        //! sets the values of the given quotes from the stored ones
+        /*! Quotes whose names are not in the file are left
+            untouched; the number of updated quotes is returned.
+        */
+        Size updateQuotes(
+             const std::map<std::string, ext::shared_ptr<SimpleQuote> >&)
+                                                                    const;
+        //@}
+
+        //! writes the given histories and quote values to a file
+        /*! The histories are read from the IndexManager; quotes
+            without a valid value are skipped.
+        */
+        static void write(
+            const std::string& path,
+            const std::vector<std::string>& indexNames,
+            const std::map<std::string, ext::shared_ptr<Quote> >& quotes);
+      private:
+        struct Mapping;
+        const char* address(Size offset, Size size) const;
+        const char* historyEntry(Size i) const;
+        const char* quoteEntry(Size i) const;
+        ext::shared_ptr<Mapping> mapping_;
+        const char* data_;
+        Size size_, histories_, quotes_;
+    };
+
+}
+
+
+#endif
@@ -1057,6 +1057,77 @@ void AndreasenHugeVolatilityInterplTest::testFlatVolCalibration() {
 }
 
 
+void AndreasenHugeVolatilityInterplTest::testAnalyticJacobian() {
+    BOOST_TEST_MESSAGE(
+        "Testing Andreasen-Huge calibration with analytic Jacobian...");
+
+    SavedSettings backup;
+
+    const CalibrationData data = AndreasenHugeExampleData();
+    const Date today = data.rTS->referenceDate();
+    Settings::instance().evaluationDate() = today;
+
+    const std::pair<AndreasenHugeVolatilityInterpl::InterpolationType,
+                    AndreasenHugeVolatilityInterpl::CalibrationType>
+        types[] = {
+            std::make_pair(AndreasenHugeVolatilityInterpl::CubicSpline,
+                           AndreasenHugeVolatilityInterpl::CallPut),
+            std::make_pair(AndreasenHugeVolatilityInterpl::Linear,
+                           AndreasenHugeVolatilityInterpl::Call),
+            std::make_pair(AndreasenHugeVolatilityInterpl::PiecewiseConstant,
+                           AndreasenHugeVolatilityInterpl::Put)
+        };
+
+    for (Size i=0; i < LENGTH(types); ++i) {
+        const AndreasenHugeVolatilityInterpl analytic(
+            data.calibrationSet, data.spot, data.rTS, data.qTS,
+            types[i].first, types[i].second);
+
+        const AndreasenHugeVolatilityInterpl finiteDifferences(
+            data.calibrationSet, data.spot, data.rTS, data.qTS,
+            types[i].first, types[i].second, 500,
+            Null<Real>(), Null<Real>(),
+            ext::make_shared<LevenbergMarquardt>());
+
+        const Real analyticError = analytic.calibrationError().get<2>();
+        const Real fdError = finiteDifferences.calibrationError().get<2>();
+
+        if (analyticError > 1.01*fdError + 1e-8)
+            BOOST_ERROR("analytic Jacobian gives worse calibration"
+                        << "\n    interpolation type : " << types[i].first
+                        << "\n    calibration type   : " << types[i].second
+                        << "\n    analytic Jacobian  : " << analyticError
+                        << "\n    finite differences : " << fdError);
+
+        for (Size j=0; j < data.calibrationSet.size(); j+=5) {
+            const ext::shared_ptr<VanillaOption> option =
+                data.calibrationSet[j].first;
+            const Real strike = ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                option->payoff())->strike();
+            const Time t = data.rTS->timeFromReference(
+                option->exercise()->lastDate());
+
+            const Real expected =
+                finiteDifferences.optionPrice(t, strike, Option::Call);
+            const Real calculated =
+                analytic.optionPrice(t, strike, Option::Call);
+
+            const Real tol = 1e-5*data.spot->value();
+            if (std::fabs(calculated - expected) > tol)
+                BOOST_ERROR("failed to reproduce option price with "
+                            "analytic Jacobian"
+                            << "\n    interpolation type : " << types[i].first
+                            << "\n    calibration type   : " << types[i].second
+                            << "\n    time               : " << t
+                            << "\n    strike             : " << strike
+                            << "\n    expected           : " << expected
+                            << "\n    calculated         : " << calculated
+                            << "\n    tolerance          : " << tol);
+        }
+    }
+}
+
+
 test_suite* AndreasenHugeVolatilityInterplTest::suite(SpeedLevel speed) {
     test_suite* suite =
         BOOST_TEST_SUITE("Andreasen-Huge volatility interpolation tests");
@@ -1073,6 +1144,8 @@ test_suite* AndreasenHugeVolatilityInterplTest::suite(SpeedLevel speed) {
         &AndreasenHugeVolatilityInterplTest::testMovingReferenceDate));
     suite->add(QUANTLIB_TEST_CASE(
         &AndreasenHugeVolatilityInterplTest::testFlatVolCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AndreasenHugeVolatilityInterplTest::testAnalyticJacobian));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -41,6 +41,7 @@ class AndreasenHugeVolatilityInterplTest {
     static void testDifferentOptimizers();
     static void testMovingReferenceDate();
     static void testFlatVolCalibration();
+    static void testAnalyticJacobian();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel speed);
 };
@@ -685,6 +685,107 @@ void AsianOptionTest::testMCDiscreteArithmeticAveragePrice() {
 }
 
 
+void AsianOptionTest::testMCDiscreteArithmeticAveragePriceGreeks() {
+
+    BOOST_TEST_MESSAGE(
+           "Testing Monte Carlo greeks of discrete arithmetic average-price "
+           "Asians against finite differences...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(90.0));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.06));
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.025));
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.13));
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(
+                                                  flatRate(today, qRate, dc)),
+                                  Handle<YieldTermStructure>(
+                                                  flatRate(today, rRate, dc)),
+                                  Handle<BlackVolTermStructure>(
+                                                  flatVol(today, vol, dc))));
+
+    Average::Type averageType = Average::Arithmetic;
+    Real runningSum = 0.0;
+    Size pastFixings = 0;
+
+    Size fixings = 12;
+    std::vector<Date> fixingDates(fixings);
+    for (Size i=0; i<fixings; i++)
+        fixingDates[i] = today + Integer((i+1)*30);
+
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(fixingDates.back()));
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+                                     new PlainVanillaPayoff(Option::Put, 87.0));
+
+    DiscreteAveragingAsianOption option(averageType, runningSum,
+                                        pastFixings, fixingDates,
+                                        payoff, exercise);
+
+    MonteCarloGreeks::Method methods[] = { MonteCarloGreeks::Pathwise,
+                                           MonteCarloGreeks::LikelihoodRatio };
+    Real tolerances[] = { 1.0e-2, 5.0e-2 };
+
+    for (Size k=0; k<LENGTH(methods); k++) {
+        // the same random numbers are used for all valuations, so that
+        // finite differences are not swamped by the simulation noise
+        ext::shared_ptr<PricingEngine> engine =
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(50000)
+            .withAntitheticVariate()
+            .withSeed(42)
+            .withGreeks(methods[k]);
+        option.setPricingEngine(engine);
+
+        std::map<std::string,Real> calculated, expected;
+        calculated["delta"] = option.delta();
+        calculated["vega"]  = option.vega();
+        calculated["rho"]   = option.rho();
+
+        Real u = spot->value(), du = u*1.0e-2;
+        spot->setValue(u+du);
+        Real valuePlus = option.NPV();
+        spot->setValue(u-du);
+        Real valueMinus = option.NPV();
+        spot->setValue(u);
+        expected["delta"] = (valuePlus - valueMinus)/(2.0*du);
+
+        Volatility v = vol->value(), dv = 1.0e-3;
+        vol->setValue(v+dv);
+        valuePlus = option.NPV();
+        vol->setValue(v-dv);
+        valueMinus = option.NPV();
+        vol->setValue(v);
+        expected["vega"] = (valuePlus - valueMinus)/(2.0*dv);
+
+        Rate r = rRate->value(), dr = 1.0e-4;
+        rRate->setValue(r+dr);
+        valuePlus = option.NPV();
+        rRate->setValue(r-dr);
+        valueMinus = option.NPV();
+        rRate->setValue(r);
+        expected["rho"] = (valuePlus - valueMinus)/(2.0*dr);
+
+        std::map<std::string,Real>::const_iterator it;
+        for (it = calculated.begin(); it != calculated.end(); ++it) {
+            std::string greek = it->first;
+            Real tolerance = tolerances[k]*std::fabs(expected[greek]);
+            if (std::fabs(it->second - expected[greek]) > tolerance) {
+                REPORT_FAILURE(greek, averageType, runningSum, pastFixings,
+                               fixingDates, payoff, exercise, spot->value(),
+                               qRate->value(), rRate->value(), today,
+                               vol->value(), expected[greek], it->second,
+                               tolerance);
+            }
+        }
+    }
+}
+
+
 void AsianOptionTest::testMCDiscreteArithmeticAverageStrike() {
 
     BOOST_TEST_MESSAGE(
@@ -1452,6 +1553,8 @@ test_suite* AsianOptionTest::suite() {
         &AsianOptionTest::testMCDiscreteGeometricAveragePrice));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testMCDiscreteArithmeticAveragePrice));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMCDiscreteArithmeticAveragePriceGreeks));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testMCDiscreteArithmeticAverageStrike));
     suite->add(QUANTLIB_TEST_CASE(
@@ -1083,6 +1083,171 @@ void BasketOptionTest::test2DPDEGreeks() {
     }
 }
 
+void BasketOptionTest::testMcGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing greeks of Monte Carlo "
+                       "basket engine against finite differences...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual360();
+    const Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<SimpleQuote> rRate(
+        ext::make_shared<SimpleQuote>(0.05));
+    const Handle<YieldTermStructure> rTS(flatRate(today, rRate, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+
+    const Real s[] = { 100.0, 90.0 };
+    const Volatility v[] = { 0.25, 0.3 };
+    std::vector<ext::shared_ptr<SimpleQuote> > spots, vols;
+    std::vector<ext::shared_ptr<StochasticProcess1D> > procs;
+    for (Size j=0; j<LENGTH(s); ++j) {
+        spots.push_back(ext::make_shared<SimpleQuote>(s[j]));
+        vols.push_back(ext::make_shared<SimpleQuote>(v[j]));
+        procs.push_back(ext::make_shared<BlackScholesMertonProcess>(
+                              Handle<Quote>(spots[j]), qTS, rTS,
+                              Handle<BlackVolTermStructure>(
+                                               flatVol(today, vols[j], dc))));
+    }
+
+    Matrix correlation(2, 2, 1.0);
+    correlation[0][1] = correlation[1][0] = 0.5;
+    const ext::shared_ptr<StochasticProcessArray> process(
+        ext::make_shared<StochasticProcessArray>(procs, correlation));
+
+    const ext::shared_ptr<Exercise> exercise(
+        ext::make_shared<EuropeanExercise>(today + 360));
+    const ext::shared_ptr<PlainVanillaPayoff> vanilla(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 95.0));
+
+    const ext::shared_ptr<BasketPayoff> payoffs[] = {
+        ext::make_shared<AverageBasketPayoff>(vanilla, 2),
+        ext::make_shared<MaxBasketPayoff>(vanilla)
+    };
+    const MonteCarloGreeks::Method methods[] = {
+        MonteCarloGreeks::Pathwise,
+        MonteCarloGreeks::LikelihoodRatio
+    };
+    // likelihood-ratio estimators have a larger variance, which
+    // increases with the number of steps
+    const Size steps[] = { 4, 1 };
+    const Real tolerances[] = { 1.0e-2, 3.0e-2 };
+    // finite-difference gammas of kinked payoffs are noisy as well
+    const Real gammaTolerances[] = { 1.0e-1, 1.5e-1 };
+
+    for (Size i=0; i<LENGTH(payoffs); ++i) {
+        for (Size k=0; k<LENGTH(methods); ++k) {
+            BasketOption option(payoffs[i], exercise);
+
+            // the same random numbers are used for all valuations, so
+            // that finite differences are not swamped by the
+            // simulation noise
+            option.setPricingEngine(
+                MakeMCEuropeanBasketEngine<PseudoRandom>(process)
+                .withSteps(steps[k])
+                .withSamples(20000)
+                .withAntitheticVariate()
+                .withSeed(42)
+                .withGreeks(methods[k]));
+
+            const Real npv = option.NPV();
+            const Real rho = option.rho();
+            const std::vector<Real> deltas =
+                option.result<std::vector<Real> >("deltas");
+            const std::vector<Real> gammas =
+                option.result<std::vector<Real> >("gammas");
+            const std::vector<Real> vegas =
+                option.result<std::vector<Real> >("vegas");
+
+            const Real tol = tolerances[k];
+            const Real gammaTol = gammaTolerances[k];
+
+            for (Size j=0; j<LENGTH(s); ++j) {
+                const Real du = 1.0e-2*s[j];
+                spots[j]->setValue(s[j] + du);
+                Real npvUp = option.NPV();
+                spots[j]->setValue(s[j] - du);
+                Real npvDown = option.NPV();
+                spots[j]->setValue(s[j]);
+                const Real expectedDelta = (npvUp - npvDown)/(2*du);
+                const Real expectedGamma =
+                    (npvUp + npvDown - 2*npv)/(du*du);
+
+                if (std::fabs(deltas[j] - expectedDelta)
+                                            > tol*expectedDelta) {
+                    BOOST_ERROR("failed to reproduce delta of asset " << j
+                                << "\n    payoff:     #" << i
+                                << "\n    method:     " << methods[k]
+                                << std::fixed << std::setprecision(8)
+                                << "\n    calculated: " << deltas[j]
+                                << "\n    expected:   " << expectedDelta);
+                }
+
+                if (std::fabs(gammas[j] - expectedGamma)
+                                            > gammaTol*expectedGamma) {
+                    BOOST_ERROR("failed to reproduce gamma of asset " << j
+                                << "\n    payoff:     #" << i
+                                << "\n    method:     " << methods[k]
+                                << std::fixed << std::setprecision(8)
+                                << "\n    calculated: " << gammas[j]
+                                << "\n    expected:   " << expectedGamma);
+                }
+
+                const Volatility dv = 1.0e-3;
+                vols[j]->setValue(v[j] + dv);
+                npvUp = option.NPV();
+                vols[j]->setValue(v[j] - dv);
+                npvDown = option.NPV();
+                vols[j]->setValue(v[j]);
+                const Real expectedVega = (npvUp - npvDown)/(2*dv);
+
+                if (std::fabs(vegas[j] - expectedVega)
+                                            > tol*expectedVega) {
+                    BOOST_ERROR("failed to reproduce vega of asset " << j
+                                << "\n    payoff:     #" << i
+                                << "\n    method:     " << methods[k]
+                                << std::fixed << std::setprecision(8)
+                                << "\n    calculated: " << vegas[j]
+                                << "\n    expected:   " << expectedVega);
+                }
+            }
+
+            const Rate r = rRate->value(), dr = 1.0e-4;
+            rRate->setValue(r + dr);
+            const Real npvUp = option.NPV();
+            rRate->setValue(r - dr);
+            const Real npvDown = option.NPV();
+            rRate->setValue(r);
+            const Real expectedRho = (npvUp - npvDown)/(2*dr);
+
+            if (std::fabs(rho - expectedRho) > tol*std::fabs(expectedRho)) {
+                BOOST_ERROR("failed to reproduce rho"
+                            << "\n    payoff:     #" << i
+                            << "\n    method:     " << methods[k]
+                            << std::fixed << std::setprecision(8)
+                            << "\n    calculated: " << rho
+                            << "\n    expected:   " << expectedRho);
+            }
+        }
+    }
+
+    // pathwise greeks need the gradient of the payoff
+    BasketOption digital(
+        ext::make_shared<AverageBasketPayoff>(
+            ext::make_shared<CashOrNothingPayoff>(Option::Call, 95.0, 1.0),
+            2),
+        exercise);
+    digital.setPricingEngine(
+        MakeMCEuropeanBasketEngine<PseudoRandom>(process)
+        .withSteps(4)
+        .withSamples(1000)
+        .withSeed(42)
+        .withGreeks(MonteCarloGreeks::Pathwise));
+    BOOST_CHECK_THROW(digital.NPV(), Error);
+}
+
 test_suite* BasketOptionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Basket option tests");
 
@@ -1093,6 +1258,7 @@ test_suite* BasketOptionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(
         &BasketOptionTest::testLocalVolatilitySpreadOption));
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::test2DPDEGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testMcGreeks));
 
     if (speed <= Fast) {
         #define N_TEST_CASES 5
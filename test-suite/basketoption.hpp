@@ -36,6 +36,7 @@ class BasketOptionTest {
     static void testOddSamples();
     static void testLocalVolatilitySpreadOption();
     static void test2DPDEGreeks();
+    static void testMcGreeks();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
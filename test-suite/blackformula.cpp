@@ -277,6 +277,231 @@ void BlackFormulaTest::testImpliedVolAdaptiveSuccessiveOverRelaxation() {
     }
 }
 
+void BlackFormulaTest::testBatchFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing Black and Bachelier formulas "
+                       "on arrays of options...");
+
+    const Real displacement = 0.01;
+    const Real forward = 0.03;
+    // the last strikes test zero displaced strike and zero stdDev
+    Real strikes[] = { 0.005, 0.02, 0.03, 0.04, 0.08, -0.01, 0.025 };
+    Real stdDevs[] = { 0.2, 0.5, 0.05, 1.2, 0.3, 0.4, 0.0 };
+    Real bpStdDevs[] = { 0.002, 0.01, 0.0005, 0.02, 0.004, 0.008, 0.0 };
+    const Size n = LENGTH(strikes);
+
+    std::vector<Real> k(strikes, strikes+n), f(n, forward), d(n);
+    std::vector<Real> s(stdDevs, stdDevs+n), bs(bpStdDevs, bpStdDevs+n);
+    for (Size i=0; i<n; ++i)
+        d[i] = std::exp(-0.02*(i+1));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    for (Size j=0; j<LENGTH(types); ++j) {
+        Option::Type type = types[j];
+        std::vector<Real> v, values, deltas, vegas, gammas;
+        std::vector<Real> bv, bValues, bDeltas, bVegas, bGammas;
+        blackFormula(type, k, f, s, d, v, displacement);
+        blackFormulaWithGreeks(type, k, f, s, d,
+                               values, deltas, vegas, gammas, displacement);
+        bachelierBlackFormula(type, k, f, bs, d, bv);
+        bachelierBlackFormulaWithGreeks(type, k, f, bs, d,
+                                        bValues, bDeltas, bVegas, bGammas);
+
+        for (Size i=0; i<n; ++i) {
+            Real value = blackFormula(type, k[i], f[i], s[i], d[i],
+                                      displacement);
+            Real bValue = bachelierBlackFormula(type, k[i], f[i],
+                                                bs[i], d[i]);
+            if (v[i] != value || values[i] != value
+                || bv[i] != bValue || bValues[i] != bValue)
+                BOOST_ERROR("failed to reproduce scalar formulas"
+                            << "\n    type:             " << type
+                            << "\n    strike:           " << k[i]
+                            << std::setprecision(16)
+                            << "\n    Black:            " << value
+                            << "\n    batch:            " << v[i]
+                            << "\n    batch w/ greeks:  " << values[i]
+                            << "\n    Bachelier:        " << bValue
+                            << "\n    batch:            " << bv[i]
+                            << "\n    batch w/ greeks:  " << bValues[i]);
+
+            // sensitivities against finite differences and
+            // against the scalar vega
+            Real h = 1.0e-5, tolerance = 1.0e-6;
+            Real expectedDelta, expectedGamma, expectedVega;
+            if (s[i] > 0.0) {
+                Real up = blackFormula(type, k[i], f[i]+h, s[i], d[i],
+                                       displacement);
+                Real down = blackFormula(type, k[i], f[i]-h, s[i], d[i],
+                                         displacement);
+                expectedDelta = (up-down)/(2.0*h);
+                expectedGamma = (up-2.0*value+down)/(h*h);
+            } else {
+                expectedDelta = (f[i]-k[i])*type > 0.0 ? type*d[i] : 0.0;
+                expectedGamma = 0.0;
+            }
+            expectedVega = blackFormulaStdDevDerivative(k[i], f[i], s[i],
+                                                        d[i], displacement);
+            if (std::fabs(deltas[i]-expectedDelta) > tolerance
+                || std::fabs(gammas[i]-expectedGamma) > 1.0e-3*std::max(
+                                             std::fabs(expectedGamma), 1.0)
+                || std::fabs(vegas[i]-expectedVega) > 1.0e-12)
+                BOOST_ERROR("wrong Black sensitivities"
+                            << "\n    type:       " << type
+                            << "\n    strike:     " << k[i]
+                            << "\n    stdDev:     " << s[i]
+                            << "\n    delta:      " << deltas[i]
+                            << " (expected " << expectedDelta << ")"
+                            << "\n    gamma:      " << gammas[i]
+                            << " (expected " << expectedGamma << ")"
+                            << "\n    vega:       " << vegas[i]
+                            << " (expected " << expectedVega << ")");
+
+            if (bs[i] > 0.0) {
+                h = 1.0e-6;
+                Real up = bachelierBlackFormula(type, k[i], f[i]+h,
+                                                bs[i], d[i]);
+                Real down = bachelierBlackFormula(type, k[i], f[i]-h,
+                                                  bs[i], d[i]);
+                expectedDelta = (up-down)/(2.0*h);
+                expectedGamma = (up-2.0*bValue+down)/(h*h);
+            } else {
+                expectedDelta = (f[i]-k[i])*type > 0.0 ? type*d[i] : 0.0;
+                expectedGamma = 0.0;
+            }
+            expectedVega = bachelierBlackFormulaStdDevDerivative(
+                                                 k[i], f[i], bs[i], d[i]);
+            if (std::fabs(bDeltas[i]-expectedDelta) > tolerance
+                || std::fabs(bGammas[i]-expectedGamma) > 1.0e-3*std::max(
+                                             std::fabs(expectedGamma), 1.0)
+                || std::fabs(bVegas[i]-expectedVega) > 1.0e-12)
+                BOOST_ERROR("wrong Bachelier sensitivities"
+                            << "\n    type:       " << type
+                            << "\n    strike:     " << k[i]
+                            << "\n    stdDev:     " << bs[i]
+                            << "\n    delta:      " << bDeltas[i]
+                            << " (expected " << expectedDelta << ")"
+                            << "\n    gamma:      " << bGammas[i]
+                            << " (expected " << expectedGamma << ")"
+                            << "\n    vega:       " << bVegas[i]
+                            << " (expected " << expectedVega << ")");
+        }
+    }
+}
+
+
+void BlackFormulaTest::testBatchImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing Black and Bachelier implied standard "
+                       "deviations on arrays of options...");
+
+    const Real displacement = 0.01;
+    const Real forward = 0.03;
+    Real strikes[] = { 0.001, 0.01, 0.02, 0.029, 0.03, 0.031,
+                       0.04, 0.06, 0.1 };
+    Real stdDevs[] = { 0.02, 0.1, 0.3, 0.7, 1.5 };
+    Real bpStdDevs[] = { 0.0005, 0.002, 0.01, 0.05 };
+    const Size n = LENGTH(strikes);
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    for (Size j=0; j<LENGTH(types); ++j) {
+        Option::Type type = types[j];
+
+        for (Size m=0; m<LENGTH(stdDevs); ++m) {
+            std::vector<Real> k(strikes, strikes+n), f(n, forward), d(n);
+            std::vector<Real> s(n, stdDevs[m]), prices, implied;
+            for (Size i=0; i<n; ++i)
+                d[i] = std::exp(-0.02*(i+1));
+            blackFormula(type, k, f, s, d, prices, displacement);
+            blackFormulaImpliedStdDev(type, k, f, prices, d, implied,
+                                      displacement);
+
+            for (Size i=0; i<n; ++i) {
+                // skip options whose time value is lost in round-off, as
+                // well as tiny prices for which the reference values are
+                // not accurate to machine precision
+                Real intrinsic = std::max(type*(f[i]-k[i]), 0.0)*d[i];
+                if (prices[i]-intrinsic <= 1.0e-3*prices[i]
+                    || prices[i] < 1.0e-7*forward)
+                    continue;
+                Real scalar = blackFormulaImpliedStdDevHouseholder(
+                               type, k[i], f[i], prices[i], d[i],
+                               displacement);
+                if (implied[i] != scalar
+                    || std::fabs(implied[i]-s[i]) > 1.0e-10*s[i])
+                    BOOST_ERROR("failed to recover Black standard deviation"
+                                << "\n    type:       " << type
+                                << "\n    strike:     " << k[i]
+                                << std::setprecision(16)
+                                << "\n    price:      " << prices[i]
+                                << "\n    stdDev:     " << s[i]
+                                << "\n    implied:    " << implied[i]
+                                << "\n    scalar:     " << scalar);
+            }
+        }
+
+        for (Size m=0; m<LENGTH(bpStdDevs); ++m) {
+            std::vector<Real> k(strikes, strikes+n), f(n, forward), d(n);
+            std::vector<Real> s(n, bpStdDevs[m]), prices, implied;
+            for (Size i=0; i<n; ++i)
+                d[i] = std::exp(-0.02*(i+1));
+            bachelierBlackFormula(type, k, f, s, d, prices);
+            bachelierBlackFormulaImpliedStdDev(type, k, f, prices, d,
+                                               implied);
+
+            for (Size i=0; i<n; ++i) {
+                Real intrinsic = std::max(type*(f[i]-k[i]), 0.0)*d[i];
+                if (prices[i]-intrinsic <= 1.0e-3*prices[i]
+                    || prices[i] < 1.0e-7*forward)
+                    continue;
+                Real scalar = bachelierBlackFormulaImpliedStdDev(
+                                      type, k[i], f[i], prices[i], d[i]);
+                if (implied[i] != scalar
+                    || std::fabs(implied[i]-s[i]) > 1.0e-10*s[i])
+                    BOOST_ERROR("failed to recover Bachelier "
+                                "standard deviation"
+                                << "\n    type:       " << type
+                                << "\n    strike:     " << k[i]
+                                << std::setprecision(16)
+                                << "\n    price:      " << prices[i]
+                                << "\n    stdDev:     " << s[i]
+                                << "\n    implied:    " << implied[i]
+                                << "\n    scalar:     " << scalar);
+            }
+        }
+    }
+
+    // prices at the intrinsic value give a null standard deviation,
+    // prices outside the no-arbitrage bounds are rejected
+    if (blackFormulaImpliedStdDevHouseholder(Option::Call, 0.02, 0.03,
+                                             0.01) != 0.0)
+        BOOST_ERROR("null Black standard deviation not recovered");
+    if (bachelierBlackFormulaImpliedStdDev(Option::Put, 0.04, 0.03,
+                                           0.01) != 0.0)
+        BOOST_ERROR("null Bachelier standard deviation not recovered");
+    BOOST_CHECK_THROW(blackFormulaImpliedStdDevHouseholder(
+                                   Option::Call, 0.02, 0.03, 0.005),
+                      Error);
+    BOOST_CHECK_THROW(blackFormulaImpliedStdDevHouseholder(
+                                   Option::Call, 0.02, 0.03, 0.03),
+                      Error);
+
+    // subnormal prices of options far out of the money cannot be
+    // inverted; the failure to converge must be reported instead of
+    // returning the last iterate
+    BOOST_CHECK_THROW(blackFormulaImpliedStdDevHouseholder(
+                                   Option::Call, 1.0e5, 1.0, 1.0e-322),
+                      Error);
+    BOOST_CHECK_THROW(bachelierBlackFormulaImpliedStdDev(
+                                   Option::Call, 200.0, 1.0, 1.0e-320),
+                      Error);
+    std::vector<Real> k(1, 1.0e5), f(1, 1.0), p(1, 1.0e-322), d(1, 1.0);
+    std::vector<Real> implied;
+    BOOST_CHECK_THROW(blackFormulaImpliedStdDev(Option::Call, k, f, p, d,
+                                                implied),
+                      Error);
+}
+
 
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
@@ -291,6 +516,10 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testRadoicicStefanicaLowerBound));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testImpliedVolAdaptiveSuccessiveOverRelaxation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchFormulas));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchImpliedStdDev));
 
     return suite;
 }
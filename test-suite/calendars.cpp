@@ -36,6 +36,7 @@
 #include <ql/time/calendars/southkorea.hpp>
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/time/calendars/bespokecalendar.hpp>
+#include <ql/time/calendars/bitmapcalendar.hpp>
 #include <ql/errors.hpp>
 #include <fstream>
 
@@ -2055,6 +2056,137 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+void CalendarTest::testBitmapCalendars() {
+
+    BOOST_TEST_MESSAGE("Testing calendars with precomputed business days...");
+
+    const Calendar calendars[] = {
+        TARGET(),
+        UnitedKingdom(UnitedKingdom::Exchange),
+        UnitedStates(UnitedStates::NYSE),
+        JointCalendar(TARGET(), UnitedStates(UnitedStates::Settlement),
+                      Japan(), JoinHolidays)
+    };
+
+    const Integer steps[] = { -25, -3, -1, 1, 2, 5, 40 };
+
+    for (Size i=0; i<LENGTH(calendars); ++i) {
+        const Calendar& c = calendars[i];
+        const BitmapCalendar b(c);
+
+        if (b != c)
+            BOOST_ERROR("bitmap calendar " << b.name()
+                        << " does not compare equal to " << c.name());
+
+        const Date firstDate(1, January, 1990), endDate(1, January, 2060);
+
+        for (Date d = firstDate; d < endDate; d++) {
+            if (b.isBusinessDay(d) != c.isBusinessDay(d))
+                BOOST_FAIL("isBusinessDay mismatch for " << c.name()
+                           << " at " << d);
+        }
+
+        for (Date d = firstDate; d < endDate; d += 17) {
+            for (Size j=0; j<LENGTH(steps); ++j) {
+                const Date expected = c.advance(d, steps[j], Days);
+                const Date calculated = b.advance(d, steps[j], Days);
+                if (expected != calculated)
+                    BOOST_FAIL("advance mismatch for " << c.name()
+                               << "\n    date:       " << d
+                               << "\n    days:       " << steps[j]
+                               << "\n    expected:   " << expected
+                               << "\n    calculated: " << calculated);
+            }
+
+            const Date to = d + Integer(d.serialNumber() % 731) - 300;
+            for (Size j=0; j<4; ++j) {
+                const bool includeFirst = (j & 1) != 0;
+                const bool includeLast = (j & 2) != 0;
+                const Date::serial_type expected =
+                    c.businessDaysBetween(d, to, includeFirst, includeLast);
+                const Date::serial_type calculated =
+                    b.businessDaysBetween(d, to, includeFirst, includeLast);
+                if (expected != calculated)
+                    BOOST_FAIL("businessDaysBetween mismatch for "
+                               << c.name()
+                               << "\n    from:       " << d
+                               << "\n    to:         " << to
+                               << "\n    first:      " << includeFirst
+                               << "\n    last:       " << includeLast
+                               << "\n    expected:   " << expected
+                               << "\n    calculated: " << calculated);
+            }
+        }
+    }
+
+    // holidays added to the bitmap calendar are honored
+    BitmapCalendar b = BitmapCalendar(TARGET());
+    const Date holiday(12, June, 2019);
+    b.addHoliday(holiday);
+
+    if (b.isBusinessDay(holiday))
+        BOOST_ERROR(holiday << " (marked as holiday) not detected");
+    if (b.advance(Date(11, June, 2019), 1, Days) != Date(13, June, 2019))
+        BOOST_ERROR("added holiday " << holiday << " not skipped");
+    if (b.businessDaysBetween(Date(10, June, 2019),
+                              Date(14, June, 2019)) != 3)
+        BOOST_ERROR("added holiday " << holiday << " counted");
+}
+
+void CalendarTest::testBitmapCalendarConstruction() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing construction of calendars with precomputed business days...");
+
+    // the tables are built by the first construction...
+    const Calendar c = UnitedStates(UnitedStates::NYSE);
+    const BitmapCalendar first(c);
+
+    // ...and shared by the later ones, which must not rebuild them
+    const Date from(1, January, 2000), to(1, January, 2030);
+    const Date::serial_type expectedDays = c.businessDaysBetween(from, to);
+    for (Size i=0; i<10; ++i) {
+        const BitmapCalendar b(c);
+        if (!b.sharesTablesWith(first))
+            BOOST_ERROR("tables of " << c.name() << " not shared");
+        const Date::serial_type calculated = b.businessDaysBetween(from, to);
+        if (calculated != expectedDays)
+            BOOST_ERROR("business days between " << from << " and " << to
+                        << " for " << c.name() << ":"
+                        << "\n    expected:   " << expectedDays
+                        << "\n    calculated: " << calculated);
+    }
+
+    // tables are not shared after the weekends or holidays changed
+    BespokeCalendar bespoke("bespoke");
+    bespoke.addWeekend(Sunday);
+    const BitmapCalendar sundays(bespoke);
+    bespoke.addWeekend(Saturday);
+    const BitmapCalendar weekends(bespoke);
+    bespoke.addHoliday(Date(12, June, 2019));
+    const BitmapCalendar holidays(bespoke);
+
+    if (sundays.sharesTablesWith(weekends)
+        || holidays.sharesTablesWith(BitmapCalendar(bespoke)))
+        BOOST_ERROR("tables shared after the calendar changed");
+
+    const Date start(10, June, 2019), end(17, June, 2019);
+    const BitmapCalendar calendars[] = { sundays, weekends, holidays };
+    const Date::serial_type expected[] = { 6, 5, 4 };
+    const std::string cases[] = { "Sunday weekends",
+                                  "Saturday and Sunday weekends",
+                                  "an added holiday" };
+    for (Size i=0; i<LENGTH(calendars); ++i) {
+        const Date::serial_type calculated =
+            calendars[i].businessDaysBetween(start, end);
+        if (calculated != expected[i])
+            BOOST_ERROR("business days between " << start << " and " << end
+                        << " with " << cases[i] << ":"
+                        << "\n    expected:   " << expected[i]
+                        << "\n    calculated: " << calculated);
+    }
+}
+
 void CalendarTest::testIntradayAddHolidays() {
 #ifdef QL_HIGH_RESOLUTION_DATE
     BOOST_TEST_MESSAGE("Testing addHolidays with enable-intraday...");
@@ -2179,6 +2311,9 @@ test_suite* CalendarTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testModifiedCalendars));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testJointCalendars));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBespokeCalendars));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBitmapCalendars));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &CalendarTest::testBitmapCalendarConstruction));
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
@@ -57,6 +57,8 @@ class CalendarTest {
     static void testModifiedCalendars();
     static void testJointCalendars();
     static void testBespokeCalendars();
+    static void testBitmapCalendars();
+    static void testBitmapCalendarConstruction();
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
@@ -30,6 +30,7 @@
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <ql/time/daycounters/business252.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/calendars/canada.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -634,6 +635,64 @@ void DayCounterTest::testBusiness252() {
     }
 }
 
+void DayCounterTest::testBusiness252Consistency() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing business/252 day counter against its calendar...");
+
+    const Calendar calendar = Brazil();
+    const DayCounter dayCounter = Business252(calendar);
+
+    for (Date d1 = Date(3, January, 1995); d1 < Date(1, January, 2040);
+         d1 += 37) {
+        for (Integer days = -400; days <= 4000; days += 231) {
+            const Date d2 = d1 + days;
+            const Date::serial_type expected =
+                calendar.businessDaysBetween(d1, d2);
+            const Date::serial_type calculated = dayCounter.dayCount(d1, d2);
+            if (calculated != expected)
+                BOOST_FAIL("from " << d1 << " to " << d2 << ":\n"
+                           << "    calculated: " << calculated << "\n"
+                           << "    expected:   " << expected);
+        }
+    }
+
+    // holidays added before building the day counter are honored
+    BespokeCalendar bespoke("business252");
+    bespoke.addWeekend(Saturday);
+    bespoke.addWeekend(Sunday);
+    bespoke.addHoliday(Date(12, June, 2019));
+
+    const Date::serial_type calculated =
+        Business252(bespoke).dayCount(Date(10, June, 2019),
+                                      Date(17, June, 2019));
+    if (calculated != 4)
+        BOOST_ERROR("added holiday not honored:\n"
+                    << "    calculated: " << calculated << "\n"
+                    << "    expected:   " << 4);
+
+    // calendars with the same name don't share their business days
+    BespokeCalendar fiveDays("bespoke");
+    fiveDays.addWeekend(Saturday);
+    fiveDays.addWeekend(Sunday);
+    BespokeCalendar fourDays("bespoke");
+    fourDays.addWeekend(Friday);
+    fourDays.addWeekend(Saturday);
+    fourDays.addWeekend(Sunday);
+
+    const DayCounter first = Business252(fiveDays);
+    const DayCounter second = Business252(fourDays);
+    const Date::serial_type firstCalculated =
+        first.dayCount(Date(10, June, 2019), Date(17, June, 2019));
+    const Date::serial_type secondCalculated =
+        second.dayCount(Date(10, June, 2019), Date(17, June, 2019));
+    if (firstCalculated != 5 || secondCalculated != 4)
+        BOOST_ERROR("business days shared by same-name calendars:\n"
+                    << "    calculated: " << firstCalculated
+                    << ", " << secondCalculated << "\n"
+                    << "    expected:   5, 4");
+}
+
 void DayCounterTest::testThirty360_BondBasis() {
 
     BOOST_TEST_MESSAGE("Testing thirty/360 day counter (Bond Basis)...");
@@ -840,6 +899,8 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testSimple));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testOne));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252));
+    suite->add(
+        QUANTLIB_TEST_CASE(&DayCounterTest::testBusiness252Consistency));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_BondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_EurobondBasis));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testActual365_Canadian));
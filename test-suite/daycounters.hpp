@@ -34,6 +34,7 @@ class DayCounterTest {
     static void testSimple();
     static void testOne();
     static void testBusiness252();
+    static void testBusiness252Consistency();
     static void testThirty360_BondBasis();
     static void testThirty360_EurobondBasis();
     static void testActual365_Canadian();
@@ -1247,6 +1247,91 @@ void EuropeanOptionTest::testMcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo greeks of European options "
+                       "against analytic results...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.02));
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(
+                                                  flatRate(today, qRate, dc)),
+                                      Handle<YieldTermStructure>(
+                                                  flatRate(today, rRate, dc)),
+                                      Handle<BlackVolTermStructure>(
+                                                  flatVol(today, vol, dc))));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 90.0, 110.0 };
+    MonteCarloGreeks::Method methods[] = { MonteCarloGreeks::Pathwise,
+                                           MonteCarloGreeks::LikelihoodRatio };
+
+    ext::shared_ptr<Exercise> exercise(
+                           new EuropeanExercise(today + Period(1, Years)));
+    ext::shared_ptr<PricingEngine> analytic(
+                                     new AnalyticEuropeanEngine(process));
+
+    std::map<std::string,Real> tolerance;
+    tolerance["delta"] = 0.02;
+    tolerance["gamma"] = 0.05;
+    tolerance["vega"]  = 0.03;
+    tolerance["rho"]   = 0.03;
+
+    for (Size i=0; i<LENGTH(types); i++) {
+      for (Size j=0; j<LENGTH(strikes); j++) {
+        ext::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[i], strikes[j]));
+        VanillaOption option(payoff, exercise);
+
+        option.setPricingEngine(analytic);
+        std::map<std::string,Real> expected;
+        expected["delta"] = option.delta();
+        expected["gamma"] = option.gamma();
+        expected["vega"]  = option.vega();
+        expected["rho"]   = option.rho();
+
+        for (Size k=0; k<LENGTH(methods); k++) {
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(4)
+                .withAntitheticVariate()
+                .withSamples(100000)
+                .withSeed(42)
+                .withGreeks(methods[k]));
+
+            std::map<std::string,Real> calculated;
+            calculated["delta"] = option.delta();
+            calculated["gamma"] = option.gamma();
+            calculated["vega"]  = option.vega();
+            calculated["rho"]   = option.rho();
+
+            std::map<std::string,Real>::const_iterator it;
+            for (it = calculated.begin(); it != calculated.end(); ++it) {
+                std::string greek = it->first;
+                Real error = relativeError(expected[greek], it->second,
+                                           std::fabs(expected[greek]));
+                if (error > tolerance[greek]) {
+                    REPORT_FAILURE(greek, payoff, exercise, spot->value(),
+                                   qRate->value(), rRate->value(), today,
+                                   vol->value(), expected[greek],
+                                   it->second, error, tolerance[greek]);
+                }
+            }
+        }
+      }
+    }
+}
+
 void EuropeanOptionTest::testQmcEngines() {
 
     BOOST_TEST_MESSAGE("Testing Quasi Monte Carlo European engines "
@@ -1773,6 +1858,7 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcGreeks));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
 
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
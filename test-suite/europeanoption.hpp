@@ -44,6 +44,7 @@ class EuropeanOptionTest {
     static void testIntegralEngines();
     static void testQmcEngines();
     static void testMcEngines();
+    static void testMcGreeks();
     static void testFFTEngines();
     static void testLocalVolatility();
     static void testAnalyticEngineDiscountCurve();
@@ -41,6 +41,8 @@
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrbicgstab.hpp>
+#include <ql/math/matrixutilities/csrgmres.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
@@ -84,11 +86,118 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
 #include <numeric>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    // solves the whole system with a single sweep through the mesher,
+    // i.e., coupling the lines through the outward boundary bands
+    class FullSweepTripleBandLinearOp : public TripleBandLinearOp {
+      public:
+        explicit FullSweepTripleBandLinearOp(const TripleBandLinearOp& m)
+        : TripleBandLinearOp(m) {}
+
+        void setLower(Size i, Real value) { lower_[i] = value; }
+
+        Disposable<Array> solveFullSweep(const Array& r,
+                                         Real a, Real b) const {
+            const Size n = r.size();
+            Array retVal(n), tmp(n);
+
+            Size rim1 = reverseIndex_[0];
+            Real bet = 1.0/(a*diag_[rim1]+b);
+            retVal[rim1] = r[rim1]*bet;
+
+            for (Size j=1; j<n; ++j) {
+                const Size ri = reverseIndex_[j];
+                tmp[j] = a*upper_[rim1]*bet;
+                bet = 1.0/(b+a*(diag_[ri]-tmp[j]*lower_[ri]));
+                retVal[ri] = (r[ri]-a*lower_[ri]*retVal[rim1])*bet;
+                rim1 = ri;
+            }
+            for (Size j=n-1; j>0; --j)
+                retVal[reverseIndex_[j-1]] -=
+                    tmp[j]*retVal[reverseIndex_[j]];
+
+            return retVal;
+        }
+    };
+
+}
+
+void FdmLinearOpTest::testTripleBandSolveSplittingLines() {
+
+    BOOST_TEST_MESSAGE("Testing line-wise triple-band solution "
+                       "against a full sweep...");
+
+    Size dims[] = {30, 40, 8};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.5, 1.5));
+
+    ext::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    const Size n = layout->size();
+    Array u(n), drift(n), vol(n), rate(n);
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter; ++iter) {
+        const Size i = iter.index();
+        const Real x = mesher->location(iter, 0);
+        const Real y = mesher->location(iter, 1);
+        const Real z = mesher->location(iter, 2);
+
+        u[i] = std::sin(3.0*x)*std::cos(y) + z;
+        drift[i] = 0.3 - 0.5*x*y;
+        vol[i] = 0.1 + 0.2*y*y*z;
+        rate[i] = -0.05*z;
+    }
+
+    const Real factors[][2] = { {1.0, 0.0}, {-0.4, 1.0}, {0.02, 1.0} };
+
+    for (Size d=0; d < dim.size(); ++d) {
+        TripleBandLinearOp op(
+            SecondDerivativeOp(d, mesher).mult(vol)
+                .add(FirstDerivativeOp(d, mesher).mult(drift))
+                .add(rate));
+        const FullSweepTripleBandLinearOp fullSweep(op);
+
+        for (Size k=0; k < LENGTH(factors); ++k) {
+            const Real a = factors[k][0], b = factors[k][1];
+            const Array r = (a == 1.0 && b == 0.0) ? op.apply(u) : u;
+
+            const Array calculated = op.solve_splitting(r, a, b);
+            const Array expected = fullSweep.solveFullSweep(r, a, b);
+
+            for (Size i=0; i < n; ++i) {
+                if (std::fabs(calculated[i] - expected[i])
+                        > 1e-12*std::max(1.0, std::fabs(expected[i]))) {
+                    BOOST_FAIL("line-wise and full-sweep solutions differ"
+                               << "\n direction     : " << d
+                               << "\n a, b          : " << a << ", " << b
+                               << std::setprecision(16)
+                               << "\n expected      : " << expected[i]
+                               << "\n calculated    : " << calculated[i]);
+                }
+            }
+        }
+
+        // a non-zero entry coupling two lines must be rejected
+        FullSweepTripleBandLinearOp coupled(op);
+        coupled.setLower(0, 0.1);
+        BOOST_CHECK_THROW(coupled.solve_splitting(u, -0.4, 1.0), Error);
+    }
+}
+
 namespace {
 
     class FdmHestonExpressCondition : public StepCondition<Array> {
@@ -1322,6 +1431,199 @@ void FdmLinearOpTest::testBiCGstab() {
 #endif
 }
 
+void FdmLinearOpTest::testCSRBiCGstab() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE(
+        "Testing bi-conjugated gradient stabilized algorithm "
+        "with CSR matrices...");
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+    const boost::numeric::ublas::compressed_matrix<Real> a
+        = createTestMatrix(n, m, theta);
+
+    const CSRMatrix csr(a);
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Array expected = axpy(a, b);
+    const Array calculated = csr.apply(b);
+    for (Size i=0; i < b.size(); ++i) {
+        if (std::fabs(expected[i] - calculated[i]) > 1e-14) {
+            BOOST_FAIL("Error in CSR matrix vector product" <<
+                    "\n row:        " << i <<
+                    "\n expected:   " << expected[i] <<
+                    "\n calculated: " << calculated[i]);
+        }
+    }
+
+    const Real tol = 1e-10;
+
+    const ext::shared_ptr<CSRPreconditioner> preconditioners[] = {
+        ext::make_shared<CSRILU0Preconditioner>(csr),
+        ext::make_shared<CSRJacobiPreconditioner>(csr)
+    };
+    const std::string names[] = { "ILU(0)", "Jacobi" };
+
+    for (Size i=0; i < LENGTH(preconditioners); ++i) {
+        const CSRBiCGstab biCGstab(csr, n*m, tol, preconditioners[i]);
+        const Array x = biCGstab.solve(b).x;
+
+        Array y(b.size(), 0.0);
+        biCGstab.solveInPlace(b, y);
+
+        const Real error = std::sqrt(DotProduct(b-axpy(a, x),
+                                     b-axpy(a, x))/DotProduct(b,b));
+        const Real inPlaceError = std::sqrt(DotProduct(b-axpy(a, y),
+                                     b-axpy(a, y))/DotProduct(b,b));
+
+        if (error > tol || inPlaceError > tol) {
+            BOOST_FAIL("Error calculating the inverse using BiCGstab" <<
+                    "\n preconditioner: " << names[i] <<
+                    "\n tolerance:      " << tol <<
+                    "\n error:          " << error <<
+                    "\n in place error: " << inPlaceError);
+        }
+
+        // converging on the last allowed iteration is not a failure
+        std::fill(y.begin(), y.end(), 0.0);
+        const Size iterations = biCGstab.solveInPlace(b, y);
+        std::fill(y.begin(), y.end(), 0.0);
+        try {
+            CSRBiCGstab(csr, iterations, tol, preconditioners[i])
+                .solveInPlace(b, y);
+        } catch (Error& e) {
+            BOOST_FAIL("BiCGstab failed with the exact number "
+                       "of iterations" <<
+                       "\n preconditioner: " << names[i] <<
+                       "\n iterations:     " << iterations <<
+                       "\n error:          " << e.what());
+        }
+    }
+#endif
+}
+
+void FdmLinearOpTest::testCSRGMRES() {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    BOOST_TEST_MESSAGE("Testing GMRES algorithm with CSR matrices...");
+
+    const Size n=41, m=21;
+    const Real theta = 1.0;
+    const boost::numeric::ublas::compressed_matrix<Real> a
+        = createTestMatrix(n, m, theta);
+
+    const CSRMatrix csr(a);
+
+    Array b(n*m);
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    const ext::shared_ptr<CSRPreconditioner> preconditioners[] = {
+        ext::make_shared<CSRILU0Preconditioner>(csr),
+        ext::make_shared<CSRJacobiPreconditioner>(csr)
+    };
+    const std::string names[] = { "ILU(0)", "Jacobi" };
+
+    for (Size i=0; i < LENGTH(preconditioners); ++i) {
+        const CSRGMRES gmres(csr, n*m, tol, preconditioners[i]);
+        const GMRESResult result = gmres.solve(b, b);
+        const Array x = result.x;
+
+        Array y(b);
+        const Size iterations = gmres.solveInPlace(b, y);
+
+        const Real error = std::sqrt(DotProduct(b-axpy(a, x),
+                                     b-axpy(a, x))/DotProduct(b,b));
+        const Real inPlaceError = std::sqrt(DotProduct(b-axpy(a, y),
+                                     b-axpy(a, y))/DotProduct(b,b));
+
+        if (error > tol || inPlaceError > tol) {
+            BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                    "\n preconditioner: " << names[i] <<
+                    "\n tolerance:      " << tol <<
+                    "\n error:          " << error <<
+                    "\n in place error: " << inPlaceError);
+        }
+
+        if (std::fabs(error - result.errors.back()) > 1e3*QL_EPSILON
+            || result.errors.size() != iterations+1) {
+            BOOST_FAIL("Calculation of the error in GMRES went wrong" <<
+                    "\n preconditioner: " << names[i] <<
+                    "\n calculated:     " << result.errors.back() <<
+                    "\n error:          " << error <<
+                    "\n iterations:     " << iterations <<
+                    "\n errors:         " << result.errors.size());
+        }
+
+        // converging on the last allowed iteration is not a failure
+        y = b;
+        try {
+            CSRGMRES(csr, iterations, tol, preconditioners[i])
+                .solveInPlace(b, y);
+        } catch (Error& e) {
+            BOOST_FAIL("GMRES failed with the exact number "
+                       "of iterations" <<
+                       "\n preconditioner: " << names[i] <<
+                       "\n iterations:     " << iterations <<
+                       "\n error:          " << e.what());
+        }
+    }
+#endif
+}
+
+void FdmLinearOpTest::testToCSRMatrix() {
+    BOOST_TEST_MESSAGE("Testing conversion of operators to CSR matrices...");
+
+    const Size dims[] = { 7, 11 };
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+    const ext::shared_ptr<FdmLinearOpLayout> index(
+                                                new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>(-1.0, 1.0));
+    boundaries.push_back(std::pair<Real, Real>( 0.0, 2.0));
+
+    const ext::shared_ptr<FdmMesher> mesher(
+                            new UniformGridMesher(index, boundaries));
+
+    Array r(index->size());
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < r.size(); ++i) {
+        r[i] = rng.next().value;
+    }
+
+    const SecondDerivativeOp tripleBand(1, mesher);
+    const SecondOrderMixedDerivativeOp ninePoint(0, 1, mesher);
+
+    const Array expected[] = { tripleBand.apply(r), ninePoint.apply(r) };
+    const CSRMatrix csr[] = {
+        tripleBand.toCSRMatrix(), ninePoint.toCSRMatrix()
+    };
+    const std::string names[] = { "triple-band", "nine-point" };
+
+    for (Size k=0; k < LENGTH(csr); ++k) {
+        const Array calculated = csr[k].apply(r);
+        for (Size i=0; i < r.size(); ++i) {
+            if (std::fabs(expected[k][i] - calculated[i])
+                    > 1e-12*std::max(1.0, std::fabs(expected[k][i]))) {
+                BOOST_FAIL("Error in CSR matrix of " << names[k]
+                           << " operator" <<
+                           "\n row:        " << i <<
+                           "\n expected:   " << expected[k][i] <<
+                           "\n calculated: " << calculated[i]);
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testGMRES() {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     BOOST_TEST_MESSAGE("Testing GMRES algorithm...");
@@ -1769,11 +2071,16 @@ test_suite* FdmLinearOpTest::suite() {
         &FdmLinearOpTest::testSecondOrderMixedDerivativesMapApply));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testTripleBandMapSolve));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testTripleBandSolveSplittingLines));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCSRBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCSRGMRES));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testToCSRMatrix));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
@@ -36,11 +36,15 @@ public:
     static void testDerivativeWeightsOnNonUniformGrids();
     static void testSecondOrderMixedDerivativesMapApply();
     static void testTripleBandMapSolve();
+    static void testTripleBandSolveSplittingLines();
     static void testFdmHestonBarrier();
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
     static void testBiCGstab();
+    static void testCSRBiCGstab();
+    static void testCSRGMRES();
+    static void testToCSRMatrix();
     static void testGMRES();
     static void testCrankNicolsonWithDamping();
     static void testSpareMatrixReference();
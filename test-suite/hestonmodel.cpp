@@ -25,13 +25,16 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/carrmadanfftengine.hpp>
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -2671,6 +2674,475 @@ void HestonModelTest::testPiecewiseTimeDependentChFAsymtotic() {
     }
 }
 
+void HestonModelTest::testSliceValues() {
+    BOOST_TEST_MESSAGE("Testing Heston slice pricing with shared "
+                       "characteristic function evaluations...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.04, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> model =
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS,
+                s0, 0.05, 1.5, 0.08, 0.6, -0.7));
+
+    typedef AnalyticHestonEngine::Integration Integration;
+
+    std::vector<ext::shared_ptr<AnalyticHestonEngine> > analyticEngines;
+    analyticEngines.push_back(
+        ext::make_shared<AnalyticHestonEngine>(model, 144));
+    analyticEngines.push_back(ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::BranchCorrection,
+        Integration::gaussLaguerre(144)));
+    analyticEngines.push_back(ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::Gatheral,
+        Integration::gaussLegendre(256)));
+    analyticEngines.push_back(ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::AndersenPiterbarg,
+        Integration::gaussLaguerre(), 1e-8));
+    analyticEngines.push_back(ext::make_shared<AnalyticHestonEngine>(
+        model, AnalyticHestonEngine::AndersenPiterbarg,
+        Integration::gaussChebyshev(256), 1e-8));
+    analyticEngines.push_back(
+        ext::make_shared<AnalyticHestonEngine>(model, 1e-8, 10000));
+
+    const ext::shared_ptr<COSHestonEngine> cosEngine =
+        ext::make_shared<COSHestonEngine>(model);
+
+    const Real strikes[] = { 50, 75, 90, 100, 110, 125, 150, 200 };
+    const Size nStrikes = LENGTH(strikes);
+    const Period maturities[] = { 1*Weeks, 3*Months, 1*Years, 5*Years };
+
+    std::vector<Real> k;
+    std::vector<Option::Type> types;
+    for (Size i=0; i < nStrikes; ++i) {
+        k.push_back(strikes[i]);
+        types.push_back(Option::Call);
+        k.push_back(strikes[i]);
+        types.push_back(Option::Put);
+    }
+
+    const Real tol = 1e-10;
+    for (Size m=0; m < LENGTH(maturities); ++m) {
+        const Date maturityDate = settlementDate + maturities[m];
+        const ext::shared_ptr<Exercise> exercise =
+            ext::make_shared<EuropeanExercise>(maturityDate);
+
+        for (Size e=0; e <= analyticEngines.size(); ++e) {
+            const ext::shared_ptr<PricingEngine> engine =
+                (e < analyticEngines.size())
+                ? ext::shared_ptr<PricingEngine>(analyticEngines[e])
+                : ext::shared_ptr<PricingEngine>(cosEngine);
+
+            const std::vector<Real> values = (e < analyticEngines.size())
+                ? analyticEngines[e]->sliceValues(maturityDate, k, types)
+                : cosEngine->sliceValues(maturityDate, k, types);
+
+            for (Size i=0; i < k.size(); ++i) {
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(types[i], k[i]),
+                    exercise);
+                option.setPricingEngine(engine);
+
+                const Real expected = option.NPV();
+                const Real diff = std::fabs(values[i] - expected);
+                if (diff > tol) {
+                    BOOST_ERROR("failed to reproduce single option value "
+                                "with slice pricing"
+                                << "\n    engine:     " << e
+                                << "\n    maturity:   " << maturityDate
+                                << "\n    type:       " << types[i]
+                                << "\n    strike:     " << k[i]
+                                << std::setprecision(12)
+                                << "\n    expected:   " << expected
+                                << "\n    calculated: " << values[i]
+                                << "\n    difference: " << diff
+                                << "\n    tolerance:  " << tol);
+                }
+            }
+        }
+    }
+}
+
+void HestonModelTest::testAnalyticGradientCalibration() {
+    BOOST_TEST_MESSAGE("Testing Heston and Bates calibration "
+                       "with analytic gradients...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<Quote> vol(ext::make_shared<SimpleQuote>(0.25));
+
+    const ext::shared_ptr<HestonProcess> process =
+        ext::make_shared<HestonProcess>(riskFreeTS, dividendTS, s0,
+                                        0.06, 1.2, 0.08, 0.5, -0.6);
+
+    const ext::shared_ptr<HestonModel> hestonModel =
+        ext::make_shared<HestonModel>(process);
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(
+            ext::make_shared<BatesProcess>(riskFreeTS, dividendTS, s0,
+                                           0.06, 1.2, 0.08, 0.5, -0.6,
+                                           0.4, -0.1, 0.15));
+
+    const ext::shared_ptr<CalibratedModel> models[] = {
+        hestonModel, batesModel };
+    const ext::shared_ptr<PricingEngine> engines[] = {
+        ext::make_shared<AnalyticHestonEngine>(hestonModel, 128),
+        ext::make_shared<BatesEngine>(batesModel, 128) };
+
+    const BlackCalibrationHelper::CalibrationErrorType errorTypes[] = {
+        BlackCalibrationHelper::RelativePriceError,
+        BlackCalibrationHelper::PriceError,
+        BlackCalibrationHelper::ImpliedVolError };
+
+    const Period maturities[] = { 3*Months, 1*Years, 3*Years };
+    const Real strikes[] = { 70.0, 100.0, 130.0 };
+
+    const Real h = 1e-6;
+    const Real tol = 1e-5;
+
+    for (Size m=0; m < LENGTH(models); ++m) {
+        const Array params = models[m]->params();
+
+        for (Size e=0; e < LENGTH(errorTypes); ++e) {
+            for (Size i=0; i < LENGTH(maturities); ++i) {
+                for (Size k=0; k < LENGTH(strikes); ++k) {
+                    HestonModelHelper helper(
+                        maturities[i], NullCalendar(), s0->value(),
+                        strikes[k], vol, riskFreeTS, dividendTS,
+                        errorTypes[e]);
+                    helper.setPricingEngine(engines[m]);
+
+                    models[m]->setParams(params);
+                    Array gradient;
+                    if (!helper.calibrationErrorGradient(gradient)) {
+                        BOOST_FAIL("analytic gradient not available");
+                    }
+
+                    for (Size l=0; l < params.size(); ++l) {
+                        Array p(params);
+                        p[l] += h;
+                        models[m]->setParams(p);
+                        const Real up = helper.calibrationError();
+                        p[l] -= 2*h;
+                        models[m]->setParams(p);
+                        const Real down = helper.calibrationError();
+                        const Real expected = (up - down)/(2*h);
+
+                        if (std::fabs(gradient[l] - expected)
+                                > tol*std::max(1.0, std::fabs(expected))) {
+                            BOOST_ERROR("failed to reproduce "
+                                        "finite-difference derivative"
+                                        << "\n    model:      " << m
+                                        << "\n    error type: " << e
+                                        << "\n    maturity:   "
+                                        << maturities[i]
+                                        << "\n    strike:     " << strikes[k]
+                                        << "\n    parameter:  " << l
+                                        << std::setprecision(10)
+                                        << "\n    expected:   " << expected
+                                        << "\n    calculated: "
+                                        << gradient[l]);
+                        }
+                    }
+                }
+            }
+        }
+        models[m]->setParams(params);
+    }
+
+    // DAX calibration using the analytic Jacobian
+    Settings::instance().evaluationDate() = Date(5, July, 2002);
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<BlackCalibrationHelper> > options
+                                                    = marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<AnalyticHestonEngine>(model, 64);
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < options.size(); ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    const Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_ERROR("failed to reproduce calibration error "
+                    "with analytic Jacobian"
+                    << "\n    calculated: " << sse
+                    << "\n    expected:   " << expected);
+    }
+}
+
+void HestonModelTest::testParallelCalibration() {
+    BOOST_TEST_MESSAGE("Testing parallel Heston calibration "
+                       "against serial calibration...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(5, July, 2002);
+
+    Array params[2];
+    Array errors[2];
+    for (Size n=0; n < 2; ++n) {
+        CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+        const std::vector<ext::shared_ptr<BlackCalibrationHelper> > options
+                                                        = marketData.options;
+
+        const ext::shared_ptr<HestonModel> model(
+            ext::make_shared<HestonModel>(
+                ext::make_shared<HestonProcess>(
+                    marketData.riskFreeTS, marketData.dividendYield,
+                    marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+        const bool parallel = (n == 1);
+        model->enableParallelCalibration(parallel);
+
+        // the parallel calibration needs an engine for each helper
+        const ext::shared_ptr<PricingEngine> engine =
+            ext::make_shared<AnalyticHestonEngine>(model, 64);
+        for (Size i = 0; i < options.size(); ++i)
+            options[i]->setPricingEngine(
+                parallel ? ext::make_shared<AnalyticHestonEngine>(model, 64)
+                         : engine);
+
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        model->calibrate(options, om,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+        params[n] = model->params();
+        errors[n] = model->problemValues();
+    }
+
+    const Real tol = 1e-12;
+    for (Size i = 0; i < params[0].size(); ++i) {
+        if (std::fabs(params[0][i] - params[1][i]) > tol) {
+            BOOST_ERROR("failed to reproduce serial calibration"
+                        << "\n    parameter:  " << i
+                        << std::setprecision(16)
+                        << "\n    serial:     " << params[0][i]
+                        << "\n    parallel:   " << params[1][i]);
+        }
+    }
+    for (Size i = 0; i < errors[0].size(); ++i) {
+        if (std::fabs(errors[0][i] - errors[1][i]) > tol) {
+            BOOST_ERROR("failed to reproduce serial calibration errors"
+                        << "\n    helper:     " << i
+                        << std::setprecision(16)
+                        << "\n    serial:     " << errors[0][i]
+                        << "\n    parallel:   " << errors[1][i]);
+        }
+    }
+}
+
+void HestonModelTest::testParallelFdCalibration() {
+    BOOST_TEST_MESSAGE("Testing parallel Heston calibration "
+                       "with finite-difference engines...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(5, July, 2002);
+
+    Array params[2];
+    for (Size n=0; n < 2; ++n) {
+        CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+        const ext::shared_ptr<HestonModel> model(
+            ext::make_shared<HestonModel>(
+                ext::make_shared<HestonProcess>(
+                    marketData.riskFreeTS, marketData.dividendYield,
+                    marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+        const bool parallel = (n == 1);
+        model->enableParallelCalibration(parallel);
+
+        // the engines register with the shared Heston process at
+        // each calculation, so that the helpers must be evaluated
+        // serially even though each of them has its own engine
+        std::vector<ext::shared_ptr<CalibrationHelperBase> > options;
+        for (Size s = 1; s < 13; s += 2) {
+            const ext::shared_ptr<BlackCalibrationHelper> helper =
+                marketData.options[s*8 + 3];
+            helper->setPricingEngine(
+                ext::make_shared<FdHestonVanillaEngine>(model, 20, 40, 15));
+            options.push_back(helper);
+        }
+
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        model->calibrate(options, om,
+                         EndCriteria(20, 10, 1.0e-8, 1.0e-8, 1.0e-8));
+
+        params[n] = model->params();
+    }
+
+    const Real tol = 1e-12;
+    for (Size i = 0; i < params[0].size(); ++i) {
+        if (std::fabs(params[0][i] - params[1][i]) > tol) {
+            BOOST_ERROR("failed to reproduce serial calibration"
+                        << "\n    parameter:  " << i
+                        << std::setprecision(16)
+                        << "\n    serial:     " << params[0][i]
+                        << "\n    parallel:   " << params[1][i]);
+        }
+    }
+}
+
+void HestonModelTest::testCarrMadanFFTEngine() {
+    BOOST_TEST_MESSAGE("Testing Carr-Madan FFT engine "
+                       "for Heston and Bates models...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const ext::shared_ptr<SimpleQuote> spot =
+        ext::make_shared<SimpleQuote>(100.0);
+    const Handle<Quote> s0(spot);
+
+    const ext::shared_ptr<HestonModel> hestonModel =
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(riskFreeTS, dividendTS, s0,
+                                            0.06, 1.2, 0.08, 0.5, -0.6));
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(
+            ext::make_shared<BatesProcess>(riskFreeTS, dividendTS, s0,
+                                           0.06, 1.2, 0.08, 0.5, -0.6,
+                                           0.4, -0.1, 0.15));
+
+    const ext::shared_ptr<ForwardCharacteristicFunction> chFs[] = {
+        ext::make_shared<HestonCharacteristicFunction>(hestonModel),
+        ext::make_shared<BatesCharacteristicFunction>(batesModel) };
+    const ext::shared_ptr<PricingEngine> analyticEngines[] = {
+        ext::make_shared<AnalyticHestonEngine>(hestonModel, 1e-12, 100000),
+        ext::make_shared<BatesEngine>(batesModel, 1e-12, 100000) };
+
+    const Period maturities[] = { 3*Months, 1*Years, 5*Years };
+    const Real strikes[] = { 60.0, 80.0, 95.0, 100.0, 110.0, 130.0, 160.0 };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    const Real tol = 1e-6;
+
+    for (Size m=0; m < LENGTH(chFs); ++m) {
+        // plain FFT and fractional FFT
+        const ext::shared_ptr<CarrMadanFFTEngine> engines[] = {
+            ext::make_shared<CarrMadanFFTEngine>(chFs[m], s0,
+                                                 riskFreeTS, dividendTS),
+            ext::make_shared<CarrMadanFFTEngine>(chFs[m], s0,
+                                                 riskFreeTS, dividendTS,
+                                                 10, 0.005, 0.25) };
+
+        for (Size e=0; e < LENGTH(engines); ++e) {
+            for (Size i=0; i < LENGTH(maturities); ++i) {
+                const ext::shared_ptr<Exercise> exercise =
+                    ext::make_shared<EuropeanExercise>(
+                                          settlementDate + maturities[i]);
+                for (Size k=0; k < LENGTH(strikes); ++k) {
+                    for (Size l=0; l < LENGTH(types); ++l) {
+                        VanillaOption option(
+                            ext::make_shared<PlainVanillaPayoff>(
+                                                  types[l], strikes[k]),
+                            exercise);
+
+                        option.setPricingEngine(analyticEngines[m]);
+                        const Real expected = option.NPV();
+
+                        option.setPricingEngine(engines[e]);
+                        const Real calculated = option.NPV();
+
+                        if (std::fabs(calculated - expected) > tol) {
+                            BOOST_ERROR("failed to reproduce analytic "
+                                        "option value"
+                                        << "\n    model:      " << m
+                                        << "\n    engine:     " << e
+                                        << "\n    maturity:   "
+                                        << maturities[i]
+                                        << "\n    strike:     "
+                                        << strikes[k]
+                                        << "\n    type:       " << types[l]
+                                        << std::setprecision(10)
+                                        << "\n    expected:   " << expected
+                                        << "\n    calculated: "
+                                        << calculated);
+                        }
+                    }
+                }
+            }
+
+            // one transform per expiry, shared among all strikes
+            if (engines[e]->numberOfTransforms() != LENGTH(maturities)) {
+                BOOST_ERROR("unexpected number of transforms"
+                            << "\n    model:      " << m
+                            << "\n    engine:     " << e
+                            << "\n    calculated: "
+                            << engines[e]->numberOfTransforms()
+                            << "\n    expected:   " << LENGTH(maturities));
+            }
+        }
+    }
+
+    // cached values are discarded when the model changes
+    const ext::shared_ptr<CarrMadanFFTEngine> engine =
+        ext::make_shared<CarrMadanFFTEngine>(chFs[0], s0,
+                                             riskFreeTS, dividendTS);
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 105.0),
+        ext::make_shared<EuropeanExercise>(settlementDate + 1*Years));
+    option.setPricingEngine(engine);
+    option.NPV();
+
+    Array params = hestonModel->params();
+    params[4] = 0.04;
+    hestonModel->setParams(params);
+    const Real calculated = option.NPV();
+
+    option.setPricingEngine(analyticEngines[0]);
+    const Real expected = option.NPV();
+
+    if (std::fabs(calculated - expected) > tol
+        || engine->numberOfTransforms() != 2) {
+        BOOST_ERROR("failed to update option value after model change"
+                    << std::setprecision(10)
+                    << "\n    expected:   " << expected
+                    << "\n    calculated: " << calculated
+                    << "\n    transforms: "
+                    << engine->numberOfTransforms());
+    }
+}
+
 test_suite* HestonModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -2709,6 +3181,15 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
         &HestonModelTest::testPiecewiseTimeDependentComparison));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonModelTest::testPiecewiseTimeDependentChFAsymtotic));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testSliceValues));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testAnalyticGradientCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testParallelCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testParallelFdCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonModelTest::testCarrMadanFFTEngine));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
@@ -54,6 +54,11 @@ class HestonModelTest {
     static void testPiecewiseTimeDependentChFvsHestonChF();
     static void testPiecewiseTimeDependentComparison();
     static void testPiecewiseTimeDependentChFAsymtotic();
+    static void testSliceValues();
+    static void testAnalyticGradientCalibration();
+    static void testParallelCalibration();
+    static void testParallelFdCalibration();
+    static void testCarrMadanFFTEngine();
 
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
     static boost::unit_test_framework::test_suite* experimental();
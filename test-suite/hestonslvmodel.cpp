@@ -47,6 +47,7 @@
 #include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/gridmodellocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
@@ -2490,6 +2491,294 @@ void HestonSLVModelTest::testMoustacheGraph() {
 }
 
 
+void HestonSLVModelTest::testGriddedLocalVolSurface() {
+    BOOST_TEST_MESSAGE("Testing gridded local volatility surface...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(5, Nov, 2015);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const ext::shared_ptr<SimpleQuote> spotQuote(
+        ext::make_shared<SimpleQuote>(100.0));
+    const Handle<Quote> spot(spotQuote);
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const Period maturities[] = {
+        Period(1, Months), Period(3, Months), Period(6, Months),
+        Period(1, Years), Period(2, Years), Period(3, Years) };
+
+    std::vector<Real> strikes;
+    for (Size i=0; i <= 20; ++i)
+        strikes.push_back(100.0*std::exp(0.2*(Integer(i) - 10)));
+
+    std::vector<Date> dates;
+    for (Size j=0; j < LENGTH(maturities); ++j)
+        dates.push_back(todaysDate + maturities[j]);
+
+    Matrix vols(strikes.size(), dates.size());
+    for (Size i=0; i < strikes.size(); ++i) {
+        const Real x = std::log(strikes[i]/100.0);
+        for (Size j=0; j < dates.size(); ++j)
+            vols[i][j] = 0.25 - 0.05*x + 0.05*x*x
+                + 0.01*dc.yearFraction(todaysDate, dates[j]);
+    }
+
+    const ext::shared_ptr<BlackVarianceSurface> blackSurface(
+        ext::make_shared<BlackVarianceSurface>(
+            todaysDate, TARGET(), dates, strikes, vols, dc));
+    blackSurface->setInterpolation<Bicubic>();
+    blackSurface->enableExtrapolation();
+
+    const Handle<LocalVolTermStructure> localVol(
+        ext::make_shared<LocalVolSurface>(
+            Handle<BlackVolTermStructure>(blackSurface), rTS, qTS, spot));
+
+    std::vector<Time> times;
+    for (Size i=0; i <= 40; ++i)
+        times.push_back(0.05*i);
+
+    const ext::shared_ptr<GriddedLocalVolSurface> griddedLocalVol(
+        ext::make_shared<GriddedLocalVolSurface>(
+            localVol, times, 30.0, 350.0, 201));
+
+    const std::vector<Real>& x = griddedLocalVol->logUnderlyings();
+
+    // grid points are reproduced, the rest is interpolated
+    for (Size i=2; i < times.size(); i+=3) {
+        for (Size j=0; j < x.size(); j+=7) {
+            const Real s = std::exp(x[j]);
+            const Volatility expected = localVol->localVol(times[i], s, true);
+            const Volatility calculated
+                = griddedLocalVol->localVol(times[i], s, true);
+            if (std::fabs(calculated - expected) > 1e-12)
+                BOOST_ERROR("failed to reproduce local volatility "
+                            "at grid point"
+                            << "\n    time       : " << times[i]
+                            << "\n    underlying : " << s
+                            << "\n    expected   : " << expected
+                            << "\n    calculated : " << calculated);
+
+            const Time t = times[i] - 0.025;
+            const Real sMid = std::exp(0.5*(x[j] + x[j+1]));
+            const Volatility lv = localVol->localVol(t, sMid, true);
+            const Volatility glv = griddedLocalVol->localVol(t, sMid, true);
+            if (std::fabs(glv - lv) > 5e-3*lv)
+                BOOST_ERROR("failed to interpolate local volatility"
+                            << "\n    time       : " << t
+                            << "\n    underlying : " << sMid
+                            << "\n    expected   : " << lv
+                            << "\n    calculated : " << glv);
+        }
+    }
+
+    // the batch lookup agrees with the single ones
+    Array underlyings(101);
+    for (Size j=0; j < underlyings.size(); ++j)
+        underlyings[j] = 20.0 + 4.0*j;
+    const Array batch = griddedLocalVol->localVols(0.77, underlyings);
+    for (Size j=0; j < underlyings.size(); ++j) {
+        const Volatility single
+            = griddedLocalVol->localVol(0.77, underlyings[j], true);
+        if (std::fabs(batch[j] - single) > 1e-15)
+            BOOST_ERROR("batch and single lookups differ"
+                        << "\n    underlying : " << underlyings[j]
+                        << "\n    batch      : " << batch[j]
+                        << "\n    single     : " << single);
+    }
+
+    // finite difference prices with the direct and the cached surface
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> bsProcess(
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            spot, qTS, rTS, Handle<BlackVolTermStructure>(blackSurface),
+            localVol));
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> griddedProcess(
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            spot, qTS, rTS, Handle<BlackVolTermStructure>(blackSurface),
+            Handle<LocalVolTermStructure>(griddedLocalVol)));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 90.0),
+        ext::make_shared<EuropeanExercise>(todaysDate + Period(1, Years)));
+
+    // the cached values are discarded when the market moves
+    const Real spotValues[] = { 100.0, 105.0 };
+    for (Size k=0; k < LENGTH(spotValues); ++k) {
+        spotQuote->setValue(spotValues[k]);
+
+        const Real s = std::exp(x[100]);
+        const Volatility expectedLV = localVol->localVol(1.0, s, true);
+        const Volatility calculatedLV
+            = griddedLocalVol->localVol(1.0, s, true);
+        if (std::fabs(calculatedLV - expectedLV) > 1e-12)
+            BOOST_ERROR("gridded local volatility surface "
+                        "was not recalculated"
+                        << "\n    spot       : " << spotValues[k]
+                        << "\n    expected   : " << expectedLV
+                        << "\n    calculated : " << calculatedLV);
+
+        option.setPricingEngine(ext::make_shared<FdBlackScholesVanillaEngine>(
+            bsProcess, 25, 101, 0, FdmSchemeDesc::Douglas(), true));
+        const Real expected = option.NPV();
+
+        option.setPricingEngine(ext::make_shared<FdBlackScholesVanillaEngine>(
+            griddedProcess, 25, 101, 0, FdmSchemeDesc::Douglas(), true));
+        const Real calculated = option.NPV();
+
+        const Real tol = 2e-3;
+        if (std::fabs(calculated - expected) > tol)
+            BOOST_ERROR("failed to reproduce local volatility price "
+                        "with gridded local volatility surface"
+                        << "\n    spot       : " << spotValues[k]
+                        << "\n    expected   : " << expected
+                        << "\n    calculated : " << calculated
+                        << "\n    diff       : "
+                        << std::fabs(calculated - expected)
+                        << "\n    tolerance  : " << tol);
+    }
+}
+
+namespace {
+    void checkLeverageFunction(
+        const std::string& model,
+        const ext::shared_ptr<LocalVolTermStructure>& leverageFct,
+        const ext::shared_ptr<LocalVolTermStructure>& recalibrated,
+        const ext::shared_ptr<HestonModel>& hestonModel,
+        const Handle<Quote>& spot,
+        const Handle<YieldTermStructure>& rTS,
+        const Handle<YieldTermStructure>& qTS,
+        Volatility lv, Real tol) {
+
+        const Date todaysDate = Settings::instance().evaluationDate();
+        const DayCounter dc = leverageFct->dayCounter();
+
+        // the calibration must not depend on the scheduling of the
+        // parallel loops
+        const Time times[] = { 0.1, 0.25, 0.45 };
+        const Real spots[] = { 70, 85, 100, 115, 130 };
+        for (Size i=0; i < LENGTH(times); ++i) {
+            for (Size j=0; j < LENGTH(spots); ++j) {
+                const Real expected =
+                    leverageFct->localVol(times[i], spots[j], true);
+                const Real calculated =
+                    recalibrated->localVol(times[i], spots[j], true);
+                if (expected != calculated)
+                    BOOST_ERROR(model << " leverage function differs "
+                                "after re-calibration"
+                                << std::setprecision(16)
+                                << "\n   time        " << times[i]
+                                << "\n   spot        " << spots[j]
+                                << "\n   first       " << expected
+                                << "\n   second      " << calculated);
+            }
+        }
+
+        // round trip to the local volatility
+        const ext::shared_ptr<PricingEngine> bsEngine(
+            ext::make_shared<AnalyticEuropeanEngine>(
+                ext::make_shared<GeneralizedBlackScholesProcess>(
+                    spot, qTS, rTS,
+                    Handle<BlackVolTermStructure>(flatVol(lv, dc)))));
+
+        const Real strikes[] = { 80, 90, 100, 110, 120 };
+        const Size months[] = { 3, 6 };
+        for (Size i=0; i < LENGTH(months); ++i) {
+            const ext::shared_ptr<Exercise> exercise(
+                ext::make_shared<EuropeanExercise>(
+                    todaysDate + Period(months[i], Months)));
+            const ext::shared_ptr<PricingEngine> fdEngine(
+                ext::make_shared<FdHestonVanillaEngine>(
+                    hestonModel, 51, 201, 51, 0,
+                    FdmSchemeDesc::ModifiedCraigSneyd(), leverageFct));
+
+            for (Size j=0; j < LENGTH(strikes); ++j) {
+                const Real strike = strikes[j];
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(
+                        strike < spot->value() ? Option::Put : Option::Call,
+                        strike),
+                    exercise);
+
+                option.setPricingEngine(bsEngine);
+                const Real expected = option.NPV();
+                const Real vega = option.vega();
+
+                option.setPricingEngine(fdEngine);
+                const Real calculated = option.NPV();
+
+                const Real diff = std::fabs(calculated-expected)/vega;
+                if (diff > tol)
+                    BOOST_ERROR("failed to reproduce local volatility with "
+                                << model << " leverage function"
+                                << "\n   strike         " << strike
+                                << "\n   months         " << months[i]
+                                << "\n   expected NPV   " << expected
+                                << "\n   calculated NPV " << calculated
+                                << std::fixed << std::setprecision(2)
+                                << "\n   diff  (in bp)  " << diff*1e4
+                                << "\n   tolerance      " << tol*1e4);
+            }
+        }
+    }
+}
+
+void HestonSLVModelTest::testLeverageFunctionCalibration() {
+    BOOST_TEST_MESSAGE(
+        "Testing FDM and Monte-Carlo leverage function calibration...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = ActualActual();
+    const Date todaysDate(5, Jan, 2016);
+    const Date maturityDate = todaysDate + Period(6, Months);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const Volatility lv = 0.3;
+    const Handle<LocalVolTermStructure> localVol(
+        ext::make_shared<LocalConstantVol>(todaysDate, lv, dc));
+
+    const ext::shared_ptr<HestonModel> hestonModel(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.09, 1.0, 0.06, 0.4, -0.75)));
+
+    const HestonSLVFokkerPlanckFdmParams params = {
+        51, 201, 200, 50, 2.0, 0, 2,
+        0.1, 1e-4, 10000,
+        1e-5, 1e-5, 0.0000025, 1.0, 0.1, 0.9, 1e-5,
+        FdmHestonGreensFct::Gaussian,
+        FdmSquareRootFwdOp::Log,
+        FdmSchemeDesc::ModifiedCraigSneyd()
+    };
+
+    checkLeverageFunction(
+        "FDM",
+        HestonSLVFDMModel(localVol, Handle<HestonModel>(hestonModel),
+                          maturityDate, params).leverageFunction(),
+        HestonSLVFDMModel(localVol, Handle<HestonModel>(hestonModel),
+                          maturityDate, params).leverageFunction(),
+        hestonModel, spot, rTS, qTS, lv, 0.0005);
+
+    const ext::shared_ptr<BrownianGeneratorFactory> factory(
+        ext::make_shared<MTBrownianGeneratorFactory>(1234ul));
+
+    checkLeverageFunction(
+        "Monte-Carlo",
+        HestonSLVMCModel(localVol, Handle<HestonModel>(hestonModel),
+                         factory, maturityDate, 91, 101, 1 << 14)
+            .leverageFunction(),
+        HestonSLVMCModel(localVol, Handle<HestonModel>(hestonModel),
+                         factory, maturityDate, 91, 101, 1 << 14)
+            .leverageFunction(),
+        hestonModel, spot, rTS, qTS, lv, 0.0025);
+}
+
 test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE(
         "Heston Stochastic Local Volatility tests");
@@ -2512,6 +2801,10 @@ test_suite* HestonSLVModelTest::experimental(SpeedLevel speed) {
         &HestonSLVModelTest::testMonteCarloVsFdmPricing));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testLocalVolsvSLVPropDensity));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testGriddedLocalVolSurface));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testLeverageFunctionCalibration));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
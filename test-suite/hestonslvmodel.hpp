@@ -46,6 +46,8 @@ public:
     static void testMonteCarloCalibration();
     static void testMoustacheGraph();
     static void testForwardSkewSLV();
+    static void testGriddedLocalVolSurface();
+    static void testLeverageFunctionCalibration();
 
     static boost::unit_test_framework::test_suite* experimental(SpeedLevel);
 
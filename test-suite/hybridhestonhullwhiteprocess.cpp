@@ -640,6 +640,39 @@ void HybridHestonHullWhiteProcessTest::testAnalyticHestonHullWhitePricing() {
             }
         }
     }
+
+    // slices and single options at alternating maturities must use
+    // the add-on term of their own maturity
+    const ext::shared_ptr<AnalyticHestonHullWhiteEngine> analyticEngine(
+        new AnalyticHestonHullWhiteEngine(hestonModel, hullWhiteModel, 128));
+    const Date maturities[] = {
+        maturity, today + Period(2, Years), maturity };
+    const std::vector<Real> strikes(strike, strike + LENGTH(strike));
+    const std::vector<Option::Type> callTypes(strikes.size(), Option::Call);
+
+    for (Size k=0; k < LENGTH(maturities); ++k) {
+        const std::vector<Real> slice =
+            analyticEngine->sliceValues(maturities[k], strikes, callTypes);
+
+        for (Size j=0; j < strikes.size(); ++j) {
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(Option::Call, strikes[j]),
+                ext::make_shared<EuropeanExercise>(maturities[k]));
+            option.setPricingEngine(
+                ext::make_shared<AnalyticHestonHullWhiteEngine>(
+                                        hestonModel, hullWhiteModel, 128));
+            const Real expected = option.NPV();
+
+            if (std::fabs(slice[j] - expected) > 1e-10) {
+                BOOST_ERROR("Failed to reproduce hw heston slice prices"
+                        << "\n   maturity:   " << maturities[k]
+                        << "\n   strike:     " << strikes[j]
+                        << std::setprecision(12)
+                        << "\n   calculated: " << slice[j]
+                        << "\n   expected:   " << expected);
+            }
+        }
+    }
 }
 
 void HybridHestonHullWhiteProcessTest::testCallableEquityPricing() {
@@ -25,11 +25,13 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "marketmodel.hpp"
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
 #include <ql/models/marketmodels/callability/lsstrategy.hpp>
 #include <ql/models/marketmodels/callability/nothingexercisevalue.hpp>
+#include <ql/models/marketmodels/callability/parallelupperboundengine.hpp>
 #include <ql/models/marketmodels/callability/parametricexerciseadapter.hpp>
 #include <ql/models/marketmodels/callability/swapbasissystem.hpp>
 #include <ql/models/marketmodels/callability/swapratetrigger.hpp>
@@ -807,6 +809,110 @@ void MarketModelTest::testOneStepForwardsAndOptionlets() {
         }
 }
 
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing parallel accounting engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<Rate> forwardStrikes(todaysForwards.size());
+    std::vector<ext::shared_ptr<Payoff> > optionletPayoffs(todaysForwards.size());
+    std::vector<ext::shared_ptr<StrikedTypePayoff> >
+        displacedPayoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i) {
+        forwardStrikes[i] = todaysForwards[i] + 0.01;
+        optionletPayoffs[i] = ext::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+        displacedPayoffs[i] = ext::shared_ptr<StrikedTypePayoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]+displacement));
+    }
+
+    OneStepForwards forwards(rateTimes, accruals,
+        paymentTimes, forwardStrikes);
+    OneStepOptionlets optionlets(rateTimes, accruals,
+        paymentTimes, optionletPayoffs);
+
+    MultiProductComposite product;
+    product.add(forwards);
+    product.add(optionlets);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, Terminal);
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, todaysForwards.size(),
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // a single engine reproduces the serial simulation
+    {
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        AccountingEngine engine(makeMarketModelEvolver(marketModel,
+                                                       numeraires,
+                                                       generatorFactory,
+                                                       Pc),
+                                product, initialNumeraireValue);
+        SequenceStatisticsInc serial(product.numberOfProducts());
+        engine.multiplePathValues(serial, paths_);
+
+        std::vector<ext::shared_ptr<AccountingEngine> > engines(1,
+            ext::make_shared<AccountingEngine>(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       generatorFactory, Pc),
+                product, initialNumeraireValue));
+        ParallelAccountingEngine<> parallelEngine(engines, 1000);
+        SequenceStatisticsInc parallel(product.numberOfProducts());
+        parallelEngine.multiplePathValues(parallel, paths_);
+
+        std::vector<Real> expected = serial.mean();
+        std::vector<Real> calculated = parallel.mean();
+        for (Size i=0; i<expected.size(); ++i) {
+            if (calculated[i] != expected[i])
+                BOOST_ERROR("failed to reproduce serial simulation"
+                            << "\n    product:    " << i
+                            << std::setprecision(16)
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]);
+        }
+    }
+
+    // several engines with independent generators
+    Size numberOfEngines = 4;
+    std::vector<std::vector<Real> > results;
+    for (Size k=0; k<2; ++k) {
+        std::vector<ext::shared_ptr<AccountingEngine> > engines;
+        for (Size i=0; i<numberOfEngines; ++i) {
+            MTBrownianGeneratorFactory generatorFactory(seed_+i);
+            engines.push_back(ext::make_shared<AccountingEngine>(
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       generatorFactory, Pc),
+                product, initialNumeraireValue));
+        }
+        ParallelAccountingEngine<> parallelEngine(engines);
+        SequenceStatisticsInc stats(product.numberOfProducts());
+        parallelEngine.multiplePathValues(stats, paths_);
+
+        if (stats.samples() != paths_)
+            BOOST_ERROR("wrong number of simulated paths"
+                        << "\n    calculated: " << stats.samples()
+                        << "\n    expected:   " << paths_);
+
+        checkForwardsAndOptionlets(stats, forwardStrikes, displacedPayoffs,
+                                   "parallel accounting engine");
+        results.push_back(stats.mean());
+    }
+
+    for (Size i=0; i<results[0].size(); ++i) {
+        if (results[0][i] != results[1][i])
+            BOOST_ERROR("parallel simulation is not reproducible"
+                        << "\n    product:       " << i
+                        << std::setprecision(16)
+                        << "\n    first run:     " << results[0][i]
+                        << "\n    second run:    " << results[1][i]);
+    }
+}
+
 void MarketModelTest::testOneStepNormalForwardsAndOptionlets() {
 
     BOOST_TEST_MESSAGE("Testing exact repricing of "
@@ -1932,6 +2038,212 @@ void MarketModelTest::testCallableSwapAnderson(
 }
 
 
+namespace {
+
+    ext::shared_ptr<UpperBoundEngine> makeUpperBoundEngine(
+                            const ext::shared_ptr<MarketModel>& marketModel,
+                            const std::vector<Size>& numeraires,
+                            const MarketModelMultiProduct& swap,
+                            const ExerciseStrategy<CurveState>& strategy,
+                            BigNatural seed) {
+        MTBrownianGeneratorFactory outerFactory(seed);
+        ext::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   outerFactory, Pc);
+        std::vector<ext::shared_ptr<MarketModelEvolver> > innerEvolvers;
+        std::valarray<bool> isExerciseTime =
+            isInSubset(swap.evolution().evolutionTimes(),
+                       strategy.exerciseTimes());
+        for (Size s=0; s < isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                MTBrownianGeneratorFactory innerFactory(seed+1+s);
+                innerEvolvers.push_back(
+                    makeMarketModelEvolver(marketModel, numeraires,
+                                           innerFactory, Pc, s));
+            }
+        }
+        NothingExerciseValue nullRebate(rateTimes);
+        return ext::make_shared<UpperBoundEngine>(
+                               evolver, innerEvolvers,
+                               swap, nullRebate, swap, nullRebate,
+                               strategy, todaysDiscounts[numeraires.front()]);
+    }
+
+    ext::shared_ptr<UpperBoundEngine> makeBlockUpperBoundEngine(
+                            const ext::shared_ptr<MarketModel>& marketModel,
+                            const std::vector<Size>& numeraires,
+                            const MarketModelMultiProduct& swap,
+                            const ExerciseStrategy<CurveState>& strategy,
+                            BigNatural seed,
+                            Size blocks) {
+        MTBrownianGeneratorFactory outerFactory(seed);
+        ext::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   outerFactory, Pc);
+        std::vector<std::vector<ext::shared_ptr<MarketModelEvolver> > >
+            innerEvolvers;
+        std::valarray<bool> isExerciseTime =
+            isInSubset(swap.evolution().evolutionTimes(),
+                       strategy.exerciseTimes());
+        for (Size s=0; s < isExerciseTime.size(); ++s) {
+            if (isExerciseTime[s]) {
+                std::vector<ext::shared_ptr<MarketModelEvolver> > evolvers;
+                for (Size b=0; b<blocks; ++b) {
+                    MTBrownianGeneratorFactory innerFactory(
+                                                      seed+1+s+100*b);
+                    evolvers.push_back(
+                        makeMarketModelEvolver(marketModel, numeraires,
+                                               innerFactory, Pc, s));
+                }
+                innerEvolvers.push_back(evolvers);
+            }
+        }
+        NothingExerciseValue nullRebate(rateTimes);
+        return ext::make_shared<UpperBoundEngine>(
+                               evolver, innerEvolvers,
+                               swap, nullRebate, swap, nullRebate,
+                               strategy, todaysDiscounts[numeraires.front()]);
+    }
+
+}
+
+void MarketModelTest::testParallelUpperBoundEngine() {
+
+    BOOST_TEST_MESSAGE("Testing parallel upper-bound engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger strategy(rateTimes, swapTriggers, exerciseTimes);
+
+    EvolutionDescription evolution = receiverSwap.evolution();
+    std::vector<Size> numeraires = terminalMeasure(evolution);
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 3,
+                        ExponentialCorrelationFlatVolatility);
+
+    Size outerPaths = 30, innerPaths = 64;
+
+    // a single engine reproduces the serial simulation
+    {
+        ext::shared_ptr<UpperBoundEngine> engine =
+            makeUpperBoundEngine(marketModel, numeraires,
+                                 receiverSwap, strategy, seed_);
+        Statistics serial;
+        engine->multiplePathValues(serial, outerPaths, innerPaths);
+
+        std::vector<ext::shared_ptr<UpperBoundEngine> > engines(1,
+            makeUpperBoundEngine(marketModel, numeraires,
+                                 receiverSwap, strategy, seed_));
+        ParallelUpperBoundEngine parallelEngine(engines);
+        Statistics parallel;
+        parallelEngine.multiplePathValues(parallel, outerPaths, innerPaths);
+
+        if (parallel.mean() != serial.mean())
+            BOOST_ERROR("failed to reproduce serial simulation"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << parallel.mean()
+                        << "\n    expected:   " << serial.mean());
+    }
+
+    // several engines with independent generators
+    Size numberOfEngines = 3;
+    std::vector<Real> results;
+    for (Size k=0; k<2; ++k) {
+        std::vector<ext::shared_ptr<UpperBoundEngine> > engines;
+        for (Size i=0; i<numberOfEngines; ++i)
+            engines.push_back(
+                makeUpperBoundEngine(marketModel, numeraires, receiverSwap,
+                                     strategy, seed_+1000*i));
+        ParallelUpperBoundEngine parallelEngine(engines);
+        Statistics stats;
+        parallelEngine.multiplePathValues(stats, outerPaths, innerPaths);
+
+        if (stats.samples() != outerPaths)
+            BOOST_ERROR("wrong number of simulated paths"
+                        << "\n    calculated: " << stats.samples()
+                        << "\n    expected:   " << outerPaths);
+        // the duality gap is non-negative up to the inner
+        // simulation error
+        if (stats.mean() < -3.0*stats.errorEstimate())
+            BOOST_ERROR("negative upper-bound delta"
+                        << "\n    delta: " << stats.mean()
+                        << "\n    error: " << stats.errorEstimate());
+        results.push_back(stats.mean());
+    }
+
+    if (results[0] != results[1])
+        BOOST_ERROR("parallel simulation is not reproducible"
+                    << std::setprecision(16)
+                    << "\n    first run:     " << results[0]
+                    << "\n    second run:    " << results[1]);
+
+    // a single inner block reproduces the unblocked simulation
+    {
+        ext::shared_ptr<UpperBoundEngine> engine =
+            makeUpperBoundEngine(marketModel, numeraires,
+                                 receiverSwap, strategy, seed_);
+        Statistics serial;
+        engine->multiplePathValues(serial, outerPaths, innerPaths);
+
+        ext::shared_ptr<UpperBoundEngine> blockEngine =
+            makeBlockUpperBoundEngine(marketModel, numeraires,
+                                      receiverSwap, strategy, seed_, 1);
+        Statistics blocked;
+        blockEngine->multiplePathValues(blocked, outerPaths, innerPaths);
+
+        if (blocked.mean() != serial.mean())
+            BOOST_ERROR("failed to reproduce unblocked simulation"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << blocked.mean()
+                        << "\n    expected:   " << serial.mean());
+    }
+
+    // inner simulations split into blocks
+    Size numberOfBlocks = 4;
+    std::vector<Real> blockResults;
+    for (Size k=0; k<2; ++k) {
+        std::vector<ext::shared_ptr<UpperBoundEngine> > engines;
+        for (Size i=0; i<numberOfEngines; ++i)
+            engines.push_back(
+                makeBlockUpperBoundEngine(marketModel, numeraires,
+                                          receiverSwap, strategy,
+                                          seed_+1000*i, numberOfBlocks));
+        Statistics stats;
+        if (k == 0) {
+            ParallelUpperBoundEngine parallelEngine(engines);
+            parallelEngine.multiplePathValues(stats, outerPaths, innerPaths);
+        } else {
+            // the same paths run one engine at a time, so that the
+            // inner blocks are the ones being run in parallel
+            Size n = engines.size();
+            for (Size i=0; i<n; ++i)
+                engines[i]->multiplePathValues(
+                    stats, outerPaths/n + (i < outerPaths%n ? 1 : 0),
+                    innerPaths);
+        }
+
+        if (stats.mean() < -3.0*stats.errorEstimate())
+            BOOST_ERROR("negative upper-bound delta"
+                        << "\n    delta: " << stats.mean()
+                        << "\n    error: " << stats.errorEstimate());
+        blockResults.push_back(stats.mean());
+    }
+
+    if (blockResults[0] != blockResults[1])
+        BOOST_ERROR("blocked simulation is not reproducible"
+                    << std::setprecision(16)
+                    << "\n    outer parallelism: " << blockResults[0]
+                    << "\n    inner parallelism: " << blockResults[1]);
+}
+
 
 void MarketModelTest::testGreeks() {
 
@@ -4731,6 +5043,159 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testBlockDriftCalculator() {
+
+    // Test drift equivalence between block and single-path computation
+
+    BOOST_TEST_MESSAGE("Testing drift calculation on blocks of paths...");
+
+    setup();
+
+    Real tolerance = 1.0e-16;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Real> rateTaus = evolution.rateTaus();
+    std::vector<Size> numeraires = moneyMarketPlusMeasure(evolution,
+        measureOffset_);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfSteps = evolutionTimes.size();
+    Size numberOfRates = todaysForwards.size();
+
+    // forwards of each path in a column
+    Size paths = 7;
+    Matrix forwards(numberOfRates, paths);
+    for (Size i=0; i<numberOfRates; ++i)
+        for (Size p=0; p<paths; ++p)
+            forwards[i][p] = todaysForwards[i]*(0.7 + 0.1*p);
+
+    Size testedFactors[] = { 3, numberOfRates };
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        bool logNormal = true;
+        ext::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(logNormal, evolution, testedFactors[m],
+                            ExponentialCorrelationAbcdVolatility);
+        std::vector<Rate> displacements = marketModel->displacements();
+        for (Size j=0; j<numberOfSteps; ++j) {
+            const Matrix& A = marketModel->pseudoRoot(j);
+            for (Size h=alive[j]; h<numeraires.size(); ++h) {
+                LMMDriftCalculator driftcalculator(A, displacements, rateTaus,
+                    numeraires[h], alive[j]);
+                Matrix blockDrifts(numberOfRates, paths, 0.0);
+                driftcalculator.compute(forwards, blockDrifts);
+                for (Size p=0; p<paths; ++p) {
+                    std::vector<Rate> fwds(forwards.column_begin(p),
+                                           forwards.column_end(p));
+                    std::vector<Real> drifts(numberOfRates, 0.0);
+                    driftcalculator.compute(fwds, drifts);
+                    for (Size i=alive[j]; i<numberOfRates; ++i) {
+                        Real error = std::abs(blockDrifts[i][p]-drifts[i]);
+                        if (error>tolerance)
+                            BOOST_ERROR(testedFactors[m] << " factors, " <<
+                            io::ordinal(j+1) << " step, " <<
+                            io::ordinal(h+1) << " numeraire, " <<
+                            io::ordinal(p+1) << " path, " <<
+                            io::ordinal(i+1) << " drift, " <<
+                            "\ndrift        =" << drifts[i] <<
+                            "\nblock drift  =" << blockDrifts[i][p] <<
+                            "\n       error =" << error <<
+                            "\n   tolerance =" << tolerance);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void MarketModelTest::testBlockEvolvers() {
+
+    // Test evolution equivalence between blocks and single paths
+
+    BOOST_TEST_MESSAGE("Testing evolution of blocks of paths...");
+
+    setup();
+
+    Real tolerance = 1.0e-14;
+    std::vector<Time> evolutionTimes(rateTimes.size()-1);
+    std::copy(rateTimes.begin(), rateTimes.end()-1, evolutionTimes.begin());
+    EvolutionDescription evolution(rateTimes,evolutionTimes);
+    std::vector<Size> alive = evolution.firstAliveRate();
+    Size numberOfRates = todaysForwards.size();
+    Size paths = 5;
+
+    EvolverType evolvers[] = { Pc, Ipc, NormalPc };
+    for (Size k=0; k<LENGTH(evolvers); ++k) {
+        bool logNormal = (evolvers[k] != NormalPc);
+        // the iterative predictor-corrector requires the terminal measure
+        std::vector<Size> numeraires = (evolvers[k] == Ipc) ?
+            terminalMeasure(evolution) : moneyMarketMeasure(evolution);
+        ext::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(logNormal, evolution, 3,
+                            ExponentialCorrelationAbcdVolatility);
+
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        ext::shared_ptr<MarketModelEvolver> evolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   generatorFactory, evolvers[k]);
+        ext::shared_ptr<MarketModelEvolver> blockEvolver =
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   generatorFactory, evolvers[k]);
+        MarketModelBlockEvolver& block =
+            dynamic_cast<MarketModelBlockEvolver&>(*blockEvolver);
+
+        // single paths, stored step by step
+        Size steps = evolution.numberOfSteps();
+        std::vector<Matrix> forwards(steps, Matrix(numberOfRates, paths));
+        Matrix weights(steps+1, paths);
+        for (Size p=0; p<paths; ++p) {
+            weights[0][p] = evolver->startNewPath();
+            for (Size j=0; j<steps; ++j) {
+                weights[j+1][p] = evolver->advanceStep();
+                const std::vector<Rate>& f =
+                    evolver->currentState().forwardRates();
+                for (Size i=0; i<numberOfRates; ++i)
+                    forwards[j][i][p] = f[i];
+            }
+        }
+
+        std::vector<Real> blockWeights;
+        block.startNewBlock(paths, blockWeights);
+        for (Size p=0; p<paths; ++p)
+            if (blockWeights[p] != weights[0][p])
+                BOOST_ERROR(evolverTypeToString(evolvers[k]) << ", " <<
+                            io::ordinal(p+1) << " path: " <<
+                            "mismatched initial weight");
+        for (Size j=0; j<steps; ++j) {
+            block.advanceBlockStep(blockWeights);
+            const Matrix& blockForwards = block.currentBlockForwards();
+            for (Size p=0; p<paths; ++p) {
+                if (blockWeights[p] != weights[j+1][p])
+                    BOOST_ERROR(evolverTypeToString(evolvers[k]) << ", " <<
+                                io::ordinal(j+1) << " step, " <<
+                                io::ordinal(p+1) << " path: " <<
+                                "mismatched weight");
+                for (Size i=alive[j]; i<numberOfRates; ++i) {
+                    Real error =
+                        std::fabs(blockForwards[i][p]-forwards[j][i][p]);
+                    if (error>tolerance)
+                        BOOST_ERROR(evolverTypeToString(evolvers[k]) <<
+                            ", " << io::ordinal(j+1) << " step, " <<
+                            io::ordinal(p+1) << " path, " <<
+                            io::ordinal(i+1) << " forward, " <<
+                            "\nforward       =" << forwards[j][i][p] <<
+                            "\nblock forward =" << blockForwards[i][p] <<
+                            "\n        error =" << error <<
+                            "\n    tolerance =" << tolerance);
+                }
+            }
+        }
+        if (block.currentBlockStep() != steps)
+            BOOST_ERROR(evolverTypeToString(evolvers[k]) <<
+                        ": block evolved for " << block.currentBlockStep() <<
+                        " steps instead of " << steps);
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4872,6 +5337,8 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testOneStepForwardsAndOptionlets));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testOneStepNormalForwardsAndOptionlets));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelUpperBoundEngine));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testGreeks));
 
@@ -4882,6 +5349,8 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBlockDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBlockEvolvers));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
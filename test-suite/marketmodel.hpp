@@ -39,6 +39,8 @@ class MarketModelTest {
     static void testAllMultiStepProducts();
     static void testOneStepForwardsAndOptionlets();
     static void testOneStepNormalForwardsAndOptionlets();
+    static void testParallelAccountingEngine();
+    static void testParallelUpperBoundEngine();
     static void testCallableSwapNaif();
     static void testCallableSwapLS();
     static void testCallableSwapAnderson(
@@ -52,6 +54,8 @@ class MarketModelTest {
     static void testAbcdVolatilityCompare();
     static void testAbcdVolatilityFit();
     static void testDriftCalculator();
+    static void testBlockDriftCalculator();
+    static void testBlockEvolvers();
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
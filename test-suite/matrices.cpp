@@ -558,6 +558,40 @@ void MatricesTest::testCholeskyDecomposition() {
     }
 }
 
+void MatricesTest::testCholeskySolveFor() {
+
+    BOOST_TEST_MESSAGE("Testing CholeskySolveFor...");
+
+    MersenneTwisterUniformRng rng(1234);
+
+    for (Size n=1; n<25; n+=3) {
+        Matrix m(n, n);
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<n; ++j)
+                m[i][j] = rng.next().value - 0.5;
+
+        // symmetric positive definite test matrix
+        Matrix s = m*transpose(m);
+        for (Size i=0; i<n; ++i)
+            s[i][i] += 1.0;
+
+        Array b(n);
+        for (Size i=0; i<n; ++i)
+            b[i] = rng.next().value;
+
+        const Array x = CholeskySolveFor(CholeskyDecomposition(s), b);
+        const Array residual = s*x - b;
+
+        const Real tol = 1e-12;
+        if (norm(residual) > tol) {
+            BOOST_FAIL("Failed to solve via Cholesky decomposition"
+                       << "\n    size     : " << n
+                       << "\n    residual : " << norm(residual)
+                       << "\n    tolerance: " << tol);
+        }
+    }
+}
+
 void MatricesTest::testMoorePenroseInverse() {
 
     BOOST_TEST_MESSAGE("Testing Moore-Penrose inverse...");
@@ -751,6 +785,7 @@ test_suite* MatricesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testDeterminant));
     #endif
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testCholeskyDecomposition));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testCholeskySolveFor));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testIterativeSolvers));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testInitializers));
@@ -39,6 +39,7 @@ class MatricesTest {
     static void testDeterminant();
     static void testOrthogonalProjection();
     static void testCholeskyDecomposition();
+    static void testCholeskySolveFor();
     static void testMoorePenroseInverse();
     static void testIterativeSolvers();
     static void testInitializers();
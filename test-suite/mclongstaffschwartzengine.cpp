@@ -314,6 +314,115 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testStreamingCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing memory-bounded Longstaff-Schwartz "
+                       "calibration...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+
+    const Date maturity(17, May, 1999);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(36.0));
+    const Handle<YieldTermStructure> rTS(
+        ext::make_shared<FlatForward>(today, 0.06, dayCounter));
+    const Handle<YieldTermStructure> qTS(
+        ext::make_shared<FlatForward>(today, 0.02, dayCounter));
+    const Handle<BlackVolTermStructure> volTS(
+        ext::make_shared<BlackConstantVol>(
+            today, NullCalendar(), 0.25, dayCounter));
+
+    const ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            spot, qTS, rTS, volTS);
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 40.0),
+        ext::make_shared<AmericanExercise>(today, maturity));
+
+    for (Size i=0; i < 2; ++i) {
+        const bool antithetic = (i == 1);
+
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(50)
+            .withAntitheticVariate(antithetic)
+            .withSamples(4095)
+            .withCalibrationSamples(3000)
+            .withSeed(42)
+            .withPolynomOrder(3));
+        const Real expected = option.NPV();
+        const Real expectedExProb =
+            option.result<Real>("exerciseProbability");
+
+        option.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(50)
+            .withAntitheticVariate(antithetic)
+            .withSamples(4095)
+            .withCalibrationSamples(3000)
+            .withSeed(42)
+            .withPolynomOrder(3)
+            .withStreamingCalibration());
+        const Real calculated = option.NPV();
+        const Real calculatedExProb =
+            option.result<Real>("exerciseProbability");
+
+        // same calibration paths, hence only the regression solver
+        // differs between the two calibration modes
+        const Real tol = 1e-6;
+        if (std::fabs(calculated - expected) > tol
+            || std::fabs(calculatedExProb - expectedExProb) > tol) {
+            BOOST_ERROR("Failed to reproduce stored-path calibration"
+                        << "\n    antithetic variate:  " << antithetic
+                        << "\n    expected price:      " << expected
+                        << "\n    calculated price:    " << calculated
+                        << "\n    expected ex. prob:   " << expectedExProb
+                        << "\n    calculated ex. prob: " << calculatedExProb);
+        }
+    }
+
+    // with the default (random) calibration seed the two modes are
+    // calibrated on different paths, but must agree within the Monte
+    // Carlo error; the pricing paths are kept the same
+    option.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(process)
+        .withSteps(50)
+        .withSamples(32767)
+        .withCalibrationSamples(4096)
+        .withSeed(42)
+        .withSeedCalibration(0)
+        .withPolynomOrder(3));
+    const Real expected = option.NPV();
+    const Real expectedError = option.errorEstimate();
+
+    option.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(process)
+        .withSteps(50)
+        .withSamples(32767)
+        .withCalibrationSamples(4096)
+        .withSeed(42)
+        .withSeedCalibration(0)
+        .withPolynomOrder(3)
+        .withStreamingCalibration());
+    const Real calculated = option.NPV();
+    const Real calculatedError = option.errorEstimate();
+
+    const Real tol = 2.0*std::sqrt(expectedError*expectedError
+                                   + calculatedError*calculatedError);
+    if (std::fabs(calculated - expected) > tol) {
+        BOOST_ERROR("Failed to reproduce stored-path calibration "
+                    "with the default seed"
+                    << "\n    expected price:   " << expected
+                    << "\n    calculated price: " << calculated
+                    << "\n    tolerance:        " << tol);
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -321,6 +430,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testStreamingCalibration));
     return suite;
 }
 
@@ -0,0 +1,305 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "multilevelmontecarlo.hpp"
+#include "utilities.hpp"
+#include <ql/instruments/barrieroption.hpp>
+#include <ql/instruments/asianoption.hpp>
+#include <ql/instruments/lookbackoption.hpp>
+#include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mcmultilevelbarrierengine.hpp>
+#include <ql/pricingengines/asian/mcmultilevelasianengine.hpp>
+#include <ql/pricingengines/lookback/analyticcontinuousfloatinglookback.hpp>
+#include <ql/pricingengines/lookback/mcmultilevellookbackengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+namespace {
+
+    ext::shared_ptr<GeneralizedBlackScholesProcess> makeProcess(
+                                                 const Date& today,
+                                                 Real spot, Rate q, Rate r,
+                                                 Volatility vol) {
+        DayCounter dc = Actual360();
+        return ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(spot)),
+            Handle<YieldTermStructure>(flatRate(today, q, dc)),
+            Handle<YieldTermStructure>(flatRate(today, r, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc)));
+    }
+
+    // single-level engine reporting the number of simulated paths
+    class SampleCountingBarrierEngine : public MCBarrierEngine<PseudoRandom> {
+      public:
+        SampleCountingBarrierEngine(
+             const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps, Real requiredTolerance, BigNatural seed)
+        : MCBarrierEngine<PseudoRandom>(process, timeSteps, Null<Size>(),
+                                        false, false, Null<Size>(),
+                                        requiredTolerance, Null<Size>(),
+                                        false, seed) {}
+        Size samples() const {
+            return this->mcModel_->sampleAccumulator().samples();
+        }
+    };
+
+}
+
+
+void MultilevelMonteCarloTest::testCoupledPaths() {
+
+    BOOST_TEST_MESSAGE("Testing coupling of multilevel fine and coarse paths...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(today, 100.0, 0.02, 0.05, 0.3);
+
+    const Size refinement = 4;
+    TimeGrid coarseGrid(1.0, 5);
+    PseudoRandom::rsg_type rsg = PseudoRandom::make_sequence_generator(
+                                       refinement*(coarseGrid.size()-1), 42);
+    MultilevelPathGenerator<PseudoRandom::rsg_type> generator(
+                                   process, coarseGrid, refinement, rsg);
+
+    const TimeGrid fineGrid = refinedTimeGrid(coarseGrid, refinement);
+    if (fineGrid.size() != refinement*(coarseGrid.size()-1)+1)
+        BOOST_FAIL("unexpected size of refined grid: " << fineGrid.size());
+    for (Size i=0; i<coarseGrid.size(); ++i) {
+        if (std::fabs(fineGrid[i*refinement] - coarseGrid[i]) > 1e-14)
+            BOOST_ERROR("coarse grid point " << i << " (" << coarseGrid[i]
+                        << ") not in refined grid");
+    }
+
+    // the Black-Scholes process is evolved exactly, so that both
+    // paths must be on the same Brownian motion at the coarse nodes
+    const Real tolerance = 1e-10;
+    for (Size j=0; j<100; ++j) {
+        const MultilevelPathGenerator<PseudoRandom::rsg_type>::sample_type&
+            sample = generator.next();
+        const Path& fine = sample.value.first[0];
+        const Path& coarse = sample.value.second[0];
+        for (Size i=0; i<coarse.length(); ++i) {
+            const Real error =
+                std::fabs(fine[i*refinement] - coarse[i])/coarse[i];
+            if (error > tolerance)
+                BOOST_FAIL("fine and coarse paths not coupled:"
+                           << "\n    sample:      " << j
+                           << "\n    node:        " << i
+                           << "\n    fine path:   " << fine[i*refinement]
+                           << "\n    coarse path: " << coarse[i]
+                           << "\n    tolerance:   " << tolerance);
+        }
+    }
+}
+
+
+void MultilevelMonteCarloTest::testBarrierEngine() {
+
+    BOOST_TEST_MESSAGE("Testing multilevel Monte Carlo barrier engine...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(today, 100.0, 0.02, 0.05, 0.2);
+
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 180);
+
+    BarrierOption option(Barrier::UpOut, 130.0, 0.0, payoff, exercise);
+
+    option.setPricingEngine(
+                  ext::make_shared<AnalyticBarrierEngine>(process));
+    const Real expected = option.NPV();
+
+    const Real requiredTolerance = 0.05;
+    option.setPricingEngine(ext::make_shared<
+        MCMultilevelBarrierEngine<PseudoRandom> >(
+                 process, 4, Null<Size>(), requiredTolerance, 10, 2, 1000, 42));
+    const Real calculated = option.NPV();
+
+    // the engine targets a root mean squared error, including the
+    // monitoring bias, below the required tolerance
+    if (std::fabs(calculated - expected) > 3.0*requiredTolerance)
+        BOOST_ERROR("failed to reproduce continuous barrier price:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << option.errorEstimate()
+                    << "\n    tolerance:      " << 3.0*requiredTolerance);
+}
+
+
+void MultilevelMonteCarloTest::testAsianEngine() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel Monte Carlo discrete arithmetic Asian engine...");
+
+    SavedSettings backup;
+
+    // data from "Asian Option", Levy, 1997
+    // in "Exotic Options: The State of the Art",
+    // edited by Clewlow, Strickland
+    Date today = Settings::instance().evaluationDate();
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(today, 90.0, 0.06, 0.025, 0.13);
+
+    const Size fixings = 12;
+    const Time length = 11.0/12.0;
+    const Time dt = length/(fixings-1);
+    std::vector<Date> fixingDates(fixings);
+    for (Size i=0; i<fixings; ++i)
+        fixingDates[i] = today + Integer(i*dt*360+0.5);
+
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 87.0);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(fixingDates.back());
+
+    DiscreteAveragingAsianOption option(Average::Arithmetic, 0.0, 0,
+                                        fixingDates, payoff, exercise);
+
+    const Real requiredTolerance = 0.01;
+    option.setPricingEngine(ext::make_shared<
+        MCMultilevelDiscreteArithmeticAPEngine<PseudoRandom> >(
+              process, Null<Size>(), requiredTolerance, 10, 2, 1000, 42));
+
+    const Real calculated = option.NPV();
+    const Real expected = 1.6980019214;
+    if (std::fabs(calculated - expected) > 3.0*requiredTolerance)
+        BOOST_ERROR("failed to reproduce Asian price:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << option.errorEstimate()
+                    << "\n    tolerance:      " << 3.0*requiredTolerance);
+}
+
+
+void MultilevelMonteCarloTest::testLookbackEngine() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel Monte Carlo floating lookback engine...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(today, 100.0, 0.02, 0.05, 0.2);
+
+    ext::shared_ptr<FloatingTypePayoff> payoff =
+        ext::make_shared<FloatingTypePayoff>(Option::Put);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 90);
+
+    ContinuousFloatingLookbackOption option(100.0, payoff, exercise);
+
+    option.setPricingEngine(
+        ext::make_shared<AnalyticContinuousFloatingLookbackEngine>(process));
+    const Real expected = option.NPV();
+
+    const Real requiredTolerance = 0.05;
+    option.setPricingEngine(ext::make_shared<
+        MCMultilevelContinuousFloatingLookbackEngine<PseudoRandom> >(
+                 process, 4, Null<Size>(), requiredTolerance, 10, 2, 1000, 42));
+    const Real calculated = option.NPV();
+
+    if (std::fabs(calculated - expected) > 3.0*requiredTolerance)
+        BOOST_ERROR("failed to reproduce continuous lookback price:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << option.errorEstimate()
+                    << "\n    tolerance:      " << 3.0*requiredTolerance);
+}
+
+
+void MultilevelMonteCarloTest::testCostToTolerance() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multilevel against single-level cost to tolerance...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(today, 100.0, 0.02, 0.05, 0.2);
+
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 180);
+
+    BarrierOption option(Barrier::UpOut, 130.0, 0.0, payoff, exercise);
+
+    const Real requiredTolerance = 0.025;
+    const Size coarsestSteps = 4;
+    ext::shared_ptr<MCMultilevelBarrierEngine<PseudoRandom> > engine =
+        ext::make_shared<MCMultilevelBarrierEngine<PseudoRandom> >(
+              process, coarsestSteps, Null<Size>(), requiredTolerance,
+              12, 2, 1000, 42);
+    option.setPricingEngine(engine);
+    option.NPV();
+
+    // the single-level engine on the finest grid also accounts for
+    // barrier crossings between nodes and has the same bias, so it
+    // needs the statistical error left by the multilevel one, i.e.,
+    // half the mean squared error
+    const Size levels = engine->multilevelModel().levels();
+    const Size fineSteps =
+        engine->multilevelModel().timeGrid(levels-1).size()-1;
+    ext::shared_ptr<SampleCountingBarrierEngine> singleLevelEngine =
+        ext::make_shared<SampleCountingBarrierEngine>(
+              process, fineSteps, requiredTolerance/std::sqrt(2.0), 42);
+    option.setPricingEngine(singleLevelEngine);
+    option.NPV();
+
+    const Real singleLevelCost =
+        Real(singleLevelEngine->samples())*fineSteps;
+    const Real multilevelCost = engine->multilevelModel().cost();
+
+    BOOST_TEST_MESSAGE("    levels:             " << levels
+                       << "\n    single-level cost:  " << singleLevelCost
+                       << "\n    multilevel cost:    " << multilevelCost);
+
+    if (multilevelCost >= singleLevelCost)
+        BOOST_ERROR("multilevel estimator not cheaper than single level:"
+                    << "\n    levels:            " << levels
+                    << "\n    single-level cost: " << singleLevelCost
+                    << "\n    multilevel cost:   " << multilevelCost);
+}
+
+
+test_suite* MultilevelMonteCarloTest::suite() {
+    test_suite* suite = BOOST_TEST_SUITE("Multilevel Monte Carlo tests");
+    suite->add(QUANTLIB_TEST_CASE(&MultilevelMonteCarloTest::testCoupledPaths));
+    suite->add(QUANTLIB_TEST_CASE(&MultilevelMonteCarloTest::testBarrierEngine));
+    suite->add(QUANTLIB_TEST_CASE(&MultilevelMonteCarloTest::testAsianEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &MultilevelMonteCarloTest::testLookbackEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &MultilevelMonteCarloTest::testCostToTolerance));
+    return suite;
+}
+
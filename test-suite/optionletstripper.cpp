@@ -814,6 +814,188 @@ void OptionletStripperTest::testSwitchStrike() {
                    << "\ntolerance:     " << io::rate(vars.tolerance));
 }
 
+void OptionletStripperTest::testFlatNormalVolatilityStripping2() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing forward/forward vol stripping from flat normal term vol "
+        "surface using OptionletStripper2 class...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(28, October, 2013);
+
+    vars.setFlatTermVolSurface();
+
+    Volatility flatVol = 0.0075;
+    vars.termV = Matrix(vars.optionTenors.size(), vars.strikes.size(),
+                        flatVol);
+    ext::shared_ptr<CapFloorTermVolSurface> termVolSurface =
+        ext::make_shared<CapFloorTermVolSurface>(0, vars.calendar, Following,
+                                                 vars.optionTenors,
+                                                 vars.strikes, vars.termV,
+                                                 vars.dayCounter);
+    std::vector<Handle<Quote> > atmVolHandles(vars.optionTenors.size());
+    for (Size i=0; i<vars.optionTenors.size(); ++i)
+        atmVolHandles[i] =
+            Handle<Quote>(ext::make_shared<SimpleQuote>(flatVol));
+    Handle<CapFloorTermVolCurve> atmVolCurve(
+        ext::make_shared<CapFloorTermVolCurve>(0, vars.calendar, Following,
+                                               vars.optionTenors,
+                                               atmVolHandles,
+                                               vars.dayCounter));
+
+    shared_ptr<IborIndex> iborIndex(new Euribor6M(vars.yieldTermStructure));
+
+    ext::shared_ptr<OptionletStripper1> optionletStripper1(
+        new OptionletStripper1(termVolSurface, iborIndex, Null<Rate>(),
+                               vars.accuracy, 100,
+                               Handle<YieldTermStructure>(), Normal));
+
+    // the atm vols are read as normal ones, consistently with the
+    // smile; no spread is needed to reprice the atm caps
+    ext::shared_ptr<OptionletStripper2> optionletStripper2(
+        new OptionletStripper2(optionletStripper1, atmVolCurve));
+
+    std::vector<Volatility> spreads = optionletStripper2->spreadsVol();
+    for (Size i=0; i<spreads.size(); ++i) {
+        if (std::fabs(spreads[i]) > 1.0e-6)
+            BOOST_FAIL("\noption tenor:  " << vars.optionTenors[i] <<
+                       "\nspread:        " << spreads[i] <<
+                       "\ntolerance:     " << 1.0e-6);
+    }
+
+    StrippedOptionletAdapter vol1(optionletStripper1);
+    vol1.enableExtrapolation();
+    StrippedOptionletAdapter vol2(optionletStripper2);
+    vol2.enableExtrapolation();
+
+    for (Size strikeIndex=0; strikeIndex<vars.strikes.size(); ++strikeIndex) {
+        for (Size tenorIndex=0; tenorIndex<vars.optionTenors.size();
+             ++tenorIndex) {
+            Volatility strippedVol1 =
+                vol1.volatility(vars.optionTenors[tenorIndex],
+                                vars.strikes[strikeIndex], true);
+            Volatility strippedVol2 =
+                vol2.volatility(vars.optionTenors[tenorIndex],
+                                vars.strikes[strikeIndex], true);
+            Real error = std::fabs(strippedVol1-strippedVol2);
+            if (error > 1.0e-6)
+                BOOST_FAIL("\noption tenor:  " <<
+                           vars.optionTenors[tenorIndex] <<
+                           "\nstrike:        " <<
+                           io::rate(vars.strikes[strikeIndex]) <<
+                           "\nstripped vol1: " << strippedVol1 <<
+                           "\nstripped vol2: " << strippedVol2 <<
+                           "\nerror:         " << error <<
+                           "\ntolerance:     " << 1.0e-6);
+        }
+    }
+}
+
+void OptionletStripperTest::testIncrementalStripping() {
+    BOOST_TEST_MESSAGE("Testing incremental stripping after changes "
+                       "in term volatilities and curves...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(28, October, 2013);
+    vars.setCapFloorTermVolSurface();
+
+    std::vector<std::vector<ext::shared_ptr<SimpleQuote> > > quotes(
+                                                    vars.optionTenors.size());
+    std::vector<std::vector<Handle<Quote> > > termVolHandles(
+                                                    vars.optionTenors.size());
+    for (Size i=0; i<vars.optionTenors.size(); ++i) {
+        for (Size j=0; j<vars.strikes.size(); ++j) {
+            quotes[i].push_back(
+                ext::make_shared<SimpleQuote>(vars.termV[i][j]));
+            termVolHandles[i].push_back(Handle<Quote>(quotes[i][j]));
+        }
+    }
+    ext::shared_ptr<CapFloorTermVolSurface> termVolSurface =
+        ext::make_shared<CapFloorTermVolSurface>(0, vars.calendar, Following,
+                                                 vars.optionTenors,
+                                                 vars.strikes,
+                                                 termVolHandles,
+                                                 vars.dayCounter);
+
+    RelinkableHandle<YieldTermStructure> yieldTermStructure;
+    yieldTermStructure.linkTo(ext::make_shared<FlatForward>(
+        0, vars.calendar, 0.03, vars.dayCounter));
+
+    RelinkableHandle<YieldTermStructure> discountingTermStructure;
+    discountingTermStructure.linkTo(ext::make_shared<FlatForward>(
+        0, vars.calendar, 0.02, vars.dayCounter));
+
+    shared_ptr<IborIndex> iborIndex(new Euribor6M(yieldTermStructure));
+
+    ext::shared_ptr<OptionletStripper1> optionletStripper1(
+        new OptionletStripper1(termVolSurface, iborIndex,
+                               Null<Rate>(), vars.accuracy, 100,
+                               discountingTermStructure));
+    optionletStripper1->capFloorPrices();
+
+    for (Size k=0; k<4; ++k) {
+        std::string change;
+        switch (k) {
+          case 0:
+            change = "single term volatility";
+            quotes[3][5]->setValue(quotes[3][5]->value() + 0.01);
+            break;
+          case 1:
+            change = "term volatilities of two strikes";
+            quotes[0][1]->setValue(quotes[0][1]->value() - 0.005);
+            quotes[7][9]->setValue(quotes[7][9]->value() + 0.005);
+            break;
+          case 2:
+            change = "forwarding curve";
+            // moves the switch strike across some strikes
+            yieldTermStructure.linkTo(ext::make_shared<FlatForward>(
+                0, vars.calendar, 0.05, vars.dayCounter));
+            break;
+          case 3:
+            change = "discounting curve";
+            discountingTermStructure.linkTo(ext::make_shared<FlatForward>(
+                0, vars.calendar, 0.025, vars.dayCounter));
+            break;
+          default:
+            QL_FAIL("unknown change");
+        }
+
+        OptionletStripper1 fresh(termVolSurface, iborIndex,
+                                 Null<Rate>(), vars.accuracy, 100,
+                                 discountingTermStructure);
+
+        const Matrix& incrementalPrices =
+            optionletStripper1->capFloorPrices();
+        const Matrix& freshPrices = fresh.capFloorPrices();
+        for (Size i=0; i<optionletStripper1->optionletMaturities(); ++i) {
+            const std::vector<Volatility>& incrementalVols =
+                optionletStripper1->optionletVolatilities(i);
+            const std::vector<Volatility>& freshVols =
+                fresh.optionletVolatilities(i);
+            for (Size j=0; j<vars.strikes.size(); ++j) {
+                Real priceError =
+                    std::fabs(incrementalPrices[i][j] - freshPrices[i][j]);
+                Real volError =
+                    std::fabs(incrementalVols[j] - freshVols[j]);
+                if (priceError > 1.0e-12 || volError > 1.0e-5)
+                    BOOST_FAIL("\nchange:              " << change <<
+                               "\noptionlet date:      " <<
+                               fresh.optionletFixingDates()[i] <<
+                               "\nstrike:              " <<
+                               io::rate(vars.strikes[j]) <<
+                               "\nincremental price:   " <<
+                               incrementalPrices[i][j] <<
+                               "\nfresh price:         " <<
+                               freshPrices[i][j] <<
+                               "\nincremental vol:     " <<
+                               io::volatility(incrementalVols[j]) <<
+                               "\nfresh vol:           " <<
+                               io::volatility(freshVols[j]));
+            }
+        }
+    }
+}
+
 test_suite* OptionletStripperTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("OptionletStripper Tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -830,6 +1012,10 @@ test_suite* OptionletStripperTest::suite() {
         &OptionletStripperTest::testTermVolatilityStrippingNormalVol));
     suite->add(QUANTLIB_TEST_CASE(
         &OptionletStripperTest::testTermVolatilityStrippingShiftedLogNormalVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptionletStripperTest::testFlatNormalVolatilityStripping2));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptionletStripperTest::testIncrementalStripping));
 
     return suite;
 }
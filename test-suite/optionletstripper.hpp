@@ -36,6 +36,8 @@ class OptionletStripperTest {
     static void testFlatTermVolatilityStripping2();
     static void testTermVolatilityStripping2();
     static void testSwitchStrike();
+    static void testFlatNormalVolatilityStripping2();
+    static void testIncrementalStripping();
     static boost::unit_test_framework::test_suite* suite();
 };
 
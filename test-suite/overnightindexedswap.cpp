@@ -35,7 +35,9 @@
 #include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/fedfunds.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
@@ -497,6 +499,87 @@ void OvernightIndexedSwapTest::testBootstrapRegression() {
 }
 
 
+void OvernightIndexedSwapTest::testSeasonedCouponCache() {
+
+    BOOST_TEST_MESSAGE("Testing cached past fixings of seasoned "
+                       "overnight coupons...");
+
+    CommonVars vars;
+    IndexHistoryCleaner cleaner;
+    // other tests might have left some fixings behind
+    vars.eoniaIndex->clearFixings();
+
+    Date startDate = Date(2, February, 2009);
+    Date endDate = Date(4, May, 2009);
+    OvernightIndexedCoupon coupon(endDate, 1.0, startDate, endDate,
+                                  vars.eoniaIndex);
+
+    Date d = startDate;
+    Real fixing = 0.0010;
+    while (d < vars.today) {
+        vars.eoniaIndex->addFixing(d, fixing);
+        d = vars.calendar.advance(d, 1, Days);
+        fixing += 0.0001;
+    }
+
+    Date evaluationDates[] = {
+        Date(5, February, 2009), Date(12, February, 2009),
+        Date(26, February, 2009), Date(9, February, 2009)
+    };
+
+    const IndexManager& manager = IndexManager::instance();
+    Size handle = manager.handle(vars.eoniaIndex->name());
+
+    for (Size i=0; i<LENGTH(evaluationDates); ++i) {
+        // appended fixings don't touch the cached ones...
+        Size revision = manager.revision(handle);
+        Date firstAppended = d < evaluationDates[i] ? d : Date();
+        while (d < evaluationDates[i]) {
+            vars.eoniaIndex->addFixing(d, fixing);
+            d = vars.calendar.advance(d, 1, Days);
+            fixing += 0.0001;
+        }
+        if (manager.firstChangedDate(handle, revision) != firstAppended)
+            BOOST_ERROR("wrong first changed date after appending fixings:"
+                        << "\n    expected:   " << firstAppended
+                        << "\n    calculated: "
+                        << manager.firstChangedDate(handle, revision));
+        Settings::instance().evaluationDate() = evaluationDates[i];
+
+        for (Size j=0; j<2; ++j) {
+            if (j == 1) {
+                // ...while a corrected past fixing does
+                revision = manager.revision(handle);
+                vars.eoniaIndex->addFixing(startDate, 0.0020 + 0.0001*i,
+                                           true);
+                if (manager.firstChangedDate(handle, revision) != startDate)
+                    BOOST_ERROR("wrong first changed date after "
+                                "correcting a fixing:"
+                                << "\n    expected:   " << startDate
+                                << "\n    calculated: "
+                                << manager.firstChangedDate(handle,
+                                                            revision));
+                // overwriting a fixing with the same value is no change
+                revision = manager.revision(handle);
+                vars.eoniaIndex->addFixing(startDate, 0.0020 + 0.0001*i,
+                                           true);
+                if (manager.firstChangedDate(handle, revision) != Date())
+                    BOOST_ERROR("unchanged fixing reported as changed");
+            }
+            OvernightIndexedCoupon fresh(endDate, 1.0, startDate, endDate,
+                                         vars.eoniaIndex);
+            Rate cached = coupon.rate(), expected = fresh.rate();
+            if (std::fabs(cached - expected) > 1.0e-15)
+                BOOST_ERROR("cached coupon rate differs from fresh one:"
+                            << std::setprecision(12)
+                            << "\n    evaluation date: "
+                            << evaluationDates[i]
+                            << "\n    cached rate:     " << cached
+                            << "\n    fresh rate:      " << expected);
+        }
+    }
+}
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
@@ -507,5 +590,7 @@ test_suite* OvernightIndexedSwapTest::suite() {
         &OvernightIndexedSwapTest::testBootstrapWithTelescopicDates));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testSeasonedSwaps));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrapRegression));
+    suite->add(QUANTLIB_TEST_CASE(
+                  &OvernightIndexedSwapTest::testSeasonedCouponCache));
     return suite;
 }
@@ -160,6 +160,7 @@
 #include "mclongstaffschwartzengine.hpp"
 #include "mersennetwister.hpp"
 #include "money.hpp"
+#include "multilevelmontecarlo.hpp"
 #include "noarbsabr.hpp"
 #include "normalclvmodel.hpp"
 #include "nthorderderivativeop.hpp"
@@ -438,6 +439,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(MCLongstaffSchwartzEngineTest::suite());
     test->add(MersenneTwisterTest::suite());
     test->add(MoneyTest::suite());
+    test->add(MultilevelMonteCarloTest::suite());
     test->add(NumericalDifferentiationTest::suite());
     test->add(NthOrderDerivativeOpTest::suite());
     test->add(ObservableTest::suite());
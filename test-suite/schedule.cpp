@@ -20,6 +20,8 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -550,6 +552,97 @@ void ScheduleTest::testTruncation() {
     BOOST_CHECK(t.isRegular().front() == true);
 }
 
+void ScheduleTest::testScheduleCache() {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCache cache;
+    const Calendar calendar = UnitedStates(UnitedStates::GovernmentBond);
+
+    std::vector<Date> startDates, endDates;
+    for (Integer i=0; i<200; ++i) {
+        // every start date appears twice
+        const Date start = Date(15, January, 2010) + 7*(i/2);
+        startDates.push_back(start);
+        endDates.push_back(start + (5 + (i/2)%3)*Years);
+    }
+
+    const std::vector<Schedule> schedules =
+        cache.schedules(startDates, endDates, 6*Months, calendar,
+                        ModifiedFollowing, ModifiedFollowing,
+                        DateGeneration::Backward, false);
+
+    BOOST_CHECK(schedules.size() == startDates.size());
+    BOOST_CHECK(cache.size() == 100);
+
+    for (Size i=0; i<schedules.size(); ++i) {
+        const Schedule expected(startDates[i], endDates[i], 6*Months,
+                                calendar, ModifiedFollowing,
+                                ModifiedFollowing,
+                                DateGeneration::Backward, false);
+        check_dates(schedules[i], expected.dates());
+        BOOST_CHECK(schedules[i].isRegular() == expected.isRegular());
+        // the schedules hold the original calendar
+        BOOST_CHECK(schedules[i].calendar().identity() ==
+                    calendar.identity());
+    }
+
+    // identical parameters share their dates
+    const Schedule s =
+        cache.schedule(startDates[0], endDates[0], 6*Months, calendar,
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, false);
+    BOOST_CHECK(&s.dates() == &schedules[0].dates());
+    BOOST_CHECK(&s.dates() == &schedules[1].dates());
+    BOOST_CHECK(&s.dates() != &schedules[2].dates());
+    BOOST_CHECK(cache.size() == 100);
+
+    // truncating a shared schedule leaves the cached one alone
+    const Schedule t = s.after(s[2] + 1);
+    check_dates(schedules[0], s.dates());
+    BOOST_CHECK(t.size() == s.size() - 2);
+    BOOST_CHECK(&t.dates() != &s.dates());
+
+    // truncating outside the schedule doesn't copy the dates
+    BOOST_CHECK(&s.after(s.startDate() - 1).dates() == &s.dates());
+    BOOST_CHECK(&s.until(s.endDate() + 1).dates() == &s.dates());
+
+    // calendars sharing a name don't share schedules
+    BespokeCalendar fiveDays("bespoke");
+    fiveDays.addWeekend(Saturday);
+    fiveDays.addWeekend(Sunday);
+    BespokeCalendar fourDays("bespoke");
+    fourDays.addWeekend(Friday);
+    fourDays.addWeekend(Saturday);
+    fourDays.addWeekend(Sunday);
+
+    const Schedule first =
+        cache.schedule(Date(14, June, 2019), Date(14, June, 2020),
+                       3*Months, fiveDays, Following, Following,
+                       DateGeneration::Forward, false);
+    const Schedule second =
+        cache.schedule(Date(14, June, 2019), Date(14, June, 2020),
+                       3*Months, fourDays, Following, Following,
+                       DateGeneration::Forward, false);
+    BOOST_CHECK(first.startDate() == Date(14, June, 2019));
+    BOOST_CHECK(second.startDate() == Date(17, June, 2019));
+    BOOST_CHECK(first.calendar().identity() == fiveDays.identity());
+    BOOST_CHECK(second.calendar().identity() == fourDays.identity());
+    BOOST_CHECK(cache.size() == 102);
+
+    // weekends added after the first use are taken into account
+    fiveDays.addWeekend(Friday);
+    const Schedule third =
+        cache.schedule(Date(14, June, 2019), Date(14, June, 2020),
+                       3*Months, fiveDays, Following, Following,
+                       DateGeneration::Forward, false);
+    BOOST_CHECK(third.startDate() == Date(17, June, 2019));
+    BOOST_CHECK(cache.size() == 103);
+
+    cache.clear();
+    BOOST_CHECK(cache.size() == 0);
+    check_dates(s, schedules[1].dates());
+}
+
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDailySchedule));
@@ -572,5 +665,6 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFirstDateOnMaturity));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testNextToLastDateOnStart));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testTruncation));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testScheduleCache));
     return suite;
 }
@@ -132,6 +132,69 @@ void ShortRateModelTest::testCachedHullWhite() {
     }
 }
 
+void ShortRateModelTest::testParallelImpliedVolCalibration() {
+    BOOST_TEST_MESSAGE("Testing parallel Hull-White calibration "
+                       "with implied-volatility errors...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    Array params[2];
+    for (Size n=0; n<2; ++n) {
+        const bool parallel = (n == 1);
+        ext::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+        model->enableParallelCalibration(parallel);
+
+        // the Jamshidian engine doesn't declare itself thread-safe,
+        // so that all helpers must be evaluated serially
+        std::vector<ext::shared_ptr<BlackCalibrationHelper> > swaptions;
+        for (Size i=0; i<2*LENGTH(data); i++) {
+            const CalibrationData& d = data[i % LENGTH(data)];
+            ext::shared_ptr<Quote> vol(new SimpleQuote(d.volatility));
+            ext::shared_ptr<BlackCalibrationHelper> helper(
+                new SwaptionHelper(Period(d.start, Years),
+                                   Period(d.length, Years),
+                                   Handle<Quote>(vol),
+                                   index,
+                                   Period(1, Years), Thirty360(),
+                                   Actual360(), termStructure,
+                                   i < LENGTH(data) ?
+                                       BlackCalibrationHelper::ImpliedVolError :
+                                       BlackCalibrationHelper::PriceError));
+            helper->setPricingEngine(
+                ext::make_shared<JamshidianSwaptionEngine>(model));
+            swaptions.push_back(helper);
+        }
+
+        LevenbergMarquardt optimizationMethod(1.0e-8,1.0e-8,1.0e-8);
+        EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+        model->calibrate(swaptions, optimizationMethod, endCriteria);
+        params[n] = model->params();
+    }
+
+    const Real tolerance = 1.0e-12;
+    for (Size i=0; i<params[0].size(); ++i) {
+        if (std::fabs(params[0][i] - params[1][i]) > tolerance)
+            BOOST_ERROR("failed to reproduce serial calibration:"
+                        << "\n    parameter:  " << i
+                        << std::setprecision(16)
+                        << "\n    serial:     " << params[0][i]
+                        << "\n    parallel:   " << params[1][i]);
+    }
+}
+
 void ShortRateModelTest::testCachedHullWhiteFixedReversion() {
     BOOST_TEST_MESSAGE("Testing Hull-White calibration with fixed reversion against cached values...");
 
@@ -469,6 +532,8 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhiteFixedReversion));
+    suite->add(QUANTLIB_TEST_CASE(
+        &ShortRateModelTest::testParallelImpliedVolCalibration));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
     suite->add(QUANTLIB_TEST_CASE(
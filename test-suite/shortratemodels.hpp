@@ -31,6 +31,7 @@ class ShortRateModelTest {
     static void testFuturesConvexityBias();
     static void testCachedHullWhite();
     static void testCachedHullWhiteFixedReversion();
+    static void testParallelImpliedVolCalibration();
     static void testCachedHullWhite2();
     static void testSwaps();
     static void testExtendedCoxIngersollRossDiscountFactor();
@@ -26,6 +26,7 @@
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
@@ -124,6 +125,7 @@ void StatisticsTest::testStatistics() {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<TDigestRiskStatistics>(std::string("TDigestRiskStatistics"));
 }
 
 
@@ -244,6 +246,8 @@ void StatisticsTest::testSequenceStatistics() {
     checkSequence<IncrementalStatistics>(
         std::string("IncrementalStatistics"),5);
     checkSequence<Statistics>(std::string("Statistics"),5);
+    checkSequence<TDigestRiskStatistics>(
+        std::string("TDigestRiskStatistics"),5);
 }
 
 
@@ -389,11 +393,123 @@ void StatisticsTest::testIncrementalStatistics() {
                                  << tol);
 }
 
+void StatisticsTest::testTDigestStatistics() {
+
+    BOOST_TEST_MESSAGE("Testing bounded-memory t-digest statistics...");
+
+    // small samples are reproduced exactly
+    Statistics s0;
+    TDigestRiskStatistics t0;
+    for (Size i=0; i<LENGTH(data); i++) {
+        s0.add(data[i], weights[i]);
+        t0.add(data[i], weights[i]);
+    }
+    for (Size i=1; i<=20; i++) {
+        Real p = i/20.0;
+        if (t0.percentile(p) != s0.percentile(p)
+            || t0.topPercentile(p) != s0.topPercentile(p))
+            BOOST_ERROR("failed to reproduce percentiles of small sample"
+                        << "\n    percentile:     " << p
+                        << "\n    calculated:     " << t0.percentile(p)
+                        << "\n    expected:       " << s0.percentile(p)
+                        << "\n    top calculated: " << t0.topPercentile(p)
+                        << "\n    top expected:   " << s0.topPercentile(p));
+    }
+
+    // large samples, also collected in separate pieces and merged
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal(mt);
+
+    Size samples = 200000, pieces = 4;
+    Statistics s;
+    TDigestRiskStatistics t;
+    std::vector<TDigestRiskStatistics> p(pieces);
+    for (Size i=0; i<samples; ++i) {
+        Real x = normal.next().value;
+        s.add(x);
+        t.add(x);
+        p[i%pieces].add(x);
+    }
+    for (Size i=1; i<pieces; ++i)
+        p[0].merge(p[i]);
+
+    const TDigestRiskStatistics* digests[] = { &t, &p[0] };
+    std::string names[] = { "single", "merged" };
+    CumulativeNormalDistribution N;
+    for (Size k=0; k<LENGTH(digests); ++k) {
+        const TDigestRiskStatistics& d = *digests[k];
+
+        if (d.samples() != samples)
+            BOOST_ERROR(names[k] << " digest: wrong number of samples"
+                        << "\n    calculated: " << d.samples()
+                        << "\n    expected:   " << samples);
+
+        if (d.centroids() > 5*d.compression())
+            BOOST_ERROR(names[k] << " digest: too many centroids"
+                        << "\n    centroids:   " << d.centroids()
+                        << "\n    compression: " << d.compression());
+
+        Real tolerance = 1.0e-12;
+        if (std::fabs(d.mean() - s.mean()) > tolerance
+            || relativeError(d.variance(), s.variance(),
+                             s.variance()) > tolerance
+            || relativeError(d.skewness(), s.skewness(),
+                             std::fabs(s.skewness())) > 1.0e-9
+            || relativeError(d.kurtosis(), s.kurtosis(),
+                             std::fabs(s.kurtosis())) > 1.0e-9
+            || d.min() != s.min() || d.max() != s.max())
+            BOOST_ERROR(names[k] << " digest: moments not reproduced"
+                        << std::setprecision(16)
+                        << "\n    mean:     " << d.mean()
+                        << " (expected " << s.mean() << ")"
+                        << "\n    variance: " << d.variance()
+                        << " (expected " << s.variance() << ")"
+                        << "\n    skewness: " << d.skewness()
+                        << " (expected " << s.skewness() << ")"
+                        << "\n    kurtosis: " << d.kurtosis()
+                        << " (expected " << s.kurtosis() << ")");
+
+        // percentiles are compared in terms of the quantile error
+        Real percentiles[] = { 0.0001, 0.001, 0.01, 0.05, 0.25, 0.5,
+                               0.75, 0.95, 0.99, 0.999, 0.9999 };
+        for (Size i=0; i<LENGTH(percentiles); ++i) {
+            Real q = percentiles[i];
+            Real error = std::fabs(N(d.percentile(q)) - N(s.percentile(q)));
+            tolerance = 0.05*std::min(q, 1.0-q) + 1.0/samples;
+            if (error > tolerance)
+                BOOST_ERROR(names[k] << " digest: wrong percentile"
+                            << "\n    percentile: " << q
+                            << "\n    calculated: " << d.percentile(q)
+                            << "\n    expected:   " << s.percentile(q)
+                            << "\n    error:      " << error
+                            << "\n    tolerance:  " << tolerance);
+        }
+
+        Real centiles[] = { 0.95, 0.99, 0.999 };
+        for (Size i=0; i<LENGTH(centiles); ++i) {
+            Real c = centiles[i];
+            Real var = d.valueAtRisk(c), es = d.expectedShortfall(c);
+            Real expectedVar = s.valueAtRisk(c),
+                 expectedEs = s.expectedShortfall(c);
+            if (relativeError(var, expectedVar, expectedVar) > 0.01
+                || relativeError(es, expectedEs, expectedEs) > 0.01)
+                BOOST_ERROR(names[k] << " digest: wrong risk measures"
+                            << "\n    percentile: " << c
+                            << "\n    VaR:        " << var
+                            << " (expected " << expectedVar << ")"
+                            << "\n    ES:         " << es
+                            << " (expected " << expectedEs << ")");
+        }
+    }
+}
+
 test_suite* StatisticsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Statistics tests");
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testSequenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testConvergenceStatistics));
     suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testIncrementalStatistics));
+    suite->add(QUANTLIB_TEST_CASE(&StatisticsTest::testTDigestStatistics));
     return suite;
 }
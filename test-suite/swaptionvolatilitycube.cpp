@@ -442,6 +442,103 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testSabrRecalibration() {
+    BOOST_TEST_MESSAGE("Testing SABR cube recalibration after quote change...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    ext::shared_ptr<SwaptionVolCube1> volCubes[2];
+    for (Size n=0; n<2; n++) {
+        const bool warmStart = (n == 1);
+        volCubes[n] = ext::make_shared<SwaptionVolCube1>(vars.atmVolMatrix,
+                                                         vars.cube.tenors.options,
+                                                         vars.cube.tenors.swaps,
+                                                         vars.cube.strikeSpreads,
+                                                         vars.cube.volSpreadsHandle,
+                                                         vars.swapIndexBase,
+                                                         vars.shortSwapIndexBase,
+                                                         vars.vegaWeighedSmileFit,
+                                                         parametersGuess,
+                                                         isParameterFixed,
+                                                         true,
+                                                         ext::shared_ptr<EndCriteria>(),
+                                                         Null<Real>(),
+                                                         ext::shared_ptr<OptimizationMethod>(),
+                                                         Null<Real>(), false, 50,
+                                                         false, 0.0001,
+                                                         warmStart);
+        volCubes[n]->enableExtrapolation();
+        volCubes[n]->sparseSabrParameters();
+    }
+
+    // market move on a single smile
+    ext::shared_ptr<SimpleQuote> quote =
+        ext::dynamic_pointer_cast<SimpleQuote>(
+                                 vars.cube.volSpreadsHandle[1][0].currentLink());
+    quote->setValue(quote->value() + 0.0010);
+
+    const ext::shared_ptr<SwaptionVolCube1> expectedCube =
+        ext::make_shared<SwaptionVolCube1>(vars.atmVolMatrix,
+                                           vars.cube.tenors.options,
+                                           vars.cube.tenors.swaps,
+                                           vars.cube.strikeSpreads,
+                                           vars.cube.volSpreadsHandle,
+                                           vars.swapIndexBase,
+                                           vars.shortSwapIndexBase,
+                                           vars.vegaWeighedSmileFit,
+                                           parametersGuess,
+                                           isParameterFixed,
+                                           true);
+    expectedCube->enableExtrapolation();
+
+    // the cold-started cube must reproduce a new calibration exactly;
+    // the warm-started one must fit the smiles equally well
+    const Real tolerances[] = { 1e-14, 1e-4 };
+    for (Size n=0; n<2; n++) {
+        for (Size i=0;i<vars.cube.tenors.options.size(); i++ ) {
+            for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+                Rate atmStrike = expectedCube->atmStrike(vars.cube.tenors.options[i],
+                                                         vars.cube.tenors.swaps[j]);
+                for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                    Rate strike = atmStrike + vars.cube.strikeSpreads[k];
+                    Volatility expected =
+                        expectedCube->volatility(vars.cube.tenors.options[i],
+                                                 vars.cube.tenors.swaps[j],
+                                                 strike, true);
+                    Volatility calculated =
+                        volCubes[n]->volatility(vars.cube.tenors.options[i],
+                                                vars.cube.tenors.swaps[j],
+                                                strike, true);
+                    if (std::fabs(calculated - expected) > tolerances[n])
+                        BOOST_ERROR("failed to reproduce recalibrated smile" <<
+                                    (n == 0 ? "" : " with warm start") <<
+                                    "\n    option tenor = " << vars.cube.tenors.options[i] <<
+                                    "\n      swap tenor = " << vars.cube.tenors.swaps[j] <<
+                                    "\n          strike = " << io::rate(strike) <<
+                                    "\n        expected = " << io::volatility(expected) <<
+                                    "\n      calculated = " << io::volatility(calculated) <<
+                                    "\n           error = " << std::fabs(calculated-expected));
+                }
+            }
+        }
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -458,6 +555,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &SwaptionVolatilityCubeTest::testSabrRecalibration));
 
     return suite;
 }
@@ -23,6 +23,14 @@
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/indexes/bmaindex.hpp>
+#include <ql/utilities/marketdatafile.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -193,11 +201,236 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testIndexManagerFixings() {
+    BOOST_TEST_MESSAGE("Testing fixing storage in the index manager...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Euribor6M index;
+    IndexManager& manager = IndexManager::instance();
+    Size handle = manager.handle(index.name());
+    if (manager.handle("euribor6m actual/360") != handle)
+        BOOST_ERROR("index handle depends on the case of the name");
+
+    Flag flag;
+    flag.registerWith(manager.notifier(handle));
+
+    // bulk load on valid fixing dates
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    Date d = index.fixingCalendar().adjust(Date(4, January, 2010));
+    for (Size i=0; i<500; ++i) {
+        dates.push_back(d);
+        values.push_back(0.01 + 0.0001*i);
+        d = index.fixingCalendar().advance(d, 1, Days);
+    }
+    manager.setHistory(handle, dates, values);
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of bulk load");
+    if (!manager.hasHistory(index.name()))
+        BOOST_ERROR("history not stored");
+
+    // append, out-of-order merge and lookup through the index
+    std::vector<Date> newDates;
+    std::vector<Real> newValues;
+    newDates.push_back(d);
+    newValues.push_back(0.05);
+    newDates.push_back(dates[10]);
+    newValues.push_back(values[10]);
+    newDates.push_back(index.fixingCalendar().adjust(dates[0] - 3*Months));
+    newValues.push_back(0.04);
+    flag.lower();
+    index.addFixings(newDates.begin(), newDates.end(), newValues.begin());
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of added fixings");
+
+    const std::vector<Date>& stored = manager.fixingDates(handle);
+    if (stored.size() != dates.size()+2
+        || stored.front() != newDates[2] || stored.back() != newDates[0])
+        BOOST_ERROR("wrong merged fixing dates");
+    for (Size i=1; i<stored.size(); ++i) {
+        if (!(stored[i-1] < stored[i]))
+            BOOST_ERROR("fixing dates not sorted at " << stored[i]);
+    }
+
+    const TimeSeries<Real>& history = index.timeSeries();
+    if (history.size() != stored.size())
+        BOOST_ERROR("time series view has " << history.size()
+                    << " fixings instead of " << stored.size());
+    for (Size i=0; i<stored.size(); ++i) {
+        Real expected = manager.fixingValues(handle)[i];
+        if (manager.fixing(handle, stored[i]) != expected
+            || history[stored[i]] != expected
+            || index.fixing(stored[i]) != expected)
+            BOOST_ERROR("inconsistent fixing for " << stored[i]);
+    }
+    if (manager.fixing(handle, dates[0] - 1*Days) != Null<Real>())
+        BOOST_ERROR("fixing found for missing date");
+
+    // duplicates are rejected unless overwritten
+    BOOST_CHECK_THROW(index.addFixing(dates[20], 0.5), Error);
+    if (manager.fixing(handle, dates[20]) != values[20])
+        BOOST_ERROR("duplicated fixing overwrote the stored one");
+    index.addFixing(dates[20], 0.5, true);
+    if (manager.fixing(handle, dates[20]) != 0.5)
+        BOOST_ERROR("fixing not overwritten");
+    if (history[dates[20]] != 0.5)
+        BOOST_ERROR("held time series view not updated");
+
+    index.clearFixings();
+    if (manager.hasHistory(handle) || !manager.fixingDates(handle).empty())
+        BOOST_ERROR("fixings not cleared");
+    if (!history.empty())
+        BOOST_ERROR("held time series view not cleared");
+    if (!index.timeSeries().empty())
+        BOOST_ERROR("time series view not cleared");
+    flag.lower();
+    index.addFixing(dates[0], 0.02);
+    if (!flag.isUp())
+        BOOST_ERROR("observer lost after clearing the fixings");
+
+    // indexes whose name isn't built from the family name
+    BMAIndex bma;
+    Date wednesday(7, October, 2015);
+    Settings::instance().evaluationDate() = wednesday + 1*Weeks;
+    bma.addFixing(wednesday, 0.003);
+    if (manager.fixing(manager.handle(bma.name()), wednesday) != 0.003
+        || bma.fixing(wednesday) != 0.003)
+        BOOST_ERROR("BMA fixing not found after being stored");
+}
+
+namespace {
+
+    // removes the file on exit, even if a check throws
+    class TemporaryFile {
+      public:
+        explicit TemporaryFile(const std::string& path) : path_(path) {}
+        ~TemporaryFile() { std::remove(path_.c_str()); }
+        const std::string& path() const { return path_; }
+      private:
+        std::string path_;
+    };
+
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const std::string& path, const std::string& contents) {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out.write(contents.data(), contents.size());
+    }
+
+}
+
+void TimeSeriesTest::testMarketDataFile() {
+    BOOST_TEST_MESSAGE("Testing market-data file round trip...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Euribor6M euribor6m;
+    Euribor3M euribor3m;
+    Date d = euribor6m.fixingCalendar().adjust(Date(4, January, 2010));
+    for (Size i=0; i<300; ++i) {
+        euribor6m.addFixing(d, 0.02 + 0.0001*i);
+        if (i % 2 == 0)
+            euribor3m.addFixing(d, 0.01 + 0.0001*i);
+        d = euribor6m.fixingCalendar().advance(d, 1, Days);
+    }
+
+    std::vector<std::string> names;
+    names.push_back(euribor6m.name());
+    names.push_back(euribor3m.name());
+    std::map<std::string, ext::shared_ptr<Quote> > quotes;
+    quotes["EUR6M"] = ext::make_shared<SimpleQuote>(0.0215);
+    quotes["EUR3M"] = ext::make_shared<SimpleQuote>(0.0108);
+    quotes["EMPTY"] = ext::make_shared<SimpleQuote>();
+
+    const TemporaryFile temporary("quantlib-market-data-test.bin");
+    const std::string& path = temporary.path();
+    MarketDataFile::write(path, names, quotes);
+
+    std::vector<Date> dates6m = euribor6m.timeSeries().dates();
+    std::vector<Real> values6m = euribor6m.timeSeries().values();
+    std::vector<Date> dates3m = euribor3m.timeSeries().dates();
+    IndexManager::instance().clearHistories();
+
+    Flag flag;
+    flag.registerWith(IndexManager::instance().notifier(euribor6m.name()));
+    {
+        MarketDataFile file(path);
+        if (file.histories() != 2 || file.quotes() != 2)
+            BOOST_ERROR("wrong number of entries: " << file.histories()
+                        << " histories, " << file.quotes() << " quotes");
+        if (file.historyName(0) != "EURIBOR6M ACTUAL/360")
+            BOOST_ERROR("wrong history name " << file.historyName(0));
+        if (file.historySize(1) != dates3m.size())
+            BOOST_ERROR("wrong history size " << file.historySize(1));
+
+        file.loadHistories();
+
+        std::map<std::string, ext::shared_ptr<SimpleQuote> > loaded =
+            file.simpleQuotes();
+        if (loaded.size() != 2 || loaded["EUR6M"]->value() != 0.0215
+            || loaded["EUR3M"]->value() != 0.0108)
+            BOOST_ERROR("quotes not restored");
+
+        ext::shared_ptr<SimpleQuote> q = ext::make_shared<SimpleQuote>(0.0);
+        std::map<std::string, ext::shared_ptr<SimpleQuote> > existing;
+        existing["EUR3M"] = q;
+        existing["OTHER"] = ext::make_shared<SimpleQuote>(1.0);
+        if (file.updateQuotes(existing) != 1 || q->value() != 0.0108
+            || existing["OTHER"]->value() != 1.0)
+            BOOST_ERROR("quotes not updated");
+    }
+
+    if (!flag.isUp())
+        BOOST_ERROR("observer not notified of loaded fixings");
+    if (euribor6m.timeSeries().dates() != dates6m
+        || euribor6m.timeSeries().values() != values6m
+        || euribor3m.timeSeries().dates() != dates3m)
+        BOOST_ERROR("fixings not restored");
+    for (Size i=0; i<dates6m.size(); ++i) {
+        if (euribor6m.fixing(dates6m[i]) != values6m[i])
+            BOOST_ERROR("wrong fixing for " << dates6m[i]);
+    }
+
+    BOOST_CHECK_THROW(MarketDataFile("quantlib-missing-file.bin"), Error);
+
+    // corrupted files are rejected
+    const std::string contents = readFile(path);
+    const TemporaryFile corrupted("quantlib-market-data-corrupted.bin");
+
+    writeFile(corrupted.path(), contents.substr(0, contents.size()-8));
+    BOOST_CHECK_THROW(MarketDataFile(corrupted.path()), Error);
+
+    std::string badMagic = contents;
+    badMagic[0] = 'X';
+    writeFile(corrupted.path(), badMagic);
+    BOOST_CHECK_THROW(MarketDataFile(corrupted.path()), Error);
+
+    // dates offset of the first history entry past the end of the file
+    std::string badOffset = contents;
+    const boost::uint64_t offset = 8*boost::uint64_t(contents.size());
+    std::memcpy(&badOffset[48+24], &offset, sizeof(offset));
+    writeFile(corrupted.path(), badOffset);
+    BOOST_CHECK_THROW(MarketDataFile(corrupted.path()), Error);
+
+    // the unmodified contents are still accepted
+    writeFile(corrupted.path(), contents);
+    BOOST_CHECK_NO_THROW(MarketDataFile(corrupted.path()));
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIndexManagerFixings));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testMarketDataFile));
     return suite;
 }
 
@@ -25,6 +25,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/instruments/europeanoption.hpp>
 #include <ql/experimental/variancegamma/analyticvariancegammaengine.hpp>
 #include <ql/experimental/variancegamma/fftvariancegammaengine.hpp>
+#include <ql/experimental/variancegamma/variancegammacharacteristicfunction.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -204,6 +205,33 @@ void VarianceGammaTest::testVarianceGamma() {
                     error, tol);
             }
         }
+
+        // Test Carr-Madan engine, which caches the prices by expiry
+        ext::shared_ptr<PricingEngine> carrMadanEngine(
+            new CarrMadanFFTEngine(
+                ext::make_shared<VarianceGammaCharacteristicFunction>(
+                    ext::make_shared<VarianceGammaModel>(stochProcess)),
+                Handle<Quote>(spot),
+                Handle<YieldTermStructure>(rTS),
+                Handle<YieldTermStructure>(qTS)));
+        for (Size j=0; j<LENGTH(options); j++)
+        {
+            ext::shared_ptr<VanillaOption> option = ext::static_pointer_cast<VanillaOption>(optionList[j]);
+            option->setPricingEngine(carrMadanEngine);
+
+            Real calculated = option->NPV();
+            Real expected = results[i][j];
+            Real error = std::fabs(calculated-expected);
+            if (error>tol) {
+                ext::shared_ptr<StrikedTypePayoff> payoff = 
+                    ext::dynamic_pointer_cast<StrikedTypePayoff>(option->payoff());
+                REPORT_FAILURE("Carr-Madan value", payoff, option->exercise(),
+                    processes[i].s, processes[i].q, processes[i].r,
+                    today, processes[i].sigma, processes[i].nu,
+                    processes[i].theta, expected, calculated,
+                    error, tol);
+            }
+        }
     }
 }
 